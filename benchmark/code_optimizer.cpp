@@ -0,0 +1,267 @@
+#include <benchmark/benchmark.h>
+#include <sstream>
+
+extern "C" {
+#include "../src/parser.h"
+#include "../src/code_optimizer.h"
+#include "../src/code_optimizer_expr.h"
+#include "../src/code_optimizer_dataflow.h"
+#include "../src/code_optimizer_ssa.h"
+#include "../src/code_optimizer_licm.h"
+}
+
+#include "../test/utils/stringbycharprovider.h"
+
+class CodeOptimizerBenchmark : public benchmark::Fixture {
+    protected:
+        StringByCharProvider* provider = StringByCharProvider::instance();
+
+        static std::string generate_program(long functions_count) {
+            std::ostringstream program;
+            for(long i = 0; i < functions_count; ++i) {
+                program << "Function fn" << i << "(a As Integer, b As Double, s As String) As Integer\n"
+                        << "Dim i As Integer = 0\n"
+                        << "Dim acc As Integer = &H1F\n"
+                        << "Dim k As Integer = 7\n"
+                        << "Do While i < a\n"
+                        << "acc = acc + i * " << i % 97 + 1 << " + k * 2 - (k + 3) * &B101\n"
+                        << "If acc > 1000 Then\n"
+                        << "acc = acc - " << i % 800 + 100 << "\n"
+                        << "Else\n"
+                        << "acc = acc + Length(s)\n"
+                        << "End If\n"
+                        << "Scope\n"
+                        << "Dim inner As Integer = i * 2\n"
+                        << "s = s + !\"x\"\n"
+                        << "End Scope\n"
+                        << "i = i + 1\n"
+                        << "Loop\n"
+                        << "Return acc + b * 1.5\n"
+                        << "End Function\n";
+            }
+            program << "Scope\n"
+                    << "Dim r As Integer\n"
+                    << "Dim x As Integer\n"
+                    << "input x\n";
+            for(long i = 0; i < functions_count; ++i)
+                program << "r = r + fn" << i << "(x + " << i << ", " << i << ".5, !\"str\")\n";
+            program << "print r;\n"
+                    << "End Scope\n";
+            return program.str();
+        }
+
+        // many live constants and nested branches, each branch forks constants table
+        static std::string generate_branches(long branches_count) {
+            std::ostringstream program;
+            program << "Scope\n"
+                    << "Dim x As Integer\n"
+                    << "input x\n";
+            for(long i = 0; i < branches_count; ++i)
+                program << "Dim c" << i << " As Integer = " << i << "\n";
+            for(long i = 0; i < branches_count; ++i) {
+                program << "If x > " << i << " Then\n"
+                        << "c" << i << " = c" << (i + 1) % branches_count << " + 1\n"
+                        << "Else\n"
+                        << "x = x + c" << i << "\n";
+            }
+            for(long i = 0; i < branches_count; ++i)
+                program << "End If\n";
+            program << "print x;\n"
+                    << "End Scope\n";
+            return program.str();
+        }
+
+        void optimize(benchmark::State &st, bool worklist = false, bool advanced = false) {
+            const std::string program = generate_program(st.range(0));
+            size_t passes = 0;
+            size_t applied = 0;
+            size_t revisits = 0;
+            while(st.KeepRunning()) {
+                st.PauseTiming();
+                provider->setString(program);
+                Parser* parser = parser_init(token_stream);
+                parser_parse(parser);
+                code_optimizer_optimize_type_casts(parser->optimizer);
+                code_optimizer_update_meta_data(parser->optimizer);
+                if(advanced)
+                    code_optimizer_add_advance_peep_hole_patterns(parser->optimizer);
+                st.ResumeTiming();
+
+                passes = 1;
+                while(worklist ? code_optimizer_peep_hole_optimization_worklist(parser->optimizer)
+                               : code_optimizer_peep_hole_optimization(parser->optimizer))
+                    passes++;
+
+                st.PauseTiming();
+                applied = parser->optimizer->peep_hole_applied_count;
+                revisits = parser->optimizer->peep_hole_revisits_count;
+                parser_free(&parser);
+                memory_manager_collect(nullptr);
+                st.ResumeTiming();
+            }
+            st.counters["passes"] = passes;
+            st.counters["applied"] = applied;
+            st.counters["revisits"] = revisits;
+        }
+};
+
+BENCHMARK_DEFINE_F(CodeOptimizerBenchmark, PeepHole)(benchmark::State &st) {
+    optimize(st);
+}
+
+BENCHMARK_DEFINE_F(CodeOptimizerBenchmark, PeepHoleWorklist)(benchmark::State &st) {
+    optimize(st, true);
+}
+
+BENCHMARK_DEFINE_F(CodeOptimizerBenchmark, PeepHoleAdvanced)(benchmark::State &st) {
+    optimize(st, false, true);
+}
+
+BENCHMARK_DEFINE_F(CodeOptimizerBenchmark, PeepHoleAdvancedWorklist)(benchmark::State &st) {
+    optimize(st, true, true);
+}
+
+BENCHMARK_DEFINE_F(CodeOptimizerBenchmark, PropagateConstants)(benchmark::State &st) {
+    const std::string program = generate_branches(st.range(0));
+    while(st.KeepRunning()) {
+        st.PauseTiming();
+        provider->setString(program);
+        Parser* parser = parser_init(token_stream);
+        parser_parse(parser);
+        code_optimizer_split_code_to_graph(parser->optimizer);
+        code_optimizer_update_meta_data(parser->optimizer);
+        st.ResumeTiming();
+
+        code_optimizer_propagate_constants_optimization(parser->optimizer);
+
+        st.PauseTiming();
+        parser_free(&parser);
+        memory_manager_collect(nullptr);
+        st.ResumeTiming();
+    }
+}
+
+// repeated propagation passes as in main loop, constants tables dropped by pass are lazily freed and either
+// reclaimed between passes or kept until end of session, as lazy free did before
+BENCHMARK_DEFINE_F(CodeOptimizerBenchmark, PropagationPasses)(benchmark::State &st) {
+    const std::string program = generate_branches(st.range(0));
+    const bool collect = st.range(1) != 0;
+    while(st.KeepRunning()) {
+        st.PauseTiming();
+        provider->setString(program);
+        Parser* parser = parser_init(token_stream);
+        parser_parse(parser);
+        code_optimizer_split_code_to_graph(parser->optimizer);
+        code_optimizer_update_meta_data(parser->optimizer);
+        st.ResumeTiming();
+
+        for(int i = 0; i < 16; i++) {
+            code_optimizer_propagate_constants_optimization(parser->optimizer);
+            if(collect)
+                memory_manager_collect(nullptr);
+        }
+
+        st.PauseTiming();
+        parser_free(&parser);
+        memory_manager_collect(nullptr);
+        st.ResumeTiming();
+    }
+}
+
+// meta data after optimization pass, only expressions are rescanned once meta data were counted
+BENCHMARK_DEFINE_F(CodeOptimizerBenchmark, UpdateMetaData)(benchmark::State &st) {
+    provider->setString(generate_program(st.range(0)));
+    Parser* parser = parser_init(token_stream);
+    parser_parse(parser);
+    code_optimizer_update_meta_data(parser->optimizer);
+    while(st.KeepRunning())
+        code_optimizer_update_meta_data(parser->optimizer);
+    parser_free(&parser);
+    memory_manager_collect(nullptr);
+}
+
+// reaching definitions, liveness and available expressions of code graph
+BENCHMARK_DEFINE_F(CodeOptimizerBenchmark, Dataflow)(benchmark::State &st) {
+    provider->setString(generate_program(st.range(0)));
+    Parser* parser = parser_init(token_stream);
+    parser_parse(parser);
+    code_optimizer_split_code_to_graph(parser->optimizer);
+    size_t evaluations_count = 0;
+    while(st.KeepRunning()) {
+        CodeDataflow* definitions = code_optimizer_reaching_definitions(parser->optimizer);
+        CodeDataflow* live_variables = code_optimizer_live_variables(parser->optimizer);
+        CodeDataflow* expressions = code_optimizer_available_expressions(parser->optimizer);
+        evaluations_count = definitions->dataflow->evaluations_count + live_variables->dataflow->evaluations_count +
+                            expressions->dataflow->evaluations_count;
+        code_dataflow_free(&definitions);
+        code_dataflow_free(&live_variables);
+        code_dataflow_free(&expressions);
+    }
+    st.counters["evaluations"] = evaluations_count;
+    st.counters["blocks"] = parser->optimizer->code_graph->nodes_count;
+    parser_free(&parser);
+    memory_manager_collect(nullptr);
+}
+
+// construction of SSA form with value numbering and sparse conditional constant propagation
+BENCHMARK_DEFINE_F(CodeOptimizerBenchmark, SSA)(benchmark::State &st) {
+    provider->setString(generate_program(st.range(0)));
+    Parser* parser = parser_init(token_stream);
+    parser_parse(parser);
+    code_optimizer_update_meta_data(parser->optimizer);
+    code_optimizer_add_advance_peep_hole_patterns(parser->optimizer);
+    while(code_optimizer_peep_hole_optimization_worklist(parser->optimizer));
+    code_optimizer_split_code_to_graph(parser->optimizer);
+    size_t values_count = 0;
+    size_t redundancies_count = 0;
+    while(st.KeepRunning()) {
+        CodeSSA* ssa = code_optimizer_ssa_init(parser->optimizer);
+        code_ssa_propagate_constants(ssa);
+        values_count = ssa->values_count;
+        redundancies_count = ssa->redundancies_count;
+        code_ssa_free(&ssa);
+    }
+    st.counters["values"] = values_count;
+    st.counters["redundancies"] = redundancies_count;
+    st.counters["blocks"] = parser->optimizer->code_graph->nodes_count;
+    parser_free(&parser);
+    memory_manager_collect(nullptr);
+}
+
+// motion of invariant computations out of loops of generated program
+BENCHMARK_DEFINE_F(CodeOptimizerBenchmark, LoopInvariantCodeMotion)(benchmark::State &st) {
+    const std::string program = generate_program(st.range(0));
+    while(st.KeepRunning()) {
+        st.PauseTiming();
+        provider->setString(program);
+        Parser* parser = parser_init(token_stream);
+        parser_parse(parser);
+        code_optimizer_update_meta_data(parser->optimizer);
+        code_optimizer_add_advance_peep_hole_patterns(parser->optimizer);
+        while(code_optimizer_peep_hole_optimization_worklist(parser->optimizer));
+        code_optimizer_update_meta_data(parser->optimizer);
+        code_optimizer_split_code_to_graph(parser->optimizer);
+        code_optimizer_update_meta_data(parser->optimizer);
+        st.ResumeTiming();
+
+        code_optimizer_loop_invariant_code_motion(parser->optimizer);
+
+        st.PauseTiming();
+        parser_free(&parser);
+        memory_manager_collect(nullptr);
+        st.ResumeTiming();
+    }
+}
+
+BENCHMARK_REGISTER_F(CodeOptimizerBenchmark, PeepHole)->Range(8, 128)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(CodeOptimizerBenchmark, PeepHoleWorklist)->Range(8, 128)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(CodeOptimizerBenchmark, PeepHoleAdvanced)->Range(8, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(CodeOptimizerBenchmark, PeepHoleAdvancedWorklist)->Range(8, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(CodeOptimizerBenchmark, PropagateConstants)->RangeMultiplier(4)->Range(16, 1024)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(CodeOptimizerBenchmark, PropagationPasses)->RangeMultiplier(4)->Ranges({{16, 256}, {0, 1}})
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(CodeOptimizerBenchmark, UpdateMetaData)->Range(8, 1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(CodeOptimizerBenchmark, Dataflow)->Range(8, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(CodeOptimizerBenchmark, SSA)->Range(8, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(CodeOptimizerBenchmark, LoopInvariantCodeMotion)->Range(8, 1024)->Unit(benchmark::kMillisecond);
@@ -1,9 +1,14 @@
 #include <benchmark/benchmark.h>
 #include <cmath>
+#include <cstring>
 #include <deque>
+#include <string>
+#include <vector>
 
 extern "C" {
 #include "../src/memory.h"
+#include "../src/string_interner.h"
+#include "../src/symtable.h"
 }
 
 class HashBenchmark : public benchmark::Fixture {
@@ -22,15 +27,100 @@ size_t hash(const char* str) {
 
 BENCHMARK_DEFINE_F(HashBenchmark, Hash)(benchmark::State &st) {
     while(st.KeepRunning()) {
-        hash("ahoj soniku");
+        benchmark::DoNotOptimize(hash("ahoj soniku"));
+    }
+}
+
+BENCHMARK_DEFINE_F(HashBenchmark, InternerHash)(benchmark::State &st) {
+    while(st.KeepRunning()) {
+        benchmark::DoNotOptimize(string_interner_hash("ahoj soniku", 11));
     }
 }
 
 BENCHMARK_DEFINE_F(HashBenchmark, Strcmp)(benchmark::State &st) {
     while(st.KeepRunning()) {
-        strcmp("ahoj soniku", "ahoj soniku");
+        benchmark::DoNotOptimize(strcmp("ahoj soniku", "ahoj soniku"));
     }
 }
 
 BENCHMARK_REGISTER_F(HashBenchmark, Hash);
-BENCHMARK_REGISTER_F(HashBenchmark, Strcmp);
\ No newline at end of file
+BENCHMARK_REGISTER_F(HashBenchmark, InternerHash);
+BENCHMARK_REGISTER_F(HashBenchmark, Strcmp);
+
+class SymbolTableBenchmark : public benchmark::Fixture {
+    protected:
+        std::vector<std::string> keys;
+
+        // names similar to identifiers in programs, table starts with size used by symbol register
+        void SetUp(benchmark::State &st) override {
+            keys.clear();
+            for(long i = 0; i < st.range(0); ++i)
+                keys.push_back("variable_" + std::to_string(i));
+        }
+
+        static SymbolTable* init() {
+            return symbol_table_init(32, sizeof(SymbolTableBaseItem), nullptr, nullptr);
+        }
+
+        void fill(SymbolTable* table) {
+            for(auto &key : keys)
+                symbol_table_get_or_create(table, key.c_str());
+        }
+
+        static void count_item(const char* key, void* item, void* data) {
+            (*(size_t*) data)++;
+        }
+};
+
+BENCHMARK_DEFINE_F(SymbolTableBenchmark, Insert)(benchmark::State &st) {
+    while(st.KeepRunning()) {
+        SymbolTable* table = init();
+        fill(table);
+        st.PauseTiming();
+        symbol_table_free(table);
+        st.ResumeTiming();
+    }
+    st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+
+BENCHMARK_DEFINE_F(SymbolTableBenchmark, Get)(benchmark::State &st) {
+    SymbolTable* table = init();
+    fill(table);
+    while(st.KeepRunning()) {
+        for(auto &key : keys)
+            benchmark::DoNotOptimize(symbol_table_get(table, key.c_str()));
+    }
+    symbol_table_free(table);
+    st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+
+BENCHMARK_DEFINE_F(SymbolTableBenchmark, GetMissing)(benchmark::State &st) {
+    SymbolTable* table = init();
+    fill(table);
+    std::vector<std::string> missing;
+    for(auto &key : keys)
+        missing.push_back(key + "_missing");
+    while(st.KeepRunning()) {
+        for(auto &key : missing)
+            benchmark::DoNotOptimize(symbol_table_get(table, key.c_str()));
+    }
+    symbol_table_free(table);
+    st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+
+BENCHMARK_DEFINE_F(SymbolTableBenchmark, Foreach)(benchmark::State &st) {
+    SymbolTable* table = init();
+    fill(table);
+    size_t count = 0;
+    while(st.KeepRunning()) {
+        symbol_table_foreach(table, count_item, &count);
+    }
+    benchmark::DoNotOptimize(count);
+    symbol_table_free(table);
+    st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+
+BENCHMARK_REGISTER_F(SymbolTableBenchmark, Insert)->RangeMultiplier(8)->Range(8, 32768);
+BENCHMARK_REGISTER_F(SymbolTableBenchmark, Get)->RangeMultiplier(8)->Range(8, 32768);
+BENCHMARK_REGISTER_F(SymbolTableBenchmark, GetMissing)->RangeMultiplier(8)->Range(8, 32768);
+BENCHMARK_REGISTER_F(SymbolTableBenchmark, Foreach)->RangeMultiplier(8)->Range(8, 32768);
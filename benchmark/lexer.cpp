@@ -1,5 +1,8 @@
 #include <benchmark/benchmark.h>
 #include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
 
 extern "C" {
 #include "../src/lexer.h"
@@ -9,25 +12,56 @@ extern "C" {
 
 class LexerBenchmark : public benchmark::Fixture {
     protected:
-        Lexer* lexer;
         StringByCharProvider* provider = StringByCharProvider::instance();
 
-        LexerBenchmark() {
-            lexer = lexer_init(token_stream);
-        }
-
-        void tokenize(benchmark::State &st) {
+        // whole source is tokenized in every iteration, throughput is reported as bytes per second
+        void tokenize(benchmark::State &st, const std::string &source, bool buffered,
+                      LexerFSMEngine engine = LEXER_FSM_ENGINE__SWITCH) {
             Token token{};
             while(st.KeepRunning()) {
+                Lexer* lexer;
+                if(buffered) {
+                    lexer = lexer_init_with_input(lexer_input_init_memory(source.c_str(), source.length()));
+                } else {
+                    provider->setString(source);
+                    lexer = lexer_init(token_stream);
+                }
+                lexer->lexer_fsm->engine = engine;
                 do {
                     token = lexer_next_token(lexer);
+                    token_free(&token);
                 } while(!(token.type == TOKEN_ERROR || token.type == TOKEN_EOF));
+                lexer_free(&lexer);
+            }
+            st.SetBytesProcessed(st.iterations() * source.length());
+        }
+
+        // machine generated like source, with comment banners and big string tables
+        static std::string generated(long lines) {
+            const std::string banner(76, '*');
+            std::string source = "/'" + banner + "\n";
+            for(int i = 0; i < 20; ++i)
+                source += "  * generated table of messages, do not edit" + std::string(32, ' ') + "*\n";
+            source += banner + "'/\n";
+            for(long i = 0; i < lines; ++i) {
+                source += "    ' message " + std::to_string(i) + std::string(60, '-') + "\n";
+                source += "    messages_" + std::to_string(i) + " = !\"";
+                for(int j = 0; j < 8; ++j)
+                    source += "Lorem ipsum dolor sit amet, consectetur adipiscing elit";
+                source += "\\n\"\n";
             }
+            return source;
+        }
+
+        static std::string repeat(const std::string &source, long count) {
+            std::string repeated;
+            for(long i = 0; i < count; ++i)
+                repeated += source;
+            return repeated;
         }
 };
 
-BENCHMARK_DEFINE_F(LexerBenchmark, Factorial)(benchmark::State &st) {
-    provider->setString(R"RAW(
+static const std::string FACTORIAL = R"RAW(
 /'Program 2: Vypocet faktorialu (rekurzivne)'/
 Declare Function factorial (n As Integer) As Integer
 Function factorial (n As Integer) As Integer
@@ -43,12 +77,9 @@ result = n * temp_result
 End If
 Return result
 End Function
-)RAW");
-    tokenize(st);
-}
+)RAW";
 
-BENCHMARK_DEFINE_F(LexerBenchmark, StringsManipulation)(benchmark::State &st) {
-    provider->setString(R"RAW(
+static const std::string STRINGS_MANIPULATION = R"RAW(
 /' Program 3: Prace s retezci a vestavenymi funkcemi '/
 Scope
 Dim s1 aS String
@@ -73,9 +104,127 @@ Print !"\\nSpatne zadana posloupnost, zkuste znovu";
 Input s1
 Loop
 End Scope
-)RAW");
-    tokenize(st);
+)RAW";
+
+static const std::string IDENTIFIERS = R"RAW(
+Dim counter As Integer
+Dim accumulated_value As Double
+Dim s As String
+Do While counter < limit And Not finished
+If accumulated_value > threshold Then
+accumulated_value = accumulated_value - threshold * counter
+ElseIf counter = next_counter Then
+s = SubStr(s, counter, Length(s)) + Chr(Asc(s, counter))
+End If
+counter = counter + step_size
+Loop
+Return accumulated_value
+)RAW";
+
+// constant table unrolled into assignments
+static const std::string NUMBERS = R"RAW(
+table_values = 1234567 + &HFF7A * 3.25e2 - &B1011 / 0.5
+table_values = 2147483 - &O7741 * 12.5e-3 + &H1F2E3D / 1024
+)RAW";
+
+BENCHMARK_DEFINE_F(LexerBenchmark, Factorial)(benchmark::State &st) {
+    tokenize(st, repeat(FACTORIAL, st.range(0)), false);
+}
+
+BENCHMARK_DEFINE_F(LexerBenchmark, FactorialBuffered)(benchmark::State &st) {
+    tokenize(st, repeat(FACTORIAL, st.range(0)), true);
+}
+
+BENCHMARK_DEFINE_F(LexerBenchmark, StringsManipulation)(benchmark::State &st) {
+    tokenize(st, repeat(STRINGS_MANIPULATION, st.range(0)), false);
+}
+
+BENCHMARK_DEFINE_F(LexerBenchmark, StringsManipulationBuffered)(benchmark::State &st) {
+    tokenize(st, repeat(STRINGS_MANIPULATION, st.range(0)), true);
+}
+
+BENCHMARK_DEFINE_F(LexerBenchmark, IdentifiersBuffered)(benchmark::State &st) {
+    tokenize(st, repeat(IDENTIFIERS, st.range(0)), true);
+}
+
+BENCHMARK_DEFINE_F(LexerBenchmark, FactorialTable)(benchmark::State &st) {
+    tokenize(st, repeat(FACTORIAL, st.range(0)), true, LEXER_FSM_ENGINE__TABLE);
+}
+
+BENCHMARK_DEFINE_F(LexerBenchmark, StringsManipulationTable)(benchmark::State &st) {
+    tokenize(st, repeat(STRINGS_MANIPULATION, st.range(0)), true, LEXER_FSM_ENGINE__TABLE);
+}
+
+BENCHMARK_DEFINE_F(LexerBenchmark, IdentifiersTable)(benchmark::State &st) {
+    tokenize(st, repeat(IDENTIFIERS, st.range(0)), true, LEXER_FSM_ENGINE__TABLE);
+}
+
+BENCHMARK_DEFINE_F(LexerBenchmark, NumbersTable)(benchmark::State &st) {
+    tokenize(st, repeat(NUMBERS, st.range(0)), true, LEXER_FSM_ENGINE__TABLE);
+}
+
+BENCHMARK_DEFINE_F(LexerBenchmark, GeneratedBuffered)(benchmark::State &st) {
+    tokenize(st, generated(st.range(0)), true);
+}
+
+BENCHMARK_DEFINE_F(LexerBenchmark, GeneratedTable)(benchmark::State &st) {
+    tokenize(st, generated(st.range(0)), true, LEXER_FSM_ENGINE__TABLE);
+}
+
+class KeywordLookupBenchmark : public benchmark::Fixture {
+    protected:
+        const std::vector<std::string> names = {
+                "dim", "counter", "as", "integer", "accumulated_value", "double", "do", "while",
+                "limit", "and", "not", "finished", "if", "threshold", "then", "elseif",
+                "next_counter", "substr", "length", "chr", "asc", "end", "step_size", "loop", "return"
+        };
+
+        // previous implementation, kept as reference
+        static LexerFSMState linear_identifier_state(const char* name) {
+            static const LexerFSMState states[] = {
+#define KEYWORD_STATE(name, state) state,
+                    LEXER_FSM_KEYWORDS(KEYWORD_STATE)
+#undef KEYWORD_STATE
+            };
+            static const char* keywords[] = {
+#define KEYWORD_NAME(name, state) name,
+                    LEXER_FSM_KEYWORDS(KEYWORD_NAME)
+#undef KEYWORD_NAME
+            };
+            for(size_t i = 0; i < sizeof(keywords) / sizeof(*keywords); i++) {
+                if(strcmp(keywords[i], name) == 0)
+                    return states[i];
+            }
+            return LEX_FSM__IDENTIFIER_FINISHED;
+        }
+};
+
+BENCHMARK_DEFINE_F(KeywordLookupBenchmark, Linear)(benchmark::State &st) {
+    while(st.KeepRunning()) {
+        for(const std::string &name: names)
+            benchmark::DoNotOptimize(linear_identifier_state(name.c_str()));
+    }
+    st.SetItemsProcessed(st.iterations() * names.size());
+}
+
+BENCHMARK_DEFINE_F(KeywordLookupBenchmark, PerfectHash)(benchmark::State &st) {
+    while(st.KeepRunning()) {
+        for(const std::string &name: names)
+            benchmark::DoNotOptimize(lexer_fsm_get_identifier_state_with_length(name.c_str(), name.length()));
+    }
+    st.SetItemsProcessed(st.iterations() * names.size());
 }
 
-BENCHMARK_REGISTER_F(LexerBenchmark, Factorial);
-BENCHMARK_REGISTER_F(LexerBenchmark, StringsManipulation);
+BENCHMARK_REGISTER_F(LexerBenchmark, Factorial)->Range(1, 256);
+BENCHMARK_REGISTER_F(LexerBenchmark, FactorialBuffered)->Range(1, 256);
+BENCHMARK_REGISTER_F(LexerBenchmark, StringsManipulation)->Range(1, 256);
+BENCHMARK_REGISTER_F(LexerBenchmark, StringsManipulationBuffered)->Range(1, 256);
+BENCHMARK_REGISTER_F(LexerBenchmark, IdentifiersBuffered)->Range(1, 256);
+BENCHMARK_REGISTER_F(LexerBenchmark, FactorialTable)->Range(1, 256);
+BENCHMARK_REGISTER_F(LexerBenchmark, StringsManipulationTable)->Range(1, 256);
+BENCHMARK_REGISTER_F(LexerBenchmark, IdentifiersTable)->Range(1, 256);
+BENCHMARK_REGISTER_F(LexerBenchmark, NumbersTable)->Range(1, 256);
+BENCHMARK_REGISTER_F(LexerBenchmark, GeneratedBuffered)->Range(16, 1024);
+BENCHMARK_REGISTER_F(LexerBenchmark, GeneratedTable)->Range(16, 1024);
+BENCHMARK_REGISTER_F(KeywordLookupBenchmark, Linear);
+BENCHMARK_REGISTER_F(KeywordLookupBenchmark, PerfectHash);
@@ -8,7 +8,7 @@ extern "C" {
 
 class MemoryManagerBenchmark : public benchmark::Fixture {
     protected:
-        MemoryManager* manager;
+        MemoryManager* manager = nullptr;
         std::deque<void*> addresses;
 
         void SetUp(benchmark::State &st) override {
@@ -40,5 +40,44 @@ BENCHMARK_DEFINE_F(MemoryManagerBenchmark, Free)(benchmark::State &st) {
 
 }
 
+class MemoryManagerArenaBenchmark : public MemoryManagerBenchmark {
+    protected:
+        void SetUp(benchmark::State &st) override {
+            MemoryManagerBenchmark::SetUp(st);
+            memory_manager_switch_arena(manager, MEMORY_MANAGER_ARENA_PARSER);
+        }
+};
+
+BENCHMARK_DEFINE_F(MemoryManagerArenaBenchmark, Alloc)(benchmark::State &st) {
+    while(st.KeepRunning()) {
+        memory_manager_malloc(static_cast<size_t>(st.range(0)), "", 0, "", manager);
+    }
+}
+
+BENCHMARK_DEFINE_F(MemoryManagerArenaBenchmark, Free)(benchmark::State &st) {
+    while(st.KeepRunning()) {
+        for(int i = 0; i < st.range(0); ++i) {
+            addresses.push_front(memory_manager_malloc(1, "", 0, "", manager));
+        }
+
+        for(auto address: addresses)
+            memory_manager_free(address, "", 0, "", manager);
+
+        addresses.clear();
+    }
+}
+
+BENCHMARK_DEFINE_F(MemoryManagerArenaBenchmark, Drop)(benchmark::State &st) {
+    while(st.KeepRunning()) {
+        for(int i = 0; i < st.range(0); ++i) {
+            memory_manager_malloc(16, "", 0, "", manager);
+        }
+        memory_manager_drop_arena(manager, MEMORY_MANAGER_ARENA_PARSER);
+    }
+}
+
 BENCHMARK_REGISTER_F(MemoryManagerBenchmark, Alloc)->Ranges({{8, 32}});
-BENCHMARK_REGISTER_F(MemoryManagerBenchmark, Free)->Ranges({{4, 64}});
\ No newline at end of file
+BENCHMARK_REGISTER_F(MemoryManagerBenchmark, Free)->Ranges({{4, 64}});
+BENCHMARK_REGISTER_F(MemoryManagerArenaBenchmark, Alloc)->Ranges({{8, 32}});
+BENCHMARK_REGISTER_F(MemoryManagerArenaBenchmark, Free)->Ranges({{4, 64}});
+BENCHMARK_REGISTER_F(MemoryManagerArenaBenchmark, Drop)->Ranges({{64, 4096}});
\ No newline at end of file
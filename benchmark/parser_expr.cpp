@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include <string>
+
+extern "C" {
+#include "../src/parser.h"
+#include "../src/parser_expr.h"
+}
+
+#include "../test/utils/stringbycharprovider.h"
+
+class ParserExpressionBenchmark : public benchmark::Fixture {
+    protected:
+        StringByCharProvider* provider = StringByCharProvider::instance();
+
+        // only precedence parser is measured, no semantic analysis and code generation
+        void parse(benchmark::State &st, const std::string &expression) {
+            while(st.KeepRunning()) {
+                st.PauseTiming();
+                provider->setString(expression);
+                Parser* parser = parser_init(token_stream);
+                parser->run_type = PARSER_RUN_TYPE_NOTHING;
+                st.ResumeTiming();
+
+                if(!parser_parse_expression(parser))
+                    st.SkipWithError("Expression parsing failed.");
+
+                st.PauseTiming();
+                parser_free(&parser);
+                st.ResumeTiming();
+            }
+            st.SetItemsProcessed(st.iterations() * st.range(0));
+        }
+
+        // 1 + 2 * 3 - 4 \ 5 ..., stack stays shallow
+        static std::string flat(long terms) {
+            const char* operators[] = {" + ", " * ", " - ", " \\ ", " / "};
+            std::string expression = "1";
+            for(long i = 1; i < terms; ++i)
+                expression += operators[i % 5] + std::to_string(i + 1);
+            return expression + "\n";
+        }
+
+        // 1 + (2 * (3 - (...))), stack grows with count of terms
+        static std::string nested(long terms) {
+            std::string expression;
+            for(long i = 1; i < terms; ++i)
+                expression += std::to_string(i) + (i % 2 ? " + (" : " * (");
+            expression += std::to_string(terms);
+            return expression + std::string(terms - 1, ')') + "\n";
+        }
+};
+
+BENCHMARK_DEFINE_F(ParserExpressionBenchmark, Flat)(benchmark::State &st) {
+    parse(st, flat(st.range(0)));
+}
+
+BENCHMARK_DEFINE_F(ParserExpressionBenchmark, Nested)(benchmark::State &st) {
+    parse(st, nested(st.range(0)));
+}
+
+BENCHMARK_REGISTER_F(ParserExpressionBenchmark, Flat)->RangeMultiplier(4)->Range(4, 4096);
+BENCHMARK_REGISTER_F(ParserExpressionBenchmark, Nested)->RangeMultiplier(4)->Range(4, 4096);
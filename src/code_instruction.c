@@ -16,6 +16,7 @@ CodeInstruction* code_instruction_init(
     instruction->meta_data.purity_type = META_TYPE_PURE;
     instruction->meta_data.interpretable = false;
     instruction->meta_data.without_effect = false;
+    instruction->meta_data.function = NULL;
 
     instruction->prev = instruction->next = NULL;
 
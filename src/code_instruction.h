@@ -123,6 +123,8 @@ typedef struct {
     MetaType purity_type;
     bool interpretable;
     bool without_effect;
+    // function containing instruction, maintained by optimizer
+    FunctionMetaData* function;
 } CodeInstructionMetaData;
 
 typedef struct code_instruction_signature_t {
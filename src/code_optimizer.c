@@ -1,7 +1,6 @@
 #include "code_optimizer.h"
 #include "memory.h"
 #include "meta_data_constants_tables_stack.h"
-#include "meta_data_cycled_blocks_mod_vars.h"
 #include "oriented_graph.h"
 #include "meta_data_code_block.h"
 
@@ -27,8 +26,11 @@ CodeOptimizer* code_optimizer_init(CodeGenerator* generator, SymbolVariable* tem
 
     optimizer->labels_meta_data = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(LabelMetaData),
                                                     &init_label_meta_data, NULL);
+    optimizer->meta_data_counted = false;
 
     optimizer->code_graph = oriented_graph_init(sizeof(CodeBlock), &init_code_block, &free_code_block);
+    optimizer->code_loops = NULL;
+    optimizer->code_loops_mod_vars = NULL;
 
     optimizer->generator = generator;
     optimizer->temp1 = temp1;
@@ -42,6 +44,12 @@ CodeOptimizer* code_optimizer_init(CodeGenerator* generator, SymbolVariable* tem
 
     llist_init(&optimizer->peep_hole_patterns, sizeof(PeepHolePattern), &init_peep_hole_pattern,
                &free_peep_hole_pattern, NULL);
+    optimizer->peep_hole_patterns_index_valid = false;
+    optimizer->peep_hole_patterns_window = 0;
+    optimizer->peep_hole_applied_count = 0;
+    optimizer->peep_hole_revisits_count = 0;
+    optimizer->peep_hole_temp_operand = code_instruction_operand_init_variable(optimizer->temp6);
+    optimizer->peep_hole_true_operand = code_instruction_operand_init_boolean(true);
 
     // adding peephole patterns
     /* Deleting unused frame
@@ -553,12 +561,15 @@ void code_optimizer_free(CodeOptimizer** optimizer) {
     NULL_POINTER_CHECK(optimizer,);
     NULL_POINTER_CHECK(*optimizer,);
 
+    code_optimizer_free_code_loops(*optimizer);
     oriented_graph_free(&(*optimizer)->code_graph);
     symbol_table_free((*optimizer)->variables_meta_data);
     symbol_table_free((*optimizer)->functions_meta_data);
     symbol_table_free((*optimizer)->labels_meta_data);
     interpreter_free(&(*optimizer)->interpreter);
     llist_free(&(*optimizer)->peep_hole_patterns);
+    code_instruction_operand_free(&(*optimizer)->peep_hole_temp_operand);
+    code_instruction_operand_free(&(*optimizer)->peep_hole_true_operand);
     memory_free(*optimizer);
     *optimizer = NULL;
 }
@@ -582,38 +593,194 @@ void code_optimizer_reset_function_meta_data(const char* key, void* item, void*
     FunctionMetaData* v = (FunctionMetaData*) item;
     v->call_count = 0;
     v->purity_type = META_TYPE_PURE;
+    v->dynamic_dependent_count = 0;
+    v->outputed_count = 0;
+    v->with_side_effect_count = 0;
     symbol_table_clear_buckets(v->mod_global_vars);
     symbol_table_clear_buckets(v->read_global_vars);
 }
 
-void code_optimizer_update_meta_data(CodeOptimizer* optimizer) {
-    NULL_POINTER_CHECK(optimizer,);
+// function of instruction following instruction from previous_function, same as in sequential scan of program
+static FunctionMetaData* code_optimizer_instruction_function(CodeOptimizer* optimizer, CodeInstruction* instruction,
+                                                            FunctionMetaData* previous_function) {
+    if(instruction->meta_data.type == CODE_INSTRUCTION_META_TYPE_FUNCTION_START) {
+        ASSERT(instruction->type == I_LABEL);
+        return code_optimizer_function_meta_data(optimizer, instruction->op0->data.label);
+    }
 
-    // clear old statistics
-    symbol_table_foreach(optimizer->variables_meta_data, code_optimizer_reset_variable_meta_data, NULL);
-    symbol_table_foreach(optimizer->labels_meta_data, code_optimizer_reset_label_meta_data, NULL);
-    symbol_table_foreach(optimizer->functions_meta_data, code_optimizer_reset_function_meta_data, NULL);
+    if(instruction->meta_data.type == CODE_INSTRUCTION_META_TYPE_FUNCTION_END)
+        return NULL;
 
-    CodeInstruction* instruction = optimizer->generator->first;
-    const char* current_function = NULL;
+    return previous_function;
+}
 
-    while(instruction != NULL) {
-        if(instruction->meta_data.type == CODE_INSTRUCTION_META_TYPE_FUNCTION_START) {
-            ASSERT(instruction->type == I_LABEL);
-            current_function = instruction->op0->data.label;
+static void code_optimizer_count_global_var(SymbolTable* global_vars, SymbolVariable* variable, int delta) {
+    const char* key = variable_cached_identifier(variable);
+    SymbolTableIntItem* item = (SymbolTableIntItem*) (
+            delta > 0 ? symbol_table_get_or_create(global_vars, key) : symbol_table_get(global_vars, key)
+    );
+    NULL_POINTER_CHECK(item,);
+
+    item->value += delta;
+    // only variables used by any instruction are kept
+    if(item->value <= 0)
+        symbol_table_remove(global_vars, key);
+}
+
+// adds (delta 1) or removes (delta -1) contribution of instruction to meta data of function containing it
+static void code_optimizer_count_function_instruction(FunctionMetaData* function, CodeInstruction* instruction,
+                                                      int delta) {
+    const TypeInstructionClass instruction_cls = instruction_class(instruction);
+
+    if(instruction->type == I_READ)
+        function->dynamic_dependent_count += delta;
+    else if(instruction->type == I_WRITE)
+        function->outputed_count += delta;
+
+    // set modified global variables
+    if((instruction_cls == INSTRUCTION_TYPE_WRITE ||
+        instruction_cls == INSTRUCTION_TYPE_VAR_MODIFIERS) &&
+       instruction->op0->type == TYPE_INSTRUCTION_OPERAND_VARIABLE &&
+       instruction->op0->data.variable->frame == VARIABLE_FRAME_GLOBAL) {
+        function->with_side_effect_count += delta;
+        code_optimizer_count_global_var(function->mod_global_vars, instruction->op0->data.variable, delta);
+    }
+
+    // set read global variables
+    CodeInstructionOperand* operands[OPERANDS_MAX_COUNT] = {
+            instruction->op0,
+            instruction->op1,
+            instruction->op2
+    };
+
+    const TypeInstructionOperand operands_type[OPERANDS_MAX_COUNT] = {
+            instruction->signature_buffer->type0,
+            instruction->signature_buffer->type1,
+            instruction->signature_buffer->type2,
+    };
+
+    for(int j = 0; j < instruction->signature_buffer->operand_count; j++) {
+        if(operands[j]->type == TYPE_INSTRUCTION_OPERAND_VARIABLE &&
+           operands_type[j] == TYPE_INSTRUCTION_OPERAND_SYMBOL &&
+           operands[j]->data.variable->frame == VARIABLE_FRAME_GLOBAL) {
+            code_optimizer_count_global_var(function->read_global_vars, operands[j]->data.variable, delta);
         }
+    }
 
-        if(instruction->meta_data.type == CODE_INSTRUCTION_META_TYPE_FUNCTION_END)
-            current_function = NULL;
+    function->purity_type = META_TYPE_PURE;
+    if(function->dynamic_dependent_count > 0)
+        function->purity_type |= META_TYPE_DYNAMIC_DEPENDENT;
+    if(function->outputed_count > 0)
+        function->purity_type |= META_TYPE_OUTPUTED;
+    if(function->with_side_effect_count > 0)
+        function->purity_type |= META_TYPE_WITH_SIDE_EFFECT;
+}
 
-        code_optimizer_adding_instruction(optimizer, instruction);
-        code_optimizer_update_function_meta_data(optimizer, instruction, current_function);
+// adds (delta 1) or removes (delta -1) contribution of instruction to meta data of variables, labels and functions calls
+static void code_optimizer_count_instruction(CodeOptimizer* optimizer, CodeInstruction* instruction, int delta) {
+    const TypeInstruction instruction_type = instruction->type;
 
+    // handle labels
+    switch(instruction_type) {
+        case I_CALL:
+            code_optimizer_function_meta_data(optimizer, instruction->op0->data.label)->call_count += delta;
+            // fall through
+        case I_JUMP:
+        case I_JUMP_IF_EQUAL:
+        case I_JUMP_IF_NOT_EQUAL:
+        case I_JUMP_IF_EQUAL_STACK:
+        case I_JUMP_IF_NOT_EQUAL_STACK:
+            code_optimizer_label_meta_data(optimizer, instruction->op0->data.label)->occurrences_count += delta;
+            break;
+        default:
+            break;
+    }
+
+    if(instruction_type == I_DEF_VAR || instruction_type == I_POP_STACK)
+        return;
+
+    const short operands_count = code_generator_instruction_operands_count(optimizer->generator, instruction_type);
+    const CodeInstructionOperand* operands[] = {instruction->op0, instruction->op1, instruction->op2};
+
+    for(int i = 0; i < operands_count; i++) {
+        if(operands[i] == NULL) {
+            LOG_WARNING("Operand is null when it shoul not.");
+            return;
+        }
+
+        if(operands[i]->type != TYPE_INSTRUCTION_OPERAND_VARIABLE)
+            continue;
+
+        if(instruction_type == I_MOVE && i == 0) // it's first operand
+            continue;
+
+        VariableMetaData* meta_data = code_optimizer_variable_meta_data(optimizer, operands[i]->data.variable);
+        meta_data->occurrences_count += delta;
+
+        if(instruction_type == I_READ) {
+            meta_data->read_usage_count += delta;
+            if(meta_data->read_usage_count > 0)
+                meta_data->purity_type |= META_TYPE_DYNAMIC_DEPENDENT;
+            else
+                meta_data->purity_type &= ~META_TYPE_DYNAMIC_DEPENDENT;
+            break;
+        }
+    }
+}
+
+// reassigns functions of instructions from given one, which follow changed boundary of function
+static void code_optimizer_update_instructions_function(CodeOptimizer* optimizer, CodeInstruction* instruction,
+                                                        FunctionMetaData* previous_function) {
+    while(instruction != NULL) {
+        FunctionMetaData* function = code_optimizer_instruction_function(optimizer, instruction, previous_function);
+        // rest of program is not affected
+        if(function == instruction->meta_data.function)
+            return;
+
+        if(instruction->meta_data.function != NULL)
+            code_optimizer_count_function_instruction(instruction->meta_data.function, instruction, -1);
+        if(function != NULL)
+            code_optimizer_count_function_instruction(function, instruction, 1);
+        instruction->meta_data.function = function;
+
+        previous_function = function;
         instruction = instruction->next;
     }
+}
 
-    // another loop to spread dynamic and check literal expression
-    instruction = optimizer->generator->first;
+// counts whole program into meta data, functions of instructions are assigned or only compared with stored ones
+static bool code_optimizer_count_program(CodeOptimizer* optimizer, bool assign_functions) {
+    CodeInstruction* instruction = optimizer->generator->first;
+    FunctionMetaData* function = NULL;
+    bool functions_match = true;
+
+    while(instruction != NULL) {
+        function = code_optimizer_instruction_function(optimizer, instruction, function);
+        code_optimizer_count_instruction(optimizer, instruction, 1);
+        if(function != NULL)
+            code_optimizer_count_function_instruction(function, instruction, 1);
+
+        if(assign_functions) {
+            instruction->meta_data.function = function;
+        } else {
+            // keys are interned
+            const char* stored_key = instruction->meta_data.function == NULL ?
+                                     NULL : instruction->meta_data.function->base.key;
+            if(stored_key != (function == NULL ? NULL : function->base.key)) {
+                LOG_WARNING("Instruction %s has invalid function.", instruction->signature_buffer->identifier);
+                functions_match = false;
+            }
+        }
+
+        instruction = instruction->next;
+    }
+
+    return functions_match;
+}
+
+static void code_optimizer_update_expressions_meta_data(CodeOptimizer* optimizer) {
+    // spread dynamic and check literal expression
+    CodeInstruction* instruction = optimizer->generator->first;
     CodeInstruction* expr_start_instruction = NULL;
     while(instruction != NULL) {
         if((instruction->meta_data.type & CODE_INSTRUCTION_META_TYPE_EXPRESSION_START) &&
@@ -658,84 +825,105 @@ void code_optimizer_update_meta_data(CodeOptimizer* optimizer) {
     }
 }
 
-void code_optimizer_update_function_meta_data(CodeOptimizer* optimizer, CodeInstruction* instruction,
-                                              const char* current_func_label) {
+void code_optimizer_update_meta_data(CodeOptimizer* optimizer) {
     NULL_POINTER_CHECK(optimizer,);
-    NULL_POINTER_CHECK(instruction,);
 
-    if(instruction->type == I_CALL) {
-        FunctionMetaData* function_meta_data = code_optimizer_function_meta_data(optimizer,
-                                                                                 instruction->op0->data.label);
-        function_meta_data->call_count++;
+    if(!optimizer->meta_data_counted) {
+        // clear old statistics
+        symbol_table_foreach(optimizer->variables_meta_data, code_optimizer_reset_variable_meta_data, NULL);
+        symbol_table_foreach(optimizer->labels_meta_data, code_optimizer_reset_label_meta_data, NULL);
+        symbol_table_foreach(optimizer->functions_meta_data, code_optimizer_reset_function_meta_data, NULL);
+
+        code_optimizer_count_program(optimizer, true);
+        optimizer->meta_data_counted = true;
     }
+    ASSERT(code_optimizer_check_meta_data(optimizer));
 
-    if(current_func_label == NULL)
-        return;
+    code_optimizer_update_expressions_meta_data(optimizer);
+}
 
-    MetaType flags = META_TYPE_PURE;
-    if(instruction->type == I_READ)
-        flags |= META_TYPE_DYNAMIC_DEPENDENT;
-    else if(instruction->type == I_WRITE)
-        flags |= META_TYPE_OUTPUTED;
-    if((instruction_class(instruction) == INSTRUCTION_TYPE_WRITE ||
-        instruction_class(instruction) == INSTRUCTION_TYPE_VAR_MODIFIERS) &&
-       instruction->op0->type == TYPE_INSTRUCTION_OPERAND_VARIABLE &&
-       instruction->op0->data.variable->frame == VARIABLE_FRAME_GLOBAL) {
-        flags |= META_TYPE_WITH_SIDE_EFFECT;
+typedef struct meta_data_check_t {
+    SymbolTable* other;
+    // missing item in other table is compared as NULL
+    bool (* equal)(SymbolTableBaseItem* item, SymbolTableBaseItem* other_item);
+    bool valid;
+} MetaDataCheck;
+
+static void code_optimizer_check_meta_data_item(const char* key, void* item, void* data) {
+    MetaDataCheck* check = (MetaDataCheck*) data;
+    if(!check->equal((SymbolTableBaseItem*) item, symbol_table_get(check->other, key))) {
+        LOG_WARNING("Meta data of %s differs from rebuilt ones.", key);
+        check->valid = false;
     }
-    FunctionMetaData* meta_data = code_optimizer_function_meta_data(optimizer, current_func_label);
-    meta_data->purity_type |= flags;
+}
 
-    // set modified global variables
-    const TypeInstructionClass instruction_cls = instruction_class(instruction);
-    if(instruction_cls == INSTRUCTION_TYPE_WRITE ||
-       instruction_cls == INSTRUCTION_TYPE_VAR_MODIFIERS) {
-        SymbolVariable* variable = instruction->op0->data.variable;
-        if(variable->frame == VARIABLE_FRAME_GLOBAL) {
-            symbol_table_get_or_create(meta_data->mod_global_vars, variable_cached_identifier(variable));
-        }
-    }
+static bool code_optimizer_check_meta_data_tables(SymbolTable* first, SymbolTable* second,
+                                                  bool (* equal)(SymbolTableBaseItem*, SymbolTableBaseItem*)) {
+    MetaDataCheck check = {.other = second, .equal = equal, .valid = true};
+    symbol_table_foreach(first, &code_optimizer_check_meta_data_item, &check);
+    check.other = first;
+    symbol_table_foreach(second, &code_optimizer_check_meta_data_item, &check);
+    return check.valid;
+}
 
-    // set read global variables
-    CodeInstructionOperand* operands[OPERANDS_MAX_COUNT] = {
-            instruction->op0,
-            instruction->op1,
-            instruction->op2
-    };
+static bool code_optimizer_variable_meta_data_equal(SymbolTableBaseItem* item, SymbolTableBaseItem* other_item) {
+    const VariableMetaData* v = (VariableMetaData*) item;
+    const VariableMetaData* other = (VariableMetaData*) other_item;
+    if(other == NULL)
+        return v->occurrences_count == 0 && v->read_usage_count == 0 && v->purity_type == META_TYPE_PURE;
+    return v->occurrences_count == other->occurrences_count && v->read_usage_count == other->read_usage_count &&
+           v->purity_type == other->purity_type;
+}
 
-    const TypeInstructionOperand operands_type[OPERANDS_MAX_COUNT] = {
-            instruction->signature_buffer->type0,
-            instruction->signature_buffer->type1,
-            instruction->signature_buffer->type2,
-    };
+static bool code_optimizer_label_meta_data_equal(SymbolTableBaseItem* item, SymbolTableBaseItem* other_item) {
+    const int other_occurrences_count = other_item == NULL ? 0 : ((LabelMetaData*) other_item)->occurrences_count;
+    return ((LabelMetaData*) item)->occurrences_count == other_occurrences_count;
+}
 
-    for(int j = 0; j < instruction->signature_buffer->operand_count; j++) {
-        if(operands[j]->type == TYPE_INSTRUCTION_OPERAND_VARIABLE &&
-           operands_type[j] == TYPE_INSTRUCTION_OPERAND_SYMBOL) {
-            SymbolVariable* variable = operands[j]->data.variable;
-            if(variable->frame == VARIABLE_FRAME_GLOBAL) {
-                symbol_table_get_or_create(meta_data->read_global_vars, variable_cached_identifier(variable));
-            }
-        }
-    }
+static bool code_optimizer_global_var_usage_equal(SymbolTableBaseItem* item, SymbolTableBaseItem* other_item) {
+    return other_item != NULL && ((SymbolTableIntItem*) item)->value == ((SymbolTableIntItem*) other_item)->value;
 }
 
-void code_optimizer_update_label_meta_data(CodeOptimizer* optimizer, CodeInstruction* instruction) {
-    NULL_POINTER_CHECK(optimizer,);
-    NULL_POINTER_CHECK(instruction,);
+static bool code_optimizer_function_meta_data_equal(SymbolTableBaseItem* item, SymbolTableBaseItem* other_item) {
+    FunctionMetaData* f = (FunctionMetaData*) item;
+    FunctionMetaData* other = (FunctionMetaData*) other_item;
+    if(other == NULL)
+        return f->call_count == 0 && f->purity_type == META_TYPE_PURE && symbol_table_size(f->mod_global_vars) == 0 &&
+               symbol_table_size(f->read_global_vars) == 0;
+    return f->call_count == other->call_count && f->purity_type == other->purity_type &&
+           f->dynamic_dependent_count == other->dynamic_dependent_count &&
+           f->outputed_count == other->outputed_count &&
+           f->with_side_effect_count == other->with_side_effect_count &&
+           code_optimizer_check_meta_data_tables(f->mod_global_vars, other->mod_global_vars,
+                                                 &code_optimizer_global_var_usage_equal) &&
+           code_optimizer_check_meta_data_tables(f->read_global_vars, other->read_global_vars,
+                                                 &code_optimizer_global_var_usage_equal);
+}
 
-    switch(instruction->type) {
-        case I_CALL:
-        case I_JUMP:
-        case I_JUMP_IF_EQUAL:
-        case I_JUMP_IF_NOT_EQUAL:
-        case I_JUMP_IF_EQUAL_STACK:
-        case I_JUMP_IF_NOT_EQUAL_STACK:
-            code_optimizer_label_meta_data(optimizer, instruction->op0->data.label)->occurrences_count++;
-            break;
-        default:
-            break;
-    }
+bool code_optimizer_check_meta_data(CodeOptimizer* optimizer) {
+    NULL_POINTER_CHECK(optimizer, false);
+
+    // same optimizer with empty tables
+    CodeOptimizer rebuilt = *optimizer;
+    rebuilt.variables_meta_data = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(VariableMetaData),
+                                                    &init_variable_meta_data, NULL);
+    rebuilt.functions_meta_data = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(FunctionMetaData),
+                                                    &init_function_meta_data, &free_function_meta_data);
+    rebuilt.labels_meta_data = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(LabelMetaData),
+                                                 &init_label_meta_data, NULL);
+
+    bool valid = code_optimizer_count_program(&rebuilt, false);
+    valid &= code_optimizer_check_meta_data_tables(optimizer->variables_meta_data, rebuilt.variables_meta_data,
+                                                   &code_optimizer_variable_meta_data_equal);
+    valid &= code_optimizer_check_meta_data_tables(optimizer->labels_meta_data, rebuilt.labels_meta_data,
+                                                   &code_optimizer_label_meta_data_equal);
+    valid &= code_optimizer_check_meta_data_tables(optimizer->functions_meta_data, rebuilt.functions_meta_data,
+                                                   &code_optimizer_function_meta_data_equal);
+
+    symbol_table_free(rebuilt.variables_meta_data);
+    symbol_table_free(rebuilt.functions_meta_data);
+    symbol_table_free(rebuilt.labels_meta_data);
+    return valid;
 }
 
 VariableMetaData* code_optimizer_variable_meta_data(CodeOptimizer* optimizer, SymbolVariable* variable) {
@@ -816,8 +1004,7 @@ bool code_optimizer_remove_unused_variables(CodeOptimizer* optimizer, bool hard_
 
         if(delete_instruction) {
             CodeInstruction* temp = instruction->next;
-            code_optimizer_removing_instruction(optimizer, instruction);
-            code_generator_remove_instruction(optimizer->generator, instruction);
+            code_optimizer_remove_instruction(optimizer, instruction);
             instruction = temp;
         } else if(delete_expression) {
             CodeInstruction* expr_instruction = instruction;
@@ -825,14 +1012,12 @@ bool code_optimizer_remove_unused_variables(CodeOptimizer* optimizer, bool hard_
 
             while(expr_instruction->meta_data.type != CODE_INSTRUCTION_META_TYPE_EXPRESSION_START) {
                 prev_expr_instruction = expr_instruction->prev;
-                code_optimizer_removing_instruction(optimizer, expr_instruction);
-                code_generator_remove_instruction(optimizer->generator, expr_instruction);
+                code_optimizer_remove_instruction(optimizer, expr_instruction);
                 expr_instruction = prev_expr_instruction;
             }
 
             instruction = expr_instruction->prev;
-            code_optimizer_removing_instruction(optimizer, expr_instruction);
-            code_generator_remove_instruction(optimizer->generator, expr_instruction);
+            code_optimizer_remove_instruction(optimizer, expr_instruction);
         } else
             instruction = instruction->next;
     }
@@ -841,81 +1026,102 @@ bool code_optimizer_remove_unused_variables(CodeOptimizer* optimizer, bool hard_
 }
 
 PeepHolePattern* code_optimizer_new_ph_pattern(CodeOptimizer* optimizer) {
+    optimizer->peep_hole_patterns_index_valid = false;
     return (PeepHolePattern*) llist_new_tail_item(optimizer->peep_hole_patterns);
 }
 
-SymbolTable* code_optimizer_check_ph_pattern(CodeOptimizer* optimizer,
-                                             PeepHolePattern* ph_pattern,
-                                             CodeInstruction* instruction) {
-    NULL_POINTER_CHECK(optimizer, NULL);
-    NULL_POINTER_CHECK(ph_pattern, NULL);
-    NULL_POINTER_CHECK(instruction, NULL);
+void code_optimizer_update_ph_patterns_index(CodeOptimizer* optimizer) {
+    NULL_POINTER_CHECK(optimizer,);
+    if(optimizer->peep_hole_patterns_index_valid)
+        return;
+
+    PeepHolePattern* tails[I__LAST];
+    for(int i = 0; i < I__LAST; i++) {
+        optimizer->peep_hole_patterns_index[i] = NULL;
+        tails[i] = NULL;
+    }
+    optimizer->peep_hole_patterns_window = 0;
+
+    // keep order of adding in every chain
+    PeepHolePattern* pattern = (PeepHolePattern*) optimizer->peep_hole_patterns->head;
+    while(pattern != NULL) {
+        PeepHolePatternInstruction* first = (PeepHolePatternInstruction*) pattern->matching_instructions->head;
+        pattern->next_indexed = NULL;
+        if(pattern->matching_instructions_count > optimizer->peep_hole_patterns_window)
+            optimizer->peep_hole_patterns_window = pattern->matching_instructions_count;
+        if(first != NULL) {
+            if(tails[first->type] == NULL)
+                optimizer->peep_hole_patterns_index[first->type] = pattern;
+            else
+                tails[first->type]->next_indexed = pattern;
+            tails[first->type] = pattern;
+        }
+        pattern = (PeepHolePattern*) pattern->base.next;
+    }
+    optimizer->peep_hole_patterns_index_valid = true;
+}
+
+bool code_optimizer_check_ph_pattern(CodeOptimizer* optimizer,
+                                     PeepHolePattern* ph_pattern,
+                                     CodeInstruction* instruction,
+                                     CodeInstructionOperand** bound_operands) {
+    NULL_POINTER_CHECK(optimizer, false);
+    NULL_POINTER_CHECK(ph_pattern, false);
+    NULL_POINTER_CHECK(instruction, false);
+    NULL_POINTER_CHECK(bound_operands, false);
 
     PeepHolePatternInstruction* pattern_instruction =
             (PeepHolePatternInstruction*) ph_pattern->matching_instructions->head;
-    SymbolTable* mapped_operands = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(MappedOperand),
-                                                     &init_mapped_operand_item,
-                                                     &free_mapped_operand_item);
-    MappedOperand* temp = (MappedOperand*) symbol_table_get_or_create(mapped_operands, "temp");
-    temp->operand = code_instruction_operand_init_variable(optimizer->temp6);
 
-    temp = (MappedOperand*) symbol_table_get_or_create(mapped_operands, "<true");
-    temp->operand = code_instruction_operand_init_boolean(true);
-
-    const int operands_max_count = 3;
+    bound_operands[PEEP_HOLE_PATTERN_ALIAS_TEMP] = optimizer->peep_hole_temp_operand;
+    bound_operands[PEEP_HOLE_PATTERN_ALIAS_TRUE] = optimizer->peep_hole_true_operand;
+    for(int i = PEEP_HOLE_PATTERN_FIXED_ALIASES_COUNT; i < ph_pattern->aliases_count; i++)
+        bound_operands[i] = NULL;
 
     while(pattern_instruction != NULL) {
         // means end of program of instruction type mismatch
         if(instruction == NULL || pattern_instruction->type != instruction->type)
-            goto patten_not_matched;
+            return false;
 
         // check operands
-        const char* operands_aliases[] = {pattern_instruction->op0_alias, pattern_instruction->op1_alias,
-                                          pattern_instruction->op2_alias};
         int operands_occ_count[] = {pattern_instruction->op0_occurrences_count,
                                     pattern_instruction->op1_occurrences_count,
                                     pattern_instruction->op2_occurrences_count};
         CodeInstructionOperand* operands[] = {instruction->op0, instruction->op1, instruction->op2};
 
-        for(int i = 0; i < operands_max_count; i++) {
-            if(operands_aliases[i] == NULL)
+        for(int i = 0; i < OPERANDS_MAX_COUNT; i++) {
+            const int slot = pattern_instruction->operands_slots[i];
+            if(slot == PEEP_HOLE_PATTERN_NO_ALIAS)
                 continue;
 
             // check meta pattern flag type
-            const MetaPHPatternFlag meta_type_flag = extract_flag(operands_aliases[i]);
             const bool meta_type_flag_matched = code_optimizer_check_operand_with_meta_type_flag(
                     optimizer,
                     operands[i],
-                    meta_type_flag
+                    pattern_instruction->operands_flags[i]
             );
 
             if(!meta_type_flag_matched)
-                goto patten_not_matched;
-
-            MappedOperand* mapped_operand = (MappedOperand*) symbol_table_get_or_create(mapped_operands,
-                                                                                        operands_aliases[i]);
-
-            if(mapped_operand->operand == NULL)
-                mapped_operand->operand = code_instruction_operand_copy(operands[i]);
+                return false;
 
-            else {
-                if(!code_instruction_operand_cmp(operands[i], mapped_operand->operand))
-                    goto patten_not_matched;
-            }
+            if(bound_operands[slot] == NULL)
+                bound_operands[slot] = operands[i];
+            else if(!code_instruction_operand_cmp(operands[i], bound_operands[slot]))
+                return false;
 
             // check occurrences count
             if(operands_occ_count[i] != -1) {
-                if(mapped_operand->operand->type == TYPE_INSTRUCTION_OPERAND_VARIABLE) {
+                if(bound_operands[slot]->type == TYPE_INSTRUCTION_OPERAND_VARIABLE) {
                     const VariableMetaData* var_meta_data = code_optimizer_variable_meta_data(optimizer,
-                                                                                              mapped_operand->operand->data.variable);
+                                                                                              bound_operands[slot]->data.variable);
 
                     if(var_meta_data->occurrences_count != operands_occ_count[i])
-                        goto patten_not_matched;
-                } else if(mapped_operand->operand->type == TYPE_INSTRUCTION_OPERAND_LABEL) {
+                        return false;
+                } else if(bound_operands[slot]->type == TYPE_INSTRUCTION_OPERAND_LABEL) {
                     const LabelMetaData* label_meta_data = code_optimizer_label_meta_data(optimizer,
-                                                                                          mapped_operand->operand->data.label);
+                                                                                          bound_operands[slot]->data.label);
                     if(label_meta_data->occurrences_count != operands_occ_count[i])
-                        goto patten_not_matched;
+                        return false;
                 }
 
             }
@@ -926,57 +1132,138 @@ SymbolTable* code_optimizer_check_ph_pattern(CodeOptimizer* optimizer,
         pattern_instruction = (PeepHolePatternInstruction*) pattern_instruction->base.next;
     }
 
-    return mapped_operands;
+    return true;
+}
 
-    patten_not_matched:
-    symbol_table_free(mapped_operands);
+// first pattern matching from given instruction or NULL
+// pattern is first of indexed patterns to check, only patterns starting with type of instruction can match
+static PeepHolePattern* code_optimizer_find_ph_pattern(CodeOptimizer* optimizer, PeepHolePattern* pattern,
+                                                       CodeInstruction* instruction,
+                                                       CodeInstructionOperand** bound_operands) {
+    while(pattern != NULL) {
+        if(code_optimizer_check_ph_pattern(optimizer, pattern, instruction, bound_operands))
+            return pattern;
+        pattern = pattern->next_indexed;
+    }
     return NULL;
 }
 
+// replacement of matched instructions would produce same instructions, e.g. for self assignment
+static bool code_optimizer_ph_pattern_is_identity(PeepHolePattern* pattern, CodeInstruction* instruction,
+                                                  CodeInstructionOperand** bound_operands) {
+    if(pattern->replacement_instructions_count != pattern->matching_instructions_count)
+        return false;
+
+    PeepHolePatternInstruction* ph_pattern_instruction = (PeepHolePatternInstruction*) pattern->replacement_instructions->head;
+    for(size_t i = 0; i < pattern->replacement_instructions_count; i++) {
+        if(ph_pattern_instruction->type != instruction->type)
+            return false;
+
+        CodeInstructionOperand* operands[] = {instruction->op0, instruction->op1, instruction->op2};
+        for(int j = 0; j < OPERANDS_MAX_COUNT; j++) {
+            const int slot = ph_pattern_instruction->operands_slots[j];
+            CodeInstructionOperand* replacement = slot == PEEP_HOLE_PATTERN_NO_ALIAS ? NULL : bound_operands[slot];
+            if(!code_instruction_operand_cmp(replacement, operands[j]))
+                return false;
+        }
+
+        ph_pattern_instruction = (PeepHolePatternInstruction*) ph_pattern_instruction->base.next;
+        instruction = instruction->next;
+    }
+    return true;
+}
+
+// replaces matched instructions, returns first instruction after them
+static CodeInstruction* code_optimizer_apply_ph_pattern(CodeOptimizer* optimizer, PeepHolePattern* pattern,
+                                                        CodeInstruction* instruction,
+                                                        CodeInstructionOperand** bound_operands) {
+    // add replacement, bound operands are copied before removing of matched instructions
+    PeepHolePatternInstruction* ph_pattern_instruction = (PeepHolePatternInstruction*) pattern->replacement_instructions->head;
+    for(size_t i = 0; i < pattern->replacement_instructions_count; i++) {
+        CodeInstruction* replacement_instruction = code_optimizer_new_instruction_with_mapped_operands(
+                optimizer, ph_pattern_instruction, bound_operands);
+        code_optimizer_insert_instruction_before(optimizer, replacement_instruction, instruction);
+        ph_pattern_instruction = (PeepHolePatternInstruction*) ph_pattern_instruction->base.next;
+    }
+
+    // remove old
+    for(size_t i = 0; i < pattern->matching_instructions_count; i++) {
+        CodeInstruction* temp = instruction->next;
+        code_optimizer_remove_instruction(optimizer, instruction);
+        instruction = temp;
+    }
+
+    pattern->applied_count++;
+    optimizer->peep_hole_applied_count++;
+    return instruction;
+}
+
 bool code_optimizer_peep_hole_optimization(CodeOptimizer* optimizer) {
     NULL_POINTER_CHECK(optimizer, false);
 
     CodeInstruction* instruction = optimizer->generator->first;
-    PeepHolePattern* pattern = NULL;
+    CodeInstructionOperand* bound_operands[PEEP_HOLE_PATTERN_ALIASES_MAX_COUNT];
     bool removed_something = false;
 
+    code_optimizer_update_ph_patterns_index(optimizer);
+
     while(instruction != NULL) {
-        bool removed_instruction = false;
-
-        pattern = (PeepHolePattern*) optimizer->peep_hole_patterns->head;
-        while(pattern != NULL) {
-            SymbolTable* mapped_operands = code_optimizer_check_ph_pattern(optimizer, pattern, instruction);
-            if(mapped_operands != NULL) {
-                // add replacement
-                PeepHolePatternInstruction* ph_pattern_instruction = (PeepHolePatternInstruction*) pattern->replacement_instructions->head;
-                const size_t replacement_pattern_instruction_count = llist_length(pattern->replacement_instructions);
-                for(size_t i = 0; i < replacement_pattern_instruction_count; i++) {
-                    CodeInstruction* replacement_instruction = code_optimizer_new_instruction_with_mapped_operands(
-                            optimizer, ph_pattern_instruction, mapped_operands);
-                    code_generator_insert_instruction_before(optimizer->generator, replacement_instruction,
-                                                             instruction);
-                    ph_pattern_instruction = (PeepHolePatternInstruction*) ph_pattern_instruction->base.next;
-                }
+        PeepHolePattern* pattern = code_optimizer_find_ph_pattern(
+                optimizer, optimizer->peep_hole_patterns_index[instruction->type], instruction, bound_operands
+        );
+        if(pattern != NULL) {
+            instruction = code_optimizer_apply_ph_pattern(optimizer, pattern, instruction, bound_operands);
+            removed_something = true;
+        } else {
+            instruction = instruction->next;
+        }
+    }
 
-                // remove old
-                const size_t matching_pattern_instruction_count = llist_length(pattern->matching_instructions);
-                for(size_t i = 0; i < matching_pattern_instruction_count; i++) {
-                    CodeInstruction* temp = instruction->next;
-                    code_optimizer_removing_instruction(optimizer, instruction);
-                    code_generator_remove_instruction(optimizer->generator, instruction);
-                    instruction = temp;
-                    removed_instruction = true;
-                    removed_something = true;
-                }
+    return removed_something;
+}
 
-                symbol_table_free(mapped_operands);
-                break;
-            }
-            pattern = (PeepHolePattern*) pattern->base.next;
-        }
+bool code_optimizer_peep_hole_optimization_worklist(CodeOptimizer* optimizer) {
+    NULL_POINTER_CHECK(optimizer, false);
+
+    CodeInstruction* instruction = optimizer->generator->first;
+    CodeInstructionOperand* bound_operands[PEEP_HOLE_PATTERN_ALIASES_MAX_COUNT];
+    bool removed_something = false;
+
+    code_optimizer_update_ph_patterns_index(optimizer);
 
-        if(!removed_instruction)
+    // patterns rewriting into each other would be revisited forever, so revisits are bounded by size of program
+    size_t revisits_left = 0;
+    for(CodeInstruction* it = instruction; it != NULL; it = it->next)
+        revisits_left += CODE_OPTIMIZER_PEEP_HOLE_REVISITS_PER_INSTRUCTION;
+
+    while(instruction != NULL) {
+        PeepHolePattern* pattern = code_optimizer_find_ph_pattern(
+                optimizer, optimizer->peep_hole_patterns_index[instruction->type], instruction, bound_operands
+        );
+        // rewrite to same instructions would match again forever, but some of next patterns still could match
+        while(pattern != NULL && code_optimizer_ph_pattern_is_identity(pattern, instruction, bound_operands))
+            pattern = code_optimizer_find_ph_pattern(optimizer, pattern->next_indexed, instruction, bound_operands);
+        if(pattern == NULL) {
             instruction = instruction->next;
+            continue;
+        }
+
+        CodeInstruction* previous = instruction->prev;
+        instruction = code_optimizer_apply_ph_pattern(optimizer, pattern, instruction, bound_operands);
+        removed_something = true;
+        // out of budget continues after rewritten region as simple pass
+        if(revisits_left == 0)
+            continue;
+        revisits_left--;
+
+        // new match can start at most one window before end of rewritten region, revisit only these instructions
+        instruction = previous == NULL ? optimizer->generator->first : previous->next;
+        for(size_t i = 1; i < optimizer->peep_hole_patterns_window && instruction != NULL &&
+                          instruction->prev != NULL && revisits_left > 0; i++) {
+            instruction = instruction->prev;
+            optimizer->peep_hole_revisits_count++;
+            revisits_left--;
+        }
     }
 
     return removed_something;
@@ -984,22 +1271,19 @@ bool code_optimizer_peep_hole_optimization(CodeOptimizer* optimizer) {
 
 CodeInstruction* code_optimizer_new_instruction_with_mapped_operands(CodeOptimizer* optimizer,
                                                                      PeepHolePatternInstruction* ph_pattern_instruction,
-                                                                     SymbolTable* mapped_operands) {
+                                                                     CodeInstructionOperand** bound_operands) {
     NULL_POINTER_CHECK(optimizer, NULL);
     NULL_POINTER_CHECK(ph_pattern_instruction, NULL);
-    NULL_POINTER_CHECK(mapped_operands, NULL);
+    NULL_POINTER_CHECK(bound_operands, NULL);
 
     const TypeInstruction instruction_type = ph_pattern_instruction->type;
     const short operands_count = code_generator_instruction_operands_count(optimizer->generator, instruction_type);
-    const char* op_aliases[] = {ph_pattern_instruction->op0_alias, ph_pattern_instruction->op1_alias,
-                                ph_pattern_instruction->op2_alias};
     CodeInstructionOperand* operands[] = {NULL, NULL, NULL};
 
     for(int i = 0; i < operands_count; i++) {
-        if(op_aliases[i] != NULL) {
-            operands[i] = code_instruction_operand_copy(
-                    ((MappedOperand*) symbol_table_get_or_create(mapped_operands, op_aliases[i]))->operand);
-        }
+        const int slot = ph_pattern_instruction->operands_slots[i];
+        if(slot != PEEP_HOLE_PATTERN_NO_ALIAS)
+            operands[i] = code_instruction_operand_copy(bound_operands[slot]);
     }
 
     CodeInstruction* instruction = code_generator_new_instruction(
@@ -1008,8 +1292,6 @@ CodeInstruction* code_optimizer_new_instruction_with_mapped_operands(CodeOptimiz
             operands[0], operands[1], operands[2]
     );
 
-    code_optimizer_adding_instruction(optimizer, instruction);
-
     return instruction;
 }
 
@@ -1133,7 +1415,7 @@ bool code_optimizer_remove_unused_functions(CodeOptimizer* optimizer) {
             if(instruction->meta_data.type == CODE_INSTRUCTION_META_TYPE_FUNCTION_END)
                 removing_function = false;
             CodeInstruction* next_instruction = instruction->next;
-            code_generator_remove_instruction(optimizer->generator, instruction);
+            code_optimizer_remove_instruction(optimizer, instruction);
             removed_something = true;
             instruction = next_instruction;
         } else {
@@ -1146,116 +1428,118 @@ bool code_optimizer_remove_unused_functions(CodeOptimizer* optimizer) {
 void code_optimizer_adding_instruction(CodeOptimizer* optimizer, CodeInstruction* instruction) {
     NULL_POINTER_CHECK(optimizer,);
     NULL_POINTER_CHECK(instruction,);
-
-    const TypeInstruction instruction_type = instruction->type;
-    if(instruction_type == I_DEF_VAR || instruction_type == I_POP_STACK)
+    // whole program is counted later
+    if(!optimizer->meta_data_counted)
         return;
 
-    const short operands_count = code_generator_instruction_operands_count(optimizer->generator, instruction->type);
-    const CodeInstructionOperand* operands[] = {instruction->op0, instruction->op1, instruction->op2};
+    code_optimizer_count_instruction(optimizer, instruction, 1);
 
-    // handle label
-    code_optimizer_update_label_meta_data(optimizer, instruction);
-
-    for(int i = 0; i < operands_count; i++) {
-        if(operands[i] == NULL) {
-            LOG_WARNING("Operand is null when it shoul not.");
-            return;
-        }
+    FunctionMetaData* function = code_optimizer_instruction_function(
+            optimizer, instruction, instruction->prev == NULL ? NULL : instruction->prev->meta_data.function
+    );
+    if(function != NULL)
+        code_optimizer_count_function_instruction(function, instruction, 1);
+    instruction->meta_data.function = function;
 
-        const TypeInstructionOperand operand_type = operands[i]->type;
+    // instruction can start or end function
+    code_optimizer_update_instructions_function(optimizer, instruction->next, function);
+}
 
-        // update meta data
+void code_optimizer_removing_instruction(CodeOptimizer* optimizer, CodeInstruction* instruction) {
+    NULL_POINTER_CHECK(optimizer,);
+    NULL_POINTER_CHECK(instruction,);
+    // whole program is counted later
+    if(!optimizer->meta_data_counted)
+        return;
 
-        if(operand_type != TYPE_INSTRUCTION_OPERAND_VARIABLE)
-            continue;
+    code_optimizer_count_instruction(optimizer, instruction, -1);
 
-        if(instruction->type == I_MOVE && i == 0) // it's first operand
-            continue;
+    if(instruction->meta_data.function != NULL)
+        code_optimizer_count_function_instruction(instruction->meta_data.function, instruction, -1);
 
-        if(instruction_type == I_READ) {
-            VariableMetaData* meta_data = code_optimizer_variable_meta_data(optimizer, operands[i]->data.variable);
-            meta_data->occurrences_count++;
-            meta_data->purity_type |= META_TYPE_DYNAMIC_DEPENDENT;
-            meta_data->read_usage_count++;
-            break;
-        } else {
-            VariableMetaData* meta_data = code_optimizer_variable_meta_data(optimizer, operands[i]->data.variable);
-            meta_data->occurrences_count++;
-        }
-    }
+    // following instructions are evaluated as if instruction was already removed
+    code_optimizer_update_instructions_function(
+            optimizer, instruction->next, instruction->prev == NULL ? NULL : instruction->prev->meta_data.function
+    );
+    instruction->meta_data.function = NULL;
 }
 
-void code_optimizer_removing_instruction(CodeOptimizer* optimizer, CodeInstruction* instruction) {
+void code_optimizer_insert_instruction_before(CodeOptimizer* optimizer, CodeInstruction* instruction,
+                                              CodeInstruction* before_instruction) {
     NULL_POINTER_CHECK(optimizer,);
     NULL_POINTER_CHECK(instruction,);
 
-    const TypeInstruction instruction_type = instruction->type;
-    if(instruction_type == I_DEF_VAR || instruction_type == I_POP_STACK)
-        return;
-
-    // handle labels
-    switch(instruction->type) {
-        case I_CALL:
-        case I_JUMP:
-        case I_JUMP_IF_EQUAL:
-        case I_JUMP_IF_NOT_EQUAL:
-        case I_JUMP_IF_EQUAL_STACK:
-        case I_JUMP_IF_NOT_EQUAL_STACK: {
-            LabelMetaData* meta_data = code_optimizer_label_meta_data(optimizer, instruction->op0->data.label);
-            if(meta_data->occurrences_count > 0)
-                meta_data->occurrences_count--;
-            return;
-        }
-        default:
-            break;
-    }
-
-    const short operands_count = code_generator_instruction_operands_count(optimizer->generator, instruction->type);
-    const CodeInstructionOperand* operands[] = {instruction->op0, instruction->op1, instruction->op2};
+    code_generator_insert_instruction_before(optimizer->generator, instruction, before_instruction);
+    code_optimizer_adding_instruction(optimizer, instruction);
+}
 
-    for(int i = 0; i < operands_count; i++) {
-        if(operands[i] == NULL) {
-            LOG_WARNING("Operand is null when it shoul not.");
-            return;
-        }
+void code_optimizer_remove_instruction(CodeOptimizer* optimizer, CodeInstruction* instruction) {
+    NULL_POINTER_CHECK(optimizer,);
+    NULL_POINTER_CHECK(instruction,);
 
-        const TypeInstructionOperand operand_type = operands[i]->type;
+    code_optimizer_removing_instruction(optimizer, instruction);
+    code_generator_remove_instruction(optimizer->generator, instruction);
+}
 
-        // update meta data
+static void code_optimizer_add_modified_var(const char* key, void* item, void* data) {
+    symbol_table_get_or_create((SymbolTable*) data, key);
+}
 
-        if(operand_type != TYPE_INSTRUCTION_OPERAND_VARIABLE)
-            continue;
+// summarizes variables modified in every loop of code graph, nested loops are summarized before enclosing ones
+static void code_optimizer_analyse_code_loops(CodeOptimizer* optimizer) {
+    OrientedGraph* graph = optimizer->code_graph;
+    OrientedGraphLoopForest* loops = oriented_graph_loop_forest_init(graph);
+    optimizer->code_loops = loops;
+    optimizer->code_loops_mod_vars = memory_alloc(sizeof(SymbolTable*) * (loops->loops_count + 1));
+    for(size_t i = 0; i < loops->loops_count; i++)
+        optimizer->code_loops_mod_vars[i] = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(SymbolTableBaseItem),
+                                                              NULL, NULL);
 
-        if(instruction->type == I_MOVE && i == 0) // it's first operand
+    for(unsigned int i = 0; i < graph->capacity; i++) {
+        CodeBlock* block = (CodeBlock*) oriented_graph_node(graph, i);
+        const int loop = oriented_graph_loop_forest_innermost_loop(loops, i);
+        if(block == NULL || loop == -1)
             continue;
 
-        if(instruction_type == I_READ) {
-            VariableMetaData* meta_data = code_optimizer_variable_meta_data(optimizer, operands[i]->data.variable);
+        CodeInstruction* instruction = block->instructions;
+        for(size_t j = 0; j < block->instructions_count; j++) {
+            const TypeInstructionClass instruction_cls = instruction_class(instruction);
+            if(instruction_cls == INSTRUCTION_TYPE_WRITE ||
+               instruction_cls == INSTRUCTION_TYPE_VAR_MODIFIERS)
+                symbol_table_get_or_create(optimizer->code_loops_mod_vars[loop],
+                                           variable_cached_identifier(instruction->op0->data.variable));
 
-            if(meta_data->occurrences_count > 0)
-                meta_data->occurrences_count--;
-            if(meta_data->read_usage_count > 0)
-                meta_data->read_usage_count--;
-            if(meta_data->read_usage_count == 0)
-                meta_data->purity_type &= ~META_TYPE_DYNAMIC_DEPENDENT;
-            break;
-        } else {
-            VariableMetaData* meta_data = code_optimizer_variable_meta_data(optimizer, operands[i]->data.variable);
-            if(meta_data->occurrences_count > 0)
-                meta_data->occurrences_count--;
+            instruction = instruction->next;
         }
     }
+
+    for(size_t i = loops->loops_count; i-- > 0;) {
+        if(loops->loops[i].parent != -1)
+            symbol_table_foreach(optimizer->code_loops_mod_vars[i], &code_optimizer_add_modified_var,
+                                 optimizer->code_loops_mod_vars[loops->loops[i].parent]);
+    }
+}
+
+void code_optimizer_free_code_loops(CodeOptimizer* optimizer) {
+    NULL_POINTER_CHECK(optimizer,);
+    if(optimizer->code_loops == NULL)
+        return;
+
+    for(size_t i = 0; i < optimizer->code_loops->loops_count; i++)
+        symbol_table_free(optimizer->code_loops_mod_vars[i]);
+    memory_free(optimizer->code_loops_mod_vars);
+    optimizer->code_loops_mod_vars = NULL;
+    oriented_graph_loop_forest_free(&optimizer->code_loops);
 }
 
 void code_optimizer_split_code_to_graph(CodeOptimizer* optimizer) {
     NULL_POINTER_CHECK(optimizer,);
 
+    code_optimizer_free_code_loops(optimizer);
     oriented_graph_clear(optimizer->code_graph);
 
     CodeInstruction* instruction = optimizer->generator->first;
     CodeBlock* code_block = (CodeBlock*) oriented_graph_new_node(optimizer->code_graph);
-    SymbolTable* mapped_blocks = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(SymbolTableIntItem), NULL, NULL);
 
     while(instruction != NULL) {
         const TypeInstructionClass prev_instruction_type_class = instruction_class(instruction->prev);
@@ -1267,11 +1551,9 @@ void code_optimizer_split_code_to_graph(CodeOptimizer* optimizer) {
             CodeBlock* new_code_block = (CodeBlock*) oriented_graph_new_node(optimizer->code_graph);
 
             // map block
-            if(instruction->type == I_LABEL) {
-                SymbolTableIntItem* mapped_block = (SymbolTableIntItem*) symbol_table_get_or_create(mapped_blocks,
-                                                                                                    instruction->op0->data.label);
-                mapped_block->value = (int) new_code_block->base.id;
-            }
+            if(instruction->type == I_LABEL)
+                code_optimizer_label_meta_data(optimizer, instruction->op0->data.label)->code_block_id =
+                        new_code_block->base.id;
 
             // can connect  indirect blocks
             if(code_block->last_instruction != NULL &&
@@ -1304,51 +1586,36 @@ void code_optimizer_split_code_to_graph(CodeOptimizer* optimizer) {
         const TypeInstructionClass last_block_instruction_type_class = instruction_class(block->last_instruction);
         if(last_block_instruction_type_class == INSTRUCTION_TYPE_DIRECT_JUMP ||
            last_block_instruction_type_class == INSTRUCTION_TYPE_CONDITIONAL_JUMP) {
-            SymbolTableIntItem* mapped_block = (SymbolTableIntItem*) symbol_table_get_or_create(
-                    mapped_blocks,
-                    block->last_instruction->op0->data.label);
+            LabelMetaData* label = code_optimizer_label_meta_data(optimizer, block->last_instruction->op0->data.label);
 
-            if(mapped_block == NULL) {
+            if(label == NULL) {
                 LOG_WARNING("Split code internal error");
                 return;
             }
 
             // make connection
             if(last_block_instruction_type_class == INSTRUCTION_TYPE_CONDITIONAL_JUMP)
-                set_int_add(block->conditional_jump, (unsigned int) mapped_block->value);
-            oriented_graph_connect_nodes_by_ids(graph, block->base.id, (unsigned int) mapped_block->value);
+                set_int_add(block->conditional_jump, (int) label->code_block_id);
+            oriented_graph_connect_nodes_by_ids(graph, block->base.id, label->code_block_id);
         }
     }
 
-    symbol_table_free(mapped_blocks);
+    // analyses only read edges of graph
+    oriented_graph_freeze(graph);
+    code_optimizer_analyse_code_loops(optimizer);
 }
 
 bool code_optimizer_propagate_constants_optimization(CodeOptimizer* optimizer) {
     NULL_POINTER_CHECK(optimizer, false);
     NULL_POINTER_CHECK(optimizer->code_graph, false);
+    NULL_POINTER_CHECK(optimizer->code_loops, false);
 
     bool propagated_something = false;
     OrientedGraph* graph = optimizer->code_graph;
-    LList* blocks_in_cycles = oriented_graph_scc(optimizer->code_graph);
-    LList* cycled_blocks_mod_vars;
-    llist_init(&cycled_blocks_mod_vars, sizeof(MetaDataCycledBlocksModVars), NULL,
-               &meta_data_cycled_blocks_mod_vars_free, NULL);
 
     SetInt* proccessed_blocks = set_int_init();
     Stack* constants_tables_stack = stack_init(&constants_table_stack_item_free);
 
-    // map modified variables in cycles
-    LListItemSet* item = (LListItemSet*) blocks_in_cycles->head;
-    while(item != NULL) {
-        MetaDataCycledBlocksModVars* cycle_mod_vars = (MetaDataCycledBlocksModVars*) llist_new_tail_item(
-                cycled_blocks_mod_vars);
-        cycle_mod_vars->blocks_ids = set_int_copy(item->set);
-        cycle_mod_vars->mod_vars = code_optimizer_modified_vars_in_blocks(optimizer, item->set);
-
-        item = (LListItemSet*) item->base.next;
-    }
-    llist_free(&blocks_in_cycles);
-
     // propagate constants in functions
     for(unsigned int i = 0; i < graph->capacity; i++) {
         CodeBlock* block = (CodeBlock*) oriented_graph_node(graph, i);
@@ -1358,34 +1625,23 @@ bool code_optimizer_propagate_constants_optimization(CodeOptimizer* optimizer) {
         if((block->instructions->meta_data.type & CODE_INSTRUCTION_META_TYPE_FUNCTION_START) == 0)
             continue;
 
-        SymbolTable* constants = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(MappedOperand),
-                                                   &init_mapped_operand_item,
-                                                   &free_mapped_operand_item);
-        constants->copy_data_callback = &copy_mapped_operand_item;
-        stack_push(constants_tables_stack, (StackBaseItem*) constants_table_stack_item_init(constants));
+        stack_push(constants_tables_stack, (StackBaseItem*) constants_table_stack_item_init(NULL));
 
         propagated_something |= code_optimizer_propagate_constants_in_block(optimizer, block, constants_tables_stack,
-                                                                            proccessed_blocks,
-                                                                            cycled_blocks_mod_vars, false, false);
+                                                                            proccessed_blocks, false, false);
         StackBaseItem* old_table = stack_pop(constants_tables_stack);
         constants_table_stack_item_free(old_table);
-        memory_free(old_table);
+        memory_free_lazy(old_table);
     }
 
     // propagate first block
-    SymbolTable* constants = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(MappedOperand),
-                                               &init_mapped_operand_item,
-                                               &free_mapped_operand_item);
-    constants->copy_data_callback = &copy_mapped_operand_item;
-    stack_push(constants_tables_stack, (StackBaseItem*) constants_table_stack_item_init(constants));
+    stack_push(constants_tables_stack, (StackBaseItem*) constants_table_stack_item_init(NULL));
     CodeBlock* block = (CodeBlock*) oriented_graph_node(graph, 0);
 
     // start
     propagated_something |= code_optimizer_propagate_constants_in_block(optimizer, block, constants_tables_stack,
-                                                                        proccessed_blocks,
-                                                                        cycled_blocks_mod_vars, false, true);
+                                                                        proccessed_blocks, false, true);
 
-    llist_free(&cycled_blocks_mod_vars);
     stack_free(&constants_tables_stack);
     set_int_free(&proccessed_blocks);
 
@@ -1394,42 +1650,30 @@ bool code_optimizer_propagate_constants_optimization(CodeOptimizer* optimizer) {
 
 void block_variables_in_constants_table(const char* key, void* item, void* data) {
     NULL_POINTER_CHECK(item,);
-    SymbolTable* constants_table = (SymbolTable*) data;
-    MappedOperand* op = (MappedOperand*) symbol_table_function_get_or_create(constants_table, key);
-    op->blocked = true;
-    if(op->setter != NULL)
-        op->setter->meta_data.without_effect = false;
+    ConstantsTable* constants_table = (ConstantsTable*) data;
+    CodeInstruction* setter = constants_table_get_setter(constants_table, key);
+    constants_table_block(constants_table, key);
+    if(setter != NULL)
+        setter->meta_data.without_effect = false;
 }
 
 void remove_variables_in_constants_table(const char* key, void* item, void* data) {
     NULL_POINTER_CHECK(item,);
-    SymbolTable* constants_table = (SymbolTable*) data;
-    MappedOperand* op = (MappedOperand*) symbol_table_function_get_or_create(constants_table, key);
-    if(op->operand != NULL)
-        code_instruction_operand_free(&op->operand);
+    constants_table_remove((ConstantsTable*) data, key);
 }
 
 // TODO rename
 void remove_variables_setters_in_constants_table(const char* key, void* item, void* data) {
     NULL_POINTER_CHECK(item,);
-    SymbolTable* constants_table = (SymbolTable*) data;
-    MappedOperand* op = (MappedOperand*) symbol_table_function_get_or_create(constants_table, key);
-    if(op->operand != NULL && op->setter != NULL)
-        op->setter->meta_data.without_effect = false;
-}
-
-void remove_reset_var_setters_in_constants_table(const char* key, void* item, void* data) {
-    NULL_POINTER_CHECK(item,);
-    SymbolTable* constants_table = (SymbolTable*) data;
-    MappedOperand* op = (MappedOperand*) symbol_table_function_get_or_create(constants_table, key);
-    op->setter = NULL;
+    CodeInstruction* setter = constants_table_get_setter((ConstantsTable*) data, key);
+    if(setter != NULL)
+        setter->meta_data.without_effect = false;
 }
 
 bool code_optimizer_propagate_constants_in_block(CodeOptimizer* optimizer,
                                                  CodeBlock* block,
                                                  Stack* constants_tables_stack,
                                                  SetInt* processed_blocks_ids,
-                                                 LList* cycled_block_mod_vars,
                                                  bool is_conditional_block,
                                                  bool propagate_global_vars) {
     NULL_POINTER_CHECK(optimizer, false);
@@ -1445,25 +1689,24 @@ bool code_optimizer_propagate_constants_in_block(CodeOptimizer* optimizer,
     set_int_add(processed_blocks_ids, (int) block->base.id);
 
     // get constants table
-    SymbolTable* constants_table = NULL;
-    // not copied lowest direct table
-    SymbolTable* origin_constants_table = NULL;
+    ConstantsTable* constants_table = NULL;
+    // not forked lowest direct table
+    ConstantsTable* origin_constants_table = NULL;
 
     // determining direct parent blocks
-    SetIntItem* parent_id = (SetIntItem*) block->base.in_edges->head;
+    size_t parents_count;
+    const unsigned int* parent_ids = oriented_graph_predecessors(optimizer->code_graph, block->base.id,
+                                                                 &parents_count);
     int direct_parent_blocks_count = 0;
 
-    while(parent_id != NULL) {
-        CodeBlock* parent_block = (CodeBlock*) oriented_graph_node(optimizer->code_graph,
-                                                                   (unsigned int) parent_id->value);
+    for(size_t i = 0; i < parents_count; i++) {
+        CodeBlock* parent_block = (CodeBlock*) oriented_graph_node(optimizer->code_graph, parent_ids[i]);
         if(parent_block) {
             if(!set_int_contains(parent_block->conditional_jump, (int) block->base.id))
                 direct_parent_blocks_count++;
         } else {
             LOG_WARNING("Internal error getting parent code block.");
         }
-
-        parent_id = (SetIntItem*) parent_id->base.next;
     }
 
     // choose constants table
@@ -1473,9 +1716,8 @@ bool code_optimizer_propagate_constants_in_block(CodeOptimizer* optimizer,
         constants_table = constants_tables_stack_get_lowest_direct_table(constants_tables_stack)->constants;
         origin_constants_table = constants_table;
     }
-    constants_table = symbol_table_copy(constants_table);
-    // reset table setters
-    symbol_table_foreach(constants_table, &remove_reset_var_setters_in_constants_table, constants_table);
+    // forked table shares content, but not setters of parent
+    constants_table = constants_table_fork(constants_table);
 
     // error
     if(constants_table == NULL) {
@@ -1483,15 +1725,11 @@ bool code_optimizer_propagate_constants_in_block(CodeOptimizer* optimizer,
         return false;
     }
 
-    // remove modified variables in cycles if block is in cycle
-    MetaDataCycledBlocksModVars* cycled_blocks = (MetaDataCycledBlocksModVars*) cycled_block_mod_vars->head;
-    while(cycled_blocks != NULL) {
-        if(set_int_contains(cycled_blocks->blocks_ids, block->base.id)) {
-            symbol_table_foreach(cycled_blocks->mod_vars, &block_variables_in_constants_table, constants_table);
-        }
-
-        cycled_blocks = (MetaDataCycledBlocksModVars*) cycled_blocks->base.next;
-    }
+    // block variables modified in loop if block is in loop, outermost loop summarizes nested ones
+    const int loop = oriented_graph_loop_forest_outermost_loop(optimizer->code_loops, block->base.id);
+    if(loop != -1)
+        symbol_table_foreach(optimizer->code_loops_mod_vars[loop], &block_variables_in_constants_table,
+                             constants_table);
 
     CodeInstruction* instruction = block->instructions;
     for(size_t i = 0; i < block->instructions_count; i++) {
@@ -1535,14 +1773,16 @@ bool code_optimizer_propagate_constants_in_block(CodeOptimizer* optimizer,
                (*(operands[j]))->type == TYPE_INSTRUCTION_OPERAND_VARIABLE &&
                operands_type[j] == TYPE_INSTRUCTION_OPERAND_SYMBOL) {
                 SymbolVariable* variable = (*(operands[j]))->data.variable;
-                MappedOperand* operand = (MappedOperand*) symbol_table_get(
+                CodeInstructionOperand* constant = constants_table_get_constant(
                         constants_table, variable_cached_identifier(variable));
 
                 // replace operand
-                if(operand != NULL && operand->operand != NULL && !operand->blocked) {
+                if(constant != NULL) {
                     propagated_something = true;
+                    code_optimizer_removing_instruction(optimizer, instruction);
                     code_instruction_operand_free(&(*(operands[j])));
-                    (*(operands[j])) = code_instruction_operand_copy(operand->operand);
+                    (*(operands[j])) = code_instruction_operand_copy(constant);
+                    code_optimizer_adding_instruction(optimizer, instruction);
                 }
             }
         }
@@ -1551,38 +1791,23 @@ bool code_optimizer_propagate_constants_in_block(CodeOptimizer* optimizer,
         if(instruction_cls == INSTRUCTION_TYPE_WRITE ||
            instruction_cls == INSTRUCTION_TYPE_VAR_MODIFIERS) {
             SymbolVariable* variable = instruction->op0->data.variable;
-            MappedOperand* operand = (MappedOperand*) symbol_table_get_or_create(
-                    constants_table,
-                    variable_cached_identifier(variable));
-
-            MappedOperand* origin_table_operand = NULL;
-            if(origin_constants_table != NULL) {
-                origin_table_operand = (MappedOperand*) symbol_table_get_or_create(
-                        origin_constants_table,
-                        variable_cached_identifier(variable));
-            }
+            const char* key = variable_cached_identifier(variable);
 
-            if(origin_table_operand != NULL && origin_table_operand->operand != NULL) {
-                code_instruction_operand_free(&origin_table_operand->operand);
-                origin_table_operand->setter = NULL;
-            }
-            if(operand->operand != NULL) {
-                code_instruction_operand_free(&operand->operand);
-                if(operand->setter != NULL &&
-                   !operand->blocked &&
-                   variable->frame != VARIABLE_FRAME_TEMP) {
-                    operand->setter->meta_data.without_effect = true;
-                }
-                operand->setter = NULL;
-            }
+            if(origin_constants_table != NULL)
+                constants_table_remove(origin_constants_table, key);
+
+            const bool blocked = constants_table_is_blocked(constants_table, key);
+            CodeInstruction* setter = constants_table_remove(constants_table, key);
+            if(setter != NULL && !blocked && variable->frame != VARIABLE_FRAME_TEMP)
+                setter->meta_data.without_effect = true;
 
             // add variable to constants if second operand is constant
             if(!(!propagate_global_vars && variable->frame == VARIABLE_FRAME_GLOBAL)) {
-                if(!operand->blocked && instruction_type == I_MOVE &&
+                if(!blocked && instruction_type == I_MOVE &&
                    instruction->op1->type == TYPE_INSTRUCTION_OPERAND_CONSTANT) {
                     // INFO new
-                    operand->setter = instruction;
-                    operand->operand = code_instruction_operand_copy(instruction->op1);
+                    constants_table_set(constants_table, key, code_instruction_operand_copy(instruction->op1),
+                                        instruction);
                 }
             }
         }
@@ -1595,57 +1820,27 @@ bool code_optimizer_propagate_constants_in_block(CodeOptimizer* optimizer,
     stack_table->is_direct_table = !is_conditional_block;
     stack_push(constants_tables_stack, (StackBaseItem*) stack_table);
 
-    SetInt* next_blocks_id = block->base.out_edges;
-    SetIntItem* next_block_id = (SetIntItem*) next_blocks_id->head;
-    while(next_block_id != NULL) {
+    size_t next_blocks_count;
+    const unsigned int* next_blocks_ids = oriented_graph_successors(optimizer->code_graph, block->base.id,
+                                                                    &next_blocks_count);
+    for(size_t i = 0; i < next_blocks_count; i++) {
         propagated_something |= code_optimizer_propagate_constants_in_block(
                 optimizer,
-                (CodeBlock*) oriented_graph_node(optimizer->code_graph, (unsigned int) next_block_id->value),
+                (CodeBlock*) oriented_graph_node(optimizer->code_graph, next_blocks_ids[i]),
                 constants_tables_stack,
                 processed_blocks_ids,
-                cycled_block_mod_vars,
-                set_int_contains(block->conditional_jump, next_block_id->value),
+                set_int_contains(block->conditional_jump, (int) next_blocks_ids[i]),
                 propagate_global_vars
         );
-        next_block_id = (SetIntItem*) next_block_id->base.next;
     }
 
     ConstantsTableStackItem* old_constants_table = (ConstantsTableStackItem*) stack_pop(constants_tables_stack);
     constants_tables_stack->stack_item_free_callback((StackBaseItem*) old_constants_table);
-    memory_free(old_constants_table);
+    memory_free_lazy(old_constants_table);
 
     return propagated_something;
 }
 
-SymbolTable* code_optimizer_modified_vars_in_blocks(CodeOptimizer* optimizer, SetInt* blocks_ids) {
-    NULL_POINTER_CHECK(optimizer, NULL);
-    NULL_POINTER_CHECK(blocks_ids, NULL);
-
-    SetIntItem* item = (SetIntItem*) blocks_ids->head;
-    SymbolTable* mod_vars = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(SymbolTableBaseItem), NULL, NULL);
-
-    while(item != NULL) {
-        CodeBlock* block = (CodeBlock*) oriented_graph_node(optimizer->code_graph, (unsigned int) item->value);
-
-        CodeInstruction* instruction = block->instructions;
-        for(size_t i = 0; i < block->instructions_count; i++) {
-            const TypeInstructionClass instruction_cls = instruction_class(instruction);
-            if(instruction_cls == INSTRUCTION_TYPE_WRITE ||
-               instruction_cls == INSTRUCTION_TYPE_VAR_MODIFIERS) {
-                SymbolVariable* variable = instruction->op0->data.variable;
-                symbol_table_get_or_create(
-                        mod_vars, variable_cached_identifier(variable));
-            }
-
-            instruction = instruction->next;
-        }
-
-        item = (SetIntItem*) item->base.next;
-    }
-
-    return mod_vars;
-}
-
 bool code_optimizer_literal_expression_eval_optimization(CodeOptimizer* optimizer) {
     NULL_POINTER_CHECK(optimizer, false);
 
@@ -1687,11 +1882,7 @@ bool code_optimizer_literal_expression_eval_optimization(CodeOptimizer* optimize
                             optimizer->generator, I_PUSH_STACK, lit_operand, NULL, NULL);
                 }
 
-                code_optimizer_adding_instruction(optimizer, new_instruction);
-                code_generator_insert_instruction_before(
-                        optimizer->generator,
-                        new_instruction,
-                        instruction->next);
+                code_optimizer_insert_instruction_before(optimizer, new_instruction, instruction->next);
 
                 // remove expression
                 CodeInstruction* expr_instruction = instruction;
@@ -1699,14 +1890,12 @@ bool code_optimizer_literal_expression_eval_optimization(CodeOptimizer* optimize
 
                 while(expr_instruction->meta_data.type != CODE_INSTRUCTION_META_TYPE_EXPRESSION_START) {
                     prev_expr_instruction = expr_instruction->prev;
-                    code_optimizer_removing_instruction(optimizer, expr_instruction);
-                    code_generator_remove_instruction(optimizer->generator, expr_instruction);
+                    code_optimizer_remove_instruction(optimizer, expr_instruction);
                     expr_instruction = prev_expr_instruction;
                 }
 
                 instruction = expr_instruction->prev;
-                code_optimizer_removing_instruction(optimizer, expr_instruction);
-                code_generator_remove_instruction(optimizer->generator, expr_instruction);
+                code_optimizer_remove_instruction(optimizer, expr_instruction);
             }
             start_instruction = NULL;
         }
@@ -1725,8 +1914,7 @@ void code_optimizer_remove_instructions_without_effect_optimization(CodeOptimize
     while(instruction != NULL) {
         next_instruction = instruction->next;
         if(instruction->meta_data.without_effect) {
-            code_optimizer_removing_instruction(optimizer, instruction);
-            code_generator_remove_instruction(optimizer->generator, instruction);
+            code_optimizer_remove_instruction(optimizer, instruction);
         }
 
         instruction = next_instruction;
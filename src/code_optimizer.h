@@ -9,12 +9,27 @@
 #include "oriented_graph.h"
 #include "interpreter.h"
 
+#define CODE_OPTIMIZER_PEEP_HOLE_REVISITS_PER_INSTRUCTION 8
+
 typedef struct code_optimizer_t {
     CodeGenerator* generator;
     SymbolTable* variables_meta_data;
     SymbolTable* functions_meta_data;
     SymbolTable* labels_meta_data;
+    // meta data were counted from whole program, since then they are updated by adding/removing of instructions
+    bool meta_data_counted;
     LList* peep_hole_patterns;
+    // patterns by type of their first instruction, rebuilt after adding of patterns
+    PeepHolePattern* peep_hole_patterns_index[I__LAST];
+    bool peep_hole_patterns_index_valid;
+    // count of instructions of longest pattern
+    size_t peep_hole_patterns_window;
+    // statistics of peep hole optimization
+    size_t peep_hole_applied_count;
+    size_t peep_hole_revisits_count;
+    // operands of fixed aliases
+    CodeInstructionOperand* peep_hole_temp_operand;
+    CodeInstructionOperand* peep_hole_true_operand;
     SymbolVariable* temp1;
     SymbolVariable* temp2;
     SymbolVariable* temp3;
@@ -24,6 +39,9 @@ typedef struct code_optimizer_t {
     Interpreter* interpreter;
 
     OrientedGraph* code_graph;
+    // loops of code graph and variables modified in them including nested loops, rebuilt with graph
+    OrientedGraphLoopForest* code_loops;
+    SymbolTable** code_loops_mod_vars;
 } CodeOptimizer;
 
 bool code_optimizer_check_operand_with_meta_type_flag(CodeOptimizer* optimizer, CodeInstructionOperand* operand,
@@ -45,27 +63,54 @@ void code_optimizer_free(CodeOptimizer** optimizer);
 // preparing code graph
 void code_optimizer_split_code_to_graph(CodeOptimizer* optimizer);
 
+/**
+ * @brief Frees loops of code graph, which are built by splitting code to graph.
+ */
+void code_optimizer_free_code_loops(CodeOptimizer* optimizer);
+
 // peep hole patterns managing
 PeepHolePattern* code_optimizer_new_ph_pattern(CodeOptimizer* optimizer);
 
-SymbolTable*
-code_optimizer_check_ph_pattern(CodeOptimizer* optimizer, PeepHolePattern* ph_pattern, CodeInstruction* instruction);
+void code_optimizer_update_ph_patterns_index(CodeOptimizer* optimizer);
+
+/**
+ * @brief Matches pattern from given instruction, operands of matched instructions are bound to slots of aliases.
+ * @param bound_operands array of PEEP_HOLE_PATTERN_ALIASES_MAX_COUNT slots, bound operands are not copied
+ */
+bool code_optimizer_check_ph_pattern(CodeOptimizer* optimizer, PeepHolePattern* ph_pattern,
+                                     CodeInstruction* instruction, CodeInstructionOperand** bound_operands);
 
 CodeInstruction* code_optimizer_new_instruction_with_mapped_operands(CodeOptimizer* optimizer,
                                                                      PeepHolePatternInstruction* ph_pattern_instruction,
-                                                                     SymbolTable* mapped_operands);
+                                                                     CodeInstructionOperand** bound_operands);
 
 // updating meta data
+/**
+ * @brief Counts instruction already linked into program into meta data.
+ */
 void code_optimizer_adding_instruction(CodeOptimizer* optimizer, CodeInstruction* instruction);
 
+/**
+ * @brief Removes contribution of instruction still linked in program from meta data.
+ */
 void code_optimizer_removing_instruction(CodeOptimizer* optimizer, CodeInstruction* instruction);
 
-void code_optimizer_update_meta_data(CodeOptimizer* optimizer);
+void code_optimizer_insert_instruction_before(CodeOptimizer* optimizer, CodeInstruction* instruction,
+                                              CodeInstruction* before_instruction);
 
-void code_optimizer_update_function_meta_data(CodeOptimizer* optimizer, CodeInstruction* instruction,
-                                              const char* current_func_label);
+void code_optimizer_remove_instruction(CodeOptimizer* optimizer, CodeInstruction* instruction);
 
-void code_optimizer_update_label_meta_data(CodeOptimizer* optimizer, CodeInstruction* instruction);
+/**
+ * @brief First call counts meta data of variables, labels and functions from whole program, later they are only
+ * kept by adding/removing of instructions. Purity and interpretability of expressions are updated always.
+ */
+void code_optimizer_update_meta_data(CodeOptimizer* optimizer);
+
+/**
+ * @brief Compares incrementally updated meta data with meta data rebuilt from whole program.
+ * @return true if they are same
+ */
+bool code_optimizer_check_meta_data(CodeOptimizer* optimizer);
 
 // constants propagating
 void block_variables_in_constants_table(const char* key, void* item, void* data);
@@ -74,18 +119,13 @@ void remove_variables_in_constants_table(const char* key, void* item, void* data
 
 void remove_variables_setters_in_constants_table(const char* key, void* item, void* data);
 
-void remove_reset_var_setters_in_constants_table(const char* key, void* item, void* data);
-
 bool code_optimizer_propagate_constants_in_block(CodeOptimizer* optimizer,
                                                  CodeBlock* block,
                                                  Stack* constants_tables_stack,
                                                  SetInt* processed_blocks_ids,
-                                                 LList* cycled_block_mod_vars,
                                                  bool is_conditional_block,
                                                  bool propagate_global_vars);
 
-SymbolTable* code_optimizer_modified_vars_in_blocks(CodeOptimizer* optimizer, SetInt* blocks_ids);
-
 // optimizing functions
 bool code_optimizer_remove_unused_variables(CodeOptimizer* optimizer, bool hard_remove, bool remove_special_temp);
 
@@ -93,6 +133,16 @@ void code_optimizer_add_advance_peep_hole_patterns(CodeOptimizer* optimizer);
 
 bool code_optimizer_peep_hole_optimization(CodeOptimizer* optimizer);
 
+/**
+ * @brief Peep hole optimization, which after every rewrite revisits only instructions, where new match
+ * could start. Single pass leaves no match depending only on neighbourhood, matches enabled by changed
+ * occurrences counts are found by next pass. Matches rewritten to same instructions are skipped and search
+ * continues by next patterns. Revisits in one pass are bounded by CODE_OPTIMIZER_PEEP_HOLE_REVISITS_PER_INSTRUCTION
+ * for each instruction, so cyclic patterns cannot loop forever.
+ * @return true if anything was rewritten
+ */
+bool code_optimizer_peep_hole_optimization_worklist(CodeOptimizer* optimizer);
+
 bool code_optimizer_remove_unused_functions(CodeOptimizer* optimizer);
 
 bool code_optimizer_propagate_constants_optimization(CodeOptimizer* optimizer);
@@ -0,0 +1,359 @@
+#include "code_optimizer_dataflow.h"
+
+SymbolVariable* code_dataflow_defined_variable(CodeInstruction* instruction) {
+    const TypeInstructionClass instruction_cls = instruction_class(instruction);
+    if(instruction_cls != INSTRUCTION_TYPE_WRITE && instruction_cls != INSTRUCTION_TYPE_VAR_MODIFIERS &&
+       instruction->type != I_DEF_VAR)
+        return NULL;
+
+    if(instruction->op0 == NULL || instruction->op0->type != TYPE_INSTRUCTION_OPERAND_VARIABLE)
+        return NULL;
+    return instruction->op0->data.variable;
+}
+
+SymbolVariable* code_dataflow_used_variable(CodeInstruction* instruction, int position) {
+    CodeInstructionOperand* operands[OPERANDS_MAX_COUNT] = {instruction->op0, instruction->op1, instruction->op2};
+    if(position >= instruction->signature_buffer->operand_count || operands[position] == NULL ||
+       operands[position]->type != TYPE_INSTRUCTION_OPERAND_VARIABLE)
+        return NULL;
+
+    // modified character of string keeps the rest of it
+    if(position == 0 && instruction->type != I_SET_CHAR && code_dataflow_defined_variable(instruction) != NULL)
+        return NULL;
+    return operands[position]->data.variable;
+}
+
+// instruction computing value of its first operand only from others
+static bool code_dataflow_is_expression(CodeInstruction* instruction) {
+    return instruction_class(instruction) == INSTRUCTION_TYPE_VAR_MODIFIERS && instruction->type != I_SET_CHAR &&
+           code_dataflow_defined_variable(instruction) != NULL;
+}
+
+static int code_dataflow_id(SymbolTable* ids, const char* key) {
+    SymbolTableIntItem* item = (SymbolTableIntItem*) symbol_table_get(ids, key);
+    return item == NULL ? -1 : item->value;
+}
+
+static int code_dataflow_add_id(SymbolTable* ids, size_t* count, const char* key) {
+    const int id = code_dataflow_id(ids, key);
+    if(id != -1)
+        return id;
+
+    SymbolTableIntItem* item = (SymbolTableIntItem*) symbol_table_get_or_create(ids, key);
+    item->value = (int) (*count)++;
+    return item->value;
+}
+
+// rendered operation with operands of expression instruction
+static char* code_dataflow_render_expression(CodeInstruction* instruction) {
+    char* op1 = instruction->op1 == NULL ? NULL : code_instruction_operand_render(instruction->op1);
+    char* op2 = instruction->op2 == NULL ? NULL : code_instruction_operand_render(instruction->op2);
+    const size_t length = strlen(instruction->signature_buffer->identifier) + 3 +
+                          (op1 == NULL ? 0 : strlen(op1)) + (op2 == NULL ? 0 : strlen(op2));
+
+    char* rendered = memory_alloc(sizeof(char) * length);
+    snprintf(rendered, length, "%s %s %s", instruction->signature_buffer->identifier,
+             op1 == NULL ? "" : op1, op2 == NULL ? "" : op2);
+
+    if(op1 != NULL)
+        memory_free(op1);
+    if(op2 != NULL)
+        memory_free(op2);
+    return rendered;
+}
+
+// maps variables of code graph to dense ids and creates problem
+static CodeDataflow* code_dataflow_init(CodeOptimizer* optimizer, DataflowDirection direction, DataflowMeet meet) {
+    CodeDataflow* code_dataflow = memory_alloc(sizeof(CodeDataflow));
+    NULL_POINTER_CHECK(code_dataflow, NULL);
+
+    code_dataflow->variables_ids = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(SymbolTableIntItem), NULL, NULL);
+    code_dataflow->variables_count = 0;
+    code_dataflow->global_variables = set_int_init();
+    code_dataflow->temp_variables = set_int_init();
+    code_dataflow->definitions = NULL;
+    code_dataflow->definitions_count = 0;
+    code_dataflow->variables_definitions = NULL;
+    code_dataflow->expressions_ids = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(SymbolTableIntItem), NULL,
+                                                       NULL);
+    code_dataflow->expressions_count = 0;
+
+    OrientedGraph* graph = optimizer->code_graph;
+    for(unsigned int i = 0; i < graph->capacity; i++) {
+        CodeBlock* block = (CodeBlock*) oriented_graph_node(graph, i);
+        CodeInstruction* instruction = block == NULL ? NULL : block->instructions;
+
+        for(size_t j = 0; block != NULL && j < block->instructions_count; j++) {
+            CodeInstructionOperand* operands[OPERANDS_MAX_COUNT] = {instruction->op0, instruction->op1,
+                                                                    instruction->op2};
+            for(int k = 0; k < instruction->signature_buffer->operand_count; k++) {
+                if(operands[k] == NULL || operands[k]->type != TYPE_INSTRUCTION_OPERAND_VARIABLE)
+                    continue;
+
+                SymbolVariable* variable = operands[k]->data.variable;
+                const int id = code_dataflow_add_id(code_dataflow->variables_ids, &code_dataflow->variables_count,
+                                                    variable_cached_identifier(variable));
+                if(variable->frame == VARIABLE_FRAME_GLOBAL)
+                    set_int_add(code_dataflow->global_variables, id);
+                else if(variable->frame == VARIABLE_FRAME_TEMP)
+                    set_int_add(code_dataflow->temp_variables, id);
+            }
+
+            instruction = instruction->next;
+        }
+    }
+
+    code_dataflow->dataflow = dataflow_init(graph, direction, meet, code_dataflow->variables_count);
+    return code_dataflow;
+}
+
+void code_dataflow_free(CodeDataflow** dataflow) {
+    NULL_POINTER_CHECK(dataflow,);
+    NULL_POINTER_CHECK(*dataflow,);
+
+    CodeDataflow* v = *dataflow;
+    if(v->variables_definitions != NULL) {
+        for(size_t i = 0; i < v->variables_count; i++)
+            set_int_free(&v->variables_definitions[i]);
+        memory_free(v->variables_definitions);
+    }
+    if(v->definitions != NULL)
+        memory_free(v->definitions);
+    symbol_table_free(v->variables_ids);
+    symbol_table_free(v->expressions_ids);
+    set_int_free(&v->global_variables);
+    set_int_free(&v->temp_variables);
+    dataflow_free(&v->dataflow);
+    memory_free(v);
+    *dataflow = NULL;
+}
+
+int code_dataflow_variable_id(CodeDataflow* dataflow, SymbolVariable* variable) {
+    NULL_POINTER_CHECK(dataflow, -1);
+    NULL_POINTER_CHECK(variable, -1);
+
+    return code_dataflow_id(dataflow->variables_ids, variable_cached_identifier(variable));
+}
+
+int code_dataflow_expression_id(CodeDataflow* dataflow, CodeInstruction* instruction) {
+    NULL_POINTER_CHECK(dataflow, -1);
+    NULL_POINTER_CHECK(instruction, -1);
+
+    if(!code_dataflow_is_expression(instruction))
+        return -1;
+
+    char* rendered = code_dataflow_render_expression(instruction);
+    const int id = code_dataflow_id(dataflow->expressions_ids, rendered);
+    memory_free(rendered);
+    return id;
+}
+
+CodeDataflow* code_optimizer_reaching_definitions(CodeOptimizer* optimizer) {
+    NULL_POINTER_CHECK(optimizer, NULL);
+    NULL_POINTER_CHECK(optimizer->code_graph, NULL);
+
+    OrientedGraph* graph = optimizer->code_graph;
+    CodeDataflow* code_dataflow = code_dataflow_init(optimizer, DATAFLOW_DIRECTION_FORWARD, DATAFLOW_MEET_UNION);
+    NULL_POINTER_CHECK(code_dataflow, NULL);
+
+    // number definitions
+    for(unsigned int i = 0; i < graph->capacity; i++) {
+        CodeBlock* block = (CodeBlock*) oriented_graph_node(graph, i);
+        CodeInstruction* instruction = block == NULL ? NULL : block->instructions;
+
+        for(size_t j = 0; block != NULL && j < block->instructions_count; j++) {
+            if(instruction->type == I_CALL || code_dataflow_defined_variable(instruction) != NULL)
+                code_dataflow->definitions_count++;
+            instruction = instruction->next;
+        }
+    }
+
+    code_dataflow->definitions = memory_alloc(sizeof(CodeInstruction*) * (code_dataflow->definitions_count + 1));
+    code_dataflow->variables_definitions = memory_alloc(sizeof(SetInt*) * (code_dataflow->variables_count + 1));
+    for(size_t i = 0; i < code_dataflow->variables_count; i++)
+        code_dataflow->variables_definitions[i] = set_int_init();
+
+    size_t definitions_count = 0;
+    for(unsigned int i = 0; i < graph->capacity; i++) {
+        CodeBlock* block = (CodeBlock*) oriented_graph_node(graph, i);
+        CodeInstruction* instruction = block == NULL ? NULL : block->instructions;
+
+        for(size_t j = 0; block != NULL && j < block->instructions_count; j++) {
+            SymbolVariable* variable = code_dataflow_defined_variable(instruction);
+            if(variable != NULL) {
+                set_int_add(code_dataflow->variables_definitions[code_dataflow_variable_id(code_dataflow, variable)],
+                            (int) definitions_count);
+                code_dataflow->definitions[definitions_count++] = instruction;
+            } else if(instruction->type == I_CALL) {
+                for(int id = set_int_first(code_dataflow->global_variables);
+                    id != SET_INT_END; id = set_int_next(code_dataflow->global_variables, id))
+                    set_int_add(code_dataflow->variables_definitions[id], (int) definitions_count);
+                code_dataflow->definitions[definitions_count++] = instruction;
+            }
+            instruction = instruction->next;
+        }
+    }
+
+    // gen and kill of blocks, definition hides previous definitions of same variable
+    Dataflow* dataflow = code_dataflow->dataflow;
+    dataflow->universe_size = code_dataflow->definitions_count;
+    definitions_count = 0;
+    for(unsigned int i = 0; i < graph->capacity; i++) {
+        CodeBlock* block = (CodeBlock*) oriented_graph_node(graph, i);
+        CodeInstruction* instruction = block == NULL ? NULL : block->instructions;
+
+        for(size_t j = 0; block != NULL && j < block->instructions_count; j++) {
+            SymbolVariable* variable = code_dataflow_defined_variable(instruction);
+            if(variable != NULL) {
+                SetInt* variable_definitions =
+                        code_dataflow->variables_definitions[code_dataflow_variable_id(code_dataflow, variable)];
+                set_int_difference(dataflow->gen[i], variable_definitions);
+                set_int_union(dataflow->kill[i], variable_definitions);
+                set_int_add(dataflow->gen[i], (int) definitions_count++);
+            } else if(instruction->type == I_CALL) {
+                set_int_add(dataflow->gen[i], (int) definitions_count++);
+            }
+            instruction = instruction->next;
+        }
+    }
+
+    dataflow_solve(dataflow, graph);
+    return code_dataflow;
+}
+
+CodeDataflow* code_optimizer_live_variables(CodeOptimizer* optimizer) {
+    NULL_POINTER_CHECK(optimizer, NULL);
+    NULL_POINTER_CHECK(optimizer->code_graph, NULL);
+
+    OrientedGraph* graph = optimizer->code_graph;
+    CodeDataflow* code_dataflow = code_dataflow_init(optimizer, DATAFLOW_DIRECTION_BACKWARD, DATAFLOW_MEET_UNION);
+    NULL_POINTER_CHECK(code_dataflow, NULL);
+
+    // gen are variables used before their modification in block
+    Dataflow* dataflow = code_dataflow->dataflow;
+    SetInt* used = set_int_init();
+    for(unsigned int i = 0; i < graph->capacity; i++) {
+        CodeBlock* block = (CodeBlock*) oriented_graph_node(graph, i);
+        CodeInstruction* instruction = block == NULL ? NULL : block->instructions;
+
+        for(size_t j = 0; block != NULL && j < block->instructions_count; j++) {
+            set_int_clear(used);
+            for(int k = 0; k < OPERANDS_MAX_COUNT; k++) {
+                SymbolVariable* variable = code_dataflow_used_variable(instruction, k);
+                if(variable != NULL)
+                    set_int_add(used, code_dataflow_variable_id(code_dataflow, variable));
+            }
+            if(instruction->type == I_CALL)
+                set_int_union(used, code_dataflow->global_variables);
+            else if(instruction->type == I_PUSH_FRAME)
+                set_int_union(used, code_dataflow->temp_variables);
+
+            set_int_difference(used, dataflow->kill[i]);
+            set_int_union(dataflow->gen[i], used);
+
+            // new temporary frame replaces all temporary variables
+            set_int_clear(used);
+            SymbolVariable* variable = code_dataflow_defined_variable(instruction);
+            if(variable != NULL)
+                set_int_add(used, code_dataflow_variable_id(code_dataflow, variable));
+            else if(instruction->type == I_CREATE_FRAME)
+                set_int_union(used, code_dataflow->temp_variables);
+
+            set_int_difference(used, dataflow->gen[i]);
+            set_int_union(dataflow->kill[i], used);
+
+            instruction = instruction->next;
+        }
+    }
+    set_int_free(&used);
+
+    set_int_union(dataflow->boundary, code_dataflow->global_variables);
+    dataflow_solve(dataflow, graph);
+    return code_dataflow;
+}
+
+CodeDataflow* code_optimizer_available_expressions(CodeOptimizer* optimizer) {
+    NULL_POINTER_CHECK(optimizer, NULL);
+    NULL_POINTER_CHECK(optimizer->code_graph, NULL);
+
+    OrientedGraph* graph = optimizer->code_graph;
+    CodeDataflow* code_dataflow = code_dataflow_init(optimizer, DATAFLOW_DIRECTION_FORWARD,
+                                                     DATAFLOW_MEET_INTERSECTION);
+    NULL_POINTER_CHECK(code_dataflow, NULL);
+
+    // expressions using variables, expressions over global and frame variables are killed by calls and frames
+    SetInt** variables_expressions = memory_alloc(sizeof(SetInt*) * (code_dataflow->variables_count + 1));
+    for(size_t i = 0; i < code_dataflow->variables_count; i++)
+        variables_expressions[i] = set_int_init();
+    SetInt* global_expressions = set_int_init();
+    SetInt* frame_expressions = set_int_init();
+
+    for(unsigned int i = 0; i < graph->capacity; i++) {
+        CodeBlock* block = (CodeBlock*) oriented_graph_node(graph, i);
+        CodeInstruction* instruction = block == NULL ? NULL : block->instructions;
+
+        for(size_t j = 0; block != NULL && j < block->instructions_count; j++) {
+            if(code_dataflow_is_expression(instruction)) {
+                char* rendered = code_dataflow_render_expression(instruction);
+                const int id = code_dataflow_add_id(code_dataflow->expressions_ids, &code_dataflow->expressions_count,
+                                                    rendered);
+                memory_free(rendered);
+
+                for(int k = 1; k < OPERANDS_MAX_COUNT; k++) {
+                    SymbolVariable* variable = code_dataflow_used_variable(instruction, k);
+                    if(variable == NULL)
+                        continue;
+
+                    set_int_add(variables_expressions[code_dataflow_variable_id(code_dataflow, variable)], id);
+                    if(variable->frame == VARIABLE_FRAME_GLOBAL)
+                        set_int_add(global_expressions, id);
+                    else
+                        set_int_add(frame_expressions, id);
+                }
+            }
+            instruction = instruction->next;
+        }
+    }
+
+    Dataflow* dataflow = code_dataflow->dataflow;
+    dataflow->universe_size = code_dataflow->expressions_count;
+    for(unsigned int i = 0; i < graph->capacity; i++) {
+        CodeBlock* block = (CodeBlock*) oriented_graph_node(graph, i);
+        CodeInstruction* instruction = block == NULL ? NULL : block->instructions;
+
+        for(size_t j = 0; block != NULL && j < block->instructions_count; j++) {
+            const int id = code_dataflow_expression_id(code_dataflow, instruction);
+            if(id != -1)
+                set_int_add(dataflow->gen[i], id);
+
+            SymbolVariable* variable = code_dataflow_defined_variable(instruction);
+            SetInt* killed = NULL;
+            if(variable != NULL)
+                killed = variables_expressions[code_dataflow_variable_id(code_dataflow, variable)];
+            else if(instruction->type == I_CREATE_FRAME || instruction->type == I_PUSH_FRAME ||
+                    instruction->type == I_POP_FRAME)
+                killed = frame_expressions;
+
+            if(instruction->type == I_CALL) {
+                set_int_difference(dataflow->gen[i], global_expressions);
+                set_int_union(dataflow->kill[i], global_expressions);
+                killed = frame_expressions;
+            }
+            if(killed != NULL) {
+                set_int_difference(dataflow->gen[i], killed);
+                set_int_union(dataflow->kill[i], killed);
+            }
+
+            instruction = instruction->next;
+        }
+    }
+
+    for(size_t i = 0; i < code_dataflow->variables_count; i++)
+        set_int_free(&variables_expressions[i]);
+    memory_free(variables_expressions);
+    set_int_free(&global_expressions);
+    set_int_free(&frame_expressions);
+
+    dataflow_solve(dataflow, graph);
+    return code_dataflow;
+}
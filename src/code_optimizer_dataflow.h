@@ -0,0 +1,66 @@
+#ifndef CODE_OPTIMIZER_DATAFLOW_H
+#define CODE_OPTIMIZER_DATAFLOW_H
+
+#include "code_optimizer.h"
+#include "dataflow.h"
+
+/**
+ * @brief Solved dataflow problem over code graph of optimizer with dense ids of its facts,
+ * sets of problem are indexed by ids of code blocks.
+ */
+typedef struct code_dataflow_t {
+    Dataflow* dataflow;
+    // identifiers of variables occurring in code graph mapped to dense ids
+    SymbolTable* variables_ids;
+    size_t variables_count;
+    SetInt* global_variables;
+    SetInt* temp_variables;
+    // reaching definitions: defining instructions by ids of definitions, ids of definitions of every variable
+    CodeInstruction** definitions;
+    size_t definitions_count;
+    SetInt** variables_definitions;
+    // available expressions: rendered expressions mapped to dense ids
+    SymbolTable* expressions_ids;
+    size_t expressions_count;
+} CodeDataflow;
+
+/**
+ * @brief Variable modified by instruction or NULL.
+ */
+SymbolVariable* code_dataflow_defined_variable(CodeInstruction* instruction);
+
+/**
+ * @brief Variable read by instruction on given operand position or NULL.
+ */
+SymbolVariable* code_dataflow_used_variable(CodeInstruction* instruction, int position);
+
+/**
+ * @brief Definitions reaching start and end of code blocks. Call may define all global variables.
+ */
+CodeDataflow* code_optimizer_reaching_definitions(CodeOptimizer* optimizer);
+
+/**
+ * @brief Variables live at start and end of code blocks. Global variables are live at exits and used by calls,
+ * temporary frame is used by pushing of frame and replaced by creating of frame.
+ */
+CodeDataflow* code_optimizer_live_variables(CodeOptimizer* optimizer);
+
+/**
+ * @brief Expressions available at start and end of code blocks. Expression is computed by instruction modifying
+ * variable only from its operands, calls and frame instructions kill expressions over global and frame variables.
+ */
+CodeDataflow* code_optimizer_available_expressions(CodeOptimizer* optimizer);
+
+void code_dataflow_free(CodeDataflow** dataflow);
+
+/**
+ * @brief Dense id of variable or -1, if variable does not occur in code graph.
+ */
+int code_dataflow_variable_id(CodeDataflow* dataflow, SymbolVariable* variable);
+
+/**
+ * @brief Dense id of expression computed by instruction or -1.
+ */
+int code_dataflow_expression_id(CodeDataflow* dataflow, CodeInstruction* instruction);
+
+#endif // CODE_OPTIMIZER_DATAFLOW_H
@@ -41,10 +41,8 @@ CodeInstructionOperand* code_optimizer_expr_eval(
 
     int result_i = 0;
     double result_d = 0;
-    String* result_s = string_init();
     // sorry, but too many cases here
-    memory_free_lazy(result_s);
-    memory_free_lazy(result_s->content);
+    String* result_s = NULL;
 
     if(t2 == NULL) {
         // unary op
@@ -97,20 +95,15 @@ CodeInstructionOperand* code_optimizer_expr_eval(
                         break;
 
                     case DATA_TYPE_STRING:
-                        if(t1->data_type == DATA_TYPE_STRING)
-                            string_append(result_s, t1->instruction->op0->data.constant.data.string);
-                        else {
-                            LOG_WARNING("Unknown data type");
-                            return NULL;
-                        }
-
-                        if(t2->data_type == DATA_TYPE_STRING)
-                            string_append(result_s, t2->instruction->op0->data.constant.data.string);
-                        else {
+                        if(t1->data_type != DATA_TYPE_STRING || t2->data_type != DATA_TYPE_STRING) {
                             LOG_WARNING("Unknown data type");
                             return NULL;
                         }
 
+                        // allocated only after all checks, so no return path leaks it
+                        result_s = string_init();
+                        string_append(result_s, t1->instruction->op0->data.constant.data.string);
+                        string_append(result_s, t2->instruction->op0->data.constant.data.string);
                         break;
                     default:
                         LOG_WARNING("Unknown operation");
@@ -315,8 +308,13 @@ CodeInstructionOperand* code_optimizer_expr_eval(
             return code_instruction_operand_init_integer(result_i);
         case DATA_TYPE_DOUBLE:
             return code_instruction_operand_init_double(result_d);
-        case DATA_TYPE_STRING:
-            return code_instruction_operand_init_string(result_s);
+        case DATA_TYPE_STRING: {
+            // operand holds copy of string
+            CodeInstructionOperand* operand = code_instruction_operand_init_string(result_s);
+            if(result_s != NULL)
+                string_free(&result_s);
+            return operand;
+        }
         case DATA_TYPE_BOOLEAN:
             return code_instruction_operand_init_boolean((bool) result_i);
         default:
@@ -359,13 +357,13 @@ void code_optimizer_optimize_type_casts(CodeOptimizer* optimizer) {
                     );
                     replacement->meta_data = actual->prev->meta_data;
 
-                    code_generator_insert_instruction_before(
-                            generator,
+                    code_optimizer_insert_instruction_before(
+                            optimizer,
                             replacement,
                             actual->prev
                     );
-                    code_generator_remove_instruction(generator, actual->prev);
-                    code_generator_remove_instruction(generator, actual);
+                    code_optimizer_remove_instruction(optimizer, actual->prev);
+                    code_optimizer_remove_instruction(optimizer, actual);
                     next = replacement;
                 }
                 break;
@@ -390,13 +388,13 @@ void code_optimizer_optimize_type_casts(CodeOptimizer* optimizer) {
                     );
                     replacement->meta_data = actual->prev->meta_data;
 
-                    code_generator_insert_instruction_before(
-                            generator,
+                    code_optimizer_insert_instruction_before(
+                            optimizer,
                             replacement,
                             actual->prev
                     );
-                    code_generator_remove_instruction(generator, actual->prev);
-                    code_generator_remove_instruction(generator, actual);
+                    code_optimizer_remove_instruction(optimizer, actual->prev);
+                    code_optimizer_remove_instruction(optimizer, actual);
                     next = replacement;
                 }
                 break;
@@ -421,13 +419,13 @@ void code_optimizer_optimize_type_casts(CodeOptimizer* optimizer) {
                     );
                     replacement->meta_data = actual->prev->meta_data;
 
-                    code_generator_insert_instruction_before(
-                            generator,
+                    code_optimizer_insert_instruction_before(
+                            optimizer,
                             replacement,
                             actual->prev
                     );
-                    code_generator_remove_instruction(generator, actual->prev);
-                    code_generator_remove_instruction(generator, actual);
+                    code_optimizer_remove_instruction(optimizer, actual->prev);
+                    code_optimizer_remove_instruction(optimizer, actual);
                     next = replacement;
                 }
                 break;
@@ -473,8 +471,8 @@ void code_optimizer_optimize_partial_expression_eval(CodeOptimizer* optimizer) {
                     return;
                 }
 
-                code_generator_insert_instruction_before(
-                        optimizer->generator,
+                code_optimizer_insert_instruction_before(
+                        optimizer,
                         code_generator_new_instruction(
                                 optimizer->generator,
                                 I_PUSH_STACK,
@@ -484,9 +482,9 @@ void code_optimizer_optimize_partial_expression_eval(CodeOptimizer* optimizer) {
                         ),
                         actual->prev->prev
                 );
-                code_generator_remove_instruction(optimizer->generator, actual->prev->prev);
-                code_generator_remove_instruction(optimizer->generator, actual->prev);
-                code_generator_remove_instruction(optimizer->generator, actual);
+                code_optimizer_remove_instruction(optimizer, actual->prev->prev);
+                code_optimizer_remove_instruction(optimizer, actual->prev);
+                code_optimizer_remove_instruction(optimizer, actual);
             }
         } else if(interpreter_supported_unary_operation_instruction(actual->type)) {
             if(is_literal_push(actual->prev)) {
@@ -500,8 +498,8 @@ void code_optimizer_optimize_partial_expression_eval(CodeOptimizer* optimizer) {
                     return;
                 }
 
-                code_generator_insert_instruction_before(
-                        optimizer->generator,
+                code_optimizer_insert_instruction_before(
+                        optimizer,
                         code_generator_new_instruction(
                                 optimizer->generator,
                                 I_PUSH_STACK,
@@ -511,8 +509,8 @@ void code_optimizer_optimize_partial_expression_eval(CodeOptimizer* optimizer) {
                         ),
                         actual->prev
                 );
-                code_generator_remove_instruction(optimizer->generator, actual->prev);
-                code_generator_remove_instruction(optimizer->generator, actual);
+                code_optimizer_remove_instruction(optimizer, actual->prev);
+                code_optimizer_remove_instruction(optimizer, actual);
             }
         }
         actual = next;
@@ -539,10 +537,10 @@ void code_optimizer_optimize_jumps(CodeOptimizer* optimizer) {
                         NULL,
                         NULL
                 );
-                code_generator_insert_instruction_before(optimizer->generator, const_jump, actual);
+                code_optimizer_insert_instruction_before(optimizer, const_jump, actual);
             }
 
-            code_generator_remove_instruction(optimizer->generator, actual);
+            code_optimizer_remove_instruction(optimizer, actual);
         } else if(actual->type == I_JUMP_IF_NOT_EQUAL && actual->op1->type == TYPE_INSTRUCTION_OPERAND_CONSTANT &&
                   actual->op2->type == TYPE_INSTRUCTION_OPERAND_CONSTANT) {
             if(!code_instruction_operand_cmp(actual->op1, actual->op2)) {
@@ -553,10 +551,10 @@ void code_optimizer_optimize_jumps(CodeOptimizer* optimizer) {
                         NULL,
                         NULL
                 );
-                code_generator_insert_instruction_before(optimizer->generator, const_jump, actual);
+                code_optimizer_insert_instruction_before(optimizer, const_jump, actual);
             }
 
-            code_generator_remove_instruction(optimizer->generator, actual);
+            code_optimizer_remove_instruction(optimizer, actual);
         }
         actual = next;
     }
@@ -619,8 +617,8 @@ void code_optimizer_optimize_comparisons(CodeOptimizer* optimizer) {
 
 
             if(const_move != NULL) {
-                code_generator_insert_instruction_before(optimizer->generator, const_move, actual);
-                code_generator_remove_instruction(optimizer->generator, actual);
+                code_optimizer_insert_instruction_before(optimizer, const_move, actual);
+                code_optimizer_remove_instruction(optimizer, actual);
             }
         }
         actual = next;
@@ -689,11 +687,13 @@ void code_optimizer_multi_write(CodeOptimizer* optimizer) {
 
                 memory_free(tmp);
 
+                code_optimizer_removing_instruction(optimizer, actual);
                 code_instruction_operand_free(&actual->op0);
                 actual->op0 = code_instruction_operand_init_string(together);
+                code_optimizer_adding_instruction(optimizer, actual);
                 string_free(&together);
 
-                code_generator_remove_instruction(optimizer->generator, actual->next);
+                code_optimizer_remove_instruction(optimizer, actual->next);
                 next = actual;
             }
         }
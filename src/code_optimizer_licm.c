@@ -0,0 +1,364 @@
+#include "code_optimizer_licm.h"
+#include "code_optimizer_dataflow.h"
+
+// state of processed loop, variables are indexed by ids of live variables
+typedef struct {
+    CodeOptimizer* optimizer;
+    CodeDataflow* live_variables;
+    OrientedGraphLoopForest* forest;
+    const OrientedGraphCSR* csr;
+    int loop;
+    // arrays are valid for variable only if its stamp is index of processed loop
+    int* stamps;
+    // definitions in loop, block containing all of them or -1 and definitions moved before loop or -1 if failed
+    int* definitions_counts;
+    int* definitions_blocks;
+    int* moved_counts;
+    SetInt* special_variables;
+    // functions containing calls and called functions
+    FunctionMetaData** callers;
+    const char** callees;
+    size_t calls_count;
+} CodeLICM;
+
+static bool code_licm_is_movable(CodeInstruction* instruction) {
+    switch(instruction->type) {
+        case I_MOVE:
+        case I_ADD:
+        case I_SUB:
+        case I_MUL:
+        case I_LESSER_THEN:
+        case I_GREATER_THEN:
+        case I_EQUAL:
+        case I_AND:
+        case I_OR:
+        case I_NOT:
+        case I_INT_TO_FLOAT:
+        case I_FLOAT_TO_INT:
+        case I_FLOAT_ROUND_TO_EVEN_INT:
+        case I_FLOAT_ROUND_TO_ODD_INT:
+        case I_CONCAT_STRING:
+        case I_STRING_LENGTH:
+        case I_TYPE:
+            // division and string indexing can fail, so they are never executed speculatively
+            return instruction->meta_data.purity_type == META_TYPE_PURE;
+        default:
+            return false;
+    }
+}
+
+static int code_licm_variable_id(CodeLICM* licm, SymbolVariable* variable) {
+    if(variable == NULL || (variable->frame != VARIABLE_FRAME_LOCAL && variable->frame != VARIABLE_FRAME_GLOBAL))
+        return -1;
+    return code_dataflow_variable_id(licm->live_variables, variable);
+}
+
+static void code_licm_add_definition(CodeLICM* licm, int variable, int block) {
+    if(licm->stamps[variable] != licm->loop) {
+        licm->stamps[variable] = licm->loop;
+        licm->definitions_counts[variable] = 0;
+        licm->definitions_blocks[variable] = block;
+        licm->moved_counts[variable] = 0;
+    } else if(licm->definitions_blocks[variable] != block) {
+        licm->definitions_blocks[variable] = -1;
+    }
+    licm->definitions_counts[variable]++;
+}
+
+static void code_licm_add_call_definition(const char* key, void* item, void* data) {
+    CodeLICM* licm = (CodeLICM*) data;
+    SymbolTableIntItem* id = (SymbolTableIntItem*) symbol_table_get(licm->live_variables->variables_ids, key);
+    if(id != NULL)
+        code_licm_add_definition(licm, id->value, -1);
+}
+
+// call defines global variables modified by called function and all functions reachable from it
+static void code_licm_add_call_definitions(CodeLICM* licm, const char* function) {
+    SymbolTable* visited = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(SymbolTableBaseItem), NULL, NULL);
+    const char** stack = memory_alloc(sizeof(const char*) * (licm->calls_count + 1));
+    size_t stack_count = 0;
+
+    symbol_table_get_or_create(visited, function);
+    stack[stack_count++] = function;
+    while(stack_count > 0) {
+        FunctionMetaData* meta_data = code_optimizer_function_meta_data(licm->optimizer, stack[--stack_count]);
+        symbol_table_foreach(meta_data->mod_global_vars, &code_licm_add_call_definition, licm);
+
+        for(size_t i = 0; i < licm->calls_count; i++) {
+            if(licm->callers[i] != meta_data || symbol_table_get(visited, licm->callees[i]) != NULL)
+                continue;
+            symbol_table_get_or_create(visited, licm->callees[i]);
+            stack[stack_count++] = licm->callees[i];
+        }
+    }
+
+    memory_free(stack);
+    symbol_table_free(visited);
+}
+
+// label of header, before which moved instructions are inserted, or NULL if loop is entered not only through it
+static CodeInstruction* code_licm_preheader(CodeLICM* licm, OrientedGraphLoop* loop) {
+    CodeBlock* header = (CodeBlock*) oriented_graph_node(licm->optimizer->code_graph, loop->header);
+    if(header == NULL || header->instructions_count == 0 || header->instructions->type != I_LABEL ||
+       header->instructions->prev == NULL)
+        return NULL;
+
+    CodeInstruction* previous = header->instructions->prev;
+    const TypeInstructionClass previous_cls = instruction_class(previous);
+    if(previous->type == I_RETURN || previous_cls == INSTRUCTION_TYPE_DIRECT_JUMP ||
+       (previous_cls == INSTRUCTION_TYPE_CONDITIONAL_JUMP &&
+        strcmp(previous->op0->data.label, header->instructions->op0->data.label) == 0))
+        return NULL;
+
+    // only entry from outside of loop is by falling through from previous block
+    int entry = -1;
+    for(unsigned int i = licm->csr->predecessors_offsets[loop->header];
+        i < licm->csr->predecessors_offsets[loop->header + 1]; i++) {
+        const unsigned int predecessor = licm->csr->predecessors[i];
+        if(set_int_contains(loop->nodes, (int) predecessor))
+            continue;
+        if(entry != -1)
+            return NULL;
+        entry = (int) predecessor;
+    }
+    if(entry == -1)
+        return NULL;
+
+    CodeBlock* entry_block = (CodeBlock*) oriented_graph_node(licm->optimizer->code_graph, (unsigned int) entry);
+    return entry_block->last_instruction == previous ? header->instructions : NULL;
+}
+
+// variable is not read after loop, if its definitions in block can be skipped on the way out of loop
+static bool code_licm_is_dead_after_skipped_block(CodeLICM* licm, OrientedGraphLoop* loop, int variable,
+                                                  unsigned int block_id) {
+    for(int id = set_int_first(loop->nodes); id != SET_INT_END; id = set_int_next(loop->nodes, id)) {
+        if(oriented_graph_loop_forest_dominates(licm->forest, block_id, (unsigned int) id))
+            continue;
+
+        const unsigned int successors_offset = licm->csr->successors_offsets[id];
+        const unsigned int successors_count = licm->csr->successors_offsets[id + 1] - successors_offset;
+        if(successors_count == 0 && set_int_contains(licm->live_variables->dataflow->out[id], variable))
+            return false;
+        for(unsigned int i = successors_offset; i < successors_offset + successors_count; i++) {
+            const unsigned int successor = licm->csr->successors[i];
+            if(!set_int_contains(loop->nodes, (int) successor) &&
+               set_int_contains(licm->live_variables->dataflow->in[successor], variable))
+                return false;
+        }
+    }
+    return true;
+}
+
+// block dominating all sources of back edges is executed in every iteration, so moved instructions are not executed
+// more times than before
+static bool code_licm_is_executed_in_every_iteration(CodeLICM* licm, OrientedGraphLoop* loop, unsigned int block_id) {
+    for(unsigned int i = licm->csr->predecessors_offsets[loop->header];
+        i < licm->csr->predecessors_offsets[loop->header + 1]; i++) {
+        const unsigned int predecessor = licm->csr->predecessors[i];
+        if(set_int_contains(loop->nodes, (int) predecessor) &&
+           !oriented_graph_loop_forest_dominates(licm->forest, block_id, predecessor))
+            return false;
+    }
+    return true;
+}
+
+// operand has same value in all iterations and it is defined before loop
+static bool code_licm_is_invariant(CodeLICM* licm, CodeInstructionOperand* operand) {
+    if(operand->type != TYPE_INSTRUCTION_OPERAND_VARIABLE)
+        return true;
+
+    const int variable = code_licm_variable_id(licm, operand->data.variable);
+    if(variable == -1)
+        return false;
+    // temporary variables are not defined, until some computation uses them
+    if(licm->stamps[variable] != licm->loop)
+        return !set_int_contains(licm->special_variables, variable);
+    return licm->moved_counts[variable] == licm->definitions_counts[variable];
+}
+
+static bool code_licm_is_movable_definition(CodeLICM* licm, OrientedGraphLoop* loop, CodeInstruction* instruction,
+                                            int variable, unsigned int block_id) {
+    if(!code_licm_is_movable(instruction) || licm->definitions_blocks[variable] != (int) block_id)
+        return false;
+
+    // first definition in loop sets value read by loop and after it
+    if(licm->moved_counts[variable] == 0 &&
+       (!code_licm_is_executed_in_every_iteration(licm, loop, block_id) ||
+        set_int_contains(licm->live_variables->dataflow->in[loop->header], variable) ||
+        !code_licm_is_dead_after_skipped_block(licm, loop, variable, block_id)))
+        return false;
+
+    CodeInstructionOperand* operands[OPERANDS_MAX_COUNT] = {instruction->op0, instruction->op1, instruction->op2};
+    for(int k = 1; k < instruction->signature_buffer->operand_count; k++) {
+        // previous definition of variable is already moved
+        if(operands[k]->type == TYPE_INSTRUCTION_OPERAND_VARIABLE &&
+           code_licm_variable_id(licm, operands[k]->data.variable) == variable)
+            continue;
+        if(!code_licm_is_invariant(licm, operands[k]))
+            return false;
+    }
+    return true;
+}
+
+static void code_licm_move_instruction(CodeLICM* licm, CodeBlock* block, CodeInstruction* instruction,
+                                       CodeInstruction* preheader) {
+    if(block->instructions == instruction)
+        block->instructions = instruction->next;
+    if(block->last_instruction == instruction)
+        block->last_instruction = instruction->prev;
+    block->instructions_count--;
+
+    CodeInstruction* moved = code_generator_new_instruction(
+            licm->optimizer->generator, instruction->type,
+            instruction->op0 == NULL ? NULL : code_instruction_operand_copy(instruction->op0),
+            instruction->op1 == NULL ? NULL : code_instruction_operand_copy(instruction->op1),
+            instruction->op2 == NULL ? NULL : code_instruction_operand_copy(instruction->op2));
+    code_optimizer_insert_instruction_before(licm->optimizer, moved, preheader);
+    code_optimizer_remove_instruction(licm->optimizer, instruction);
+}
+
+// definitions of variables, which are computed only from invariant operands, are moved in order of their execution
+static bool code_licm_move_block(CodeLICM* licm, OrientedGraphLoop* loop, unsigned int block_id,
+                                 CodeInstruction* preheader) {
+    CodeBlock* block = (CodeBlock*) oriented_graph_node(licm->optimizer->code_graph, block_id);
+    CodeInstruction** candidates = memory_alloc(sizeof(CodeInstruction*) * (block->instructions_count + 1));
+    size_t candidates_count = 0;
+
+    CodeInstruction* instruction = block->instructions;
+    for(size_t i = 0; i < block->instructions_count; i++) {
+        const int variable = code_licm_variable_id(licm, code_dataflow_defined_variable(instruction));
+
+        // variable read between its moved definitions would get another value
+        for(int k = 0; k < OPERANDS_MAX_COUNT; k++) {
+            const int used = code_licm_variable_id(licm, code_dataflow_used_variable(instruction, k));
+            if(used != -1 && used != variable && licm->stamps[used] == licm->loop &&
+               licm->moved_counts[used] > 0 && licm->moved_counts[used] < licm->definitions_counts[used])
+                licm->moved_counts[used] = -1;
+        }
+
+        if(variable != -1 && licm->stamps[variable] == licm->loop && licm->moved_counts[variable] != -1) {
+            if(code_licm_is_movable_definition(licm, loop, instruction, variable, block_id)) {
+                licm->moved_counts[variable]++;
+                candidates[candidates_count++] = instruction;
+            } else {
+                licm->moved_counts[variable] = -1;
+            }
+        }
+        instruction = instruction->next;
+    }
+
+    bool moved = false;
+    for(size_t i = 0; i < candidates_count; i++) {
+        const int variable = code_licm_variable_id(licm, code_dataflow_defined_variable(candidates[i]));
+        if(licm->moved_counts[variable] != licm->definitions_counts[variable])
+            continue;
+        code_licm_move_instruction(licm, block, candidates[i], preheader);
+        moved = true;
+    }
+
+    memory_free(candidates);
+    return moved;
+}
+
+static bool code_licm_move_loop(CodeLICM* licm, const unsigned int* order, size_t order_count) {
+    OrientedGraphLoop* loop = &licm->forest->loops[licm->loop];
+    CodeInstruction* preheader = code_licm_preheader(licm, loop);
+    if(preheader == NULL)
+        return false;
+
+    for(int id = set_int_first(loop->nodes); id != SET_INT_END; id = set_int_next(loop->nodes, id)) {
+        CodeBlock* block = (CodeBlock*) oriented_graph_node(licm->optimizer->code_graph, (unsigned int) id);
+        CodeInstruction* instruction = block->instructions;
+        for(size_t i = 0; i < block->instructions_count; i++) {
+            const int variable = code_licm_variable_id(licm, code_dataflow_defined_variable(instruction));
+            if(variable != -1)
+                code_licm_add_definition(licm, variable, id);
+            else if(instruction->type == I_CALL)
+                code_licm_add_call_definitions(licm, instruction->op0->data.label);
+            instruction = instruction->next;
+        }
+    }
+
+    // definition dominates its uses, so blocks of definitions of operands are processed before
+    bool moved = false;
+    for(size_t i = 0; i < order_count; i++) {
+        if(set_int_contains(loop->nodes, (int) order[i]))
+            moved |= code_licm_move_block(licm, loop, order[i], preheader);
+    }
+    return moved;
+}
+
+bool code_optimizer_loop_invariant_code_motion(CodeOptimizer* optimizer) {
+    NULL_POINTER_CHECK(optimizer, false);
+    NULL_POINTER_CHECK(optimizer->code_graph, false);
+    NULL_POINTER_CHECK(optimizer->code_loops, false);
+
+    OrientedGraph* graph = optimizer->code_graph;
+    CodeLICM licm;
+    licm.optimizer = optimizer;
+    licm.forest = optimizer->code_loops;
+    licm.csr = oriented_graph_freeze(graph);
+    if(licm.csr->nodes_count != licm.forest->nodes_count) {
+        LOG_WARNING("Loops of code graph are not analysed.");
+        return false;
+    }
+    if(licm.forest->loops_count == 0)
+        return false;
+
+    licm.live_variables = code_optimizer_live_variables(optimizer);
+    const size_t variables_count = licm.live_variables->variables_count;
+    licm.stamps = memory_alloc(sizeof(int) * (variables_count + 1));
+    licm.definitions_counts = memory_alloc(sizeof(int) * (variables_count + 1));
+    licm.definitions_blocks = memory_alloc(sizeof(int) * (variables_count + 1));
+    licm.moved_counts = memory_alloc(sizeof(int) * (variables_count + 1));
+    for(size_t i = 0; i < variables_count; i++)
+        licm.stamps[i] = -1;
+
+    licm.special_variables = set_int_init();
+    SymbolVariable* special_variables[] = {optimizer->temp1, optimizer->temp2, optimizer->temp3, optimizer->temp4,
+                                           optimizer->temp5, optimizer->temp6};
+    for(size_t i = 0; i < sizeof(special_variables) / sizeof(SymbolVariable*); i++) {
+        const int variable = code_licm_variable_id(&licm, special_variables[i]);
+        if(variable != -1)
+            set_int_add(licm.special_variables, variable);
+    }
+
+    // call graph of program
+    licm.calls_count = 0;
+    for(CodeInstruction* instruction = optimizer->generator->first;
+        instruction != NULL; instruction = instruction->next) {
+        if(instruction->type == I_CALL)
+            licm.calls_count++;
+    }
+    licm.callers = memory_alloc(sizeof(FunctionMetaData*) * (licm.calls_count + 1));
+    licm.callees = memory_alloc(sizeof(const char*) * (licm.calls_count + 1));
+    licm.calls_count = 0;
+    for(CodeInstruction* instruction = optimizer->generator->first;
+        instruction != NULL; instruction = instruction->next) {
+        if(instruction->type != I_CALL)
+            continue;
+        licm.callers[licm.calls_count] = instruction->meta_data.function;
+        licm.callees[licm.calls_count++] = instruction->op0->data.label;
+    }
+
+    unsigned int* order = memory_alloc(sizeof(unsigned int) * (graph->capacity + 1));
+    const size_t order_count = oriented_graph_reverse_postorder(graph, order);
+
+    // enclosing loops are processed first, so computations are moved out of all loops, where they are invariant
+    bool moved = false;
+    for(size_t i = 0; i < licm.forest->loops_count; i++) {
+        licm.loop = (int) i;
+        moved |= code_licm_move_loop(&licm, order, order_count);
+    }
+
+    memory_free(order);
+    memory_free(licm.callers);
+    memory_free(licm.callees);
+    set_int_free(&licm.special_variables);
+    memory_free(licm.stamps);
+    memory_free(licm.definitions_counts);
+    memory_free(licm.definitions_blocks);
+    memory_free(licm.moved_counts);
+    code_dataflow_free(&licm.live_variables);
+    return moved;
+}
@@ -0,0 +1,17 @@
+#ifndef CODE_OPTIMIZER_LICM_H
+#define CODE_OPTIMIZER_LICM_H
+
+#include "code_optimizer.h"
+
+/**
+ * @brief Loop invariant code motion, pure computations of variables from operands not modified in loop are moved
+ * before label of loop header, if header is entered from outside of loop only by falling through to it.
+ * All definitions of moved variable have to be in one block executed in every iteration and variable can not be read
+ * before them in loop or after loop, where its definitions are not executed. Calls modify global variables changed
+ * by called functions and all functions called by them. Graph has to be split with its loops analysed,
+ * it is not valid after motion.
+ * @return true if any instruction was moved
+ */
+bool code_optimizer_loop_invariant_code_motion(CodeOptimizer* optimizer);
+
+#endif // CODE_OPTIMIZER_LICM_H
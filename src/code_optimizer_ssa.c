@@ -0,0 +1,1006 @@
+#include "code_optimizer_ssa.h"
+#include "code_optimizer_dataflow.h"
+
+// state of sparse conditional constant propagation
+typedef struct {
+    const OrientedGraphCSR* csr;
+    bool* executable_edges;
+    // target blocks of edges indexed as predecessors in CSR
+    unsigned int* edges_targets;
+    unsigned int* edges_worklist;
+    size_t edges_worklist_count;
+    int* values_worklist;
+    size_t values_worklist_count;
+    // values depending on value, 2 * id of value or 2 * id of block ending by conditional jump + 1
+    size_t* users_offsets;
+    int* users;
+} CodeSSAPropagation;
+
+static int code_ssa_variable_id(CodeSSA* ssa, SymbolVariable* variable) {
+    if(variable == NULL || (variable->frame != VARIABLE_FRAME_LOCAL && variable->frame != VARIABLE_FRAME_GLOBAL))
+        return -1;
+
+    SymbolTableIntItem* item = (SymbolTableIntItem*) symbol_table_get(ssa->variables_ids,
+                                                                      variable_cached_identifier(variable));
+    return item == NULL ? -1 : item->value;
+}
+
+static void code_ssa_add_variable(CodeSSA* ssa, SymbolVariable* variable) {
+    if(variable == NULL || (variable->frame != VARIABLE_FRAME_LOCAL && variable->frame != VARIABLE_FRAME_GLOBAL) ||
+       code_ssa_variable_id(ssa, variable) != -1)
+        return;
+
+    SymbolTableIntItem* item = (SymbolTableIntItem*) symbol_table_get_or_create(
+            ssa->variables_ids, variable_cached_identifier(variable));
+    item->value = (int) ssa->variables_count++;
+    if(variable->frame == VARIABLE_FRAME_GLOBAL)
+        set_int_add(ssa->global_variables, item->value);
+}
+
+static bool code_ssa_is_expression(CodeInstruction* instruction) {
+    return instruction_class(instruction) == INSTRUCTION_TYPE_VAR_MODIFIERS && instruction->type != I_SET_CHAR;
+}
+
+// stack instruction evaluating same operation by interpreter or I__NONE
+static TypeInstruction code_ssa_folded_instruction(TypeInstruction type) {
+    switch(type) {
+        case I_ADD:
+            return I_ADD_STACK;
+        case I_SUB:
+            return I_SUB_STACK;
+        case I_MUL:
+            return I_MUL_STACK;
+        case I_LESSER_THEN:
+            return I_LESSER_THEN_STACK;
+        case I_GREATER_THEN:
+            return I_GREATER_THEN_STACK;
+        case I_EQUAL:
+            return I_EQUAL_STACK;
+        case I_AND:
+            return I_AND_STACK;
+        case I_OR:
+            return I_OR_STACK;
+        case I_NOT:
+            return I_NOT_STACK;
+        case I_INT_TO_FLOAT:
+            return I_INT_TO_FLOAT_STACK;
+        case I_FLOAT_TO_INT:
+            return I_FLOAT_TO_INT_STACK;
+        case I_FLOAT_ROUND_TO_EVEN_INT:
+            return I_FLOAT_ROUND_TO_EVEN_INT_STACK;
+        default:
+            return I__NONE;
+    }
+}
+
+static bool code_ssa_is_commutative(TypeInstruction type) {
+    return type == I_ADD || type == I_MUL || type == I_EQUAL || type == I_AND || type == I_OR;
+}
+
+// key of expression from numbers of read values and constants or NULL
+static char* code_ssa_render_expression(CodeSSA* ssa, CodeInstruction* instruction, size_t index) {
+    CodeInstructionOperand* operands[OPERANDS_MAX_COUNT] = {instruction->op0, instruction->op1, instruction->op2};
+    char* rendered_operands[OPERANDS_MAX_COUNT - 1] = {NULL, NULL};
+    size_t length = strlen(instruction->signature_buffer->identifier) + 3;
+
+    for(int k = 1; k < instruction->signature_buffer->operand_count; k++) {
+        if(operands[k]->type == TYPE_INSTRUCTION_OPERAND_VARIABLE) {
+            const int value = ssa->uses[3 * index + k];
+            if(value == -1)
+                break;
+            rendered_operands[k - 1] = memory_alloc(sizeof(char) * 16);
+            snprintf(rendered_operands[k - 1], 16, "%%%u", ssa->values[value].value_number);
+        } else {
+            rendered_operands[k - 1] = code_instruction_operand_render(operands[k]);
+        }
+        length += strlen(rendered_operands[k - 1]);
+    }
+
+    char* rendered = NULL;
+    const int count = instruction->signature_buffer->operand_count - 1;
+    if((count < 1 || rendered_operands[0] != NULL) && (count < 2 || rendered_operands[1] != NULL)) {
+        if(count == 2 && code_ssa_is_commutative(instruction->type) &&
+           strcmp(rendered_operands[0], rendered_operands[1]) > 0) {
+            char* swapped = rendered_operands[0];
+            rendered_operands[0] = rendered_operands[1];
+            rendered_operands[1] = swapped;
+        }
+        rendered = memory_alloc(sizeof(char) * length);
+        snprintf(rendered, length, "%s %s %s", instruction->signature_buffer->identifier,
+                 rendered_operands[0] == NULL ? "" : rendered_operands[0],
+                 rendered_operands[1] == NULL ? "" : rendered_operands[1]);
+    }
+
+    for(int k = 0; k < OPERANDS_MAX_COUNT - 1; k++) {
+        if(rendered_operands[k] != NULL)
+            memory_free(rendered_operands[k]);
+    }
+    return rendered;
+}
+
+static int code_ssa_new_value(CodeSSA* ssa, CodeSSAValueType type, unsigned int variable, unsigned int block) {
+    const int id = (int) ssa->values_count++;
+    CodeSSAValue* value = &ssa->values[id];
+    value->type = type;
+    value->variable = variable;
+    value->block = block;
+    value->instruction = NULL;
+    value->position = 0;
+    value->operands_offset = 0;
+    value->shadowed = -1;
+    value->value_number = (unsigned int) id;
+    value->lattice = CODE_SSA_LATTICE_UNDEFINED;
+    value->constant = NULL;
+    return id;
+}
+
+// state of renaming by walk of dominator tree
+typedef struct {
+    int* current_values;
+    int* pushed_values;
+    size_t pushed_values_count;
+    // expressions computed on path from root of dominator tree mapped to values
+    SymbolTable* expressions;
+    char** pushed_expressions;
+    size_t pushed_expressions_count;
+} CodeSSARenaming;
+
+static void code_ssa_push_value(CodeSSA* ssa, CodeSSARenaming* renaming, int value) {
+    const unsigned int variable = ssa->values[value].variable;
+    ssa->values[value].shadowed = renaming->current_values[variable];
+    renaming->current_values[variable] = value;
+    renaming->pushed_values[renaming->pushed_values_count++] = value;
+}
+
+// numbers value defined by instruction, dominating computation of same expression makes it redundant
+static void code_ssa_number_value(CodeSSA* ssa, CodeSSARenaming* renaming, int value_id, size_t index) {
+    CodeSSAValue* value = &ssa->values[value_id];
+    CodeInstruction* instruction = value->instruction;
+
+    if(instruction->type == I_MOVE) {
+        const int source = ssa->uses[3 * index + 1];
+        if(source != -1)
+            value->value_number = ssa->values[source].value_number;
+        return;
+    }
+    if(!code_ssa_is_expression(instruction))
+        return;
+
+    char* expression = code_ssa_render_expression(ssa, instruction, index);
+    if(expression == NULL)
+        return;
+
+    SymbolTableIntItem* item = (SymbolTableIntItem*) symbol_table_get(renaming->expressions, expression);
+    if(item == NULL) {
+        item = (SymbolTableIntItem*) symbol_table_get_or_create(renaming->expressions, expression);
+        item->value = value_id;
+        renaming->pushed_expressions[renaming->pushed_expressions_count++] = expression;
+        return;
+    }
+    memory_free(expression);
+
+    const int available_value = item->value;
+    const unsigned int variable = ssa->values[available_value].variable;
+    value->value_number = ssa->values[available_value].value_number;
+    if(renaming->current_values[variable] == available_value && variable != value->variable &&
+       !set_int_contains(ssa->special_variables, (int) variable) &&
+       !set_int_contains(ssa->special_variables, (int) value->variable)) {
+        CodeSSARedundancy* redundancy = &ssa->redundancies[ssa->redundancies_count++];
+        redundancy->instruction = instruction;
+        redundancy->block = value->block;
+        redundancy->value = value_id;
+        redundancy->available_value = available_value;
+    }
+}
+
+static void code_ssa_enter_block(CodeSSA* ssa, CodeSSARenaming* renaming, unsigned int block_id) {
+    CodeBlock* block = (CodeBlock*) oriented_graph_node(ssa->optimizer->code_graph, block_id);
+
+    for(size_t i = ssa->phis_offsets[block_id]; i < ssa->phis_offsets[block_id + 1]; i++)
+        code_ssa_push_value(ssa, renaming, (int) i);
+
+    CodeInstruction* instruction = block->instructions;
+    for(size_t j = 0; j < block->instructions_count; j++) {
+        const size_t index = ssa->instructions_offsets[block_id] + j;
+        for(int k = 0; k < OPERANDS_MAX_COUNT; k++) {
+            const int variable = code_ssa_variable_id(ssa, code_dataflow_used_variable(instruction, k));
+            if(variable != -1)
+                ssa->uses[3 * index + k] = renaming->current_values[variable];
+        }
+
+        const int variable = code_ssa_variable_id(ssa, code_dataflow_defined_variable(instruction));
+        if(variable != -1) {
+            const int value = code_ssa_new_value(ssa, CODE_SSA_VALUE_DEFINITION, (unsigned int) variable, block_id);
+            ssa->values[value].instruction = instruction;
+            ssa->values[value].position = j;
+            ssa->definitions[index] = value;
+            code_ssa_number_value(ssa, renaming, value, index);
+            code_ssa_push_value(ssa, renaming, value);
+        } else if(instruction->type == I_CALL) {
+            for(int global = set_int_first(ssa->global_variables);
+                global != SET_INT_END; global = set_int_next(ssa->global_variables, global)) {
+                const int value = code_ssa_new_value(ssa, CODE_SSA_VALUE_CALL, (unsigned int) global, block_id);
+                ssa->values[value].instruction = instruction;
+                ssa->values[value].position = j;
+                code_ssa_push_value(ssa, renaming, value);
+            }
+        }
+        instruction = instruction->next;
+    }
+
+    // operands of phis in successors for edge from block
+    const OrientedGraphCSR* csr = oriented_graph_freeze(ssa->optimizer->code_graph);
+    for(unsigned int i = csr->successors_offsets[block_id]; i < csr->successors_offsets[block_id + 1]; i++) {
+        const unsigned int successor = csr->successors[i];
+        unsigned int predecessor = 0;
+        while(csr->predecessors[csr->predecessors_offsets[successor] + predecessor] != block_id)
+            predecessor++;
+
+        for(size_t j = ssa->phis_offsets[successor]; j < ssa->phis_offsets[successor + 1]; j++)
+            ssa->phis_operands[ssa->values[j].operands_offset + predecessor] =
+                    renaming->current_values[ssa->values[j].variable];
+    }
+}
+
+static void code_ssa_exit_block(CodeSSA* ssa, CodeSSARenaming* renaming, size_t pushed_values_count,
+                                size_t pushed_expressions_count) {
+    while(renaming->pushed_values_count > pushed_values_count) {
+        const int value = renaming->pushed_values[--renaming->pushed_values_count];
+        renaming->current_values[ssa->values[value].variable] = ssa->values[value].shadowed;
+    }
+    while(renaming->pushed_expressions_count > pushed_expressions_count) {
+        char* expression = renaming->pushed_expressions[--renaming->pushed_expressions_count];
+        symbol_table_remove(renaming->expressions, expression);
+        memory_free(expression);
+    }
+}
+
+// values are numbered and operands of instructions and phis are bound to reaching values
+static void code_ssa_rename(CodeSSA* ssa, size_t definitions_count, size_t values_capacity) {
+    OrientedGraphLoopForest* forest = ssa->optimizer->code_loops;
+    const size_t blocks_count = ssa->blocks_count;
+
+    // children in dominator tree
+    unsigned int* children_offsets = memory_alloc(sizeof(unsigned int) * (blocks_count + 2));
+    unsigned int* children = memory_alloc(sizeof(unsigned int) * (blocks_count + 1));
+    memset(children_offsets, 0, sizeof(unsigned int) * (blocks_count + 2));
+    for(size_t i = 0; i < blocks_count; i++) {
+        if(forest->immediate_dominators[i] != -1)
+            children_offsets[forest->immediate_dominators[i] + 2]++;
+    }
+    for(size_t i = 2; i < blocks_count + 2; i++)
+        children_offsets[i] += children_offsets[i - 1];
+    for(unsigned int i = 0; i < blocks_count; i++) {
+        if(forest->immediate_dominators[i] != -1)
+            children[children_offsets[forest->immediate_dominators[i] + 1]++] = i;
+    }
+
+    CodeSSARenaming renaming;
+    renaming.current_values = memory_alloc(sizeof(int) * (ssa->variables_count + 1));
+    for(size_t i = 0; i < ssa->variables_count; i++)
+        renaming.current_values[i] = (int) i;
+    renaming.pushed_values = memory_alloc(sizeof(int) * (values_capacity + 1));
+    renaming.pushed_values_count = 0;
+    renaming.expressions = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(SymbolTableIntItem), NULL, NULL);
+    renaming.pushed_expressions = memory_alloc(sizeof(char*) * (definitions_count + 1));
+    renaming.pushed_expressions_count = 0;
+
+    // walk of dominator tree, block is pushed to be entered as 2 * id and to be exited as 2 * id + 1
+    size_t* pushed_values_marks = memory_alloc(sizeof(size_t) * (blocks_count + 1));
+    size_t* pushed_expressions_marks = memory_alloc(sizeof(size_t) * (blocks_count + 1));
+    unsigned int* stack = memory_alloc(sizeof(unsigned int) * (2 * blocks_count + 1));
+    size_t stack_count = 0;
+
+    for(unsigned int root = 0; root < blocks_count; root++) {
+        if(forest->immediate_dominators[root] != -1 || oriented_graph_node(ssa->optimizer->code_graph, root) == NULL)
+            continue;
+
+        stack[stack_count++] = 2 * root;
+        while(stack_count > 0) {
+            const unsigned int item = stack[--stack_count];
+            const unsigned int block_id = item / 2;
+
+            if(item % 2 == 1) {
+                code_ssa_exit_block(ssa, &renaming, pushed_values_marks[block_id],
+                                    pushed_expressions_marks[block_id]);
+                continue;
+            }
+
+            pushed_values_marks[block_id] = renaming.pushed_values_count;
+            pushed_expressions_marks[block_id] = renaming.pushed_expressions_count;
+            code_ssa_enter_block(ssa, &renaming, block_id);
+
+            stack[stack_count++] = 2 * block_id + 1;
+            for(unsigned int i = children_offsets[block_id + 1]; i > children_offsets[block_id]; i--)
+                stack[stack_count++] = 2 * children[i - 1];
+        }
+    }
+
+    memory_free(stack);
+    memory_free(pushed_values_marks);
+    memory_free(pushed_expressions_marks);
+    memory_free(renaming.pushed_expressions);
+    symbol_table_free(renaming.expressions);
+    memory_free(renaming.pushed_values);
+    memory_free(renaming.current_values);
+    memory_free(children);
+    memory_free(children_offsets);
+}
+
+CodeSSA* code_optimizer_ssa_init(CodeOptimizer* optimizer) {
+    NULL_POINTER_CHECK(optimizer, NULL);
+    NULL_POINTER_CHECK(optimizer->code_graph, NULL);
+    NULL_POINTER_CHECK(optimizer->code_loops, NULL);
+
+    OrientedGraph* graph = optimizer->code_graph;
+    const OrientedGraphCSR* csr = oriented_graph_freeze(graph);
+    if(csr->nodes_count != optimizer->code_loops->nodes_count) {
+        LOG_WARNING("Loops of code graph are not analysed.");
+        return NULL;
+    }
+
+    CodeSSA* ssa = memory_alloc(sizeof(CodeSSA));
+    NULL_POINTER_CHECK(ssa, NULL);
+    ssa->optimizer = optimizer;
+    ssa->variables_ids = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(SymbolTableIntItem), NULL, NULL);
+    ssa->variables_count = 0;
+    ssa->global_variables = set_int_init();
+    ssa->special_variables = set_int_init();
+    ssa->blocks_count = csr->nodes_count;
+    ssa->executable_blocks = NULL;
+    ssa->redundancies_count = 0;
+
+    // map variables and count instructions, definitions and calls
+    const size_t blocks_count = ssa->blocks_count;
+    ssa->instructions_offsets = memory_alloc(sizeof(size_t) * (blocks_count + 1));
+    size_t instructions_count = 0;
+    size_t definitions_count = 0;
+    size_t calls_count = 0;
+    for(unsigned int i = 0; i < blocks_count; i++) {
+        ssa->instructions_offsets[i] = instructions_count;
+        CodeBlock* block = (CodeBlock*) oriented_graph_node(graph, i);
+        CodeInstruction* instruction = block == NULL ? NULL : block->instructions;
+
+        for(size_t j = 0; block != NULL && j < block->instructions_count; j++) {
+            CodeInstructionOperand* operands[OPERANDS_MAX_COUNT] = {instruction->op0, instruction->op1,
+                                                                    instruction->op2};
+            for(int k = 0; k < instruction->signature_buffer->operand_count; k++) {
+                if(operands[k] != NULL && operands[k]->type == TYPE_INSTRUCTION_OPERAND_VARIABLE)
+                    code_ssa_add_variable(ssa, operands[k]->data.variable);
+            }
+            if(code_ssa_variable_id(ssa, code_dataflow_defined_variable(instruction)) != -1)
+                definitions_count++;
+            else if(instruction->type == I_CALL)
+                calls_count++;
+
+            instruction = instruction->next;
+        }
+        instructions_count += block == NULL ? 0 : block->instructions_count;
+    }
+    ssa->instructions_offsets[blocks_count] = instructions_count;
+
+    SymbolVariable* special_variables[] = {optimizer->temp1, optimizer->temp2, optimizer->temp3, optimizer->temp4,
+                                           optimizer->temp5, optimizer->temp6};
+    for(size_t i = 0; i < sizeof(special_variables) / sizeof(SymbolVariable*); i++) {
+        const int variable = code_ssa_variable_id(ssa, special_variables[i]);
+        if(variable != -1)
+            set_int_add(ssa->special_variables, variable);
+    }
+
+    // variables read before their definition in some block, their definitions and calls by blocks
+    const size_t variables_count = ssa->variables_count;
+    int* defining_blocks = memory_alloc(sizeof(int) * (variables_count + 1));
+    SetInt** definitions_blocks = memory_alloc(sizeof(SetInt*) * (variables_count + 1));
+    for(size_t i = 0; i < variables_count; i++) {
+        defining_blocks[i] = -1;
+        definitions_blocks[i] = NULL;
+    }
+    SetInt* non_local_variables = set_int_init();
+    SetInt* calls_blocks = set_int_init();
+
+    for(unsigned int i = 0; i < blocks_count; i++) {
+        CodeBlock* block = (CodeBlock*) oriented_graph_node(graph, i);
+        CodeInstruction* instruction = block == NULL ? NULL : block->instructions;
+
+        for(size_t j = 0; block != NULL && j < block->instructions_count; j++) {
+            for(int k = 0; k < OPERANDS_MAX_COUNT; k++) {
+                const int variable = code_ssa_variable_id(ssa, code_dataflow_used_variable(instruction, k));
+                if(variable != -1 && defining_blocks[variable] != (int) i)
+                    set_int_add(non_local_variables, variable);
+            }
+
+            const int variable = code_ssa_variable_id(ssa, code_dataflow_defined_variable(instruction));
+            if(variable != -1) {
+                defining_blocks[variable] = (int) i;
+                if(definitions_blocks[variable] == NULL)
+                    definitions_blocks[variable] = set_int_init();
+                set_int_add(definitions_blocks[variable], (int) i);
+            } else if(instruction->type == I_CALL) {
+                set_int_add(calls_blocks, (int) i);
+                for(int global = set_int_first(ssa->global_variables);
+                    global != SET_INT_END; global = set_int_next(ssa->global_variables, global))
+                    defining_blocks[global] = (int) i;
+            }
+            instruction = instruction->next;
+        }
+    }
+
+    // phis on iterated dominance frontiers of definitions
+    SetInt** frontiers = memory_alloc(sizeof(SetInt*) * (blocks_count + 1));
+    SetInt** blocks_phis = memory_alloc(sizeof(SetInt*) * (blocks_count + 1));
+    int* placed_phis = memory_alloc(sizeof(int) * (blocks_count + 1));
+    int* queued_blocks = memory_alloc(sizeof(int) * (blocks_count + 1));
+    unsigned int* worklist = memory_alloc(sizeof(unsigned int) * (blocks_count + 1));
+    for(size_t i = 0; i < blocks_count; i++) {
+        frontiers[i] = set_int_init();
+        blocks_phis[i] = NULL;
+        placed_phis[i] = -1;
+        queued_blocks[i] = -1;
+    }
+    oriented_graph_loop_forest_dominance_frontiers(optimizer->code_loops, graph, frontiers);
+
+    size_t phis_count = 0;
+    for(int variable = set_int_first(non_local_variables);
+        variable != SET_INT_END; variable = set_int_next(non_local_variables, variable)) {
+        size_t worklist_count = 0;
+        SetInt* sources[] = {definitions_blocks[variable],
+                             set_int_contains(ssa->global_variables, variable) ? calls_blocks : NULL};
+        for(int i = 0; i < 2; i++) {
+            for(int id = sources[i] == NULL ? SET_INT_END : set_int_first(sources[i]);
+                id != SET_INT_END; id = set_int_next(sources[i], id)) {
+                if(queued_blocks[id] != variable) {
+                    queued_blocks[id] = variable;
+                    worklist[worklist_count++] = (unsigned int) id;
+                }
+            }
+        }
+
+        while(worklist_count > 0) {
+            SetInt* frontier = frontiers[worklist[--worklist_count]];
+            for(int id = set_int_first(frontier); id != SET_INT_END; id = set_int_next(frontier, id)) {
+                if(placed_phis[id] == variable)
+                    continue;
+                placed_phis[id] = variable;
+                if(blocks_phis[id] == NULL)
+                    blocks_phis[id] = set_int_init();
+                set_int_add(blocks_phis[id], variable);
+                phis_count++;
+
+                if(queued_blocks[id] != variable) {
+                    queued_blocks[id] = variable;
+                    worklist[worklist_count++] = (unsigned int) id;
+                }
+            }
+        }
+    }
+
+    // values of entries, phis of blocks and definitions
+    const size_t values_capacity = variables_count + phis_count + definitions_count +
+                                   calls_count * set_int_size(ssa->global_variables);
+    ssa->values = memory_alloc(sizeof(CodeSSAValue) * (values_capacity + 1));
+    ssa->values_count = 0;
+    for(size_t i = 0; i < variables_count; i++)
+        code_ssa_new_value(ssa, CODE_SSA_VALUE_ENTRY, (unsigned int) i, 0);
+
+    size_t phis_operands_count = 0;
+    for(size_t i = 0; i < blocks_count; i++) {
+        if(blocks_phis[i] != NULL)
+            phis_operands_count += set_int_size(blocks_phis[i]) *
+                                   (csr->predecessors_offsets[i + 1] - csr->predecessors_offsets[i]);
+    }
+    ssa->phis_operands = memory_alloc(sizeof(int) * (phis_operands_count + 1));
+    for(size_t i = 0; i < phis_operands_count; i++)
+        ssa->phis_operands[i] = -1;
+
+    ssa->phis_offsets = memory_alloc(sizeof(size_t) * (blocks_count + 1));
+    phis_operands_count = 0;
+    for(unsigned int i = 0; i < blocks_count; i++) {
+        ssa->phis_offsets[i] = ssa->values_count;
+        for(int variable = blocks_phis[i] == NULL ? SET_INT_END : set_int_first(blocks_phis[i]);
+            variable != SET_INT_END; variable = set_int_next(blocks_phis[i], variable)) {
+            const int value = code_ssa_new_value(ssa, CODE_SSA_VALUE_PHI, (unsigned int) variable, i);
+            ssa->values[value].operands_offset = phis_operands_count;
+            phis_operands_count += csr->predecessors_offsets[i + 1] - csr->predecessors_offsets[i];
+        }
+    }
+    ssa->phis_offsets[blocks_count] = ssa->values_count;
+
+    ssa->uses = memory_alloc(sizeof(int) * (3 * instructions_count + 1));
+    ssa->definitions = memory_alloc(sizeof(int) * (instructions_count + 1));
+    for(size_t i = 0; i < instructions_count; i++) {
+        ssa->uses[3 * i] = ssa->uses[3 * i + 1] = ssa->uses[3 * i + 2] = -1;
+        ssa->definitions[i] = -1;
+    }
+    ssa->redundancies = memory_alloc(sizeof(CodeSSARedundancy) * (definitions_count + 1));
+    code_ssa_rename(ssa, definitions_count, values_capacity);
+
+    for(size_t i = 0; i < blocks_count; i++) {
+        set_int_free(&frontiers[i]);
+        if(blocks_phis[i] != NULL)
+            set_int_free(&blocks_phis[i]);
+    }
+    for(size_t i = 0; i < variables_count; i++) {
+        if(definitions_blocks[i] != NULL)
+            set_int_free(&definitions_blocks[i]);
+    }
+    memory_free(frontiers);
+    memory_free(blocks_phis);
+    memory_free(placed_phis);
+    memory_free(queued_blocks);
+    memory_free(worklist);
+    memory_free(definitions_blocks);
+    memory_free(defining_blocks);
+    set_int_free(&non_local_variables);
+    set_int_free(&calls_blocks);
+    return ssa;
+}
+
+void code_ssa_free(CodeSSA** ssa) {
+    NULL_POINTER_CHECK(ssa,);
+    NULL_POINTER_CHECK(*ssa,);
+
+    CodeSSA* v = *ssa;
+    for(size_t i = 0; i < v->values_count; i++) {
+        if(v->values[i].constant != NULL)
+            code_instruction_operand_free(&v->values[i].constant);
+    }
+    memory_free(v->values);
+    memory_free(v->phis_offsets);
+    memory_free(v->phis_operands);
+    memory_free(v->instructions_offsets);
+    memory_free(v->uses);
+    memory_free(v->definitions);
+    memory_free(v->redundancies);
+    if(v->executable_blocks != NULL)
+        memory_free(v->executable_blocks);
+    symbol_table_free(v->variables_ids);
+    set_int_free(&v->global_variables);
+    set_int_free(&v->special_variables);
+    memory_free(v);
+    *ssa = NULL;
+}
+
+int code_ssa_used_value(CodeSSA* ssa, unsigned int block_id, size_t position, int operand) {
+    NULL_POINTER_CHECK(ssa, -1);
+
+    if(block_id >= ssa->blocks_count || operand < 0 || operand >= OPERANDS_MAX_COUNT ||
+       ssa->instructions_offsets[block_id] + position >= ssa->instructions_offsets[block_id + 1])
+        return -1;
+    return ssa->uses[3 * (ssa->instructions_offsets[block_id] + position) + operand];
+}
+
+int code_ssa_defined_value(CodeSSA* ssa, unsigned int block_id, size_t position) {
+    NULL_POINTER_CHECK(ssa, -1);
+
+    if(block_id >= ssa->blocks_count ||
+       ssa->instructions_offsets[block_id] + position >= ssa->instructions_offsets[block_id + 1])
+        return -1;
+    return ssa->definitions[ssa->instructions_offsets[block_id] + position];
+}
+
+// lattice of value only descends, changed value is queued for its users
+static void code_ssa_set_lattice(CodeSSA* ssa, CodeSSAPropagation* propagation, int value_id,
+                                 CodeSSALattice lattice, CodeInstructionOperand* constant) {
+    CodeSSAValue* value = &ssa->values[value_id];
+    if(lattice == CODE_SSA_LATTICE_CONSTANT && value->lattice == CODE_SSA_LATTICE_CONSTANT &&
+       !code_instruction_operand_cmp(value->constant, constant))
+        lattice = CODE_SSA_LATTICE_VARYING;
+    if(lattice <= value->lattice)
+        return;
+
+    if(value->constant != NULL)
+        code_instruction_operand_free(&value->constant);
+    value->lattice = lattice;
+    if(lattice == CODE_SSA_LATTICE_CONSTANT)
+        value->constant = code_instruction_operand_copy(constant);
+    propagation->values_worklist[propagation->values_worklist_count++] = value_id;
+}
+
+// lattice of read operand, constant operand is constant
+static CodeSSALattice code_ssa_operand_lattice(CodeSSA* ssa, CodeInstruction* instruction, size_t index,
+                                               int operand, CodeInstructionOperand** constant) {
+    CodeInstructionOperand* operands[OPERANDS_MAX_COUNT] = {instruction->op0, instruction->op1, instruction->op2};
+    if(operands[operand]->type == TYPE_INSTRUCTION_OPERAND_CONSTANT) {
+        *constant = operands[operand];
+        return CODE_SSA_LATTICE_CONSTANT;
+    }
+
+    const int value = ssa->uses[3 * index + operand];
+    if(value == -1)
+        return CODE_SSA_LATTICE_VARYING;
+    *constant = ssa->values[value].constant;
+    return ssa->values[value].lattice;
+}
+
+// evaluates operation on constants by interpreter, operands have to be supported by it
+static CodeInstructionOperand* code_ssa_fold(CodeSSA* ssa, TypeInstruction type, CodeInstructionOperand** constants,
+                                             int count) {
+    const DataType data_type = constants[0]->data.constant.data_type;
+    if(count == 2 && constants[1]->data.constant.data_type != data_type)
+        return NULL;
+
+    bool supported;
+    switch(type) {
+        case I_ADD_STACK:
+        case I_SUB_STACK:
+        case I_MUL_STACK:
+        case I_LESSER_THEN_STACK:
+        case I_GREATER_THEN_STACK:
+        case I_EQUAL_STACK:
+            supported = data_type == DATA_TYPE_INTEGER || data_type == DATA_TYPE_DOUBLE;
+            break;
+        case I_AND_STACK:
+        case I_OR_STACK:
+        case I_NOT_STACK:
+            supported = data_type == DATA_TYPE_BOOLEAN;
+            break;
+        case I_INT_TO_FLOAT_STACK:
+            supported = data_type == DATA_TYPE_INTEGER;
+            break;
+        default:
+            supported = data_type == DATA_TYPE_DOUBLE;
+            break;
+    }
+    if(!supported)
+        return NULL;
+
+    CodeInstruction instructions[OPERANDS_MAX_COUNT];
+    memset(instructions, 0, sizeof(instructions));
+    for(int i = 0; i < count; i++) {
+        instructions[i].type = I_PUSH_STACK;
+        instructions[i].op0 = constants[i];
+        instructions[i].next = &instructions[i + 1];
+    }
+    instructions[count].type = type;
+    return interpreter_evaluate_instruction_block(ssa->optimizer->interpreter, &instructions[0],
+                                                  &instructions[count]);
+}
+
+static void code_ssa_evaluate_definition(CodeSSA* ssa, CodeSSAPropagation* propagation, int value_id) {
+    CodeSSAValue* value = &ssa->values[value_id];
+    CodeInstruction* instruction = value->instruction;
+    const size_t index = ssa->instructions_offsets[value->block] + value->position;
+    CodeInstructionOperand* constants[OPERANDS_MAX_COUNT - 1] = {NULL, NULL};
+
+    if(instruction->type == I_MOVE) {
+        const CodeSSALattice lattice = code_ssa_operand_lattice(ssa, instruction, index, 1, &constants[0]);
+        code_ssa_set_lattice(ssa, propagation, value_id, lattice, constants[0]);
+        return;
+    }
+
+    const TypeInstruction folded_instruction = code_ssa_folded_instruction(instruction->type);
+    if(folded_instruction == I__NONE) {
+        code_ssa_set_lattice(ssa, propagation, value_id, CODE_SSA_LATTICE_VARYING, NULL);
+        return;
+    }
+
+    bool undefined = false;
+    const int count = instruction->signature_buffer->operand_count - 1;
+    for(int k = 0; k < count; k++) {
+        const CodeSSALattice lattice = code_ssa_operand_lattice(ssa, instruction, index, k + 1, &constants[k]);
+        if(lattice == CODE_SSA_LATTICE_VARYING) {
+            code_ssa_set_lattice(ssa, propagation, value_id, CODE_SSA_LATTICE_VARYING, NULL);
+            return;
+        }
+        undefined |= lattice == CODE_SSA_LATTICE_UNDEFINED;
+    }
+    if(undefined)
+        return;
+
+    CodeInstructionOperand* folded = code_ssa_fold(ssa, folded_instruction, constants, count);
+    if(folded == NULL) {
+        code_ssa_set_lattice(ssa, propagation, value_id, CODE_SSA_LATTICE_VARYING, NULL);
+        return;
+    }
+    code_ssa_set_lattice(ssa, propagation, value_id, CODE_SSA_LATTICE_CONSTANT, folded);
+    code_instruction_operand_free(&folded);
+}
+
+// meet of operands on executable edges
+static void code_ssa_evaluate_phi(CodeSSA* ssa, CodeSSAPropagation* propagation, int value_id) {
+    CodeSSAValue* value = &ssa->values[value_id];
+    const unsigned int edges_offset = propagation->csr->predecessors_offsets[value->block];
+    const unsigned int predecessors_count = propagation->csr->predecessors_offsets[value->block + 1] - edges_offset;
+
+    CodeSSALattice lattice = CODE_SSA_LATTICE_UNDEFINED;
+    CodeInstructionOperand* constant = NULL;
+    for(unsigned int i = 0; i < predecessors_count && lattice != CODE_SSA_LATTICE_VARYING; i++) {
+        if(!propagation->executable_edges[edges_offset + i])
+            continue;
+
+        const int operand = ssa->phis_operands[value->operands_offset + i];
+        if(operand == -1 || ssa->values[operand].lattice == CODE_SSA_LATTICE_VARYING) {
+            lattice = CODE_SSA_LATTICE_VARYING;
+        } else if(ssa->values[operand].lattice == CODE_SSA_LATTICE_CONSTANT) {
+            if(lattice == CODE_SSA_LATTICE_UNDEFINED) {
+                lattice = CODE_SSA_LATTICE_CONSTANT;
+                constant = ssa->values[operand].constant;
+            } else if(!code_instruction_operand_cmp(constant, ssa->values[operand].constant)) {
+                lattice = CODE_SSA_LATTICE_VARYING;
+            }
+        }
+    }
+    code_ssa_set_lattice(ssa, propagation, value_id, lattice, constant);
+}
+
+static void code_ssa_mark_edge(CodeSSAPropagation* propagation, unsigned int from, unsigned int to) {
+    const OrientedGraphCSR* csr = propagation->csr;
+    for(unsigned int i = csr->predecessors_offsets[to]; i < csr->predecessors_offsets[to + 1]; i++) {
+        if(csr->predecessors[i] != from || propagation->executable_edges[i])
+            continue;
+        propagation->executable_edges[i] = true;
+        propagation->edges_worklist[propagation->edges_worklist_count++] = i;
+    }
+}
+
+// successors of block, where control can flow under current lattice
+static void code_ssa_evaluate_jump(CodeSSA* ssa, CodeSSAPropagation* propagation, unsigned int block_id) {
+    const OrientedGraphCSR* csr = propagation->csr;
+    CodeBlock* block = (CodeBlock*) oriented_graph_node(ssa->optimizer->code_graph, block_id);
+    CodeInstruction* instruction = block->last_instruction;
+
+    if(instruction != NULL && block->instructions_count > 0 &&
+       (instruction->type == I_JUMP_IF_EQUAL || instruction->type == I_JUMP_IF_NOT_EQUAL)) {
+        const size_t index = ssa->instructions_offsets[block_id] + block->instructions_count - 1;
+        CodeInstructionOperand* constants[2] = {NULL, NULL};
+        const CodeSSALattice first = code_ssa_operand_lattice(ssa, instruction, index, 1, &constants[0]);
+        const CodeSSALattice second = code_ssa_operand_lattice(ssa, instruction, index, 2, &constants[1]);
+        if(first == CODE_SSA_LATTICE_UNDEFINED || second == CODE_SSA_LATTICE_UNDEFINED)
+            return;
+
+        LabelMetaData* label = code_optimizer_label_meta_data(ssa->optimizer, instruction->op0->data.label);
+        if(first == CODE_SSA_LATTICE_CONSTANT && second == CODE_SSA_LATTICE_CONSTANT && label != NULL &&
+           constants[0]->data.constant.data_type == constants[1]->data.constant.data_type) {
+            const bool jumps = code_instruction_operand_cmp(constants[0], constants[1]) ==
+                               (instruction->type == I_JUMP_IF_EQUAL);
+            for(unsigned int i = csr->successors_offsets[block_id]; i < csr->successors_offsets[block_id + 1]; i++) {
+                if((csr->successors[i] == label->code_block_id) == jumps)
+                    code_ssa_mark_edge(propagation, block_id, csr->successors[i]);
+            }
+            return;
+        }
+    }
+
+    for(unsigned int i = csr->successors_offsets[block_id]; i < csr->successors_offsets[block_id + 1]; i++)
+        code_ssa_mark_edge(propagation, block_id, csr->successors[i]);
+}
+
+static void code_ssa_visit_block(CodeSSA* ssa, CodeSSAPropagation* propagation, unsigned int block_id) {
+    ssa->executable_blocks[block_id] = true;
+
+    for(size_t i = ssa->phis_offsets[block_id]; i < ssa->phis_offsets[block_id + 1]; i++)
+        code_ssa_evaluate_phi(ssa, propagation, (int) i);
+    for(size_t i = ssa->instructions_offsets[block_id]; i < ssa->instructions_offsets[block_id + 1]; i++) {
+        if(ssa->definitions[i] != -1)
+            code_ssa_evaluate_definition(ssa, propagation, ssa->definitions[i]);
+    }
+    code_ssa_evaluate_jump(ssa, propagation, block_id);
+}
+
+static void code_ssa_add_user(CodeSSAPropagation* propagation, size_t* users_counts, int value, int user) {
+    if(value == -1)
+        return;
+    if(propagation->users == NULL)
+        users_counts[value]++;
+    else
+        propagation->users[users_counts[value]++] = user;
+}
+
+// users of values are counted by first pass and filled by second one
+static void code_ssa_collect_users(CodeSSA* ssa, CodeSSAPropagation* propagation, size_t* users_counts) {
+    for(unsigned int i = 0; i < ssa->blocks_count; i++) {
+        CodeBlock* block = (CodeBlock*) oriented_graph_node(ssa->optimizer->code_graph, i);
+        if(block == NULL)
+            continue;
+
+        for(size_t j = ssa->phis_offsets[i]; j < ssa->phis_offsets[i + 1]; j++) {
+            const unsigned int predecessors_count =
+                    propagation->csr->predecessors_offsets[i + 1] - propagation->csr->predecessors_offsets[i];
+            for(unsigned int k = 0; k < predecessors_count; k++)
+                code_ssa_add_user(propagation, users_counts, ssa->phis_operands[ssa->values[j].operands_offset + k],
+                                  2 * (int) j);
+        }
+
+        CodeInstruction* instruction = block->instructions;
+        for(size_t j = 0; j < block->instructions_count; j++) {
+            const size_t index = ssa->instructions_offsets[i] + j;
+            const bool is_jump = j + 1 == block->instructions_count &&
+                                 (instruction->type == I_JUMP_IF_EQUAL || instruction->type == I_JUMP_IF_NOT_EQUAL);
+            for(int k = 0; k < OPERANDS_MAX_COUNT; k++) {
+                if(ssa->definitions[index] != -1)
+                    code_ssa_add_user(propagation, users_counts, ssa->uses[3 * index + k],
+                                      2 * ssa->definitions[index]);
+                if(is_jump)
+                    code_ssa_add_user(propagation, users_counts, ssa->uses[3 * index + k], 2 * (int) i + 1);
+            }
+            instruction = instruction->next;
+        }
+    }
+}
+
+void code_ssa_propagate_constants(CodeSSA* ssa) {
+    NULL_POINTER_CHECK(ssa,);
+
+    CodeSSAPropagation propagation;
+    OrientedGraph* graph = ssa->optimizer->code_graph;
+    const OrientedGraphCSR* csr = oriented_graph_freeze(graph);
+    if(csr->nodes_count != ssa->blocks_count) {
+        LOG_WARNING("SSA form was built for different graph.");
+        return;
+    }
+    propagation.csr = csr;
+
+    const size_t blocks_count = ssa->blocks_count;
+    const unsigned int edges_count = csr->predecessors_offsets[blocks_count];
+    if(ssa->executable_blocks == NULL)
+        ssa->executable_blocks = memory_alloc(sizeof(bool) * (blocks_count + 1));
+    memset(ssa->executable_blocks, 0, sizeof(bool) * (blocks_count + 1));
+    propagation.executable_edges = memory_alloc(sizeof(bool) * (edges_count + 1));
+    memset(propagation.executable_edges, 0, sizeof(bool) * (edges_count + 1));
+    propagation.edges_targets = memory_alloc(sizeof(unsigned int) * (edges_count + 1));
+    for(unsigned int i = 0; i < blocks_count; i++) {
+        for(unsigned int j = csr->predecessors_offsets[i]; j < csr->predecessors_offsets[i + 1]; j++)
+            propagation.edges_targets[j] = i;
+    }
+    propagation.edges_worklist = memory_alloc(sizeof(unsigned int) * (edges_count + 1));
+    propagation.edges_worklist_count = 0;
+    // lattice of value descends at most twice
+    propagation.values_worklist = memory_alloc(sizeof(int) * (2 * ssa->values_count + 1));
+    propagation.values_worklist_count = 0;
+
+    size_t* users_counts = memory_alloc(sizeof(size_t) * (ssa->values_count + 1));
+    memset(users_counts, 0, sizeof(size_t) * (ssa->values_count + 1));
+    propagation.users = NULL;
+    code_ssa_collect_users(ssa, &propagation, users_counts);
+    propagation.users_offsets = memory_alloc(sizeof(size_t) * (ssa->values_count + 1));
+    propagation.users_offsets[0] = 0;
+    for(size_t i = 0; i < ssa->values_count; i++) {
+        propagation.users_offsets[i + 1] = propagation.users_offsets[i] + users_counts[i];
+        users_counts[i] = propagation.users_offsets[i];
+    }
+    propagation.users = memory_alloc(sizeof(int) * (propagation.users_offsets[ssa->values_count] + 1));
+    code_ssa_collect_users(ssa, &propagation, users_counts);
+    memory_free(users_counts);
+
+    // values coming from outside of graph or calls are unknown
+    for(size_t i = 0; i < ssa->values_count; i++) {
+        if(ssa->values[i].type == CODE_SSA_VALUE_ENTRY || ssa->values[i].type == CODE_SSA_VALUE_CALL)
+            ssa->values[i].lattice = CODE_SSA_LATTICE_VARYING;
+    }
+
+    for(unsigned int i = 0; i < blocks_count; i++) {
+        if(oriented_graph_node(graph, i) != NULL && ssa->optimizer->code_loops->immediate_dominators[i] == -1)
+            code_ssa_visit_block(ssa, &propagation, i);
+    }
+
+    while(propagation.edges_worklist_count > 0 || propagation.values_worklist_count > 0) {
+        while(propagation.edges_worklist_count > 0) {
+            const unsigned int target = propagation.edges_targets[
+                    propagation.edges_worklist[--propagation.edges_worklist_count]];
+            if(!ssa->executable_blocks[target]) {
+                code_ssa_visit_block(ssa, &propagation, target);
+                continue;
+            }
+            for(size_t i = ssa->phis_offsets[target]; i < ssa->phis_offsets[target + 1]; i++)
+                code_ssa_evaluate_phi(ssa, &propagation, (int) i);
+        }
+
+        while(propagation.values_worklist_count > 0) {
+            const int value = propagation.values_worklist[--propagation.values_worklist_count];
+            for(size_t i = propagation.users_offsets[value]; i < propagation.users_offsets[value + 1]; i++) {
+                const int user = propagation.users[i];
+                if(user % 2 == 1) {
+                    if(ssa->executable_blocks[user / 2])
+                        code_ssa_evaluate_jump(ssa, &propagation, (unsigned int) user / 2);
+                } else if(ssa->executable_blocks[ssa->values[user / 2].block]) {
+                    if(ssa->values[user / 2].type == CODE_SSA_VALUE_PHI)
+                        code_ssa_evaluate_phi(ssa, &propagation, user / 2);
+                    else
+                        code_ssa_evaluate_definition(ssa, &propagation, user / 2);
+                }
+            }
+        }
+    }
+
+    memory_free(propagation.executable_edges);
+    memory_free(propagation.edges_targets);
+    memory_free(propagation.edges_worklist);
+    memory_free(propagation.values_worklist);
+    memory_free(propagation.users_offsets);
+    memory_free(propagation.users);
+}
+
+static void code_ssa_replace_instruction(CodeSSA* ssa, CodeBlock* block, CodeInstruction* instruction,
+                                         CodeInstruction* replacement) {
+    replacement->meta_data.type = instruction->meta_data.type;
+    code_optimizer_insert_instruction_before(ssa->optimizer, replacement, instruction);
+    if(block->instructions == instruction)
+        block->instructions = replacement;
+    if(block->last_instruction == instruction)
+        block->last_instruction = replacement;
+    code_optimizer_remove_instruction(ssa->optimizer, instruction);
+}
+
+bool code_ssa_lower(CodeSSA* ssa) {
+    NULL_POINTER_CHECK(ssa, false);
+
+    bool rewritten = false;
+    OrientedGraph* graph = ssa->optimizer->code_graph;
+
+    // constants, read operands are replaced before instruction computing constant
+    for(unsigned int i = 0; ssa->executable_blocks != NULL && i < ssa->blocks_count; i++) {
+        CodeBlock* block = (CodeBlock*) oriented_graph_node(graph, i);
+        if(block == NULL || !ssa->executable_blocks[i])
+            continue;
+
+        CodeInstruction* instruction = block->instructions;
+        for(size_t j = 0; j < block->instructions_count; j++) {
+            CodeInstruction* next_instruction = instruction->next;
+            const size_t index = ssa->instructions_offsets[i] + j;
+            CodeInstructionOperand** operands[OPERANDS_MAX_COUNT] = {&instruction->op0, &instruction->op1,
+                                                                     &instruction->op2};
+            const TypeInstructionOperand operands_types[OPERANDS_MAX_COUNT] = {
+                    instruction->signature_buffer->type0,
+                    instruction->signature_buffer->type1,
+                    instruction->signature_buffer->type2
+            };
+
+            for(int k = 0; k < OPERANDS_MAX_COUNT; k++) {
+                const int value = ssa->uses[3 * index + k];
+                if(value == -1 || ssa->values[value].lattice != CODE_SSA_LATTICE_CONSTANT ||
+                   operands_types[k] != TYPE_INSTRUCTION_OPERAND_SYMBOL)
+                    continue;
+
+                rewritten = true;
+                code_optimizer_removing_instruction(ssa->optimizer, instruction);
+                code_instruction_operand_free(operands[k]);
+                *operands[k] = code_instruction_operand_copy(ssa->values[value].constant);
+                code_optimizer_adding_instruction(ssa->optimizer, instruction);
+            }
+
+            const int value = ssa->definitions[index];
+            if(value != -1 && ssa->values[value].lattice == CODE_SSA_LATTICE_CONSTANT &&
+               instruction->type != I_MOVE) {
+                rewritten = true;
+                CodeInstruction* move = code_generator_new_instruction(
+                        ssa->optimizer->generator, I_MOVE, code_instruction_operand_copy(instruction->op0),
+                        code_instruction_operand_copy(ssa->values[value].constant), NULL);
+                code_ssa_replace_instruction(ssa, block, instruction, move);
+                ssa->values[value].instruction = move;
+            }
+            instruction = next_instruction;
+        }
+    }
+
+    // later redundancies first, their available values are computed by instructions still in program
+    for(size_t i = ssa->redundancies_count; i > 0; i--) {
+        CodeSSARedundancy* redundancy = &ssa->redundancies[i - 1];
+        if((ssa->executable_blocks != NULL && !ssa->executable_blocks[redundancy->block]) ||
+           ssa->values[redundancy->value].lattice == CODE_SSA_LATTICE_CONSTANT ||
+           ssa->values[redundancy->available_value].lattice == CODE_SSA_LATTICE_CONSTANT)
+            continue;
+
+        rewritten = true;
+        CodeBlock* block = (CodeBlock*) oriented_graph_node(graph, redundancy->block);
+        CodeInstruction* move = code_generator_new_instruction(
+                ssa->optimizer->generator, I_MOVE, code_instruction_operand_copy(redundancy->instruction->op0),
+                code_instruction_operand_copy(ssa->values[redundancy->available_value].instruction->op0), NULL);
+        code_ssa_replace_instruction(ssa, block, redundancy->instruction, move);
+        ssa->values[redundancy->value].instruction = move;
+    }
+
+    return rewritten;
+}
+
+bool code_optimizer_ssa_optimization(CodeOptimizer* optimizer) {
+    NULL_POINTER_CHECK(optimizer, false);
+
+    CodeSSA* ssa = code_optimizer_ssa_init(optimizer);
+    if(ssa == NULL)
+        return false;
+
+    code_ssa_propagate_constants(ssa);
+    const bool rewritten = code_ssa_lower(ssa);
+    code_ssa_free(&ssa);
+    return rewritten;
+}
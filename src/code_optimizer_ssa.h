@@ -0,0 +1,118 @@
+#ifndef CODE_OPTIMIZER_SSA_H
+#define CODE_OPTIMIZER_SSA_H
+
+#include "code_optimizer.h"
+
+typedef enum {
+    // value of variable on start of entry of graph
+    CODE_SSA_VALUE_ENTRY,
+    // value set by instruction
+    CODE_SSA_VALUE_DEFINITION,
+    // value of global variable after call
+    CODE_SSA_VALUE_CALL,
+    CODE_SSA_VALUE_PHI
+} CodeSSAValueType;
+
+typedef enum {
+    CODE_SSA_LATTICE_UNDEFINED,
+    CODE_SSA_LATTICE_CONSTANT,
+    CODE_SSA_LATTICE_VARYING
+} CodeSSALattice;
+
+typedef struct {
+    CodeSSAValueType type;
+    unsigned int variable;
+    unsigned int block;
+    // defining instruction and its index in block
+    CodeInstruction* instruction;
+    size_t position;
+    // phi has operand for every predecessor of block in order of their ids
+    size_t operands_offset;
+    // value of same variable hidden by this one during renaming
+    int shadowed;
+    // values with same number are equal
+    unsigned int value_number;
+    CodeSSALattice lattice;
+    // owned constant of lattice
+    CodeInstructionOperand* constant;
+} CodeSSAValue;
+
+typedef struct {
+    CodeInstruction* instruction;
+    unsigned int block;
+    // value defined by instruction and dominating value computed by same expression
+    int value;
+    int available_value;
+} CodeSSARedundancy;
+
+/**
+ * @brief SSA form of code graph of optimizer kept beside instructions. Variables are not renamed, every definition
+ * creates value and every read operand refers to value reaching it, phi values are placed on iterated dominance
+ * frontiers of definitions of variables read across blocks. Temporary frame variables are not in SSA form,
+ * call defines all global variables.
+ */
+typedef struct code_ssa_t {
+    CodeOptimizer* optimizer;
+    SymbolTable* variables_ids;
+    size_t variables_count;
+    SetInt* global_variables;
+    // variables used by peep hole patterns, their values are never reused
+    SetInt* special_variables;
+
+    CodeSSAValue* values;
+    size_t values_count;
+    // phis of block are values from phis_offsets[id] to phis_offsets[id + 1]
+    size_t* phis_offsets;
+    int* phis_operands;
+    size_t blocks_count;
+    // first index of instructions of block, read values are indexed by 3 * index + operand position
+    size_t* instructions_offsets;
+    int* uses;
+    int* definitions;
+
+    // computations of values, which are held by other variable, found by dominator based value numbering
+    CodeSSARedundancy* redundancies;
+    size_t redundancies_count;
+
+    // filled by sparse conditional constant propagation
+    bool* executable_blocks;
+} CodeSSA;
+
+/**
+ * @brief Builds SSA form of code graph, graph has to be split with its loops analysed.
+ */
+CodeSSA* code_optimizer_ssa_init(CodeOptimizer* optimizer);
+
+void code_ssa_free(CodeSSA** ssa);
+
+/**
+ * @brief Value read by operand of instruction at position in block or -1.
+ */
+int code_ssa_used_value(CodeSSA* ssa, unsigned int block_id, size_t position, int operand);
+
+/**
+ * @brief Value defined by instruction at position in block or -1.
+ */
+int code_ssa_defined_value(CodeSSA* ssa, unsigned int block_id, size_t position);
+
+/**
+ * @brief Sparse conditional constant propagation (Wegman, Zadeck), values get lattice
+ * and blocks reachable under constant conditions are marked executable.
+ */
+void code_ssa_propagate_constants(CodeSSA* ssa);
+
+/**
+ * @brief Rewrites program by SSA form, reads of constant values in executable blocks are replaced by constants,
+ * computations of constants by moves and redundant computations by moves from variables holding their values.
+ * Versions of variable never overlap, so phis are lowered to no copies.
+ * @return true if anything was rewritten
+ */
+bool code_ssa_lower(CodeSSA* ssa);
+
+/**
+ * @brief Builds SSA form of code graph, propagates constants in it and lowers it back to program.
+ * @return true if anything was rewritten
+ */
+bool code_optimizer_ssa_optimization(CodeOptimizer* optimizer);
+
+#endif // CODE_OPTIMIZER_SSA_H
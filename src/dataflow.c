@@ -0,0 +1,148 @@
+#include "dataflow.h"
+
+static SetInt** dataflow_init_sets(size_t count) {
+    SetInt** sets = memory_alloc(sizeof(SetInt*) * (count + 1));
+    NULL_POINTER_CHECK(sets, NULL);
+
+    for(size_t i = 0; i < count; i++)
+        sets[i] = set_int_init();
+    return sets;
+}
+
+static void dataflow_free_sets(SetInt*** sets, size_t count) {
+    for(size_t i = 0; i < count; i++)
+        set_int_free(&(*sets)[i]);
+    memory_free(*sets);
+    *sets = NULL;
+}
+
+Dataflow* dataflow_init(OrientedGraph* graph, DataflowDirection direction, DataflowMeet meet, size_t universe_size) {
+    NULL_POINTER_CHECK(graph, NULL);
+
+    Dataflow* dataflow = memory_alloc(sizeof(Dataflow));
+    NULL_POINTER_CHECK(dataflow, NULL);
+
+    dataflow->direction = direction;
+    dataflow->meet = meet;
+    dataflow->nodes_count = graph->capacity;
+    dataflow->universe_size = universe_size;
+    dataflow->gen = dataflow_init_sets(dataflow->nodes_count);
+    dataflow->kill = dataflow_init_sets(dataflow->nodes_count);
+    dataflow->in = dataflow_init_sets(dataflow->nodes_count);
+    dataflow->out = dataflow_init_sets(dataflow->nodes_count);
+    dataflow->boundary = set_int_init();
+    dataflow->evaluations_count = 0;
+
+    return dataflow;
+}
+
+void dataflow_free(Dataflow** dataflow) {
+    NULL_POINTER_CHECK(dataflow,);
+    NULL_POINTER_CHECK(*dataflow,);
+
+    const size_t nodes_count = (*dataflow)->nodes_count;
+    dataflow_free_sets(&(*dataflow)->gen, nodes_count);
+    dataflow_free_sets(&(*dataflow)->kill, nodes_count);
+    dataflow_free_sets(&(*dataflow)->in, nodes_count);
+    dataflow_free_sets(&(*dataflow)->out, nodes_count);
+    set_int_free(&(*dataflow)->boundary);
+    memory_free(*dataflow);
+    *dataflow = NULL;
+}
+
+void dataflow_solve(Dataflow* dataflow, OrientedGraph* graph) {
+    NULL_POINTER_CHECK(dataflow,);
+    NULL_POINTER_CHECK(graph,);
+
+    const OrientedGraphCSR* csr = oriented_graph_freeze(graph);
+    if(csr->nodes_count != dataflow->nodes_count) {
+        LOG_WARNING("Dataflow problem was created for different graph.");
+        return;
+    }
+
+    // sides of nodes in direction of problem
+    const bool forward = dataflow->direction == DATAFLOW_DIRECTION_FORWARD;
+    SetInt** inputs = forward ? dataflow->in : dataflow->out;
+    SetInt** outputs = forward ? dataflow->out : dataflow->in;
+    const unsigned int* sources_offsets = forward ? csr->predecessors_offsets : csr->successors_offsets;
+    const unsigned int* sources = forward ? csr->predecessors : csr->successors;
+    const unsigned int* dependents_offsets = forward ? csr->successors_offsets : csr->predecessors_offsets;
+    const unsigned int* dependents = forward ? csr->successors : csr->predecessors;
+
+    unsigned int* order = memory_alloc(sizeof(unsigned int) * (csr->nodes_count + 1));
+    size_t* positions = memory_alloc(sizeof(size_t) * (csr->nodes_count + 1));
+    bool* pending = memory_alloc(sizeof(bool) * (csr->nodes_count + 1));
+    const size_t count = oriented_graph_reverse_postorder(graph, order);
+    // postorder for backward problem
+    for(size_t i = 0; !forward && i < count / 2; i++) {
+        const unsigned int swapped = order[i];
+        order[i] = order[count - 1 - i];
+        order[count - 1 - i] = swapped;
+    }
+
+    // optimistic start, all facts hold for intersection
+    SetInt* output = set_int_init();
+    for(size_t value = 0; dataflow->meet == DATAFLOW_MEET_INTERSECTION && value < dataflow->universe_size; value++)
+        set_int_add(output, (int) value);
+    for(size_t i = 0; i < count; i++) {
+        positions[order[i]] = i;
+        pending[i] = true;
+        set_int_clear(outputs[order[i]]);
+        set_int_union(outputs[order[i]], output);
+    }
+
+    bool next_pass = true;
+    dataflow->evaluations_count = 0;
+
+    while(next_pass) {
+        next_pass = false;
+        for(size_t i = 0; i < count; i++) {
+            if(!pending[i])
+                continue;
+            pending[i] = false;
+            const unsigned int id = order[i];
+
+            // meet of sources
+            SetInt* input = inputs[id];
+            set_int_clear(input);
+            if(sources_offsets[id] == sources_offsets[id + 1])
+                set_int_union(input, dataflow->boundary);
+            else
+                set_int_union(input, outputs[sources[sources_offsets[id]]]);
+
+            for(unsigned int j = sources_offsets[id] + 1; j < sources_offsets[id + 1]; j++) {
+                if(dataflow->meet == DATAFLOW_MEET_UNION)
+                    set_int_union(input, outputs[sources[j]]);
+                else
+                    set_int_intersection(input, outputs[sources[j]]);
+            }
+
+            // transfer function
+            set_int_clear(output);
+            set_int_union(output, input);
+            set_int_difference(output, dataflow->kill[id]);
+            set_int_union(output, dataflow->gen[id]);
+            dataflow->evaluations_count++;
+
+            if(set_int_size(output) == set_int_size(outputs[id]) && set_int_difference_is_empty(output, outputs[id]))
+                continue;
+
+            SetInt* previous_output = outputs[id];
+            outputs[id] = output;
+            output = previous_output;
+
+            for(unsigned int j = dependents_offsets[id]; j < dependents_offsets[id + 1]; j++) {
+                const size_t position = positions[dependents[j]];
+                pending[position] = true;
+                // already passed nodes are evaluated in next pass
+                if(position <= i)
+                    next_pass = true;
+            }
+        }
+    }
+
+    set_int_free(&output);
+    memory_free(order);
+    memory_free(positions);
+    memory_free(pending);
+}
@@ -0,0 +1,52 @@
+#ifndef DATAFLOW_H
+#define DATAFLOW_H
+
+#include "oriented_graph.h"
+#include "set_int.h"
+
+typedef enum {
+    DATAFLOW_DIRECTION_FORWARD,
+    DATAFLOW_DIRECTION_BACKWARD
+} DataflowDirection;
+
+typedef enum {
+    DATAFLOW_MEET_UNION,
+    DATAFLOW_MEET_INTERSECTION
+} DataflowMeet;
+
+/**
+ * @brief Bit vector dataflow problem over nodes of graph, facts are dense ids lower than universe size.
+ * Output of node is gen | (input - kill), input is meet of outputs of predecessors (forward problem)
+ * or successors (backward problem), for backward problem in is output and out is input of node.
+ */
+typedef struct dataflow_t {
+    DataflowDirection direction;
+    DataflowMeet meet;
+    size_t nodes_count;
+    size_t universe_size;
+    // filled before solving, indexed by ids of nodes
+    SetInt** gen;
+    SetInt** kill;
+    // value at nodes without predecessors (forward) or successors (backward)
+    SetInt* boundary;
+    // solution at start and end of nodes
+    SetInt** in;
+    SetInt** out;
+    // count of evaluated nodes in last solving
+    size_t evaluations_count;
+} Dataflow;
+
+/**
+ * @brief Creates problem with empty gen, kill and boundary sets for every node slot of graph.
+ */
+Dataflow* dataflow_init(OrientedGraph* graph, DataflowDirection direction, DataflowMeet meet, size_t universe_size);
+
+void dataflow_free(Dataflow** dataflow);
+
+/**
+ * @brief Solves problem by worklist processed in reverse postorder (forward) or postorder (backward),
+ * node is evaluated again only if its input has changed.
+ */
+void dataflow_solve(Dataflow* dataflow, OrientedGraph* graph);
+
+#endif // DATAFLOW_H
@@ -64,6 +64,18 @@ void string_append_s(String* string, const char* s) {
     string->size = new_size;
 }
 
+void string_append_n(String* string, const char* s, size_t n) {
+    NULL_POINTER_CHECK(string,);
+    NULL_POINTER_CHECK(s,);
+    size_t new_size = string->size + n;
+    string_update_capacity(string, new_size);
+    ASSERT(string->capacity >= new_size);
+    ASSERT(string->size >= 1);
+    memcpy(&string->content[string->size - 1], s, n);
+    string->content[new_size - 1] = 0;
+    string->size = new_size;
+}
+
 void string_append(String* string, const String* b) {
     NULL_POINTER_CHECK(string,);
     NULL_POINTER_CHECK(b,);
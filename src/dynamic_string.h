@@ -44,6 +44,15 @@ void string_append_c(String* string, char c);
 */
 void string_append_s(String* string, const char* s);
 
+/**
+* @brief Append first n chars of given chars to dynamic string
+*
+* @param String* string Dynamic string to which we need to append.
+* @param const char* s Chars to be appended, need not to be terminated.
+* @param size_t n Count of chars to be appended.
+*/
+void string_append_n(String* string, const char* s, size_t n);
+
 /**
 * @brief Append dynamic string to dynamic string
 *
@@ -2,17 +2,20 @@
 #include "ifj2017.h"
 #include "code_optimizer.h"
 #include "code_optimizer_expr.h"
-
-int stdin_stream() {
-    return getchar();
-}
+#include "code_optimizer_ssa.h"
+#include "code_optimizer_licm.h"
 
 int main(int argc, char** argv) {
-    UNUSED(argc);
-    UNUSED(argv);
-
     log_verbosity = LOG_VERBOSITY_WARNING;
-    Parser* parser = parser_init(stdin_stream);
+    // debug build tracks only allocation sites, per-block info would be too slow for bigger programs
+    memory_manager_enter_tracking(&memory_manager, MEMORY_MANAGER_TRACKING_SITES);
+    // lexer & parser allocations are bump-allocated, optimizer with heavy churn keeps separate pages
+    memory_manager_switch_arena(&memory_manager, MEMORY_MANAGER_ARENA_PARSER);
+    // source is mapped from file given as argument, otherwise stdin is read by blocks
+    LexerInput* input = argc > 1 ? lexer_input_init_path(argv[1]) : lexer_input_init_file(stdin);
+    if(input == NULL)
+        exit_with_code(ERROR_INTERNAL);
+    Parser* parser = parser_init_with_input(input);
 
     if(!parser_parse(parser)) {
         ErrorReport report = parser->error_report;
@@ -21,6 +24,7 @@ int main(int argc, char** argv) {
     }
 
     setbuf(stdout, NULL);
+    memory_manager_switch_arena(&memory_manager, MEMORY_MANAGER_ARENA_NONE);
 
     // optimized redundant type casts
     code_optimizer_optimize_type_casts(parser->optimizer);
@@ -29,19 +33,24 @@ int main(int argc, char** argv) {
 
     // first PH iterations (without advanced)
     while(
-            code_optimizer_peep_hole_optimization(parser->optimizer)
+            code_optimizer_peep_hole_optimization_worklist(parser->optimizer)
             );
+    // reclaim lazy freed blocks between passes
+    memory_manager_collect(&memory_manager);
 
     bool expr_interpreted;
     do {
         // propagating constants into code blocks
         expr_interpreted = false;
         code_optimizer_split_code_to_graph(parser->optimizer);
-        code_optimizer_update_meta_data(parser->optimizer);
         expr_interpreted |= code_optimizer_propagate_constants_optimization(parser->optimizer);
+        // constants through loops and joins of branches, redundant computations
+        expr_interpreted |= code_optimizer_ssa_optimization(parser->optimizer);
+        // propagated constants make expressions interpretable, their meta data has to be refreshed
         code_optimizer_update_meta_data(parser->optimizer);
         // partial eval constant expressions
         expr_interpreted |= code_optimizer_literal_expression_eval_optimization(parser->optimizer);
+        memory_manager_collect(&memory_manager);
     } while(expr_interpreted);
 
     // remove redundant instruction after constant propagation & expr eval
@@ -55,8 +64,9 @@ int main(int argc, char** argv) {
     // setup advanced PH patterns (with metaflags destruction)
     code_optimizer_add_advance_peep_hole_patterns(parser->optimizer);
     while(
-            code_optimizer_peep_hole_optimization(parser->optimizer)
+            code_optimizer_peep_hole_optimization_worklist(parser->optimizer)
             );
+    memory_manager_collect(&memory_manager);
 
     // gently remove all unused symbols (with temps keep)
     code_optimizer_remove_unused_variables(parser->optimizer, false, true);
@@ -64,38 +74,49 @@ int main(int argc, char** argv) {
     code_optimizer_optimize_partial_expression_eval(parser->optimizer);
     // hard core PH
     while(
-            code_optimizer_peep_hole_optimization(parser->optimizer)
+            code_optimizer_peep_hole_optimization_worklist(parser->optimizer)
             );
+    memory_manager_collect(&memory_manager);
 
 
-    code_optimizer_update_meta_data(parser->optimizer);
     code_optimizer_split_code_to_graph(parser->optimizer);
-    code_optimizer_update_meta_data(parser->optimizer);
     code_optimizer_propagate_constants_optimization(parser->optimizer);
+    code_optimizer_ssa_optimization(parser->optimizer);
     code_optimizer_optimize_jumps(parser->optimizer);
 
 
-    while(code_optimizer_peep_hole_optimization(parser->optimizer));
+    while(code_optimizer_peep_hole_optimization_worklist(parser->optimizer));
+    memory_manager_collect(&memory_manager);
     code_optimizer_optimize_comparisons(parser->optimizer);
 
 
-    code_optimizer_update_meta_data(parser->optimizer);
     code_optimizer_split_code_to_graph(parser->optimizer);
-    code_optimizer_update_meta_data(parser->optimizer);
     code_optimizer_propagate_constants_optimization(parser->optimizer);
+    code_optimizer_ssa_optimization(parser->optimizer);
     code_optimizer_optimize_jumps(parser->optimizer);
 
-    while(code_optimizer_peep_hole_optimization(parser->optimizer));
+    while(code_optimizer_peep_hole_optimization_worklist(parser->optimizer));
+    memory_manager_collect(&memory_manager);
+
+    // computations invariant in loops are moved before them
+    code_optimizer_split_code_to_graph(parser->optimizer);
+    // only pure expressions could be moved
+    code_optimizer_update_meta_data(parser->optimizer);
+    code_optimizer_loop_invariant_code_motion(parser->optimizer);
 
     // gently remove all unused symbols (with temps keep)
     code_optimizer_update_meta_data(parser->optimizer);
     code_optimizer_remove_unused_variables(parser->optimizer, false, true);
 
     code_optimizer_multi_write(parser->optimizer);
+    memory_manager_switch_arena(&memory_manager, MEMORY_MANAGER_ARENA_RENDER);
     code_generator_render(parser->code_constructor->generator, stdout);
     fflush(stdout);
+    // rendered instructions are no more needed
+    memory_manager_drop_arena(&memory_manager, MEMORY_MANAGER_ARENA_RENDER);
 
     parser_free(&parser);
+    string_interner_free(&string_interner);
     memory_manager_exit(&memory_manager);
     return EXIT_SUCCESS;
 }
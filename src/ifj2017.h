@@ -13,8 +13,6 @@ short log_verbosity = LOG_VERBOSITY_DEBUG;
 short log_verbosity = LOG_VERBOSITY_WARNING;
 #endif
 
-int stdin_stream();
-
 int main(int argc, char* argv[]);
 
 #endif
\ No newline at end of file
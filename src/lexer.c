@@ -1,19 +1,32 @@
 #include <math.h>
+#include <limits.h>
+#include <ctype.h>
 #include "lexer.h"
 #include "memory.h"
 #include "debug.h"
 #include "lexer_fsm.h"
 #include "common.h"
+#include "string_interner.h"
 
 
 Lexer* lexer_init(lexer_input_stream_f input_stream) {
-    Lexer* lexer = (Lexer*) memory_alloc(sizeof(Lexer));
-    LexerFSM* lexer_fsm = lexer_fsm_init(input_stream);
-
     NULL_POINTER_CHECK(input_stream, NULL);
+    Lexer* lexer = lexer_init_with_input(lexer_input_init_stream(input_stream));
+    NULL_POINTER_CHECK(lexer, NULL);
+
+    lexer->input_stream = input_stream;
+    return lexer;
+}
 
+Lexer* lexer_init_with_input(LexerInput* input) {
+    NULL_POINTER_CHECK(input, NULL);
+    Lexer* lexer = (Lexer*) memory_alloc(sizeof(Lexer));
+    LexerFSM* lexer_fsm = lexer_fsm_init_with_input(input);
+
+    lexer->input_stream = NULL;
     lexer->lexer_fsm = lexer_fsm;
-    lexer->is_token_rewind = false;
+    lexer->lookahead_start = 0;
+    lexer->lookahead_count = 0;
     lexer->error_report.error_code = ERROR_NONE;
 
     return lexer;
@@ -24,9 +37,6 @@ void lexer_free(Lexer** lexer) {
     NULL_POINTER_CHECK(*lexer,);
 
     lexer_fsm_free(&((*lexer)->lexer_fsm));
-    if((*lexer)->is_token_rewind) {
-        token_free(&(*lexer)->rewind_token);
-    }
     memory_free(*lexer);
     *lexer = NULL;
 }
@@ -34,22 +44,20 @@ void lexer_free(Lexer** lexer) {
 void lexer_rewind_token(Lexer* lexer, Token token) {
     NULL_POINTER_CHECK(lexer,);
 
-    ASSERT(!lexer->is_token_rewind);
-    lexer->is_token_rewind = true;
-    lexer->rewind_token = token_copy(token);
+    ASSERT(lexer->lookahead_count < LEXER_LOOKAHEAD_CAPACITY);
+    lexer->lookahead_start = (lexer->lookahead_start - 1) & (LEXER_LOOKAHEAD_CAPACITY - 1);
+    lexer->lookahead[lexer->lookahead_start] = token;
+    lexer->lookahead_count++;
 }
 
-void lexer_transform_integer_value(char** integer_value) {
-    NULL_POINTER_CHECK(integer_value,);
-    NULL_POINTER_CHECK(*integer_value,);
-
-    size_t target_length = (1 + strlen(*integer_value)) * 2;
-    char* integer_value_copy = memory_alloc(target_length * sizeof(char));
+bool lexer_parse_integer_value(const char* integer_value, int* value) {
+    NULL_POINTER_CHECK(integer_value, false);
+    NULL_POINTER_CHECK(value, false);
 
     int offset = 1;
     int base;
     // First char is type of integer. [0-9] -> decimal, 'b' -> binary, 'o' -> octa, 'h' -> hexa
-    switch(**integer_value) {
+    switch(*integer_value) {
         case 'b':
             base = 2;
             break;
@@ -66,42 +74,65 @@ void lexer_transform_integer_value(char** integer_value) {
             break;
     }
 
-    int result = (int) strtol((*integer_value) + offset, NULL, base);
+    int result = 0;
+    for(const char* c = integer_value + offset; *c != '\0'; c++) {
+        int digit;
+        if(*c >= '0' && *c <= '9')
+            digit = *c - '0';
+        else if(tolower(*c) >= 'a' && tolower(*c) <= 'f')
+            digit = tolower(*c) - 'a' + 10;
+        else
+            break;
+        if(digit >= base)
+            break;
+
+        if(result > (INT_MAX - digit) / base) {
+            // keep previous truncating conversion, so overflowed literal compiles as before
+            *value = (int) strtol(integer_value + offset, NULL, base);
+            return false;
+        }
+        result = result * base + digit;
+    }
+
+    *value = result;
+    return true;
+}
 
-    snprintf(integer_value_copy, target_length, "%d", result);
+bool lexer_parse_double_value(const char* double_value, double* value) {
+    NULL_POINTER_CHECK(double_value, false);
+    NULL_POINTER_CHECK(value, false);
 
-    memory_free(*integer_value);
-    *integer_value = integer_value_copy;
+    // underflow is rounded to zero, only infinity is out of range
+    *value = strtod(double_value, NULL);
+    return !isinf(*value);
+}
 
+static void lexer_store_token_value(Lexer* lexer, Token* token) {
+    const char* content = string_content(lexer->lexer_fsm->stream_buffer);
+
+    if(token->type == TOKEN_INTEGER_LITERAL) {
+        if(!lexer_parse_integer_value(content, &token->value.integer)) {
+            LOG_WARNING("Integer literal %s on line %lu overflows, truncated to %d.",
+                        content, (long unsigned) lexer->lexer_fsm->line, token->value.integer);
+        }
+    } else if(token->type == TOKEN_DOUBLE_LITERAL) {
+        if(!lexer_parse_double_value(content, &token->value.double_)) {
+            LOG_WARNING("Double literal %s on line %lu overflows.", content, (long unsigned) lexer->lexer_fsm->line);
+        }
+    }
 }
 
-Token lexer_next_token(Lexer* lexer) {
+static Token lexer_read_token(Lexer* lexer) {
     Token token = {
             .data = NULL,
             .type = TOKEN_UNKNOWN
     };
 
-    NULL_POINTER_CHECK(lexer, token);
-
-    if(lexer->is_token_rewind) {
-        lexer->is_token_rewind = false;
-
-        Token tmp = {.data = lexer->rewind_token.data, .type = lexer->rewind_token.type};
-        lexer->rewind_token.data = NULL;
-        lexer->rewind_token.type = TOKEN_UNKNOWN;
-
-        return tmp;
-    }
-
-    LexerFSMState actual_state = LEX_FSM__INIT;
-    do {
-        // loop from init state to one of final state
-        actual_state = lexer_fsm_next_state(lexer->lexer_fsm, actual_state);
-    } while(!LEXER_FSM_IS_FINAL_STATE(actual_state));
-
-    token.type = (TokenType) actual_state;
+    // loop from init state to one of final state
+    token.type = (TokenType) lexer_fsm_next_final_state(lexer->lexer_fsm);
 
     token.data = lexer_store_token_data(lexer, token);
+    lexer_store_token_value(lexer, &token);
     string_clear(lexer->lexer_fsm->stream_buffer);
 
     // Set error information
@@ -110,35 +141,54 @@ Token lexer_next_token(Lexer* lexer) {
         lexer->error_report.detail_information = (int) lexer->lexer_fsm->lexer_error;
     }
 
-    // Transform integer value to decimal system
-    if(token.type == TOKEN_INTEGER_LITERAL) {
-        // Transform size of memory
-        char* copy = c_string_copy(token.data);
-        memory_free(token.data);
-        token.data = memory_alloc(sizeof(char) * strlen(copy) * 2);
+    return token;
+}
+
+Token lexer_next_token(Lexer* lexer) {
+    Token token = {
+            .data = NULL,
+            .type = TOKEN_UNKNOWN
+    };
 
-        // Copy data, I need memory after string
-        strcpy(token.data, copy);
+    NULL_POINTER_CHECK(lexer, token);
 
-        // transform to integer format
-        lexer_transform_integer_value(&token.data);
-        memory_free(copy);
+    if(lexer->lookahead_count > 0) {
+        token = lexer->lookahead[lexer->lookahead_start];
+        lexer->lookahead_start = (lexer->lookahead_start + 1) & (LEXER_LOOKAHEAD_CAPACITY - 1);
+        lexer->lookahead_count--;
+        return token;
     }
 
-    return token;
+    return lexer_read_token(lexer);
 }
 
-char* lexer_store_token_data(const Lexer* lexer, Token token) {
+Token lexer_peek_token(Lexer* lexer, size_t k) {
+    Token token = {
+            .data = NULL,
+            .type = TOKEN_UNKNOWN
+    };
+
+    NULL_POINTER_CHECK(lexer, token);
+    ASSERT(k < LEXER_LOOKAHEAD_CAPACITY);
+
+    while(lexer->lookahead_count <= k) {
+        const size_t end = (lexer->lookahead_start + lexer->lookahead_count) & (LEXER_LOOKAHEAD_CAPACITY - 1);
+        lexer->lookahead[end] = lexer_read_token(lexer);
+        lexer->lookahead_count++;
+    }
+
+    return lexer->lookahead[(lexer->lookahead_start + k) & (LEXER_LOOKAHEAD_CAPACITY - 1)];
+}
+
+const char* lexer_store_token_data(const Lexer* lexer, Token token) {
     NULL_POINTER_CHECK(lexer, NULL);
 
     if(
             token.type == TOKEN_IDENTIFIER ||
-            token.type == TOKEN_STRING_VALUE ||
-            token.type == TOKEN_INTEGER_LITERAL ||
-            token.type == TOKEN_DOUBLE_LITERAL
+            token.type == TOKEN_STRING_VALUE
             ) {
-
-        return c_string_copy(string_content(lexer->lexer_fsm->stream_buffer));
+        String* stream_buffer = lexer->lexer_fsm->stream_buffer;
+        return string_interner_intern(&string_interner, string_content(stream_buffer), string_length(stream_buffer));
     }
 
     return NULL;
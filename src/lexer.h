@@ -5,6 +5,9 @@
 #include "lexer_fsm.h"
 #include "error.h"
 
+// Count of tokens, which could be peeked or rewound at once, must be power of two
+#define LEXER_LOOKAHEAD_CAPACITY 4
+
 /**
  * @brief Representation of lexical analyzer
  */
@@ -12,8 +15,9 @@ typedef struct lexer_t {
     lexer_input_stream_f input_stream; // Pointer to function which stream chars
     LexerFSM* lexer_fsm; // Instance of final state machine
 
-    bool is_token_rewind;
-    Token rewind_token; // buffered token
+    Token lookahead[LEXER_LOOKAHEAD_CAPACITY]; // ring buffer of peeked and rewound tokens
+    size_t lookahead_start; // index of next token in ring buffer
+    size_t lookahead_count;
     ErrorReport error_report; // Error report
 } Lexer;
 
@@ -25,13 +29,21 @@ typedef struct lexer_t {
  */
 Lexer* lexer_init(lexer_input_stream_f input_stream);
 
+/**
+ * @brief Constructor for lexer with buffered input
+ *
+ * @param input Input of source code, lexer takes ownership
+ * @return Lexer* Pointer to lexer
+ */
+Lexer* lexer_init_with_input(LexerInput* input);
+
 /**
  * @brief Free lexer also with stack from memory.
  */
 void lexer_free(Lexer** lexer);
 
 /**
- * @brief Get next token from lexer, this token must be freed with 'token_free()' function
+ * @brief Get next token from lexer and consume it, data of token are interned and released only with string interner
  *
  * @param Lexer* lexer Pointer to lexer
  * @return Token* Pointer to next token
@@ -39,15 +51,24 @@ void lexer_free(Lexer** lexer);
 Token lexer_next_token(Lexer* lexer);
 
 /**
- * @brief Store token additional data from stream_buffer to .data ptr - only for identifiers and number, string and double literals.
+ * @brief Get token k positions ahead without consuming it, tokens are buffered by value
+ *
+ * @param Lexer* lexer Pointer to lexer
+ * @param size_t k Position of token, 0 for next token, must be less than LEXER_LOOKAHEAD_CAPACITY
+ * @return Token Peeked token
+ */
+Token lexer_peek_token(Lexer* lexer, size_t k);
+
+/**
+ * @brief Store token additional data from stream_buffer to .data ptr - only for identifiers and string literals.
  * @param lexer lexer pointer
  * @param token token to process
- * @return pointer to data block with additional data
+ * @return interned string with additional data
  */
-char* lexer_store_token_data(const Lexer* lexer, Token token);
+const char* lexer_store_token_data(const Lexer* lexer, Token token);
 
 /**
- * @brief Push token to the stack (only one token can be rewinded at time)
+ * @brief Return token in front of lookahead buffer, so it is next token again (without copy)
  *
  * @param Lexer* lexer Pointer to instance of lexer
  * @param Token* token Pointer to token
@@ -55,10 +76,21 @@ char* lexer_store_token_data(const Lexer* lexer, Token token);
 void lexer_rewind_token(Lexer* lexer, Token token);
 
 /**
- * @brief Transform integer according to the first character into the decimal system
+ * @brief Parse value of integer literal according to the first character with overflow detection
+ *
+ * @param integer_value literal from stream buffer, first char is type: [0-9] -> decimal, 'b', 'o', 'h'
+ * @param value parsed value, truncated to int in case of overflow
+ * @return bool false if value doesn't fit into integer
+ */
+bool lexer_parse_integer_value(const char* integer_value, int* value);
+
+/**
+ * @brief Parse value of double literal with overflow detection
  *
- * @param char* integer_value
+ * @param double_value literal from stream buffer
+ * @param value parsed value, infinity in case of overflow
+ * @return bool false if value is out of range of double
  */
-void lexer_transform_integer_value(char** integer_value);
+bool lexer_parse_double_value(const char* double_value, double* value);
 
 #endif //_LEXER_H
@@ -1,22 +1,36 @@
 #include <stdbool.h>
 #include <ctype.h>
+#include <string.h>
 #include "lexer_fsm.h"
 #include "debug.h"
 #include "char_stack.h"
 #include "dynamic_string.h"
+#include "lexer_fsm_table.h"
+#include "lexer_scan.h"
 
-#define REWIND_CHAR(c) char_stack_push(lexer_fsm->stack, (char) (c))
+#define REWIND_CHAR(c) lexer_fsm_rewind_char(lexer_fsm, (c))
 #define STORE_CHAR(c) string_append_c(lexer_fsm->stream_buffer, (char) (c));
 
+// chars of actual block, which were not scanned yet, always zero for stream inputs
+#define BUFFERED_CHARS_LEFT() (lexer_fsm->input->length - lexer_fsm->input->position)
+#define BUFFERED_CHAR() ((unsigned char) lexer_fsm->input->buffer[lexer_fsm->input->position])
+#define BUFFERED_CHARS() (lexer_fsm->input->buffer + lexer_fsm->input->position)
+
 
 LexerFSM* lexer_fsm_init(lexer_input_stream_f input_stream) {
     NULL_POINTER_CHECK(input_stream, NULL);
+    return lexer_fsm_init_with_input(lexer_input_init_stream(input_stream));
+}
+
+LexerFSM* lexer_fsm_init_with_input(LexerInput* input) {
+    NULL_POINTER_CHECK(input, NULL);
     LexerFSM* lexer_fsm = (LexerFSM*) memory_alloc(sizeof(LexerFSM));
     NULL_POINTER_CHECK(lexer_fsm, NULL);
     CharStack* stack = char_stack_init();
     lexer_fsm->stream_buffer = string_init_with_capacity(LEXER_FSM_STREAM_BUFFER_DEFAULT_LENGTH);
     lexer_fsm->stack = stack;
-    lexer_fsm->input_stream = input_stream;
+    lexer_fsm->input = input;
+    lexer_fsm->engine = LEXER_FSM_DEFAULT_ENGINE;
     lexer_fsm->numeric_char_position = -1;
     lexer_fsm->lexer_error = LEXER_ERROR__NO_ERROR;
 
@@ -28,21 +42,59 @@ LexerFSM* lexer_fsm_init(lexer_input_stream_f input_stream) {
 void lexer_fsm_free(LexerFSM** lexer_fsm) {
     NULL_POINTER_CHECK(lexer_fsm,);
     NULL_POINTER_CHECK(*lexer_fsm,);
-;
+
     char_stack_free(&(*lexer_fsm)->stack);
     string_free(&(*lexer_fsm)->stream_buffer);
+    lexer_input_free(&(*lexer_fsm)->input);
     memory_free(*lexer_fsm);
     *lexer_fsm = NULL;
 }
 
+int lexer_fsm_stream_char(LexerFSM* lexer_fsm) {
+    NULL_POINTER_CHECK(lexer_fsm, EOF);
+    // stored chars in stack from before loops have priority
+    const int c = char_stack_pop(lexer_fsm->stack);
+    return c == EOF ? lexer_fsm->input->stream() : c;
+}
+
+void lexer_fsm_rewind_char(LexerFSM* lexer_fsm, int c) {
+    NULL_POINTER_CHECK(lexer_fsm,);
+    if(lexer_fsm->input->source == LEXER_INPUT_SOURCE__STREAM) {
+        char_stack_push(lexer_fsm->stack, (char) c);
+        return;
+    }
+    // last char is still in actual block, EOF of buffered input is repeated by itself
+    if(c != EOF)
+        lexer_fsm->input->position--;
+}
+
+void lexer_fsm_skip_whitespace(LexerFSM* lexer_fsm) {
+    NULL_POINTER_CHECK(lexer_fsm,);
+    if(BUFFERED_CHARS_LEFT() > 0)
+        lexer_fsm->input->position += lexer_scan_whitespace(BUFFERED_CHARS(), BUFFERED_CHARS_LEFT());
+}
+
+void lexer_fsm_store_string_run(LexerFSM* lexer_fsm) {
+    NULL_POINTER_CHECK(lexer_fsm,);
+    if(BUFFERED_CHARS_LEFT() == 0)
+        return;
+    const size_t run_length = lexer_scan_string(BUFFERED_CHARS(), BUFFERED_CHARS_LEFT());
+    string_append_n(lexer_fsm->stream_buffer, BUFFERED_CHARS(), run_length);
+    lexer_fsm->input->position += run_length;
+}
+
+void lexer_fsm_skip_to_char(LexerFSM* lexer_fsm, char c) {
+    NULL_POINTER_CHECK(lexer_fsm,);
+    if(BUFFERED_CHARS_LEFT() > 0)
+        lexer_fsm->input->position += lexer_scan_to_char(BUFFERED_CHARS(), BUFFERED_CHARS_LEFT(), c);
+}
+
 LexerFSMState lexer_fsm_next_state(LexerFSM* lexer_fsm, LexerFSMState prev_state) {
     NULL_POINTER_CHECK(lexer_fsm, LEX_FSM__ERROR);
+    if(lexer_fsm->engine == LEXER_FSM_ENGINE__TABLE)
+        return lexer_fsm_table_next_state(lexer_fsm, prev_state);
 
-    // stored chars in stack from before loops have priority
-    int c = char_stack_pop(lexer_fsm->stack);
-
-    if(c == EOF)
-        c = lexer_fsm->input_stream();
+    const int c = LEXER_FSM_READ_CHAR(lexer_fsm);
 
     switch(prev_state) {
         // Starting state
@@ -53,8 +105,10 @@ LexerFSMState lexer_fsm_next_state(LexerFSM* lexer_fsm, LexerFSMState prev_state
                 return LEX_FSM__EOL;
             }
 
-            if(isspace(c))
+            if(isspace(c)) {
+                lexer_fsm_skip_whitespace(lexer_fsm);
                 return LEX_FSM__INIT;
+            }
 
             if(c == '_' || isalpha(c)) {
                 STORE_CHAR(tolower(c));
@@ -238,6 +292,7 @@ LexerFSMState lexer_fsm_next_state(LexerFSM* lexer_fsm, LexerFSMState prev_state
                     return LEX_FSM__STRING_SLASH;
                 default:
                     STORE_CHAR(c);
+                    lexer_fsm_store_string_run(lexer_fsm);
                     return LEX_FSM__STRING_LOAD;
             }
 
@@ -382,10 +437,17 @@ LexerFSMState lexer_fsm_next_state(LexerFSM* lexer_fsm, LexerFSMState prev_state
         case LEX_FSM__IDENTIFIER_UNFINISHED:
             if(c == '_' || isalnum(c)) {
                 STORE_CHAR(tolower(c));
+                while(BUFFERED_CHARS_LEFT() > 0 && (BUFFERED_CHAR() == '_' || isalnum(BUFFERED_CHAR()))) {
+                    STORE_CHAR(tolower(BUFFERED_CHAR()));
+                    lexer_fsm->input->position++;
+                }
                 return LEX_FSM__IDENTIFIER_UNFINISHED;
             } else {
                 REWIND_CHAR(tolower(c));
-                LexerFSMState return_state = lexer_fsm_get_identifier_state(string_content(lexer_fsm->stream_buffer));
+                LexerFSMState return_state = lexer_fsm_get_identifier_state_with_length(
+                        string_content(lexer_fsm->stream_buffer),
+                        string_length(lexer_fsm->stream_buffer)
+                );
                 return return_state;
             }
 
@@ -402,8 +464,10 @@ LexerFSMState lexer_fsm_next_state(LexerFSM* lexer_fsm, LexerFSMState prev_state
             }
 
         case LEX_FSM__COMMENT_LINE:
-            if(c != '\n' && c != EOF)
+            if(c != '\n' && c != EOF) {
+                lexer_fsm_skip_to_char(lexer_fsm, '\n');
                 return LEX_FSM__COMMENT_LINE;
+            }
             REWIND_CHAR(tolower(c));
             return LEX_FSM__INIT;
 
@@ -412,6 +476,7 @@ LexerFSMState lexer_fsm_next_state(LexerFSM* lexer_fsm, LexerFSMState prev_state
                 return LEX_FSM__ERROR;
             if(c == '\'')
                 return LEX_FSM__COMMENT_BLOCK_END;
+            lexer_fsm_skip_to_char(lexer_fsm, '\'');
             return LEX_FSM__COMMENT_BLOCK;
 
         case LEX_FSM__COMMENT_BLOCK_END:
@@ -428,33 +493,62 @@ LexerFSMState lexer_fsm_next_state(LexerFSM* lexer_fsm, LexerFSMState prev_state
     return LEX_FSM__ERROR;
 }
 
-LexerFSMState lexer_fsm_get_identifier_state(const char* name) {
+typedef struct lexer_fsm_keyword_t {
+    const char* name;
+    size_t length;
+    LexerFSMState state;
+} LexerFSMKeyword;
+
+static LexerFSMKeyword lexer_fsm_keywords_table[LEXER_FSM_KEYWORDS_TABLE_SIZE];
 
-    static const char* keywords[] = {
-            // keywords
-            "as", "asc", "declare", "dim", "do",
-            "else", "end", "chr", "function",
-            "if", "input", "length", "loop",
-            "print", "return", "scope", "substr",
-            "then", "while",
-            // reserved
-            "and", "continue",
-            "elseif", "exit", "false", "for", "next", "not",
-            "or", "shared", "static", "true",
-            // data type keywords
-            "integer", "double", "boolean", "string"
+static void lexer_fsm_keywords_table_init() {
+    static const LexerFSMKeyword keywords[] = {
+#define LEXER_FSM_KEYWORD_ITEM(name, state) {name, sizeof(name) - 1, state},
+            LEXER_FSM_KEYWORDS(LEXER_FSM_KEYWORD_ITEM)
+#undef LEXER_FSM_KEYWORD_ITEM
     };
 
-    static const int number_of_keywords = sizeof(keywords) / sizeof(*keywords);
+    for(size_t i = 0; i < sizeof(keywords) / sizeof(*keywords); i++) {
+        const size_t hash = LEXER_FSM_KEYWORD_HASH(keywords[i].name, keywords[i].length);
+        // new keyword needs new constants of LEXER_FSM_KEYWORD_HASH in case of collision
+        ASSERT(lexer_fsm_keywords_table[hash].name == NULL);
+        ASSERT(keywords[i].length <= LEXER_FSM_KEYWORD_MAX_LENGTH);
+        lexer_fsm_keywords_table[hash] = keywords[i];
+    }
+}
 
-    for(int i = 0; i < number_of_keywords; i++) {
-        if(strcmp(keywords[i], name) == 0) {
-            if(i >= 31)
-                return LEX_FSM__INTEGER + (i - 31);
-            return LEX_FSM__AS + i;
-        }
+LexerFSMState lexer_fsm_next_final_state(LexerFSM* lexer_fsm) {
+    NULL_POINTER_CHECK(lexer_fsm, LEX_FSM__ERROR);
+    if(lexer_fsm->engine == LEXER_FSM_ENGINE__TABLE)
+        return lexer_fsm_table_next_final_state(lexer_fsm);
+
+    LexerFSMState actual_state = LEX_FSM__INIT;
+    do {
+        // loop from init state to one of final state
+        actual_state = lexer_fsm_next_state(lexer_fsm, actual_state);
+    } while(!LEXER_FSM_IS_FINAL_STATE(actual_state));
+    return actual_state;
+}
+
+LexerFSMState lexer_fsm_get_identifier_state(const char* name) {
+    NULL_POINTER_CHECK(name, LEX_FSM__ERROR);
+    return lexer_fsm_get_identifier_state_with_length(name, strlen(name));
+}
+
+LexerFSMState lexer_fsm_get_identifier_state_with_length(const char* name, size_t length) {
+    NULL_POINTER_CHECK(name, LEX_FSM__ERROR);
+    static bool keywords_table_initialized = false;
+    if(!keywords_table_initialized) {
+        lexer_fsm_keywords_table_init();
+        keywords_table_initialized = true;
     }
 
+    if(length == 0 || length > LEXER_FSM_KEYWORD_MAX_LENGTH)
+        return LEX_FSM__IDENTIFIER_FINISHED;
+
+    const LexerFSMKeyword* keyword = &lexer_fsm_keywords_table[LEXER_FSM_KEYWORD_HASH(name, length)];
+    if(keyword->length == length && memcmp(keyword->name, name, length) == 0)
+        return keyword->state;
+
     return LEX_FSM__IDENTIFIER_FINISHED;
 }
-
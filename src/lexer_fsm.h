@@ -4,17 +4,80 @@
 #include <stdbool.h>
 #include "char_stack.h"
 #include "dynamic_string.h"
+#include "lexer_input.h"
 
 // Length of lexer buffer
 #define LEXER_FSM_STREAM_BUFFER_DEFAULT_LENGTH 2
 
+// Engine of newly created FSMs
+#define LEXER_FSM_DEFAULT_ENGINE LEXER_FSM_ENGINE__TABLE
+
 //lexer_fsm_is_final_state
 #define LEXER_FSM_IS_FINAL_STATE(state) ((state) >= LEX_FSM__ADD)
 
 /**
- * @brief Pointer to function, which streams the characters
+ * @brief Get next char for FSM, buffered inputs are read directly, stream inputs through rewind stack
+ */
+#define LEXER_FSM_READ_CHAR(lexer_fsm) (\
+    (lexer_fsm)->input->source == LEXER_INPUT_SOURCE__STREAM ?\
+        lexer_fsm_stream_char(lexer_fsm) : LEXER_INPUT_NEXT_CHAR((lexer_fsm)->input)\
+)
+
+// Size of keywords hash table, should be power of 2
+#define LEXER_FSM_KEYWORDS_TABLE_SIZE 64
+// Length of the longest keyword
+#define LEXER_FSM_KEYWORD_MAX_LENGTH 8
+
+/**
+ * @brief Perfect hash of keywords by first char, last char and length, collisions are checked in debug build
+ */
+#define LEXER_FSM_KEYWORD_HASH(name, length) (\
+    ((unsigned) (unsigned char) (name)[0] * 9 + (unsigned) (unsigned char) (name)[(length) - 1] * 52 + (unsigned) (length) * 4) &\
+    (LEXER_FSM_KEYWORDS_TABLE_SIZE - 1)\
+)
+
+/**
+ * @brief Single list of keywords with their states, keywords table is generated from it
  */
-typedef int (* lexer_input_stream_f)();
+#define LEXER_FSM_KEYWORDS(KEYWORD) \
+    /* keywords */ \
+    KEYWORD("as", LEX_FSM__AS) \
+    KEYWORD("asc", LEX_FSM__ASC) \
+    KEYWORD("declare", LEX_FSM__DECLARE) \
+    KEYWORD("dim", LEX_FSM__DIM) \
+    KEYWORD("do", LEX_FSM__DO) \
+    KEYWORD("else", LEX_FSM__ELSE) \
+    KEYWORD("end", LEX_FSM__END) \
+    KEYWORD("chr", LEX_FSM__CHR) \
+    KEYWORD("function", LEX_FSM__FUNCTION) \
+    KEYWORD("if", LEX_FSM__IF) \
+    KEYWORD("input", LEX_FSM__INPUT) \
+    KEYWORD("length", LEX_FSM__LENGTH) \
+    KEYWORD("loop", LEX_FSM__LOOP) \
+    KEYWORD("print", LEX_FSM__PRINT) \
+    KEYWORD("return", LEX_FSM__RETURN) \
+    KEYWORD("scope", LEX_FSM__SCOPE) \
+    KEYWORD("substr", LEX_FSM__SUBSTR) \
+    KEYWORD("then", LEX_FSM__THEN) \
+    KEYWORD("while", LEX_FSM__WHILE) \
+    /* reserved */ \
+    KEYWORD("and", LEX_FSM__AND) \
+    KEYWORD("continue", LEX_FSM__CONTINUE) \
+    KEYWORD("elseif", LEX_FSM__ELSEIF) \
+    KEYWORD("exit", LEX_FSM__EXIT) \
+    KEYWORD("false", LEX_FSM__FALSE) \
+    KEYWORD("for", LEX_FSM__FOR) \
+    KEYWORD("next", LEX_FSM__NEXT) \
+    KEYWORD("not", LEX_FSM__NOT) \
+    KEYWORD("or", LEX_FSM__OR) \
+    KEYWORD("shared", LEX_FSM__SHARED) \
+    KEYWORD("static", LEX_FSM__STATIC) \
+    KEYWORD("true", LEX_FSM__TRUE) \
+    /* data type keywords */ \
+    KEYWORD("integer", LEX_FSM__INTEGER) \
+    KEYWORD("double", LEX_FSM__DOUBLE) \
+    KEYWORD("boolean", LEX_FSM__BOOLEAN) \
+    KEYWORD("string", LEX_FSM__STRING)
 
 /**
  * @brief List of lexer errors
@@ -26,14 +89,23 @@ typedef enum {
     LEXER_ERROR__ERROR_LEXEM,
 } LexerError;
 
+/**
+ * @brief Implementations of FSM transitions
+ */
+typedef enum {
+    LEXER_FSM_ENGINE__SWITCH, // hand written switch over states
+    LEXER_FSM_ENGINE__TABLE, // dense table by state and char class
+} LexerFSMEngine;
+
 /**
  * @brief Representation of the FSM that is part of the lexical analyzer
  */
 typedef struct lexer_fsm_t {
 
-    CharStack* stack; // Instance of stack for returning symbols back
+    CharStack* stack; // Instance of stack for returning symbols back, used only for stream input
     String* stream_buffer; // Dynamic string for progressive compilation value
-    lexer_input_stream_f input_stream; // Pointer to function which stream chars
+    LexerInput* input; // Owned input, buffered inputs are scanned directly
+    LexerFSMEngine engine; // Implementation of transitions
 
     char numeric_char_value[4]; // Stack for numeric value of char
     short numeric_char_position; // Head of stack for numeric value of char
@@ -185,6 +257,14 @@ typedef enum {
  */
 LexerFSM* lexer_fsm_init(lexer_input_stream_f input_stream);
 
+/**
+ * @brief Constructor for LexerFSM with buffered input
+ *
+ * @param input Input to scan, FSM takes ownership.
+ * @return LexerFSM*
+ */
+LexerFSM* lexer_fsm_init_with_input(LexerInput* input);
+
 /**
  * @brief Destructor for LexerFSM
  *
@@ -200,13 +280,68 @@ void lexer_fsm_free(LexerFSM** lexer_fsm);
  */
 LexerFSMState lexer_fsm_get_identifier_state(const char* name);
 
+/**
+ * @brief Get identifier type from name with known length
+ *
+ * @param char* name
+ * @param size_t length
+ * @return LexerFSMState
+ */
+LexerFSMState lexer_fsm_get_identifier_state_with_length(const char* name, size_t length);
+
 /**
  * @brief Get next state from prev state and next symbol
  *
+ * @param LexerFSM* lexer_fsm
  * @param LexerFSMState prev_state
- * @param lexer_input_stream_f input_stream
  * @return LexerFSMState Next state
  */
 LexerFSMState lexer_fsm_next_state(LexerFSM* lexer_fsm, LexerFSMState prev_state);
 
+/**
+ * @brief Get final state of next lexem, runs transitions from init state
+ *
+ * @param LexerFSM* lexer_fsm
+ * @return LexerFSMState Final state
+ */
+LexerFSMState lexer_fsm_next_final_state(LexerFSM* lexer_fsm);
+
+/**
+ * @brief Get next char from stream input, rewound chars have priority
+ *
+ * @param LexerFSM* lexer_fsm
+ * @return int char or EOF
+ */
+int lexer_fsm_stream_char(LexerFSM* lexer_fsm);
+
+/**
+ * @brief Skip run of white chars except new line in actual block of buffered input
+ *
+ * @param LexerFSM* lexer_fsm
+ */
+void lexer_fsm_skip_whitespace(LexerFSM* lexer_fsm);
+
+/**
+ * @brief Store run of plain string chars from actual block of buffered input by one copy
+ *
+ * @param LexerFSM* lexer_fsm
+ */
+void lexer_fsm_store_string_run(LexerFSM* lexer_fsm);
+
+/**
+ * @brief Skip chars in actual block of buffered input to first occurrence of given char
+ *
+ * @param LexerFSM* lexer_fsm
+ * @param char c
+ */
+void lexer_fsm_skip_to_char(LexerFSM* lexer_fsm, char c);
+
+/**
+ * @brief Return last read char back to input
+ *
+ * @param LexerFSM* lexer_fsm
+ * @param int c last read char
+ */
+void lexer_fsm_rewind_char(LexerFSM* lexer_fsm, int c);
+
 #endif // _LEXER_FSM_H
@@ -0,0 +1,469 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include "lexer_fsm_table.h"
+#include "debug.h"
+#include "dynamic_string.h"
+
+#define LOWER_CHAR(c) ((c) >= 'A' && (c) <= 'Z' ? (c) - 'A' + 'a' : (c))
+// chars from stream inputs can be negative (signed char), EOF has own class
+#define CHAR_CLASS_OFFSET 128
+#define CHAR_CLASS(c) lexer_fsm_char_classes[(c) + CHAR_CLASS_OFFSET]
+
+#define SET_TRANSITIONS(state, classes, next_state, action) \
+    lexer_fsm_table_set_transitions((state), (classes), sizeof(classes) / sizeof(*(classes)), (next_state), (action))
+
+static unsigned char lexer_fsm_char_classes[CHAR_CLASS_OFFSET + 256];
+static LexerFSMTransition lexer_fsm_transitions[LEXER_FSM_TABLE_STATES_COUNT][LEX_FSM_CLASS__COUNT];
+
+static const LexerFSMCharClass LETTERS[] = {
+        LEX_FSM_CLASS__B, LEX_FSM_CLASS__E, LEX_FSM_CLASS__HEXA_LETTER, LEX_FSM_CLASS__O,
+        LEX_FSM_CLASS__H, LEX_FSM_CLASS__N, LEX_FSM_CLASS__T, LEX_FSM_CLASS__LETTER
+};
+static const LexerFSMCharClass DIGITS[] = {
+        LEX_FSM_CLASS__BINARY_DIGIT, LEX_FSM_CLASS__OCTA_DIGIT, LEX_FSM_CLASS__DIGIT
+};
+static const LexerFSMCharClass OCTA_DIGITS[] = {
+        LEX_FSM_CLASS__BINARY_DIGIT, LEX_FSM_CLASS__OCTA_DIGIT
+};
+static const LexerFSMCharClass HEXA_LETTERS[] = {
+        LEX_FSM_CLASS__B, LEX_FSM_CLASS__E, LEX_FSM_CLASS__HEXA_LETTER
+};
+static const LexerFSMCharClass EXPONENTS[] = {LEX_FSM_CLASS__E};
+static const LexerFSMCharClass STRING_ERRORS[] = {
+        LEX_FSM_CLASS__EOF, LEX_FSM_CLASS__EOL, LEX_FSM_CLASS__WHITESPACE, LEX_FSM_CLASS__CONTROL
+};
+static const LexerFSMCharClass ESCAPES[] = {
+        LEX_FSM_CLASS__QUOTE, LEX_FSM_CLASS__BACKSLASH, LEX_FSM_CLASS__N, LEX_FSM_CLASS__T
+};
+static const LexerFSMCharClass LINE_ENDS[] = {LEX_FSM_CLASS__EOL, LEX_FSM_CLASS__EOF};
+
+static void lexer_fsm_table_set(LexerFSMState state, LexerFSMCharClass char_class, LexerFSMState next_state,
+                                LexerFSMAction action) {
+    lexer_fsm_transitions[state][char_class].next_state = (unsigned short) next_state;
+    lexer_fsm_transitions[state][char_class].action = (unsigned char) action;
+}
+
+static void lexer_fsm_table_set_row(LexerFSMState state, LexerFSMState next_state, LexerFSMAction action) {
+    for(int char_class = 0; char_class < LEX_FSM_CLASS__COUNT; char_class++)
+        lexer_fsm_table_set(state, (LexerFSMCharClass) char_class, next_state, action);
+}
+
+static void lexer_fsm_table_set_transitions(LexerFSMState state, const LexerFSMCharClass* classes, size_t count,
+                                            LexerFSMState next_state, LexerFSMAction action) {
+    for(size_t i = 0; i < count; i++)
+        lexer_fsm_table_set(state, classes[i], next_state, action);
+}
+
+static void lexer_fsm_char_classes_init() {
+    // negative chars are not letters, digits nor spaces, in strings they are below 32
+    for(int c = -CHAR_CLASS_OFFSET; c < 0; c++)
+        CHAR_CLASS(c) = LEX_FSM_CLASS__CONTROL;
+    CHAR_CLASS(EOF) = LEX_FSM_CLASS__EOF;
+
+    for(int c = 0; c < 256; c++) {
+        LexerFSMCharClass char_class = c < 32 ? LEX_FSM_CLASS__CONTROL : LEX_FSM_CLASS__OTHER;
+        if((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+            char_class = LEX_FSM_CLASS__LETTER;
+
+        switch(LOWER_CHAR(c)) {
+            case 'b':
+                char_class = LEX_FSM_CLASS__B;
+                break;
+            case 'e':
+                char_class = LEX_FSM_CLASS__E;
+                break;
+            case 'a':
+            case 'c':
+            case 'd':
+            case 'f':
+                char_class = LEX_FSM_CLASS__HEXA_LETTER;
+                break;
+            case 'o':
+                char_class = LEX_FSM_CLASS__O;
+                break;
+            case 'h':
+                char_class = LEX_FSM_CLASS__H;
+                break;
+            default:
+                break;
+        }
+
+        switch(c) {
+            // escape sequences are case sensitive
+            case 'n':
+                char_class = LEX_FSM_CLASS__N;
+                break;
+            case 't':
+                char_class = LEX_FSM_CLASS__T;
+                break;
+            case '\n':
+                char_class = LEX_FSM_CLASS__EOL;
+                break;
+            case ' ':
+                char_class = LEX_FSM_CLASS__SPACE;
+                break;
+            case '\t':
+            case '\v':
+            case '\f':
+            case '\r':
+                char_class = LEX_FSM_CLASS__WHITESPACE;
+                break;
+            case '0':
+            case '1':
+                char_class = LEX_FSM_CLASS__BINARY_DIGIT;
+                break;
+            case '2':
+            case '3':
+            case '4':
+            case '5':
+            case '6':
+            case '7':
+                char_class = LEX_FSM_CLASS__OCTA_DIGIT;
+                break;
+            case '8':
+            case '9':
+                char_class = LEX_FSM_CLASS__DIGIT;
+                break;
+            case '_':
+                char_class = LEX_FSM_CLASS__UNDERSCORE;
+                break;
+            case '!':
+                char_class = LEX_FSM_CLASS__EXCLAMATION;
+                break;
+            case '"':
+                char_class = LEX_FSM_CLASS__QUOTE;
+                break;
+            case '\'':
+                char_class = LEX_FSM_CLASS__APOSTROPHE;
+                break;
+            case '/':
+                char_class = LEX_FSM_CLASS__SLASH;
+                break;
+            case '\\':
+                char_class = LEX_FSM_CLASS__BACKSLASH;
+                break;
+            case '+':
+                char_class = LEX_FSM_CLASS__ADD;
+                break;
+            case '-':
+                char_class = LEX_FSM_CLASS__SUBTRACT;
+                break;
+            case '*':
+                char_class = LEX_FSM_CLASS__MULTIPLY;
+                break;
+            case '(':
+                char_class = LEX_FSM_CLASS__LEFT_BRACKET;
+                break;
+            case ')':
+                char_class = LEX_FSM_CLASS__RIGHT_BRACKET;
+                break;
+            case '<':
+                char_class = LEX_FSM_CLASS__SMALLER;
+                break;
+            case '>':
+                char_class = LEX_FSM_CLASS__BIGGER;
+                break;
+            case '=':
+                char_class = LEX_FSM_CLASS__EQUAL;
+                break;
+            case ';':
+                char_class = LEX_FSM_CLASS__SEMICOLON;
+                break;
+            case ',':
+                char_class = LEX_FSM_CLASS__COMMA;
+                break;
+            case '&':
+                char_class = LEX_FSM_CLASS__AMP;
+                break;
+            case '.':
+                char_class = LEX_FSM_CLASS__DOT;
+                break;
+            default:
+                break;
+        }
+        CHAR_CLASS(c) = (unsigned char) char_class;
+    }
+}
+
+/**
+ * @brief Fills transitions table, it describes same machine as switch in lexer_fsm_next_state()
+ */
+static void lexer_fsm_transitions_init() {
+    // Starting state
+    lexer_fsm_table_set_row(LEX_FSM__INIT, LEX_FSM__ERROR, LEX_FSM_ACTION__LEXEM_ERROR);
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__EOL, LEX_FSM__EOL, LEX_FSM_ACTION__EOL);
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__SPACE, LEX_FSM__INIT, LEX_FSM_ACTION__SKIP_WHITESPACE);
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__WHITESPACE, LEX_FSM__INIT, LEX_FSM_ACTION__SKIP_WHITESPACE);
+    lexer_fsm_table_set(
+            LEX_FSM__INIT, LEX_FSM_CLASS__UNDERSCORE, LEX_FSM__IDENTIFIER_UNFINISHED, LEX_FSM_ACTION__STORE_LOWER
+    );
+    SET_TRANSITIONS(LEX_FSM__INIT, LETTERS, LEX_FSM__IDENTIFIER_UNFINISHED, LEX_FSM_ACTION__STORE_LOWER);
+    SET_TRANSITIONS(LEX_FSM__INIT, DIGITS, LEX_FSM__INTEGER_LITERAL_UNFINISHED, LEX_FSM_ACTION__STORE);
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__EXCLAMATION, LEX_FSM__STRING_EXC, LEX_FSM_ACTION__NONE);
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__APOSTROPHE, LEX_FSM__COMMENT_LINE, LEX_FSM_ACTION__SKIP_LINE);
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__SLASH, LEX_FSM__SLASH, LEX_FSM_ACTION__NONE);
+    lexer_fsm_table_set(
+            LEX_FSM__INIT, LEX_FSM_CLASS__BACKSLASH, LEX_FSM__INTEGER_DIVIDE_UNFINISHED, LEX_FSM_ACTION__NONE
+    );
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__ADD, LEX_FSM__ADD_UNFINISHED, LEX_FSM_ACTION__NONE);
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__SUBTRACT, LEX_FSM__SUBTRACT_UNFINISHED, LEX_FSM_ACTION__NONE);
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__MULTIPLY, LEX_FSM__MULTIPLY_UNFINISHED, LEX_FSM_ACTION__NONE);
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__LEFT_BRACKET, LEX_FSM__LEFT_BRACKET, LEX_FSM_ACTION__NONE);
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__RIGHT_BRACKET, LEX_FSM__RIGHT_BRACKET, LEX_FSM_ACTION__NONE);
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__SMALLER, LEX_FSM__LEFT_SHARP_BRACKET, LEX_FSM_ACTION__NONE);
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__BIGGER, LEX_FSM__RIGHT_SHARP_BRACKET, LEX_FSM_ACTION__NONE);
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__EQUAL, LEX_FSM__EQUAL, LEX_FSM_ACTION__NONE);
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__SEMICOLON, LEX_FSM__SEMICOLON, LEX_FSM_ACTION__NONE);
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__COMMA, LEX_FSM__COMMA, LEX_FSM_ACTION__NONE);
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__AMP, LEX_FSM__AMP, LEX_FSM_ACTION__NONE);
+    lexer_fsm_table_set(LEX_FSM__INIT, LEX_FSM_CLASS__EOF, LEX_FSM__EOF, LEX_FSM_ACTION__NONE);
+
+    // Binary, octa and hexa integers
+    lexer_fsm_table_set_row(LEX_FSM__AMP, LEX_FSM__ERROR, LEX_FSM_ACTION__NONE);
+    lexer_fsm_table_set(LEX_FSM__AMP, LEX_FSM_CLASS__B, LEX_FSM__BINARY_START, LEX_FSM_ACTION__STORE_LOWER);
+    lexer_fsm_table_set(LEX_FSM__AMP, LEX_FSM_CLASS__O, LEX_FSM__OCTA_START, LEX_FSM_ACTION__STORE_LOWER);
+    lexer_fsm_table_set(LEX_FSM__AMP, LEX_FSM_CLASS__H, LEX_FSM__HEXA_START, LEX_FSM_ACTION__STORE_LOWER);
+
+    const LexerFSMState integer_states[][2] = {
+            {LEX_FSM__BINARY_START, LEX_FSM__BINARY_UNFINISHED},
+            {LEX_FSM__BINARY_UNFINISHED, LEX_FSM__BINARY_UNFINISHED},
+            {LEX_FSM__OCTA_START, LEX_FSM__OCTA_UNFINISHED},
+            {LEX_FSM__OCTA_UNFINISHED, LEX_FSM__OCTA_UNFINISHED},
+            {LEX_FSM__HEXA_START, LEX_FSM__HEXA_UNFINISHED},
+            {LEX_FSM__HEXA_UNFINISHED, LEX_FSM__HEXA_UNFINISHED},
+    };
+    for(size_t i = 0; i < sizeof(integer_states) / sizeof(*integer_states); i++)
+        lexer_fsm_table_set_row(integer_states[i][0], LEX_FSM__INTEGER_LITERAL_FINISHED, LEX_FSM_ACTION__REWIND);
+    for(size_t i = 0; i < 2; i++)
+        lexer_fsm_table_set(
+                integer_states[i][0], LEX_FSM_CLASS__BINARY_DIGIT, integer_states[i][1], LEX_FSM_ACTION__STORE
+        );
+    for(size_t i = 2; i < 4; i++)
+        SET_TRANSITIONS(integer_states[i][0], OCTA_DIGITS, integer_states[i][1], LEX_FSM_ACTION__STORE);
+    for(size_t i = 4; i < 6; i++) {
+        SET_TRANSITIONS(integer_states[i][0], DIGITS, integer_states[i][1], LEX_FSM_ACTION__STORE);
+        SET_TRANSITIONS(integer_states[i][0], HEXA_LETTERS, integer_states[i][1], LEX_FSM_ACTION__STORE_LOWER);
+    }
+
+    // Operator unfinished states
+    const LexerFSMState operator_states[][3] = {
+            {LEX_FSM__ADD_UNFINISHED, LEX_FSM__ADD, LEX_FSM__ASSIGN_ADD},
+            {LEX_FSM__SUBTRACT_UNFINISHED, LEX_FSM__SUBTRACT, LEX_FSM__ASSIGN_SUB},
+            {LEX_FSM__MULTIPLY_UNFINISHED, LEX_FSM__MULTIPLY, LEX_FSM__ASSIGN_MULTIPLY},
+            {LEX_FSM__INTEGER_DIVIDE_UNFINISHED, LEX_FSM__INTEGER_DIVIDE, LEX_FSM__ASSIGN_INT_DIVIDE},
+    };
+    for(size_t i = 0; i < sizeof(operator_states) / sizeof(*operator_states); i++) {
+        lexer_fsm_table_set_row(operator_states[i][0], operator_states[i][1], LEX_FSM_ACTION__REWIND);
+        lexer_fsm_table_set(operator_states[i][0], LEX_FSM_CLASS__EQUAL, operator_states[i][2], LEX_FSM_ACTION__NONE);
+    }
+
+    // Strings
+    lexer_fsm_table_set_row(LEX_FSM__STRING_EXC, LEX_FSM__ERROR, LEX_FSM_ACTION__STRING_FORMAT_ERROR);
+    lexer_fsm_table_set(
+            LEX_FSM__STRING_EXC, LEX_FSM_CLASS__QUOTE, LEX_FSM__STRING_LOAD, LEX_FSM_ACTION__STRING_RUN
+    );
+
+    lexer_fsm_table_set_row(LEX_FSM__STRING_LOAD, LEX_FSM__STRING_LOAD, LEX_FSM_ACTION__STORE_STRING_RUN);
+    SET_TRANSITIONS(LEX_FSM__STRING_LOAD, STRING_ERRORS, LEX_FSM__ERROR, LEX_FSM_ACTION__STRING_FORMAT_ERROR);
+    lexer_fsm_table_set(LEX_FSM__STRING_LOAD, LEX_FSM_CLASS__QUOTE, LEX_FSM__STRING_VALUE, LEX_FSM_ACTION__NONE);
+    lexer_fsm_table_set(LEX_FSM__STRING_LOAD, LEX_FSM_CLASS__BACKSLASH, LEX_FSM__STRING_SLASH, LEX_FSM_ACTION__NONE);
+
+    lexer_fsm_table_set_row(LEX_FSM__STRING_SLASH, LEX_FSM__ERROR, LEX_FSM_ACTION__STRING_FORMAT_ERROR);
+    SET_TRANSITIONS(
+            LEX_FSM__STRING_SLASH, DIGITS, LEX_FSM__STRING_NUMERIC_CHAR, LEX_FSM_ACTION__NUMERIC_CHAR_START
+    );
+    SET_TRANSITIONS(LEX_FSM__STRING_SLASH, ESCAPES, LEX_FSM__STRING_LOAD, LEX_FSM_ACTION__ESCAPE);
+
+    lexer_fsm_table_set_row(LEX_FSM__STRING_NUMERIC_CHAR, LEX_FSM__ERROR, LEX_FSM_ACTION__STRING_FORMAT_ERROR);
+    SET_TRANSITIONS(
+            LEX_FSM__STRING_NUMERIC_CHAR, DIGITS, LEX_FSM__STRING_NUMERIC_CHAR, LEX_FSM_ACTION__NUMERIC_CHAR
+    );
+
+    // Integer and double literals
+    lexer_fsm_table_set_row(
+            LEX_FSM__INTEGER_LITERAL_UNFINISHED, LEX_FSM__INTEGER_LITERAL_FINISHED, LEX_FSM_ACTION__REWIND
+    );
+    SET_TRANSITIONS(
+            LEX_FSM__INTEGER_LITERAL_UNFINISHED, DIGITS, LEX_FSM__INTEGER_LITERAL_UNFINISHED, LEX_FSM_ACTION__STORE
+    );
+    lexer_fsm_table_set(
+            LEX_FSM__INTEGER_LITERAL_UNFINISHED, LEX_FSM_CLASS__DOT, LEX_FSM__DOUBLE_DOT, LEX_FSM_ACTION__STORE
+    );
+    SET_TRANSITIONS(LEX_FSM__INTEGER_LITERAL_UNFINISHED, EXPONENTS, LEX_FSM__DOUBLE_E, LEX_FSM_ACTION__STORE);
+
+    lexer_fsm_table_set_row(LEX_FSM__DOUBLE_DOT, LEX_FSM__ERROR, LEX_FSM_ACTION__DOUBLE_FORMAT_ERROR);
+    SET_TRANSITIONS(LEX_FSM__DOUBLE_DOT, DIGITS, LEX_FSM__DOUBLE_UNFINISHED, LEX_FSM_ACTION__STORE);
+
+    lexer_fsm_table_set_row(LEX_FSM__DOUBLE_UNFINISHED, LEX_FSM__DOUBLE_FINISHED, LEX_FSM_ACTION__REWIND);
+    SET_TRANSITIONS(LEX_FSM__DOUBLE_UNFINISHED, DIGITS, LEX_FSM__DOUBLE_UNFINISHED, LEX_FSM_ACTION__STORE);
+    SET_TRANSITIONS(LEX_FSM__DOUBLE_UNFINISHED, EXPONENTS, LEX_FSM__DOUBLE_E, LEX_FSM_ACTION__STORE);
+
+    lexer_fsm_table_set_row(LEX_FSM__DOUBLE_E, LEX_FSM__ERROR, LEX_FSM_ACTION__DOUBLE_FORMAT_ERROR);
+    SET_TRANSITIONS(LEX_FSM__DOUBLE_E, DIGITS, LEX_FSM__DOUBLE_E_UNFINISHED, LEX_FSM_ACTION__STORE);
+    lexer_fsm_table_set(LEX_FSM__DOUBLE_E, LEX_FSM_CLASS__ADD, LEX_FSM__DOUBLE_E_SIGN, LEX_FSM_ACTION__STORE);
+    lexer_fsm_table_set(LEX_FSM__DOUBLE_E, LEX_FSM_CLASS__SUBTRACT, LEX_FSM__DOUBLE_E_SIGN, LEX_FSM_ACTION__STORE);
+
+    lexer_fsm_table_set_row(LEX_FSM__DOUBLE_E_SIGN, LEX_FSM__ERROR, LEX_FSM_ACTION__DOUBLE_FORMAT_ERROR);
+    SET_TRANSITIONS(LEX_FSM__DOUBLE_E_SIGN, DIGITS, LEX_FSM__DOUBLE_E_UNFINISHED, LEX_FSM_ACTION__STORE);
+
+    lexer_fsm_table_set_row(LEX_FSM__DOUBLE_E_UNFINISHED, LEX_FSM__DOUBLE_FINISHED, LEX_FSM_ACTION__REWIND);
+    SET_TRANSITIONS(LEX_FSM__DOUBLE_E_UNFINISHED, DIGITS, LEX_FSM__DOUBLE_E_UNFINISHED, LEX_FSM_ACTION__STORE);
+
+    // Relation operators
+    lexer_fsm_table_set_row(LEX_FSM__LEFT_SHARP_BRACKET, LEX_FSM__SMALLER, LEX_FSM_ACTION__REWIND);
+    lexer_fsm_table_set(
+            LEX_FSM__LEFT_SHARP_BRACKET, LEX_FSM_CLASS__EQUAL, LEX_FSM__SMALLER_EQUAL, LEX_FSM_ACTION__NONE
+    );
+    lexer_fsm_table_set(
+            LEX_FSM__LEFT_SHARP_BRACKET, LEX_FSM_CLASS__BIGGER, LEX_FSM__SMALLER_BIGGER, LEX_FSM_ACTION__NONE
+    );
+    lexer_fsm_table_set_row(LEX_FSM__RIGHT_SHARP_BRACKET, LEX_FSM__BIGGER, LEX_FSM_ACTION__REWIND);
+    lexer_fsm_table_set(
+            LEX_FSM__RIGHT_SHARP_BRACKET, LEX_FSM_CLASS__EQUAL, LEX_FSM__BIGGER_EQUAL, LEX_FSM_ACTION__NONE
+    );
+
+    // Identifiers
+    lexer_fsm_table_set_row(LEX_FSM__IDENTIFIER_UNFINISHED, LEX_FSM__IDENTIFIER_FINISHED, LEX_FSM_ACTION__KEYWORD);
+    lexer_fsm_table_set(
+            LEX_FSM__IDENTIFIER_UNFINISHED, LEX_FSM_CLASS__UNDERSCORE, LEX_FSM__IDENTIFIER_UNFINISHED,
+            LEX_FSM_ACTION__STORE_LOWER
+    );
+    SET_TRANSITIONS(
+            LEX_FSM__IDENTIFIER_UNFINISHED, LETTERS, LEX_FSM__IDENTIFIER_UNFINISHED, LEX_FSM_ACTION__STORE_LOWER
+    );
+    SET_TRANSITIONS(LEX_FSM__IDENTIFIER_UNFINISHED, DIGITS, LEX_FSM__IDENTIFIER_UNFINISHED, LEX_FSM_ACTION__STORE);
+
+    // Comments
+    lexer_fsm_table_set_row(LEX_FSM__SLASH, LEX_FSM__DIVIDE, LEX_FSM_ACTION__REWIND);
+    lexer_fsm_table_set(LEX_FSM__SLASH, LEX_FSM_CLASS__EQUAL, LEX_FSM__ASSIGN_DIVIDE, LEX_FSM_ACTION__NONE);
+    lexer_fsm_table_set(
+            LEX_FSM__SLASH, LEX_FSM_CLASS__APOSTROPHE, LEX_FSM__COMMENT_BLOCK, LEX_FSM_ACTION__SKIP_COMMENT
+    );
+
+    lexer_fsm_table_set_row(LEX_FSM__COMMENT_LINE, LEX_FSM__COMMENT_LINE, LEX_FSM_ACTION__SKIP_LINE);
+    SET_TRANSITIONS(LEX_FSM__COMMENT_LINE, LINE_ENDS, LEX_FSM__INIT, LEX_FSM_ACTION__REWIND);
+
+    lexer_fsm_table_set_row(LEX_FSM__COMMENT_BLOCK, LEX_FSM__COMMENT_BLOCK, LEX_FSM_ACTION__SKIP_COMMENT);
+    lexer_fsm_table_set(LEX_FSM__COMMENT_BLOCK, LEX_FSM_CLASS__EOF, LEX_FSM__ERROR, LEX_FSM_ACTION__NONE);
+    lexer_fsm_table_set(
+            LEX_FSM__COMMENT_BLOCK, LEX_FSM_CLASS__APOSTROPHE, LEX_FSM__COMMENT_BLOCK_END, LEX_FSM_ACTION__NONE
+    );
+
+    lexer_fsm_table_set_row(LEX_FSM__COMMENT_BLOCK_END, LEX_FSM__COMMENT_BLOCK, LEX_FSM_ACTION__SKIP_COMMENT);
+    lexer_fsm_table_set(LEX_FSM__COMMENT_BLOCK_END, LEX_FSM_CLASS__SLASH, LEX_FSM__INIT, LEX_FSM_ACTION__NONE);
+}
+
+static void lexer_fsm_table_init() {
+    static bool initialized = false;
+    if(initialized)
+        return;
+
+    lexer_fsm_char_classes_init();
+    lexer_fsm_transitions_init();
+    initialized = true;
+}
+
+static LexerFSMState lexer_fsm_table_numeric_char(LexerFSM* lexer_fsm, int c) {
+    lexer_fsm->numeric_char_value[++lexer_fsm->numeric_char_position] = (char) c;
+    if(lexer_fsm->numeric_char_position < 2)
+        return LEX_FSM__STRING_NUMERIC_CHAR;
+
+    lexer_fsm->numeric_char_value[3] = '\0';
+    int numeric_char_value = atoi(lexer_fsm->numeric_char_value);
+
+    if(numeric_char_value > 0 && numeric_char_value <= 255) {
+        string_append_c(lexer_fsm->stream_buffer, (char) numeric_char_value);
+        return LEX_FSM__STRING_LOAD;
+    }
+    // not in escape range
+    lexer_fsm->lexer_error = LEXER_ERROR__STRING_FORMAT;
+    return LEX_FSM__ERROR;
+}
+
+static inline LexerFSMState lexer_fsm_table_step(LexerFSM* lexer_fsm, LexerFSMState prev_state) {
+    const int c = LEXER_FSM_READ_CHAR(lexer_fsm);
+
+    if(prev_state >= LEXER_FSM_TABLE_STATES_COUNT) {
+        lexer_fsm->lexer_error = LEXER_ERROR__ERROR_LEXEM;
+        return LEX_FSM__ERROR;
+    }
+
+    const LexerFSMTransition transition = lexer_fsm_transitions[prev_state][CHAR_CLASS(c)];
+    switch(transition.action) {
+        case LEX_FSM_ACTION__NONE:
+            break;
+        case LEX_FSM_ACTION__STORE:
+            string_append_c(lexer_fsm->stream_buffer, (char) c);
+            break;
+        case LEX_FSM_ACTION__STORE_LOWER:
+            string_append_c(lexer_fsm->stream_buffer, (char) LOWER_CHAR(c));
+            break;
+        case LEX_FSM_ACTION__REWIND:
+            lexer_fsm_rewind_char(lexer_fsm, c);
+            break;
+        case LEX_FSM_ACTION__EOL:
+            lexer_fsm->line++;
+            break;
+        case LEX_FSM_ACTION__KEYWORD:
+            lexer_fsm_rewind_char(lexer_fsm, c);
+            return lexer_fsm_get_identifier_state_with_length(
+                    string_content(lexer_fsm->stream_buffer),
+                    string_length(lexer_fsm->stream_buffer)
+            );
+        case LEX_FSM_ACTION__ESCAPE:
+            string_append_c(lexer_fsm->stream_buffer, (char) (c == 'n' ? '\n' : c == 't' ? '\t' : c));
+            lexer_fsm_store_string_run(lexer_fsm);
+            break;
+        case LEX_FSM_ACTION__STORE_STRING_RUN:
+            string_append_c(lexer_fsm->stream_buffer, (char) c);
+            lexer_fsm_store_string_run(lexer_fsm);
+            break;
+        case LEX_FSM_ACTION__STRING_RUN:
+            lexer_fsm_store_string_run(lexer_fsm);
+            break;
+        case LEX_FSM_ACTION__SKIP_WHITESPACE:
+            lexer_fsm_skip_whitespace(lexer_fsm);
+            break;
+        case LEX_FSM_ACTION__SKIP_LINE:
+            lexer_fsm_skip_to_char(lexer_fsm, '\n');
+            break;
+        case LEX_FSM_ACTION__SKIP_COMMENT:
+            lexer_fsm_skip_to_char(lexer_fsm, '\'');
+            break;
+        case LEX_FSM_ACTION__NUMERIC_CHAR_START:
+            lexer_fsm->numeric_char_value[lexer_fsm->numeric_char_position = 0] = (char) c;
+            break;
+        case LEX_FSM_ACTION__NUMERIC_CHAR:
+            return lexer_fsm_table_numeric_char(lexer_fsm, c);
+        case LEX_FSM_ACTION__STRING_FORMAT_ERROR:
+            lexer_fsm->lexer_error = LEXER_ERROR__STRING_FORMAT;
+            break;
+        case LEX_FSM_ACTION__DOUBLE_FORMAT_ERROR:
+            lexer_fsm->lexer_error = LEXER_ERROR__DOUBLE_FORMAT;
+            break;
+        case LEX_FSM_ACTION__LEXEM_ERROR:
+            lexer_fsm->lexer_error = LEXER_ERROR__ERROR_LEXEM;
+            break;
+        default:
+            break;
+    }
+    return (LexerFSMState) transition.next_state;
+}
+
+LexerFSMState lexer_fsm_table_next_state(LexerFSM* lexer_fsm, LexerFSMState prev_state) {
+    NULL_POINTER_CHECK(lexer_fsm, LEX_FSM__ERROR);
+    lexer_fsm_table_init();
+
+    return lexer_fsm_table_step(lexer_fsm, prev_state);
+}
+
+LexerFSMState lexer_fsm_table_next_final_state(LexerFSM* lexer_fsm) {
+    NULL_POINTER_CHECK(lexer_fsm, LEX_FSM__ERROR);
+    lexer_fsm_table_init();
+
+    LexerFSMState actual_state = LEX_FSM__INIT;
+    do {
+        actual_state = lexer_fsm_table_step(lexer_fsm, actual_state);
+    } while(!LEXER_FSM_IS_FINAL_STATE(actual_state));
+    return actual_state;
+}
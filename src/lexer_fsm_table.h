@@ -0,0 +1,103 @@
+#ifndef _LEXER_FSM_TABLE_H
+#define _LEXER_FSM_TABLE_H
+
+#include "lexer_fsm.h"
+
+// Count of unfinished states, which have row in transitions table
+#define LEXER_FSM_TABLE_STATES_COUNT LEX_FSM__ADD
+
+/**
+ * @brief Classes of chars, chars of one class have same transitions in all states
+ */
+typedef enum {
+    LEX_FSM_CLASS__EOF,
+    LEX_FSM_CLASS__EOL,
+    LEX_FSM_CLASS__SPACE, // ' '
+    LEX_FSM_CLASS__WHITESPACE, // other white chars from isspace() except new line
+    LEX_FSM_CLASS__CONTROL, // other chars < 32
+    LEX_FSM_CLASS__OTHER,
+
+    LEX_FSM_CLASS__UNDERSCORE,
+    LEX_FSM_CLASS__B, // also hexadecimal digit
+    LEX_FSM_CLASS__E, // also hexadecimal digit
+    LEX_FSM_CLASS__HEXA_LETTER, // a, c, d, f
+    LEX_FSM_CLASS__O,
+    LEX_FSM_CLASS__H,
+    LEX_FSM_CLASS__N,
+    LEX_FSM_CLASS__T,
+    LEX_FSM_CLASS__LETTER,
+
+    LEX_FSM_CLASS__BINARY_DIGIT, // 0, 1
+    LEX_FSM_CLASS__OCTA_DIGIT, // 2-7
+    LEX_FSM_CLASS__DIGIT, // 8, 9
+
+    LEX_FSM_CLASS__EXCLAMATION,
+    LEX_FSM_CLASS__QUOTE,
+    LEX_FSM_CLASS__APOSTROPHE,
+    LEX_FSM_CLASS__SLASH,
+    LEX_FSM_CLASS__BACKSLASH,
+    LEX_FSM_CLASS__ADD,
+    LEX_FSM_CLASS__SUBTRACT,
+    LEX_FSM_CLASS__MULTIPLY,
+    LEX_FSM_CLASS__LEFT_BRACKET,
+    LEX_FSM_CLASS__RIGHT_BRACKET,
+    LEX_FSM_CLASS__SMALLER,
+    LEX_FSM_CLASS__BIGGER,
+    LEX_FSM_CLASS__EQUAL,
+    LEX_FSM_CLASS__SEMICOLON,
+    LEX_FSM_CLASS__COMMA,
+    LEX_FSM_CLASS__AMP,
+    LEX_FSM_CLASS__DOT,
+
+    LEX_FSM_CLASS__COUNT
+} LexerFSMCharClass;
+
+/**
+ * @brief Side effects of transitions
+ */
+typedef enum {
+    LEX_FSM_ACTION__NONE,
+    LEX_FSM_ACTION__STORE, // append char to stream buffer
+    LEX_FSM_ACTION__STORE_LOWER, // append lower case char to stream buffer
+    LEX_FSM_ACTION__REWIND, // return char back to input
+    LEX_FSM_ACTION__EOL, // count new line
+    LEX_FSM_ACTION__KEYWORD, // return char back and resolve identifier state from stream buffer
+    LEX_FSM_ACTION__ESCAPE, // append escaped char of string and following run of plain chars
+    LEX_FSM_ACTION__STRING_RUN, // append run of plain string chars
+    LEX_FSM_ACTION__STORE_STRING_RUN, // append char and following run of plain string chars
+    LEX_FSM_ACTION__SKIP_WHITESPACE, // skip following white chars except new line
+    LEX_FSM_ACTION__SKIP_LINE, // skip chars to new line
+    LEX_FSM_ACTION__SKIP_COMMENT, // skip chars to apostrophe
+    LEX_FSM_ACTION__NUMERIC_CHAR_START, // first digit of \ddd sequence
+    LEX_FSM_ACTION__NUMERIC_CHAR, // next digits of \ddd sequence, next state is resolved by value
+    LEX_FSM_ACTION__STRING_FORMAT_ERROR,
+    LEX_FSM_ACTION__DOUBLE_FORMAT_ERROR,
+    LEX_FSM_ACTION__LEXEM_ERROR,
+} LexerFSMAction;
+
+/**
+ * @brief Single cell of transitions table
+ */
+typedef struct lexer_fsm_transition_t {
+    unsigned short next_state;
+    unsigned char action;
+} LexerFSMTransition;
+
+/**
+ * @brief Get next state from prev state and next symbol by transitions table
+ *
+ * @param LexerFSM* lexer_fsm
+ * @param LexerFSMState prev_state
+ * @return LexerFSMState Next state
+ */
+LexerFSMState lexer_fsm_table_next_state(LexerFSM* lexer_fsm, LexerFSMState prev_state);
+
+/**
+ * @brief Get final state of next lexem by transitions table
+ *
+ * @param LexerFSM* lexer_fsm
+ * @return LexerFSMState Final state
+ */
+LexerFSMState lexer_fsm_table_next_final_state(LexerFSM* lexer_fsm);
+
+#endif //_LEXER_FSM_TABLE_H
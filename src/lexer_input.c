@@ -0,0 +1,133 @@
+#if !defined(_WIN32)
+// mmap & fileno are not part of C99
+#define _POSIX_C_SOURCE 200809L
+#define LEXER_INPUT_MMAP
+#endif
+
+#include "lexer_input.h"
+#include "memory.h"
+#include "debug.h"
+
+#ifdef LEXER_INPUT_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+static LexerInput* lexer_input_init(LexerInputSource source) {
+    LexerInput* input = (LexerInput*) memory_alloc(sizeof(LexerInput));
+    NULL_POINTER_CHECK(input, NULL);
+
+    input->buffer = NULL;
+    input->position = 0;
+    input->length = 0;
+    input->source = source;
+    input->stream = NULL;
+    input->file = NULL;
+    input->block = NULL;
+    input->close_file = false;
+    input->eof = false;
+    return input;
+}
+
+LexerInput* lexer_input_init_stream(lexer_input_stream_f stream) {
+    NULL_POINTER_CHECK(stream, NULL);
+    LexerInput* input = lexer_input_init(LEXER_INPUT_SOURCE__STREAM);
+    NULL_POINTER_CHECK(input, NULL);
+
+    input->stream = stream;
+    return input;
+}
+
+LexerInput* lexer_input_init_memory(const char* content, size_t length) {
+    NULL_POINTER_CHECK(content, NULL);
+    LexerInput* input = lexer_input_init(LEXER_INPUT_SOURCE__MEMORY);
+    NULL_POINTER_CHECK(input, NULL);
+
+    input->buffer = content;
+    input->length = length;
+    return input;
+}
+
+LexerInput* lexer_input_init_file(FILE* file) {
+    NULL_POINTER_CHECK(file, NULL);
+    LexerInput* input = lexer_input_init(LEXER_INPUT_SOURCE__FILE);
+    NULL_POINTER_CHECK(input, NULL);
+
+    input->file = file;
+    input->block = (char*) memory_alloc(LEXER_INPUT_BLOCK_SIZE);
+    input->buffer = input->block;
+    return input;
+}
+
+LexerInput* lexer_input_init_path(const char* path) {
+    NULL_POINTER_CHECK(path, NULL);
+    FILE* file = fopen(path, "rb");
+    if(file == NULL) {
+        LOG_WARNING("Cannot open input file %s.", path);
+        return NULL;
+    }
+
+#ifdef LEXER_INPUT_MMAP
+    struct stat file_stat;
+    if(fstat(fileno(file), &file_stat) == 0 && S_ISREG(file_stat.st_mode) && file_stat.st_size > 0) {
+        void* mapped = mmap(NULL, (size_t) file_stat.st_size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+        if(mapped != MAP_FAILED) {
+            // mapping is valid also after the file is closed
+            fclose(file);
+            LexerInput* input = lexer_input_init(LEXER_INPUT_SOURCE__MAPPED);
+            NULL_POINTER_CHECK(input, NULL);
+            input->buffer = (const char*) mapped;
+            input->length = (size_t) file_stat.st_size;
+            return input;
+        }
+        LOG_INFO("Mapping of %s failed, reading by blocks.", path);
+    }
+#endif
+
+    LexerInput* input = lexer_input_init_file(file);
+    NULL_POINTER_CHECK(input, NULL);
+    input->close_file = true;
+    return input;
+}
+
+void lexer_input_free(LexerInput** input) {
+    NULL_POINTER_CHECK(input,);
+    NULL_POINTER_CHECK(*input,);
+
+    switch((*input)->source) {
+        case LEXER_INPUT_SOURCE__FILE:
+            memory_free((*input)->block);
+            if((*input)->close_file)
+                fclose((*input)->file);
+            break;
+        case LEXER_INPUT_SOURCE__MAPPED:
+#ifdef LEXER_INPUT_MMAP
+            munmap((void*) (*input)->buffer, (*input)->length);
+#endif
+            break;
+        default:
+            break;
+    }
+    memory_free(*input);
+    *input = NULL;
+}
+
+bool lexer_input_refill(LexerInput* input) {
+    NULL_POINTER_CHECK(input, false);
+    if(input->source != LEXER_INPUT_SOURCE__FILE || input->eof)
+        return false;
+
+    input->position = 0;
+    input->length = fread(input->block, sizeof(char), LEXER_INPUT_BLOCK_SIZE, input->file);
+    // interactive input would block again after end of file
+    input->eof = input->length == 0 || feof(input->file);
+    return input->length > 0;
+}
+
+int lexer_input_next_char(LexerInput* input) {
+    NULL_POINTER_CHECK(input, EOF);
+    if(input->source == LEXER_INPUT_SOURCE__STREAM)
+        return input->stream();
+
+    return LEXER_INPUT_NEXT_CHAR(input);
+}
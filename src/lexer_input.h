@@ -0,0 +1,106 @@
+#ifndef _LEXER_INPUT_H
+#define _LEXER_INPUT_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+// Size of block for buffered reads from file
+#define LEXER_INPUT_BLOCK_SIZE (64 * 1024)
+
+/**
+ * @brief Get next char from contiguous buffer of input or EOF, if actual block is exhausted and no next block was loaded
+ */
+#define LEXER_INPUT_NEXT_CHAR(input) (\
+    (input)->position < (input)->length || lexer_input_refill(input) ?\
+        (int) (unsigned char) (input)->buffer[(input)->position++] : EOF\
+)
+
+/**
+ * @brief Pointer to function, which streams the characters
+ */
+typedef int (* lexer_input_stream_f)();
+
+/**
+ * @brief Sources of input for the lexer
+ */
+typedef enum {
+    LEXER_INPUT_SOURCE__STREAM, // char by char from callback, buffer is never used
+    LEXER_INPUT_SOURCE__MEMORY, // whole input in foreign memory block
+    LEXER_INPUT_SOURCE__FILE, // blocks read from opened file
+    LEXER_INPUT_SOURCE__MAPPED, // whole input mapped from file
+} LexerInputSource;
+
+/**
+ * @brief Input of lexer, chars are scanned from contiguous buffer, which is refilled by blocks
+ */
+typedef struct lexer_input_t {
+    const char* buffer; // actual contiguous block of input
+    size_t position; // position of next char in buffer
+    size_t length; // count of valid chars in buffer
+
+    LexerInputSource source;
+    lexer_input_stream_f stream; // callback for stream source
+    FILE* file; // file for buffered reads
+    char* block; // owned block for buffered reads
+    bool close_file; // file was opened by input
+    bool eof; // end of file was reached, file is not read again
+} LexerInput;
+
+/**
+ * @brief Creates input, which streams chars from callback one by one.
+ *
+ * @param stream callback to get chars
+ * @return LexerInput*
+ */
+LexerInput* lexer_input_init_stream(lexer_input_stream_f stream);
+
+/**
+ * @brief Creates input scanning given memory, content must be valid for whole life of input.
+ *
+ * @param content chars to scan
+ * @param length count of chars
+ * @return LexerInput*
+ */
+LexerInput* lexer_input_init_memory(const char* content, size_t length);
+
+/**
+ * @brief Creates input reading given opened file in blocks of LEXER_INPUT_BLOCK_SIZE.
+ *
+ * @param file opened file, eg. stdin
+ * @return LexerInput*
+ */
+LexerInput* lexer_input_init_file(FILE* file);
+
+/**
+ * @brief Creates input with memory mapped file from given path, in case of unavailable mapping file is read in blocks.
+ *
+ * @param path path to file
+ * @return LexerInput* or NULL, if file cannot be opened
+ */
+LexerInput* lexer_input_init_path(const char* path);
+
+/**
+ * @brief Frees input with its block or mapping and closes owned file.
+ *
+ * @param input
+ */
+void lexer_input_free(LexerInput** input);
+
+/**
+ * @brief Loads next block of input into buffer, after end of file is reached, file is not read any more.
+ *
+ * @param input
+ * @return true, if at least one char was loaded
+ */
+bool lexer_input_refill(LexerInput* input);
+
+/**
+ * @brief Get next char from input, stream sources are called directly.
+ *
+ * @param input
+ * @return int next char or EOF
+ */
+int lexer_input_next_char(LexerInput* input);
+
+#endif //_LEXER_INPUT_H
@@ -0,0 +1,93 @@
+#include <string.h>
+#include "lexer_scan.h"
+
+#if defined(LEXER_SCAN_AVX2)
+#include <immintrin.h>
+#elif defined(LEXER_SCAN_SSE2)
+#include <emmintrin.h>
+#endif
+
+#define IS_WHITESPACE(c) ((c) == ' ' || ((c) >= '\t' && (c) <= '\r' && (c) != '\n'))
+#define IS_PLAIN_STRING_CHAR(c) ((c) >= 32 && (c) != '"' && (c) != '\\')
+
+#if defined(LEXER_SCAN_AVX2)
+
+// masks have set bits for interesting chars, which end the run
+static inline unsigned lexer_scan_whitespace_mask(const char* buffer) {
+    const __m256i chars = _mm256_loadu_si256((const __m256i*) buffer);
+    // c - '\t' <= '\r' - '\t' as unsigned
+    const __m256i shifted = _mm256_sub_epi8(chars, _mm256_set1_epi8('\t'));
+    const __m256i in_range = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8('\r' - '\t')), shifted);
+    const __m256i new_line = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\n'));
+    const __m256i space = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(' '));
+    const __m256i white = _mm256_or_si256(_mm256_andnot_si256(new_line, in_range), space);
+    return ~(unsigned) _mm256_movemask_epi8(white);
+}
+
+static inline unsigned lexer_scan_string_mask(const char* buffer) {
+    const __m256i chars = _mm256_loadu_si256((const __m256i*) buffer);
+    const __m256i control = _mm256_cmpeq_epi8(_mm256_max_epu8(chars, _mm256_set1_epi8(31)), _mm256_set1_epi8(31));
+    const __m256i quote = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('"'));
+    const __m256i backslash = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\\'));
+    return (unsigned) _mm256_movemask_epi8(_mm256_or_si256(control, _mm256_or_si256(quote, backslash)));
+}
+
+#define LEXER_SCAN_VECTOR_SIZE 32
+
+#elif defined(LEXER_SCAN_SSE2)
+
+static inline unsigned lexer_scan_whitespace_mask(const char* buffer) {
+    const __m128i chars = _mm_loadu_si128((const __m128i*) buffer);
+    const __m128i shifted = _mm_sub_epi8(chars, _mm_set1_epi8('\t'));
+    const __m128i in_range = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8('\r' - '\t')), shifted);
+    const __m128i new_line = _mm_cmpeq_epi8(chars, _mm_set1_epi8('\n'));
+    const __m128i space = _mm_cmpeq_epi8(chars, _mm_set1_epi8(' '));
+    const __m128i white = _mm_or_si128(_mm_andnot_si128(new_line, in_range), space);
+    return ~(unsigned) _mm_movemask_epi8(white) & 0xFFFFu;
+}
+
+static inline unsigned lexer_scan_string_mask(const char* buffer) {
+    const __m128i chars = _mm_loadu_si128((const __m128i*) buffer);
+    const __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(chars, _mm_set1_epi8(31)), _mm_set1_epi8(31));
+    const __m128i quote = _mm_cmpeq_epi8(chars, _mm_set1_epi8('"'));
+    const __m128i backslash = _mm_cmpeq_epi8(chars, _mm_set1_epi8('\\'));
+    return (unsigned) _mm_movemask_epi8(_mm_or_si128(control, _mm_or_si128(quote, backslash)));
+}
+
+#define LEXER_SCAN_VECTOR_SIZE 16
+
+#endif
+
+size_t lexer_scan_whitespace(const char* buffer, size_t length) {
+    size_t position = 0;
+#ifdef LEXER_SCAN_VECTOR_SIZE
+    for(; position + LEXER_SCAN_VECTOR_SIZE <= length; position += LEXER_SCAN_VECTOR_SIZE) {
+        const unsigned mask = lexer_scan_whitespace_mask(buffer + position);
+        if(mask != 0)
+            return position + __builtin_ctz(mask);
+    }
+#endif
+    while(position < length && IS_WHITESPACE(buffer[position]))
+        position++;
+    return position;
+}
+
+size_t lexer_scan_string(const char* buffer, size_t length) {
+    size_t position = 0;
+#ifdef LEXER_SCAN_VECTOR_SIZE
+    for(; position + LEXER_SCAN_VECTOR_SIZE <= length; position += LEXER_SCAN_VECTOR_SIZE) {
+        const unsigned mask = lexer_scan_string_mask(buffer + position);
+        if(mask != 0)
+            return position + __builtin_ctz(mask);
+    }
+#endif
+    while(position < length && IS_PLAIN_STRING_CHAR((unsigned char) buffer[position]))
+        position++;
+    return position;
+}
+
+size_t lexer_scan_to_char(const char* buffer, size_t length, char c) {
+    // memchr of common C libraries is already vectorized
+    const char* found = (const char*) memchr(buffer, c, length);
+    return found == NULL ? length : (size_t) (found - buffer);
+}
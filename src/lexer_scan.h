@@ -0,0 +1,45 @@
+#ifndef _LEXER_SCAN_H
+#define _LEXER_SCAN_H
+
+#include <stdlib.h>
+
+/**
+ * Kernels scanning runs of uninteresting chars in input buffer of lexer. Vector variants are used
+ * with GCC compatible compilers targeting SSE2 or AVX2 (-mavx2), other targets use scalar loops.
+ */
+
+#if defined(__GNUC__) && defined(__AVX2__)
+#define LEXER_SCAN_AVX2
+#elif defined(__GNUC__) && defined(__SSE2__)
+#define LEXER_SCAN_SSE2
+#endif
+
+/**
+ * @brief Count leading white chars except new line.
+ *
+ * @param buffer chars to scan
+ * @param length count of chars in buffer
+ * @return size_t length of run of ' ', '\t', '\v', '\f' and '\r'
+ */
+size_t lexer_scan_whitespace(const char* buffer, size_t length);
+
+/**
+ * @brief Count leading chars of string literal, which are stored without change.
+ *
+ * @param buffer chars to scan
+ * @param length count of chars in buffer
+ * @return size_t length of run of chars >= 32 without '"' and '\\'
+ */
+size_t lexer_scan_string(const char* buffer, size_t length);
+
+/**
+ * @brief Count leading chars different from given char, eg. to end of line or comment.
+ *
+ * @param buffer chars to scan
+ * @param length count of chars in buffer
+ * @param c char to find
+ * @return size_t position of first given char or length
+ */
+size_t lexer_scan_to_char(const char* buffer, size_t length, char c);
+
+#endif //_LEXER_SCAN_H
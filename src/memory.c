@@ -1,3 +1,4 @@
+#include <stdint.h>
 #include "memory.h"
 
 #ifdef NDEBUG
@@ -6,6 +7,169 @@ MemoryManager memory_manager;
 
 #define memory_manager_log_stats(...)
 
+#define MEMORY_MANAGER_ALIGN(size) \
+    (((size) + MEMORY_MANAGER_ARENA_ALIGNMENT - 1) & ~((size_t) MEMORY_MANAGER_ARENA_ALIGNMENT - 1))
+#define MEMORY_MANAGER_CHUNK_DATA(chunk) ((char*) (chunk) + MEMORY_MANAGER_ALIGN(sizeof(MemoryManagerChunk)))
+
+// mark of arena blocks in page header, so free could distinguish them from separately allocated pages
+static MemoryManagerPage arena_block_mark;
+#define MEMORY_MANAGER_ARENA_BLOCK (&arena_block_mark)
+
+// marks of pooled blocks, position of mark determines size class of block
+static MemoryManagerPage pool_block_marks[MEMORY_MANAGER_POOL_CLASSES_COUNT];
+#define MEMORY_MANAGER_POOL_BLOCK(pool_index) (&pool_block_marks[(pool_index)])
+#define MEMORY_MANAGER_IS_POOL_BLOCK(page) \
+    ((uintptr_t) (page)->prev - (uintptr_t) pool_block_marks < sizeof(pool_block_marks))
+
+// capacity of page is stored before its header, so freed page could be reused by allocation of same size class
+#define MEMORY_MANAGER_PAGE_PREFIX_SIZE MEMORY_MANAGER_ALIGN(sizeof(size_t))
+#define MEMORY_MANAGER_PAGE_BASE(page) ((char*) (page) - MEMORY_MANAGER_PAGE_PREFIX_SIZE)
+#define MEMORY_MANAGER_PAGE_CAPACITY(page) (*(size_t*) MEMORY_MANAGER_PAGE_BASE(page))
+
+static int memory_manager_reuse_index(size_t size) {
+    size_t capacity = MEMORY_MANAGER_REUSE_MIN_SIZE;
+    for(int i = 0; i < MEMORY_MANAGER_REUSE_CLASSES_COUNT; ++i, capacity <<= 1) {
+        if(size <= capacity)
+            return i;
+    }
+    return -1;
+}
+
+static void memory_manager_page_unlink(MemoryManagerPage* page, MemoryManager* manager) {
+    if(page->prev == NULL) {
+        manager->head = page->next;
+    } else {
+        page->prev->next = page->next;
+    }
+    if(page->next != NULL) {
+        page->next->prev = page->prev;
+    }
+    page->next = page->prev = NULL;
+}
+
+static void* memory_manager_page_malloc(size_t size, MemoryManager* manager) {
+    const int reuse_index = memory_manager_reuse_index(size);
+    MemoryManagerPage* page = NULL;
+
+    if(reuse_index != -1) {
+        size = (size_t) MEMORY_MANAGER_REUSE_MIN_SIZE << reuse_index;
+        page = manager->reusable[reuse_index];
+        if(page != NULL)
+            manager->reusable[reuse_index] = page->next;
+    }
+    if(page == NULL) {
+        char* base = (char*) malloc(MEMORY_MANAGER_PAGE_PREFIX_SIZE + sizeof(MemoryManagerPage) + size);
+        MALLOC_CHECK(base);
+        page = (MemoryManagerPage*) (base + MEMORY_MANAGER_PAGE_PREFIX_SIZE);
+        MEMORY_MANAGER_PAGE_CAPACITY(page) = size;
+    }
+
+    if(manager->head != NULL)
+        manager->head->prev = page;
+
+    page->prev = NULL;
+    page->next = manager->head;
+    manager->head = page;
+
+    return (void*) (page + 1);
+}
+
+static void memory_manager_page_release(MemoryManagerPage* page, MemoryManager* manager) {
+    const int reuse_index = memory_manager_reuse_index(MEMORY_MANAGER_PAGE_CAPACITY(page));
+    if(reuse_index == -1) {
+        free(MEMORY_MANAGER_PAGE_BASE(page));
+        return;
+    }
+    page->next = manager->reusable[reuse_index];
+    manager->reusable[reuse_index] = page;
+}
+
+static void memory_manager_reusable_release(MemoryManager* manager) {
+    for(int i = 0; i < MEMORY_MANAGER_REUSE_CLASSES_COUNT; ++i) {
+        MemoryManagerPage* page = manager->reusable[i];
+        MemoryManagerPage* next = NULL;
+        while(page != NULL) {
+            next = page->next;
+            free(MEMORY_MANAGER_PAGE_BASE(page));
+            page = next;
+        }
+        manager->reusable[i] = NULL;
+    }
+}
+
+static void* memory_manager_pool_malloc(size_t size, MemoryManager* manager) {
+    const size_t pool_index = MEMORY_MANAGER_POOL_INDEX(size);
+    MemoryManagerPool* pool = &manager->pools[pool_index];
+    MemoryManagerPage* block = pool->recycled;
+
+    if(block != NULL) {
+        pool->recycled = block->next;
+    } else {
+        const size_t block_size = sizeof(MemoryManagerPage) + (pool_index + 1) * MEMORY_MANAGER_POOL_GRANULARITY;
+        if(manager->pool_slab_left < block_size) {
+            // slab is ordinary page, so it's released with others at exit
+            manager->pool_slab = (char*) memory_manager_page_malloc(MEMORY_MANAGER_POOL_SLAB_SIZE, manager);
+            if(manager->pool_slab == NULL)
+                return NULL;
+            manager->pool_slab_left = MEMORY_MANAGER_POOL_SLAB_SIZE;
+        }
+        block = (MemoryManagerPage*) manager->pool_slab;
+        manager->pool_slab += block_size;
+        manager->pool_slab_left -= block_size;
+    }
+    block->next = NULL;
+    block->prev = MEMORY_MANAGER_POOL_BLOCK(pool_index);
+    return (void*) (block + 1);
+}
+
+static void memory_manager_pool_free(MemoryManagerPage* block, MemoryManager* manager) {
+    MemoryManagerPool* pool = &manager->pools[block->prev - pool_block_marks];
+    block->next = pool->recycled;
+    pool->recycled = block;
+}
+
+static void memory_manager_pools_reset(MemoryManager* manager) {
+    for(int i = 0; i < MEMORY_MANAGER_POOL_CLASSES_COUNT; ++i)
+        manager->pools[i].recycled = NULL;
+    manager->pool_slab = NULL;
+    manager->pool_slab_left = 0;
+}
+
+static void* memory_manager_arena_malloc(size_t size, MemoryManager* manager) {
+    size = MEMORY_MANAGER_ALIGN(sizeof(MemoryManagerPage) + size);
+    MemoryManagerChunk* chunk = manager->chunks[manager->arena];
+
+    if(chunk == NULL || chunk->size - chunk->used < size) {
+        // big blocks get own chunk to not waste rest of actual chunk
+        const bool oversized = size > MEMORY_MANAGER_ARENA_CHUNK_SIZE / 4;
+        const size_t chunk_size = oversized ? size : MEMORY_MANAGER_ARENA_CHUNK_SIZE;
+
+        MemoryManagerChunk* new_chunk = (MemoryManagerChunk*) malloc(
+                MEMORY_MANAGER_ALIGN(sizeof(MemoryManagerChunk)) + chunk_size
+        );
+        MALLOC_CHECK(new_chunk);
+        new_chunk->size = chunk_size;
+        new_chunk->used = 0;
+
+        if(oversized && chunk != NULL) {
+            // keep actual chunk on top for next bump allocations
+            new_chunk->next = chunk->next;
+            chunk->next = new_chunk;
+            new_chunk->used = size;
+            MemoryManagerPage* page = (MemoryManagerPage*) MEMORY_MANAGER_CHUNK_DATA(new_chunk);
+            page->next = page->prev = MEMORY_MANAGER_ARENA_BLOCK;
+            return (void*) (page + 1);
+        }
+        new_chunk->next = chunk;
+        manager->chunks[manager->arena] = chunk = new_chunk;
+    }
+
+    MemoryManagerPage* page = (MemoryManagerPage*) (MEMORY_MANAGER_CHUNK_DATA(chunk) + chunk->used);
+    chunk->used += size;
+    page->next = page->prev = MEMORY_MANAGER_ARENA_BLOCK;
+    return (void*) (page + 1);
+}
+
 void* memory_manager_malloc(
         size_t size,
         const char* file,
@@ -24,20 +188,12 @@ void* memory_manager_malloc(
     if(manager == NULL)
         manager = &memory_manager;
 
+    if(manager->arena != MEMORY_MANAGER_ARENA_NONE)
+        return memory_manager_arena_malloc(size, manager);
+    if(size <= MEMORY_MANAGER_POOL_MAX_SIZE)
+        return memory_manager_pool_malloc(size, manager);
 
-    size_t total_size = sizeof(MemoryManagerPage) + size;
-
-    MemoryManagerPage* page = (MemoryManagerPage*) malloc(total_size);
-    MALLOC_CHECK(page);
-
-    if(manager->head != NULL)
-        manager->head->prev = page;
-
-    page->prev = NULL;
-    page->next = manager->head;
-    manager->head = page;
-
-    return (void*) (page + 1);
+    return memory_manager_page_malloc(size, manager);
 }
 
 void memory_manager_free(void* address,
@@ -53,22 +209,50 @@ void memory_manager_free(void* address,
         manager = &memory_manager;
 
     MemoryManagerPage* target_page = ((MemoryManagerPage*) address) - 1;
-
-    if(target_page->prev == NULL) {
-        manager->head = target_page->next;
-    } else {
-        target_page->prev->next = target_page->next;
-    }
-    if(target_page->next != NULL) {
-        target_page->next->prev = target_page->prev;
+    if(target_page->prev == MEMORY_MANAGER_ARENA_BLOCK)
+        // blocks in arena are released with whole chunks
+        return;
+    if(MEMORY_MANAGER_IS_POOL_BLOCK(target_page)) {
+        memory_manager_pool_free(target_page, manager);
+        return;
     }
 
-    free(target_page);
+    memory_manager_page_unlink(target_page, manager);
+    memory_manager_page_release(target_page, manager);
 }
 
 void memory_manager_free_lazy(void* address, MemoryManager* manager) {
-    UNUSED(address);
-    UNUSED(manager);
+    NULL_POINTER_CHECK(address,);
+    if(manager == NULL)
+        manager = &memory_manager;
+
+    MemoryManagerPage* target_page = ((MemoryManagerPage*) address) - 1;
+    if(target_page->prev == MEMORY_MANAGER_ARENA_BLOCK)
+        return;
+    // pooled blocks keep their mark, pages are moved from list of pages into queue
+    if(!MEMORY_MANAGER_IS_POOL_BLOCK(target_page))
+        memory_manager_page_unlink(target_page, manager);
+    target_page->next = manager->lazy;
+    manager->lazy = target_page;
+}
+
+void memory_manager_collect(MemoryManager* manager) {
+    if(manager == NULL)
+        manager = &memory_manager;
+    // pages not reused since last collection
+    memory_manager_reusable_release(manager);
+
+    MemoryManagerPage* page = manager->lazy;
+    MemoryManagerPage* next = NULL;
+    while(page != NULL) {
+        next = page->next;
+        if(MEMORY_MANAGER_IS_POOL_BLOCK(page))
+            memory_manager_pool_free(page, manager);
+        else
+            memory_manager_page_release(page, manager);
+        page = next;
+    }
+    manager->lazy = NULL;
 }
 
 void memory_manager_enter(MemoryManager* manager) {
@@ -79,6 +263,40 @@ void memory_manager_enter(MemoryManager* manager) {
         return;
     }
     manager->head = NULL;
+    manager->arena = MEMORY_MANAGER_ARENA_NONE;
+    for(int i = 0; i < MEMORY_MANAGER_ARENA__COUNT; ++i)
+        manager->chunks[i] = NULL;
+    for(int i = 0; i < MEMORY_MANAGER_REUSE_CLASSES_COUNT; ++i)
+        manager->reusable[i] = NULL;
+    manager->lazy = NULL;
+    memory_manager_pools_reset(manager);
+}
+
+void memory_manager_enter_tracking(MemoryManager* manager, MemoryManagerTracking tracking) {
+    UNUSED(tracking);
+    memory_manager_enter(manager);
+}
+
+MemoryManagerArena memory_manager_switch_arena(MemoryManager* manager, MemoryManagerArena arena) {
+    if(manager == NULL)
+        manager = &memory_manager;
+    const MemoryManagerArena previous = manager->arena;
+    manager->arena = arena;
+    return previous;
+}
+
+void memory_manager_drop_arena(MemoryManager* manager, MemoryManagerArena arena) {
+    if(manager == NULL)
+        manager = &memory_manager;
+    MemoryManagerChunk* chunk = manager->chunks[arena];
+    MemoryManagerChunk* next = NULL;
+
+    while(chunk != NULL) {
+        next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    manager->chunks[arena] = NULL;
 }
 
 void memory_manager_exit(MemoryManager* manager) {
@@ -89,10 +307,24 @@ void memory_manager_exit(MemoryManager* manager) {
 
     while(page != NULL) {
         next = page->next;
-        free(page);
+        free(MEMORY_MANAGER_PAGE_BASE(page));
         page = next;
     }
     manager->head = NULL;
+
+    // pooled blocks are released with their slabs
+    for(page = manager->lazy; page != NULL; page = next) {
+        next = page->next;
+        if(!MEMORY_MANAGER_IS_POOL_BLOCK(page))
+            free(MEMORY_MANAGER_PAGE_BASE(page));
+    }
+    manager->lazy = NULL;
+    memory_manager_reusable_release(manager);
+    memory_manager_pools_reset(manager);
+
+    for(int i = 0; i < MEMORY_MANAGER_ARENA__COUNT; ++i)
+        memory_manager_drop_arena(manager, (MemoryManagerArena) i);
+    manager->arena = MEMORY_MANAGER_ARENA_NONE;
 }
 
 #endif
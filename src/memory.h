@@ -18,6 +18,22 @@
  *
  * memory_manager_enter and memory_manager_exit starts and closes memory session.
  * Exit also frees all non-freed and warns about all memory leaks.
+ *
+ * memory_manager_switch_arena selects sub-arena for phase of compilation - in NDEBUG blocks are then bump-allocated
+ * from big chunks, memory_free on them is no-op and all chunks are released at once by memory_manager_exit
+ * or memory_manager_drop_arena. With MEMORY_MANAGER_ARENA_NONE are blocks allocated as separate pages.
+ *
+ * Small blocks out of arena are served by size-class pools - freed blocks are recycled by next allocations
+ * of same size class without calling stdlib. In debug build are pools only simulated to keep tracking of each block
+ * and their hit rates are logged by memory_manager_log_stats.
+ *
+ * Blocks freed by memory_free_lazy are reclaimed in batches by memory_manager_collect (in optimizer between passes,
+ * e.g. constants tables dropped by propagation), bigger freed blocks are kept for reuse by allocations of same size
+ * class until next collection.
+ *
+ * Debug build tracks each block with formatted info about place of allocation. For bigger inputs is available
+ * session with MEMORY_MANAGER_TRACKING_SITES - blocks are only counted per allocation call site with bounded cost
+ * and at exit is logged report of top allocation sites.
  */
 
 #define memory_alloc_2(size, manager) memory_manager_malloc(size, __FILENAME__, __LINE__, __func__, manager)
@@ -42,6 +58,41 @@
 #define MEMORY_MANAGER_INFO_MAX_LENGTH 128
 #define MEMORY_MANAGER_INFO_FORMAT "%s:%d:%s()"
 
+#define MEMORY_MANAGER_SITES_BASE_CAPACITY 256
+#define MEMORY_MANAGER_SITES_REPORT_COUNT 10
+
+#define MEMORY_MANAGER_ARENA_CHUNK_SIZE (64 * 1024)
+#define MEMORY_MANAGER_ARENA_ALIGNMENT 16
+
+#define MEMORY_MANAGER_POOL_GRANULARITY 16
+#define MEMORY_MANAGER_POOL_CLASSES_COUNT 8
+#define MEMORY_MANAGER_POOL_MAX_SIZE (MEMORY_MANAGER_POOL_GRANULARITY * MEMORY_MANAGER_POOL_CLASSES_COUNT)
+#define MEMORY_MANAGER_POOL_SLAB_SIZE (32 * 1024)
+#define MEMORY_MANAGER_POOL_INDEX(size) (((size) - 1) / MEMORY_MANAGER_POOL_GRANULARITY)
+
+#define MEMORY_MANAGER_REUSE_MIN_SIZE 256
+#define MEMORY_MANAGER_REUSE_CLASSES_COUNT 9 // up to 64 KiB
+
+/**
+ * @brief Phases of compilation with own sub-arena, so whole phase could be dropped at once.
+ */
+typedef enum {
+    MEMORY_MANAGER_ARENA_NONE = 0, // blocks are not bump-allocated, but separately as pages
+    MEMORY_MANAGER_ARENA_PARSER,
+    MEMORY_MANAGER_ARENA_OPTIMIZER,
+    MEMORY_MANAGER_ARENA_RENDER,
+
+    MEMORY_MANAGER_ARENA__COUNT
+} MemoryManagerArena;
+
+/**
+ * @brief Way of tracking allocated blocks in debug build.
+ */
+typedef enum {
+    MEMORY_MANAGER_TRACKING_PAGES = 0, // each block has own page with formatted info
+    MEMORY_MANAGER_TRACKING_SITES, // blocks are only counted by allocation call site
+} MemoryManagerTracking;
+
 /**
  * @brief Memory page as one unit of allocated memory. Stored also info about place of allocation, size and
  * flag for state of freeing. Works as linked list, with next linked pages.
@@ -56,14 +107,85 @@ typedef struct memory_manager_page_t {
     bool lazy_free;
     size_t size;
     char* info;
+    MemoryManagerArena arena;
 #endif
 } MemoryManagerPage;
 
 /**
- * @brief Memory manager actually holds only header of linked list of pages.
+ * @brief Chunk of arena, blocks are bump-allocated from memory directly after the header.
+ */
+typedef struct memory_manager_chunk_t {
+    struct memory_manager_chunk_t* next;
+    size_t size;
+    size_t used;
+} MemoryManagerChunk;
+
+/**
+ * @brief Pool of one size class, recycled blocks are linked by headers.
+ */
+typedef struct memory_manager_pool_t {
+#ifdef NDEBUG
+    MemoryManagerPage* recycled;
+#else
+    size_t recycled;
+    size_t hits;
+    size_t misses;
+#endif
+} MemoryManagerPool;
+
+#ifndef NDEBUG
+
+/**
+ * @brief Statistics of one allocation call site, identified by pointers to file and function names and line.
+ */
+typedef struct memory_manager_site_t {
+    const char* file;
+    const char* func;
+    unsigned line;
+    size_t count;
+    size_t bytes;
+    size_t live_count;
+    size_t live_bytes;
+} MemoryManagerSite;
+
+/**
+ * @brief Header of block tracked by site, stored directly before allocated memory.
+ */
+typedef struct memory_manager_block_t {
+    struct memory_manager_block_t* next;
+    struct memory_manager_block_t* prev;
+    size_t site_index;
+    size_t size;
+    MemoryManagerArena arena;
+    bool lazy_free;
+} MemoryManagerBlock;
+
+#endif
+
+/**
+ * @brief Memory manager holds header of linked list of pages, chunk lists for each sub-arena and size-class pools.
  */
 typedef struct memory_manager_t {
     MemoryManagerPage* head;
+    MemoryManagerArena arena;
+    MemoryManagerChunk* chunks[MEMORY_MANAGER_ARENA__COUNT];
+    MemoryManagerPool pools[MEMORY_MANAGER_POOL_CLASSES_COUNT];
+#ifdef NDEBUG
+    char* pool_slab;
+    size_t pool_slab_left;
+    MemoryManagerPage* reusable[MEMORY_MANAGER_REUSE_CLASSES_COUNT];
+    MemoryManagerPage* lazy;
+#else
+    MemoryManagerTracking tracking;
+    MemoryManagerBlock* blocks;
+    MemoryManagerSite* sites;
+    size_t sites_count;
+    size_t sites_capacity;
+    size_t* sites_table; // open addressing of indexes to sites shifted by one, zero as empty slot
+    MemoryManagerBlock** blocks_table; // open addressing of live blocks, headers are read only for found blocks
+    size_t blocks_table_capacity;
+    size_t blocks_count;
+#endif
 } MemoryManager;
 
 extern MemoryManager memory_manager;
@@ -75,6 +197,28 @@ extern MemoryManager memory_manager;
  */
 void memory_manager_enter(MemoryManager* manager);
 
+/**
+ * Enters memory manager session with given way of tracking blocks, takes effect only in debug build.
+ * @param manager optional specified memory manager
+ * @param tracking way of tracking
+ */
+void memory_manager_enter_tracking(MemoryManager* manager, MemoryManagerTracking tracking);
+
+/**
+ * Switches sub-arena used for next allocations.
+ * @param manager optional specified memory manager
+ * @param arena sub-arena for next allocations
+ * @return previously used sub-arena
+ */
+MemoryManagerArena memory_manager_switch_arena(MemoryManager* manager, MemoryManagerArena arena);
+
+/**
+ * Releases all blocks allocated from given sub-arena. Caller is responsible for no living pointers into it.
+ * @param manager optional specified memory manager
+ * @param arena sub-arena to drop
+ */
+void memory_manager_drop_arena(MemoryManager* manager, MemoryManagerArena arena);
+
 /**
  * Exits session of given manager. Also deallocate all pages and non-freed memory blocks.
  * For non-freed logs warnings for possible memory leaks.
@@ -113,7 +257,7 @@ void memory_manager_free(
 );
 
 /**
- * Lazy-style of free, only marks page to lazy free at end of memory manager session.
+ * Lazy-style of free, only marks page to lazy free at next collection or at end of memory manager session.
  * @param address pointer to memory block to mark as lazy-free
  * @param manager memory manager
  */
@@ -122,6 +266,13 @@ void memory_manager_free_lazy(
         MemoryManager* manager
 );
 
+/**
+ * Reclaims all blocks marked by lazy free, so they could be reused. Blocks kept for reuse since previous collection
+ * are returned to stdlib. Caller has to guarantee no living pointers to lazy freed blocks.
+ * @param manager optional memory manager
+ */
+void memory_manager_collect(MemoryManager* manager);
+
 /**
  * Log stats about actual session of memory manager.
  * @param manager optional memory manager
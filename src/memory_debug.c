@@ -1,4 +1,5 @@
 #include <ctype.h>
+#include <stdint.h>
 #include "memory.h"
 #include "error.h"
 
@@ -6,6 +7,287 @@
 
 MemoryManager memory_manager;
 
+// pools in debug build are only simulated by counts of recycled blocks, each block is still tracked by own page
+static void memory_manager_pool_account_malloc(size_t size, MemoryManager* manager) {
+    if(manager->arena != MEMORY_MANAGER_ARENA_NONE || size > MEMORY_MANAGER_POOL_MAX_SIZE)
+        return;
+    MemoryManagerPool* pool = &manager->pools[MEMORY_MANAGER_POOL_INDEX(size)];
+    if(pool->recycled > 0) {
+        pool->recycled--;
+        pool->hits++;
+    } else {
+        pool->misses++;
+    }
+}
+
+static void memory_manager_pool_account_free(size_t size, MemoryManagerArena arena, MemoryManager* manager) {
+    if(arena != MEMORY_MANAGER_ARENA_NONE || size > MEMORY_MANAGER_POOL_MAX_SIZE)
+        return;
+    manager->pools[MEMORY_MANAGER_POOL_INDEX(size)].recycled++;
+}
+
+static void memory_manager_pool_log_stats(MemoryManager* manager) {
+    for(int i = 0; i < MEMORY_MANAGER_POOL_CLASSES_COUNT; ++i) {
+        const MemoryManagerPool* pool = &manager->pools[i];
+        const size_t total = pool->hits + pool->misses;
+        if(!total)
+            continue;
+        LOG_INFO(
+                "Pool of %d bytes blocks served %lu allocations with hit rate %.1f %%.",
+                (i + 1) * MEMORY_MANAGER_POOL_GRANULARITY,
+                (long unsigned) total,
+                100.0 * pool->hits / total
+        );
+    }
+}
+
+#define MEMORY_MANAGER_BLOCK_HEADER_SIZE \
+    ((sizeof(MemoryManagerBlock) + MEMORY_MANAGER_ARENA_ALIGNMENT - 1) & ~((size_t) MEMORY_MANAGER_ARENA_ALIGNMENT - 1))
+#define MEMORY_MANAGER_BLOCK_ADDRESS(block) ((void*) ((char*) (block) + MEMORY_MANAGER_BLOCK_HEADER_SIZE))
+
+static size_t memory_manager_site_hash(const char* file, unsigned line, const char* func) {
+    // sites are identified by addresses of string literals, so there is no need to hash their content
+    size_t hash = (size_t) (uintptr_t) file;
+    hash = hash * 31 + (size_t) (uintptr_t) func;
+    hash = hash * 31 + line;
+    return hash ^ (hash >> 15);
+}
+
+static void memory_manager_sites_table_insert(MemoryManager* manager, size_t site_index) {
+    const MemoryManagerSite* site = &manager->sites[site_index];
+    const size_t mask = 2 * manager->sites_capacity - 1;
+    size_t slot = memory_manager_site_hash(site->file, site->line, site->func) & mask;
+    while(manager->sites_table[slot] != 0)
+        slot = (slot + 1) & mask;
+    manager->sites_table[slot] = site_index + 1;
+}
+
+static void memory_manager_sites_grow(MemoryManager* manager) {
+    const size_t capacity = manager->sites_capacity ? 2 * manager->sites_capacity : MEMORY_MANAGER_SITES_BASE_CAPACITY;
+    MemoryManagerSite* sites = (MemoryManagerSite*) realloc(manager->sites, capacity * sizeof(MemoryManagerSite));
+    size_t* table = (size_t*) calloc(2 * capacity, sizeof(size_t));
+    if(sites == NULL || table == NULL) {
+        LOG_WARNING("Malloc-like function returned NULL, exiting.");
+        exit(ERROR_MEMORY);
+    }
+    free(manager->sites_table);
+    manager->sites = sites;
+    manager->sites_table = table;
+    manager->sites_capacity = capacity;
+    for(size_t i = 0; i < manager->sites_count; ++i)
+        memory_manager_sites_table_insert(manager, i);
+}
+
+static size_t memory_manager_site_index(MemoryManager* manager, const char* file, unsigned line, const char* func) {
+    if(manager->sites_count == manager->sites_capacity)
+        memory_manager_sites_grow(manager);
+
+    const size_t mask = 2 * manager->sites_capacity - 1;
+    size_t slot = memory_manager_site_hash(file, line, func) & mask;
+    while(manager->sites_table[slot] != 0) {
+        const size_t site_index = manager->sites_table[slot] - 1;
+        const MemoryManagerSite* site = &manager->sites[site_index];
+        if(site->file == file && site->line == line && site->func == func)
+            return site_index;
+        slot = (slot + 1) & mask;
+    }
+
+    const size_t site_index = manager->sites_count++;
+    MemoryManagerSite* site = &manager->sites[site_index];
+    site->file = file;
+    site->func = func;
+    site->line = line;
+    site->count = site->bytes = site->live_count = site->live_bytes = 0;
+    manager->sites_table[slot] = site_index + 1;
+    return site_index;
+}
+
+static size_t memory_manager_block_hash(const void* address) {
+    size_t hash = (size_t) (uintptr_t) address / MEMORY_MANAGER_ARENA_ALIGNMENT;
+    hash *= 0x9E3779B1u;
+    return hash ^ (hash >> 16);
+}
+
+// slot of block with given address or empty slot, where it would be inserted
+static size_t memory_manager_blocks_table_slot(MemoryManager* manager, const void* address) {
+    const size_t mask = manager->blocks_table_capacity - 1;
+    size_t slot = memory_manager_block_hash(address) & mask;
+    while(manager->blocks_table[slot] != NULL && MEMORY_MANAGER_BLOCK_ADDRESS(manager->blocks_table[slot]) != address)
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+static void memory_manager_blocks_table_insert(MemoryManager* manager, MemoryManagerBlock* block) {
+    if(2 * (manager->blocks_count + 1) > manager->blocks_table_capacity) {
+        MemoryManagerBlock** old_table = manager->blocks_table;
+        const size_t old_capacity = manager->blocks_table_capacity;
+        manager->blocks_table_capacity = old_capacity ? 2 * old_capacity : 2 * MEMORY_MANAGER_SITES_BASE_CAPACITY;
+        manager->blocks_table = (MemoryManagerBlock**) calloc(manager->blocks_table_capacity, sizeof(MemoryManagerBlock*));
+        if(manager->blocks_table == NULL) {
+            LOG_WARNING("Malloc-like function returned NULL, exiting.");
+            exit(ERROR_MEMORY);
+        }
+        for(size_t i = 0; i < old_capacity; ++i) {
+            if(old_table[i] != NULL)
+                manager->blocks_table[memory_manager_blocks_table_slot(
+                        manager, MEMORY_MANAGER_BLOCK_ADDRESS(old_table[i]))] = old_table[i];
+        }
+        free(old_table);
+    }
+    manager->blocks_table[memory_manager_blocks_table_slot(manager, MEMORY_MANAGER_BLOCK_ADDRESS(block))] = block;
+    manager->blocks_count++;
+}
+
+static void memory_manager_blocks_table_remove(MemoryManager* manager, MemoryManagerBlock* block) {
+    const size_t mask = manager->blocks_table_capacity - 1;
+    size_t slot = memory_manager_blocks_table_slot(manager, MEMORY_MANAGER_BLOCK_ADDRESS(block));
+    manager->blocks_table[slot] = NULL;
+    manager->blocks_count--;
+    // following blocks of same cluster are inserted again, so no probe sequence is broken by empty slot
+    for(slot = (slot + 1) & mask; manager->blocks_table[slot] != NULL; slot = (slot + 1) & mask) {
+        MemoryManagerBlock* moved = manager->blocks_table[slot];
+        manager->blocks_table[slot] = NULL;
+        manager->blocks_table[memory_manager_blocks_table_slot(manager, MEMORY_MANAGER_BLOCK_ADDRESS(moved))] = moved;
+    }
+}
+
+static void* memory_manager_sites_malloc(
+        size_t size,
+        const char* file,
+        unsigned line,
+        const char* func,
+        MemoryManager* manager
+) {
+    MemoryManagerBlock* block = (MemoryManagerBlock*) malloc(MEMORY_MANAGER_BLOCK_HEADER_SIZE + size);
+    MALLOC_CHECK(block);
+    memset(MEMORY_MANAGER_BLOCK_ADDRESS(block), 0, size); // reset memory block to suppress valgrind's warnings
+
+    block->size = size;
+    block->arena = manager->arena;
+    block->lazy_free = false;
+    block->site_index = memory_manager_site_index(manager, file, line, func);
+    memory_manager_pool_account_malloc(size, manager);
+
+    MemoryManagerSite* site = &manager->sites[block->site_index];
+    site->count++;
+    site->bytes += size;
+    site->live_count++;
+    site->live_bytes += size;
+
+    block->prev = NULL;
+    block->next = manager->blocks;
+    if(manager->blocks != NULL)
+        manager->blocks->prev = block;
+    manager->blocks = block;
+    memory_manager_blocks_table_insert(manager, block);
+    return MEMORY_MANAGER_BLOCK_ADDRESS(block);
+}
+
+static void memory_manager_sites_release(MemoryManagerBlock* block, MemoryManager* manager) {
+    MemoryManagerSite* site = &manager->sites[block->site_index];
+    site->live_count--;
+    site->live_bytes -= block->size;
+
+    if(block->prev == NULL)
+        manager->blocks = block->next;
+    else
+        block->prev->next = block->next;
+    if(block->next != NULL)
+        block->next->prev = block->prev;
+
+    memory_manager_blocks_table_remove(manager, block);
+    free(block);
+}
+
+// block of manager with given address or NULL for foreign or already freed address
+static MemoryManagerBlock* memory_manager_sites_find(MemoryManager* manager, void* address) {
+    if(manager->blocks_count == 0)
+        return NULL;
+    return manager->blocks_table[memory_manager_blocks_table_slot(manager, address)];
+}
+
+static int memory_manager_sites_cmp_bytes(const void* a, const void* b) {
+    const MemoryManagerSite* first = *(const MemoryManagerSite**) a;
+    const MemoryManagerSite* second = *(const MemoryManagerSite**) b;
+    return (first->bytes < second->bytes) - (first->bytes > second->bytes);
+}
+
+static int memory_manager_sites_cmp_count(const void* a, const void* b) {
+    const MemoryManagerSite* first = *(const MemoryManagerSite**) a;
+    const MemoryManagerSite* second = *(const MemoryManagerSite**) b;
+    return (first->count < second->count) - (first->count > second->count);
+}
+
+static void memory_manager_sites_log_top(
+        MemoryManager* manager,
+        const char* title,
+        int (* cmp)(const void*, const void*)
+) {
+    const MemoryManagerSite** sites = (const MemoryManagerSite**) malloc(
+            (manager->sites_count + 1) * sizeof(MemoryManagerSite*)
+    );
+    if(sites == NULL)
+        return;
+    for(size_t i = 0; i < manager->sites_count; ++i)
+        sites[i] = &manager->sites[i];
+    qsort(sites, manager->sites_count, sizeof(MemoryManagerSite*), cmp);
+
+    LOG_INFO("Top allocation sites by %s:", title);
+    for(size_t i = 0; i < manager->sites_count && i < MEMORY_MANAGER_SITES_REPORT_COUNT; ++i) {
+        LOG_INFO(
+                "%lu bytes in %lu blocks from " MEMORY_MANAGER_INFO_FORMAT ".",
+                (long unsigned) sites[i]->bytes,
+                (long unsigned) sites[i]->count,
+                sites[i]->file,
+                sites[i]->line,
+                sites[i]->func
+        );
+    }
+    free(sites);
+}
+
+static void memory_manager_sites_exit(MemoryManager* manager) {
+    MemoryManagerBlock* block = manager->blocks;
+    MemoryManagerBlock* next = NULL;
+
+    while(block != NULL) {
+        next = block->next;
+        if(block->lazy_free) {
+            // not a leak, just freed later
+            MemoryManagerSite* site = &manager->sites[block->site_index];
+            site->live_count--;
+            site->live_bytes -= block->size;
+        }
+        free(block);
+        block = next;
+    }
+    manager->blocks = NULL;
+    free(manager->blocks_table);
+    manager->blocks_table = NULL;
+    manager->blocks_table_capacity = manager->blocks_count = 0;
+
+    for(size_t i = 0; i < manager->sites_count; ++i) {
+        const MemoryManagerSite* site = &manager->sites[i];
+        if(site->live_count)
+            LOG_WARNING(
+                    "Memory leak of %lu bytes in %lu blocks from " MEMORY_MANAGER_INFO_FORMAT ".",
+                    (long unsigned) site->live_bytes,
+                    (long unsigned) site->live_count,
+                    site->file,
+                    site->line,
+                    site->func
+            );
+    }
+    memory_manager_sites_log_top(manager, "bytes", memory_manager_sites_cmp_bytes);
+    memory_manager_sites_log_top(manager, "count", memory_manager_sites_cmp_count);
+
+    free(manager->sites);
+    free(manager->sites_table);
+    manager->sites = NULL;
+    manager->sites_table = NULL;
+    manager->sites_count = manager->sites_capacity = 0;
+}
+
 void* memory_manager_malloc(
         size_t size,
         const char* file,
@@ -19,6 +301,8 @@ void* memory_manager_malloc(
     }
     if(manager == NULL)
         manager = &memory_manager;
+    if(manager->tracking == MEMORY_MANAGER_TRACKING_SITES)
+        return memory_manager_sites_malloc(size, file, line, func, manager);
 
     MemoryManagerPage* new_page = (MemoryManagerPage*) malloc(sizeof(MemoryManagerPage));
     MALLOC_CHECK(new_page);
@@ -26,6 +310,8 @@ void* memory_manager_malloc(
     new_page->size = size;
     new_page->allocated = true;
     new_page->lazy_free = false;
+    new_page->arena = manager->arena;
+    memory_manager_pool_account_malloc(size, manager);
     new_page->info = (char*) malloc(MEMORY_MANAGER_INFO_MAX_LENGTH + 1);
     MALLOC_CHECK(new_page->info);
     snprintf(new_page->info, MEMORY_MANAGER_INFO_MAX_LENGTH, MEMORY_MANAGER_INFO_FORMAT, file, line, func);
@@ -52,6 +338,14 @@ void memory_manager_free(void* address,
     NULL_POINTER_CHECK(address,);
     if(manager == NULL)
         manager = &memory_manager;
+    if(manager->tracking == MEMORY_MANAGER_TRACKING_SITES) {
+        MemoryManagerBlock* block = memory_manager_sites_find(manager, address);
+        if(block != NULL) {
+            memory_manager_pool_account_free(block->size, block->arena, manager);
+            memory_manager_sites_release(block, manager);
+            return;
+        }
+    }
 
     MemoryManagerPage* page = manager->head;
     while((page != NULL) && (page->address != address)) {
@@ -67,10 +361,11 @@ void memory_manager_free(void* address,
         );
         return;
     }
+    if(page->allocated)
+        memory_manager_pool_account_free(page->size, page->arena, manager);
     page->allocated = false;
     free(page->address);
     page->address = NULL;
-
 }
 
 void memory_manager_free_lazy(void* address,
@@ -78,6 +373,13 @@ void memory_manager_free_lazy(void* address,
     NULL_POINTER_CHECK(address,);
     if(manager == NULL)
         manager = &memory_manager;
+    if(manager->tracking == MEMORY_MANAGER_TRACKING_SITES) {
+        MemoryManagerBlock* block = memory_manager_sites_find(manager, address);
+        if(block != NULL) {
+            block->lazy_free = true;
+            return;
+        }
+    }
 
     MemoryManagerPage* page = manager->head;
     while((page != NULL) && (page->address != address)) {
@@ -90,15 +392,91 @@ void memory_manager_free_lazy(void* address,
     page->lazy_free = true;
 }
 
+void memory_manager_collect(MemoryManager* manager) {
+    if(manager == NULL)
+        manager = &memory_manager;
+
+    if(manager->tracking == MEMORY_MANAGER_TRACKING_SITES) {
+        MemoryManagerBlock* block = manager->blocks;
+        MemoryManagerBlock* next = NULL;
+        while(block != NULL) {
+            next = block->next;
+            if(block->lazy_free) {
+                memory_manager_pool_account_free(block->size, block->arena, manager);
+                memory_manager_sites_release(block, manager);
+            }
+            block = next;
+        }
+    }
+    for(MemoryManagerPage* page = manager->head; page != NULL; page = page->next) {
+        if(page->allocated && page->lazy_free) {
+            memory_manager_pool_account_free(page->size, page->arena, manager);
+            page->allocated = false;
+            page->lazy_free = false;
+            free(page->address);
+            page->address = NULL;
+        }
+    }
+}
+
 void memory_manager_enter(MemoryManager* manager) {
+    memory_manager_enter_tracking(manager, MEMORY_MANAGER_TRACKING_PAGES);
+}
+
+void memory_manager_enter_tracking(MemoryManager* manager, MemoryManagerTracking tracking) {
     LOG_DEBUG("Memory manager started.");
     if(manager == NULL)
         manager = &memory_manager;
-    if(manager->head != NULL) {
+    // session with sites tracking has no pages, its blocks and sites would be lost
+    if(manager->head != NULL || manager->blocks != NULL || manager->sites != NULL) {
         LOG_WARNING("Try to enter already entered memory manager session.");
         return;
     }
     manager->head = NULL;
+    manager->tracking = tracking;
+    manager->blocks = NULL;
+    manager->sites = NULL;
+    manager->sites_table = NULL;
+    manager->sites_count = manager->sites_capacity = 0;
+    manager->blocks_table = NULL;
+    manager->blocks_table_capacity = manager->blocks_count = 0;
+    manager->arena = MEMORY_MANAGER_ARENA_NONE;
+    for(int i = 0; i < MEMORY_MANAGER_ARENA__COUNT; ++i)
+        manager->chunks[i] = NULL;
+    for(int i = 0; i < MEMORY_MANAGER_POOL_CLASSES_COUNT; ++i)
+        manager->pools[i].recycled = manager->pools[i].hits = manager->pools[i].misses = 0;
+}
+
+MemoryManagerArena memory_manager_switch_arena(MemoryManager* manager, MemoryManagerArena arena) {
+    if(manager == NULL)
+        manager = &memory_manager;
+    const MemoryManagerArena previous = manager->arena;
+    manager->arena = arena;
+    return previous;
+}
+
+void memory_manager_drop_arena(MemoryManager* manager, MemoryManagerArena arena) {
+    if(manager == NULL)
+        manager = &memory_manager;
+
+    if(manager->tracking == MEMORY_MANAGER_TRACKING_SITES) {
+        MemoryManagerBlock* block = manager->blocks;
+        MemoryManagerBlock* next = NULL;
+        while(block != NULL) {
+            next = block->next;
+            if(block->arena == arena)
+                memory_manager_sites_release(block, manager);
+            block = next;
+        }
+    }
+    for(MemoryManagerPage* page = manager->head; page != NULL; page = page->next) {
+        if(page->arena == arena && page->allocated) {
+            page->allocated = false;
+            page->lazy_free = false;
+            free(page->address);
+            page->address = NULL;
+        }
+    }
 }
 
 void memory_manager_exit(MemoryManager* manager) {
@@ -147,7 +525,14 @@ void memory_manager_exit(MemoryManager* manager) {
             pages_count,
             size_sum
     );
+    if(manager->tracking == MEMORY_MANAGER_TRACKING_SITES)
+        memory_manager_sites_exit(manager);
+    memory_manager_pool_log_stats(manager);
     manager->head = NULL;
+    manager->tracking = MEMORY_MANAGER_TRACKING_PAGES;
+    for(int i = 0; i < MEMORY_MANAGER_POOL_CLASSES_COUNT; ++i)
+        manager->pools[i].recycled = manager->pools[i].hits = manager->pools[i].misses = 0;
+    manager->arena = MEMORY_MANAGER_ARENA_NONE;
 }
 
 void memory_manager_log_stats(MemoryManager* manager) {
@@ -169,10 +554,16 @@ void memory_manager_log_stats(MemoryManager* manager) {
 
         page = next;
     }
+    for(size_t i = 0; i < manager->sites_count; ++i) {
+        allocated_size += manager->sites[i].live_bytes;
+        allocated_pages_count += manager->sites[i].live_count;
+        total_size += manager->sites[i].bytes;
+    }
     LOG_INFO(
             "Auto freed %d bytes from %d pages. Total memory usage %d bytes.",
             allocated_size, allocated_pages_count, total_size
     );
+    memory_manager_pool_log_stats(manager);
 }
 
 #endif
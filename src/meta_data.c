@@ -10,14 +10,25 @@ void init_variable_meta_data(SymbolTableBaseItem* item) {
 }
 
 
+static void init_global_var_usage(SymbolTableBaseItem* item) {
+    NULL_POINTER_CHECK(item,);
+
+    ((SymbolTableIntItem*) item)->value = 0;
+}
+
 void init_function_meta_data(SymbolTableBaseItem* item) {
     NULL_POINTER_CHECK(item,);
 
     FunctionMetaData* v = (FunctionMetaData*) item;
     v->call_count = 0;
     v->purity_type = META_TYPE_PURE;
-    v->mod_global_vars = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(SymbolTableBaseItem), NULL, NULL);
-    v->read_global_vars = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(SymbolTableBaseItem), NULL, NULL);
+    v->dynamic_dependent_count = 0;
+    v->outputed_count = 0;
+    v->with_side_effect_count = 0;
+    v->mod_global_vars = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(SymbolTableIntItem),
+                                           &init_global_var_usage, NULL);
+    v->read_global_vars = symbol_table_init(SYMBOL_TABLE_BASE_SIZE, sizeof(SymbolTableIntItem),
+                                            &init_global_var_usage, NULL);
 }
 
 void free_function_meta_data(SymbolTableBaseItem* item)
@@ -36,4 +47,5 @@ void init_label_meta_data(SymbolTableBaseItem* item) {
 
     LabelMetaData* v = (LabelMetaData*) item;
     v->occurrences_count = 0;
+    v->code_block_id = 0;
 }
@@ -23,7 +23,12 @@ typedef struct function_meta_data_t {
     SymbolTableBaseItem base;
     unsigned int call_count;
     MetaType purity_type;
+    // counts of instructions in function body, which cause flags of purity type
+    size_t dynamic_dependent_count;
+    size_t outputed_count;
+    size_t with_side_effect_count;
 
+    // global variables mapped to count of modifying/reading instructions in function body
     SymbolTable* mod_global_vars;
     SymbolTable* read_global_vars;
 } FunctionMetaData;
@@ -31,6 +36,8 @@ typedef struct function_meta_data_t {
 typedef struct label_meta_data_t {
     SymbolTableBaseItem base;
     int occurrences_count;
+    // id of code block starting with label, set by splitting code to graph
+    unsigned int code_block_id;
 } LabelMetaData;
 
 // meta data sub item
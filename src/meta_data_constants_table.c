@@ -0,0 +1,349 @@
+#include <stdint.h>
+#include <string.h>
+#include "meta_data_constants_table.h"
+#include "string_interner.h"
+#include "memory.h"
+#include "debug.h"
+
+#define CONSTANTS_TABLE_NODE_BITS 5
+#define CONSTANTS_TABLE_NODE_MASK ((1u << CONSTANTS_TABLE_NODE_BITS) - 1)
+#define CONSTANTS_TABLE_HASH_BITS (sizeof(size_t) * 8)
+// nodes deeper than all bits of hash hold colliding entries in linear order
+#define CONSTANTS_TABLE_IS_COLLISION_NODE(shift) ((shift) >= CONSTANTS_TABLE_HASH_BITS)
+#define CONSTANTS_TABLE_BIT(hash, shift) (1u << (((hash) >> (shift)) & CONSTANTS_TABLE_NODE_MASK))
+#define CONSTANTS_TABLE_KEY_EQUAL(entry, hash_, key_) \
+    ((entry)->hash == (hash_) && ((entry)->key == (key_) || strcmp((entry)->key, (key_)) == 0))
+
+typedef struct constants_table_entry_t {
+    unsigned references;
+    size_t hash;
+    // interned
+    const char* key;
+    CodeInstructionOperand* operand;
+    CodeInstruction* setter;
+    unsigned setter_table_id;
+    bool blocked;
+} ConstantsTableEntry;
+
+typedef union constants_table_slot_t {
+    ConstantsTableEntry* entry;
+    ConstantsTableNode* node;
+} ConstantsTableSlot;
+
+/**
+ * @brief Slots with entries are followed by slots with sub-nodes, both ordered by bits in maps.
+ */
+struct constants_table_node_t {
+    unsigned references;
+    uint32_t entry_map;
+    uint32_t node_map;
+    // only for collision node
+    unsigned collisions_count;
+    ConstantsTableSlot slots[];
+};
+
+static unsigned constants_table_last_id = 0;
+
+static unsigned constants_table_bit_count(uint32_t map) {
+    map = map - ((map >> 1) & 0x55555555u);
+    map = (map & 0x33333333u) + ((map >> 2) & 0x33333333u);
+    return (((map + (map >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+}
+
+static unsigned constants_table_node_entries_count(ConstantsTableNode* node) {
+    return node->entry_map == 0 && node->node_map == 0 ?
+           node->collisions_count : constants_table_bit_count(node->entry_map);
+}
+
+static unsigned constants_table_node_slots_count(ConstantsTableNode* node) {
+    return constants_table_node_entries_count(node) + constants_table_bit_count(node->node_map);
+}
+
+static ConstantsTableNode* constants_table_node_alloc(unsigned slots_count) {
+    ConstantsTableNode* node = memory_alloc(sizeof(ConstantsTableNode) + sizeof(ConstantsTableSlot) * slots_count);
+    NULL_POINTER_CHECK(node, NULL);
+    node->references = 1;
+    node->entry_map = 0;
+    node->node_map = 0;
+    node->collisions_count = 0;
+    return node;
+}
+
+static void constants_table_entry_release(ConstantsTableEntry* entry) {
+    if(--entry->references > 0)
+        return;
+    if(entry->operand != NULL)
+        code_instruction_operand_free(&entry->operand);
+    memory_free_lazy(entry);
+}
+
+static void constants_table_node_release(ConstantsTableNode* node) {
+    if(node == NULL || --node->references > 0)
+        return;
+    const unsigned entries_count = constants_table_node_entries_count(node);
+    const unsigned slots_count = constants_table_node_slots_count(node);
+    for(unsigned i = 0; i < entries_count; ++i)
+        constants_table_entry_release(node->slots[i].entry);
+    for(unsigned i = entries_count; i < slots_count; ++i)
+        constants_table_node_release(node->slots[i].node);
+    memory_free_lazy(node);
+}
+
+// copy on write, node referenced from more tables is replaced by its own copy
+static ConstantsTableNode* constants_table_node_unique(ConstantsTableNode** node_ref) {
+    ConstantsTableNode* node = *node_ref;
+    if(node->references == 1)
+        return node;
+
+    const unsigned entries_count = constants_table_node_entries_count(node);
+    const unsigned slots_count = constants_table_node_slots_count(node);
+    ConstantsTableNode* copy = constants_table_node_alloc(slots_count);
+    copy->entry_map = node->entry_map;
+    copy->node_map = node->node_map;
+    copy->collisions_count = node->collisions_count;
+    memcpy(copy->slots, node->slots, sizeof(ConstantsTableSlot) * slots_count);
+    for(unsigned i = 0; i < entries_count; ++i)
+        copy->slots[i].entry->references++;
+    for(unsigned i = entries_count; i < slots_count; ++i)
+        copy->slots[i].node->references++;
+
+    node->references--;
+    *node_ref = copy;
+    return copy;
+}
+
+static ConstantsTableEntry* constants_table_entry_unique(ConstantsTableEntry** entry_ref) {
+    ConstantsTableEntry* entry = *entry_ref;
+    if(entry->references == 1)
+        return entry;
+
+    ConstantsTableEntry* copy = memory_alloc(sizeof(ConstantsTableEntry));
+    NULL_POINTER_CHECK(copy, NULL);
+    *copy = *entry;
+    copy->references = 1;
+    if(entry->operand != NULL)
+        copy->operand = code_instruction_operand_copy(entry->operand);
+
+    entry->references--;
+    *entry_ref = copy;
+    return copy;
+}
+
+static ConstantsTableEntry* constants_table_entry_new(const char* key, size_t hash) {
+    ConstantsTableEntry* entry = memory_alloc(sizeof(ConstantsTableEntry));
+    NULL_POINTER_CHECK(entry, NULL);
+    entry->references = 1;
+    entry->hash = hash;
+    entry->key = string_interner_intern_c_string(&string_interner, key);
+    entry->operand = NULL;
+    entry->setter = NULL;
+    entry->setter_table_id = 0;
+    entry->blocked = false;
+    return entry;
+}
+
+// replaces unique node with copy with one more slot at given position
+static ConstantsTableNode* constants_table_node_insert_slot(ConstantsTableNode** node_ref, unsigned position,
+                                                            ConstantsTableSlot slot) {
+    ConstantsTableNode* node = *node_ref;
+    const unsigned slots_count = constants_table_node_slots_count(node);
+    ConstantsTableNode* new_node = constants_table_node_alloc(slots_count + 1);
+    new_node->entry_map = node->entry_map;
+    new_node->node_map = node->node_map;
+    new_node->collisions_count = node->collisions_count;
+    memcpy(new_node->slots, node->slots, sizeof(ConstantsTableSlot) * position);
+    new_node->slots[position] = slot;
+    memcpy(new_node->slots + position + 1, node->slots + position,
+           sizeof(ConstantsTableSlot) * (slots_count - position));
+
+    memory_free_lazy(node);
+    *node_ref = new_node;
+    return new_node;
+}
+
+static ConstantsTableEntry* constants_table_find(ConstantsTable* table, const char* key) {
+    const size_t hash = string_interner_hash(key, strlen(key));
+    ConstantsTableNode* node = table->root;
+
+    for(size_t shift = 0; node != NULL; shift += CONSTANTS_TABLE_NODE_BITS) {
+        if(CONSTANTS_TABLE_IS_COLLISION_NODE(shift)) {
+            for(unsigned i = 0; i < node->collisions_count; ++i) {
+                if(CONSTANTS_TABLE_KEY_EQUAL(node->slots[i].entry, hash, key))
+                    return node->slots[i].entry;
+            }
+            return NULL;
+        }
+
+        const uint32_t bit = CONSTANTS_TABLE_BIT(hash, shift);
+        if(node->entry_map & bit) {
+            ConstantsTableEntry* entry = node->slots[constants_table_bit_count(node->entry_map & (bit - 1))].entry;
+            return CONSTANTS_TABLE_KEY_EQUAL(entry, hash, key) ? entry : NULL;
+        }
+        if((node->node_map & bit) == 0)
+            return NULL;
+        node = node->slots[constants_table_bit_count(node->entry_map) +
+                           constants_table_bit_count(node->node_map & (bit - 1))].node;
+    }
+    return NULL;
+}
+
+// finds or creates entry, which is owned only by given table
+static ConstantsTableEntry* constants_table_find_unique(ConstantsTable* table, const char* key) {
+    const size_t hash = string_interner_hash(key, strlen(key));
+    if(table->root == NULL)
+        table->root = constants_table_node_alloc(0);
+    ConstantsTableNode** node_ref = &table->root;
+
+    for(size_t shift = 0;; shift += CONSTANTS_TABLE_NODE_BITS) {
+        ConstantsTableNode* node = constants_table_node_unique(node_ref);
+
+        if(CONSTANTS_TABLE_IS_COLLISION_NODE(shift)) {
+            for(unsigned i = 0; i < node->collisions_count; ++i) {
+                if(CONSTANTS_TABLE_KEY_EQUAL(node->slots[i].entry, hash, key))
+                    return constants_table_entry_unique(&node->slots[i].entry);
+            }
+            ConstantsTableSlot slot = {.entry = constants_table_entry_new(key, hash)};
+            node = constants_table_node_insert_slot(node_ref, node->collisions_count, slot);
+            node->collisions_count++;
+            return slot.entry;
+        }
+
+        const uint32_t bit = CONSTANTS_TABLE_BIT(hash, shift);
+        const unsigned entry_position = constants_table_bit_count(node->entry_map & (bit - 1));
+        const unsigned node_position = constants_table_bit_count(node->entry_map) +
+                                       constants_table_bit_count(node->node_map & (bit - 1));
+
+        if(node->node_map & bit) {
+            node_ref = &node->slots[node_position].node;
+            continue;
+        }
+
+        if((node->entry_map & bit) == 0) {
+            ConstantsTableSlot slot = {.entry = constants_table_entry_new(key, hash)};
+            node = constants_table_node_insert_slot(node_ref, entry_position, slot);
+            node->entry_map |= bit;
+            return slot.entry;
+        }
+
+        ConstantsTableEntry* entry = node->slots[entry_position].entry;
+        if(CONSTANTS_TABLE_KEY_EQUAL(entry, hash, key))
+            return constants_table_entry_unique(&node->slots[entry_position].entry);
+
+        // push present entry one level down, new key is inserted into created sub-node in next step
+        const size_t sub_shift = shift + CONSTANTS_TABLE_NODE_BITS;
+        ConstantsTableNode* sub_node = constants_table_node_alloc(1);
+        sub_node->slots[0].entry = entry;
+        if(CONSTANTS_TABLE_IS_COLLISION_NODE(sub_shift))
+            sub_node->collisions_count = 1;
+        else
+            sub_node->entry_map = CONSTANTS_TABLE_BIT(entry->hash, sub_shift);
+
+        DEBUG_CODE(const unsigned slots_count = constants_table_node_slots_count(node););
+        memmove(node->slots + entry_position, node->slots + entry_position + 1,
+                sizeof(ConstantsTableSlot) * (node_position - entry_position - 1));
+        node->slots[node_position - 1].node = sub_node;
+        node->entry_map &= ~bit;
+        node->node_map |= bit;
+        ASSERT(slots_count == constants_table_node_slots_count(node));
+        node_ref = &node->slots[node_position - 1].node;
+    }
+}
+
+ConstantsTable* constants_table_init() {
+    ConstantsTable* table = memory_alloc(sizeof(ConstantsTable));
+    NULL_POINTER_CHECK(table, NULL);
+    table->root = NULL;
+    table->id = ++constants_table_last_id;
+    return table;
+}
+
+ConstantsTable* constants_table_fork(ConstantsTable* table) {
+    NULL_POINTER_CHECK(table, NULL);
+    ConstantsTable* fork = constants_table_init();
+    NULL_POINTER_CHECK(fork, NULL);
+    fork->root = table->root;
+    if(fork->root != NULL)
+        fork->root->references++;
+    return fork;
+}
+
+void constants_table_free(ConstantsTable** table) {
+    NULL_POINTER_CHECK(table,);
+    NULL_POINTER_CHECK(*table,);
+
+    constants_table_node_release((*table)->root);
+    memory_free_lazy(*table);
+    *table = NULL;
+}
+
+CodeInstructionOperand* constants_table_get_constant(ConstantsTable* table, const char* key) {
+    NULL_POINTER_CHECK(table, NULL);
+    NULL_POINTER_CHECK(key, NULL);
+
+    ConstantsTableEntry* entry = constants_table_find(table, key);
+    if(entry == NULL || entry->blocked)
+        return NULL;
+    return entry->operand;
+}
+
+CodeInstruction* constants_table_get_setter(ConstantsTable* table, const char* key) {
+    NULL_POINTER_CHECK(table, NULL);
+    NULL_POINTER_CHECK(key, NULL);
+
+    ConstantsTableEntry* entry = constants_table_find(table, key);
+    if(entry == NULL || entry->operand == NULL || entry->setter_table_id != table->id)
+        return NULL;
+    return entry->setter;
+}
+
+bool constants_table_is_blocked(ConstantsTable* table, const char* key) {
+    NULL_POINTER_CHECK(table, false);
+    NULL_POINTER_CHECK(key, false);
+
+    ConstantsTableEntry* entry = constants_table_find(table, key);
+    return entry != NULL && entry->blocked;
+}
+
+void constants_table_set(ConstantsTable* table, const char* key, CodeInstructionOperand* constant,
+                         CodeInstruction* setter) {
+    NULL_POINTER_CHECK(table,);
+    NULL_POINTER_CHECK(key,);
+
+    ConstantsTableEntry* entry = constants_table_find_unique(table, key);
+    NULL_POINTER_CHECK(entry,);
+    if(entry->operand != NULL)
+        code_instruction_operand_free(&entry->operand);
+    entry->operand = constant;
+    entry->setter = setter;
+    entry->setter_table_id = table->id;
+}
+
+CodeInstruction* constants_table_remove(ConstantsTable* table, const char* key) {
+    NULL_POINTER_CHECK(table, NULL);
+    NULL_POINTER_CHECK(key, NULL);
+
+    // nothing to copy if there is no constant
+    ConstantsTableEntry* entry = constants_table_find(table, key);
+    if(entry == NULL || entry->operand == NULL)
+        return NULL;
+
+    CodeInstruction* setter = entry->setter_table_id == table->id ? entry->setter : NULL;
+    entry = constants_table_find_unique(table, key);
+    NULL_POINTER_CHECK(entry, NULL);
+    code_instruction_operand_free(&entry->operand);
+    entry->setter = NULL;
+    return setter;
+}
+
+void constants_table_block(ConstantsTable* table, const char* key) {
+    NULL_POINTER_CHECK(table,);
+    NULL_POINTER_CHECK(key,);
+
+    ConstantsTableEntry* entry = constants_table_find(table, key);
+    if(entry != NULL && entry->blocked)
+        return;
+
+    entry = constants_table_find_unique(table, key);
+    NULL_POINTER_CHECK(entry,);
+    entry->blocked = true;
+}
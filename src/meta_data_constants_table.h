@@ -0,0 +1,61 @@
+#ifndef META_DATA_CONSTANTS_TABLE_H
+#define META_DATA_CONSTANTS_TABLE_H
+
+#include "code_instruction.h"
+#include "code_instruction_operand.h"
+
+typedef struct constants_table_node_t ConstantsTableNode;
+
+/**
+ * @brief Persistent map of variable identifiers to known constants. Tables share structure
+ * (hash array mapped trie with reference counted nodes), modification copies only path to changed entry.
+ */
+typedef struct constants_table_t {
+    ConstantsTableNode* root;
+    // setters are valid only in table which has set them
+    unsigned id;
+} ConstantsTable;
+
+/**
+ * @brief Creates new empty table.
+ */
+ConstantsTable* constants_table_init();
+
+/**
+ * @brief Creates table with same content as given one in O(1), setters of given table are not inherited.
+ * Later modifications of any of both tables are not visible in the other one.
+ */
+ConstantsTable* constants_table_fork(ConstantsTable* table);
+
+void constants_table_free(ConstantsTable** table);
+
+/**
+ * @brief Returns constant of not blocked variable or NULL. Constant is owned by table.
+ */
+CodeInstructionOperand* constants_table_get_constant(ConstantsTable* table, const char* key);
+
+/**
+ * @brief Returns instruction which set current constant of variable in this table or NULL.
+ */
+CodeInstruction* constants_table_get_setter(ConstantsTable* table, const char* key);
+
+bool constants_table_is_blocked(ConstantsTable* table, const char* key);
+
+/**
+ * @brief Sets constant of variable, table takes ownership of constant.
+ */
+void constants_table_set(ConstantsTable* table, const char* key, CodeInstructionOperand* constant,
+                         CodeInstruction* setter);
+
+/**
+ * @brief Forgets constant of variable.
+ * @return Setter of removed constant valid in this table or NULL
+ */
+CodeInstruction* constants_table_remove(ConstantsTable* table, const char* key);
+
+/**
+ * @brief Marks variable as blocked, its constant is not propagated anymore.
+ */
+void constants_table_block(ConstantsTable* table, const char* key);
+
+#endif // META_DATA_CONSTANTS_TABLE_H
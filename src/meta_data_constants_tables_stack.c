@@ -1,15 +1,10 @@
 #include "meta_data_constants_tables_stack.h"
 
-ConstantsTableStackItem* constants_table_stack_item_init(SymbolTable* constants) {
+ConstantsTableStackItem* constants_table_stack_item_init(ConstantsTable* constants) {
     ConstantsTableStackItem* new_item = memory_alloc(sizeof(ConstantsTableStackItem));
     new_item->is_direct_table = true;
     if(constants == NULL) {
-        new_item->constants = symbol_table_init(
-                SYMBOL_TABLE_BASE_SIZE,
-                sizeof(MappedOperand),
-                &init_mapped_operand_item,
-                &free_mapped_operand_item
-        );
+        new_item->constants = constants_table_init();
     } else {
         new_item->constants = constants;
     }
@@ -22,7 +17,7 @@ void constants_table_stack_item_free(StackBaseItem* item) {
 
     ConstantsTableStackItem* v = (ConstantsTableStackItem*) item;
     if(v->constants != NULL)
-        symbol_table_free(v->constants);
+        constants_table_free(&v->constants);
 }
 
 ConstantsTableStackItem* constants_tables_stack_get_lowest_direct_table(Stack* stack) {
@@ -4,6 +4,14 @@ void init_peep_hole_pattern(LListBaseItem* item) {
     PeepHolePattern* v = (PeepHolePattern*) item;
     llist_init(&v->matching_instructions, sizeof(PeepHolePatternInstruction), NULL, NULL, NULL);
     llist_init(&v->replacement_instructions, sizeof(PeepHolePatternInstruction), NULL, NULL, NULL);
+    v->matching_instructions_count = 0;
+    v->replacement_instructions_count = 0;
+
+    v->aliases[PEEP_HOLE_PATTERN_ALIAS_TEMP] = "temp";
+    v->aliases[PEEP_HOLE_PATTERN_ALIAS_TRUE] = "<true";
+    v->aliases_count = PEEP_HOLE_PATTERN_FIXED_ALIASES_COUNT;
+    v->next_indexed = NULL;
+    v->applied_count = 0;
 }
 
 void free_peep_hole_pattern(LListBaseItem* item) {
@@ -12,19 +20,55 @@ void free_peep_hole_pattern(LListBaseItem* item) {
     llist_free(&v->replacement_instructions);
 }
 
+static int peep_hole_pattern_alias_slot(PeepHolePattern* ph_pattern, const char* alias) {
+    if(alias == NULL)
+        return PEEP_HOLE_PATTERN_NO_ALIAS;
+
+    for(int i = 0; i < ph_pattern->aliases_count; i++) {
+        if(strcmp(ph_pattern->aliases[i], alias) == 0)
+            return i;
+    }
+
+    if(ph_pattern->aliases_count == PEEP_HOLE_PATTERN_ALIASES_MAX_COUNT) {
+        LOG_WARNING("Too many aliases in peep hole pattern.");
+        return PEEP_HOLE_PATTERN_NO_ALIAS;
+    }
+    ph_pattern->aliases[ph_pattern->aliases_count] = alias;
+    return ph_pattern->aliases_count++;
+}
+
+static void peep_hole_pattern_resolve_aliases(PeepHolePattern* ph_pattern,
+                                              PeepHolePatternInstruction* ph_pattern_instruction) {
+    const char* aliases[] = {ph_pattern_instruction->op0_alias, ph_pattern_instruction->op1_alias,
+                             ph_pattern_instruction->op2_alias};
+
+    for(int i = 0; i < OPERANDS_MAX_COUNT; i++) {
+        ph_pattern_instruction->operands_slots[i] = peep_hole_pattern_alias_slot(ph_pattern, aliases[i]);
+        ph_pattern_instruction->operands_flags[i] = extract_flag(aliases[i]);
+    }
+}
+
 void code_optimizer_add_matching_instruction_to_ph_pattern(PeepHolePattern* ph_pattern, TypeInstruction instruction,
                                                            const char* op1_alias, const char* op2_alias,
                                                            const char* op3_alias, int op0_occ_count, int op1_occ_count,
                                                            int op2_occ_count) {
+    NULL_POINTER_CHECK(ph_pattern,);
     _code_optimizer_add_instruction_to_ph_pattern(ph_pattern->matching_instructions, instruction, op1_alias, op2_alias,
                                                   op3_alias, op0_occ_count, op1_occ_count, op2_occ_count);
+    peep_hole_pattern_resolve_aliases(ph_pattern,
+                                      (PeepHolePatternInstruction*) ph_pattern->matching_instructions->tail);
+    ph_pattern->matching_instructions_count++;
 }
 
 void code_optimizer_add_replacement_instruction_to_ph_pattern(PeepHolePattern* ph_pattern, TypeInstruction instruction,
                                                               const char* op1_alias, const char* op2_alias,
                                                               const char* op3_alias) {
+    NULL_POINTER_CHECK(ph_pattern,);
     _code_optimizer_add_instruction_to_ph_pattern(ph_pattern->replacement_instructions, instruction, op1_alias,
                                                   op2_alias, op3_alias, 0, 0, 0);
+    peep_hole_pattern_resolve_aliases(ph_pattern,
+                                      (PeepHolePatternInstruction*) ph_pattern->replacement_instructions->tail);
+    ph_pattern->replacement_instructions_count++;
 }
 
 void _code_optimizer_add_instruction_to_ph_pattern(LList* pattern_instruction_sub_list, TypeInstruction instruction,
@@ -27,10 +27,27 @@ typedef enum {
     META_PATTERN_FLAG_TEMP_VARIABLE_5           // 5
 } MetaPHPatternFlag;
 
+// slots of aliases bound to fixed operands before matching
+#define PEEP_HOLE_PATTERN_ALIAS_TEMP 0          // temp
+#define PEEP_HOLE_PATTERN_ALIAS_TRUE 1          // <true
+#define PEEP_HOLE_PATTERN_FIXED_ALIASES_COUNT 2
+#define PEEP_HOLE_PATTERN_ALIASES_MAX_COUNT 8
+#define PEEP_HOLE_PATTERN_NO_ALIAS (-1)
+
 typedef struct peep_hole_pattern_t {
     LListBaseItem base;
     LList* matching_instructions;
     LList* replacement_instructions;
+    size_t matching_instructions_count;
+    size_t replacement_instructions_count;
+
+    // aliases are resolved to slots of bound operands during adding of instructions
+    const char* aliases[PEEP_HOLE_PATTERN_ALIASES_MAX_COUNT];
+    int aliases_count;
+
+    // next pattern starting with same instruction type
+    struct peep_hole_pattern_t* next_indexed;
+    size_t applied_count;
 } PeepHolePattern;
 
 typedef struct peep_hole_pattern_instruction_t {
@@ -43,6 +60,9 @@ typedef struct peep_hole_pattern_instruction_t {
     int op0_occurrences_count;
     int op1_occurrences_count;
     int op2_occurrences_count;
+
+    int operands_slots[OPERANDS_MAX_COUNT];
+    MetaPHPatternFlag operands_flags[OPERANDS_MAX_COUNT];
 } PeepHolePatternInstruction;
 
 MetaPHPatternFlag extract_flag(const char* alias);
@@ -1,6 +1,44 @@
 #include "oriented_graph.h"
 #include "math.h"
 
+// drops CSR view after modification of graph
+static void oriented_graph_thaw(OrientedGraph* graph) {
+    if(graph->csr == NULL)
+        return;
+
+    memory_free(graph->csr->successors_offsets);
+    memory_free(graph->csr->successors);
+    memory_free(graph->csr->predecessors_offsets);
+    memory_free(graph->csr->predecessors);
+    memory_free(graph->csr);
+    graph->csr = NULL;
+}
+
+// fills offsets and targets of all nodes from out or in edges
+static void oriented_graph_csr_fill(OrientedGraph* graph, bool out_edges, unsigned int** offsets,
+                                    unsigned int** targets) {
+    size_t edges_count = 0;
+    for(size_t i = 0; i < graph->capacity; i++) {
+        if(graph->nodes[i] != NULL)
+            edges_count += set_int_size(out_edges ? graph->nodes[i]->out_edges : graph->nodes[i]->in_edges);
+    }
+
+    *offsets = memory_alloc(sizeof(unsigned int) * (graph->capacity + 1));
+    *targets = memory_alloc(sizeof(unsigned int) * (edges_count + 1));
+
+    unsigned int position = 0;
+    for(size_t i = 0; i < graph->capacity; i++) {
+        (*offsets)[i] = position;
+        if(graph->nodes[i] == NULL)
+            continue;
+
+        SetInt* edges = out_edges ? graph->nodes[i]->out_edges : graph->nodes[i]->in_edges;
+        for(int id = set_int_first(edges); id != SET_INT_END; id = set_int_next(edges, id))
+            (*targets)[position++] = (unsigned int) id;
+    }
+    (*offsets)[graph->capacity] = position;
+}
+
 OrientedGraph* oriented_graph_init(size_t item_size, oriented_graph_init_data_callback_f init_callback,
                                    oriented_graph_free_data_callback_f free_callback) {
     return oriented_graph_init_with_capacity(item_size, 32, init_callback, free_callback);
@@ -15,6 +53,7 @@ OrientedGraph* oriented_graph_init_with_capacity(size_t item_size, size_t capaci
     graph->capacity = capacity;
     graph->init_data_callback = init_callback;
     graph->free_data_callback = free_callback;
+    graph->csr = NULL;
 
     graph->nodes = memory_alloc(sizeof(GraphNodeBase*) * graph->capacity);
     for(unsigned int i = 0; i < graph->capacity; i++)
@@ -37,6 +76,8 @@ void oriented_graph_free(OrientedGraph** graph) {
 GraphNodeBase* oriented_graph_new_node(OrientedGraph* graph) {
     NULL_POINTER_CHECK(graph, NULL);
 
+    oriented_graph_thaw(graph);
+
     // resize nodes container
     if(graph->nodes_count >= graph->capacity) {
         GraphNodeBase** nodes = graph->nodes;
@@ -56,7 +97,9 @@ GraphNodeBase* oriented_graph_new_node(OrientedGraph* graph) {
     bool assigned = false;
     GraphNodeBase* new_node = _oriented_graph_init_node(graph);
 
-    for(unsigned int i = 0; i < graph->capacity; i++) {
+    // without removed nodes slots are filled in order, so first free slot is right after them
+    const unsigned int first_slot = graph->nodes[graph->nodes_count] == NULL ? (unsigned int) graph->nodes_count : 0;
+    for(unsigned int i = first_slot; i < graph->capacity; i++) {
         if(graph->nodes[i] == NULL) {
             assigned = true;
             new_node->id = i;
@@ -93,22 +136,18 @@ void oriented_graph_remove_node(OrientedGraph* graph, unsigned int node_id) {
     if(node == NULL)
         return;
 
-    SetIntItem* id = (SetIntItem*) node->in_edges->head;
+    oriented_graph_thaw(graph);
+
     GraphNodeBase* in_node = NULL;
-    while(id != NULL) {
-        in_node = oriented_graph_node(graph, (unsigned int) id->value);
+    for(int id = set_int_first(node->in_edges); id != SET_INT_END; id = set_int_next(node->in_edges, id)) {
+        in_node = oriented_graph_node(graph, (unsigned int) id);
         set_int_remove(in_node->out_edges, node_id);
-
-        id = (SetIntItem*) id->base.next;
     }
 
-    id = (SetIntItem*) node->out_edges->head;
     GraphNodeBase* out_node = NULL;
-    while(id != NULL) {
-        out_node = oriented_graph_node(graph, (unsigned int) id->value);
+    for(int id = set_int_first(node->out_edges); id != SET_INT_END; id = set_int_next(node->out_edges, id)) {
+        out_node = oriented_graph_node(graph, (unsigned int) id);
         set_int_remove(out_node->in_edges, node_id);
-
-        id = (SetIntItem*) id->base.next;
     }
 
     if(graph->free_data_callback != NULL)
@@ -131,6 +170,9 @@ GraphNodeBase* oriented_graph_node(OrientedGraph* graph, unsigned int node_id) {
 }
 
 void oriented_graph_clear(OrientedGraph* graph) {
+    NULL_POINTER_CHECK(graph,);
+
+    oriented_graph_thaw(graph);
     for(unsigned int i = 0; i < graph->capacity; i++) {
         if(graph->nodes[i] != NULL) {
             if(graph->free_data_callback != NULL)
@@ -163,11 +205,56 @@ void oriented_graph_print(OrientedGraph* graph) {
     fprintf(stderr, ")\n");
 }
 
+const OrientedGraphCSR* oriented_graph_freeze(OrientedGraph* graph) {
+    NULL_POINTER_CHECK(graph, NULL);
+
+    if(graph->csr != NULL)
+        return graph->csr;
+
+    OrientedGraphCSR* csr = memory_alloc(sizeof(OrientedGraphCSR));
+    NULL_POINTER_CHECK(csr, NULL);
+    csr->nodes_count = graph->capacity;
+    oriented_graph_csr_fill(graph, true, &csr->successors_offsets, &csr->successors);
+    oriented_graph_csr_fill(graph, false, &csr->predecessors_offsets, &csr->predecessors);
+
+    graph->csr = csr;
+    return csr;
+}
+
+const unsigned int* oriented_graph_successors(OrientedGraph* graph, unsigned int node_id, size_t* count) {
+    NULL_POINTER_CHECK(graph, NULL);
+    NULL_POINTER_CHECK(count, NULL);
+
+    const OrientedGraphCSR* csr = oriented_graph_freeze(graph);
+    if(node_id >= csr->nodes_count) {
+        *count = 0;
+        return NULL;
+    }
+
+    *count = csr->successors_offsets[node_id + 1] - csr->successors_offsets[node_id];
+    return &csr->successors[csr->successors_offsets[node_id]];
+}
+
+const unsigned int* oriented_graph_predecessors(OrientedGraph* graph, unsigned int node_id, size_t* count) {
+    NULL_POINTER_CHECK(graph, NULL);
+    NULL_POINTER_CHECK(count, NULL);
+
+    const OrientedGraphCSR* csr = oriented_graph_freeze(graph);
+    if(node_id >= csr->nodes_count) {
+        *count = 0;
+        return NULL;
+    }
+
+    *count = csr->predecessors_offsets[node_id + 1] - csr->predecessors_offsets[node_id];
+    return &csr->predecessors[csr->predecessors_offsets[node_id]];
+}
+
 void oriented_graph_connect_nodes(OrientedGraph* graph, GraphNodeBase* from, GraphNodeBase* to) {
     NULL_POINTER_CHECK(graph,);
     NULL_POINTER_CHECK(from,);
     NULL_POINTER_CHECK(to,);
 
+    oriented_graph_thaw(graph);
     set_int_add(from->out_edges, to->id);
     set_int_add(to->in_edges, from->id);
 }
@@ -193,45 +280,357 @@ bool oriented_graph_node_is_in_cycle(OrientedGraph* graph, GraphNodeBase* node)
     NULL_POINTER_CHECK(graph, false);
     NULL_POINTER_CHECK(node, false);
 
-    SetInt* ids = set_int_init();
-    const unsigned int node_id = node->id;
-
-    set_int_union(ids, node->out_edges);
-    size_t previous_size;
-    size_t current_size;
+    // depth first search from successors of node, every node is visited at most once
+    const OrientedGraphCSR* csr = oriented_graph_freeze(graph);
+    bool* visited = memory_alloc(sizeof(bool) * csr->nodes_count);
+    unsigned int* pending = memory_alloc(sizeof(unsigned int) * csr->nodes_count);
+    memset(visited, 0, sizeof(bool) * csr->nodes_count);
+    size_t pending_count = 0;
+    bool found = false;
+
+    for(unsigned int i = csr->successors_offsets[node->id]; i < csr->successors_offsets[node->id + 1]; i++) {
+        visited[csr->successors[i]] = true;
+        pending[pending_count++] = csr->successors[i];
+    }
 
-    do {
-        if(set_int_contains(ids, node_id)) {
-            set_int_free(&ids);
-            return true;
+    while(pending_count > 0) {
+        const unsigned int id = pending[--pending_count];
+        if(id == node->id) {
+            found = true;
+            break;
         }
 
-        previous_size = set_int_size(ids);
-        _oriented_graph_expand_nodes(graph, ids);
-        current_size = set_int_size(ids);
-    } while(previous_size != current_size);
+        for(unsigned int i = csr->successors_offsets[id]; i < csr->successors_offsets[id + 1]; i++) {
+            if(!visited[csr->successors[i]]) {
+                visited[csr->successors[i]] = true;
+                pending[pending_count++] = csr->successors[i];
+            }
+        }
+    }
 
-    set_int_free(&ids);
-    return false;
+    memory_free(visited);
+    memory_free(pending);
+    return found;
 }
 
 void _oriented_graph_expand_nodes(OrientedGraph* graph, SetInt* layer) {
+    const OrientedGraphCSR* csr = oriented_graph_freeze(graph);
     SetInt* expanded = set_int_init();
-    SetIntItem* item = (SetIntItem*) layer->head;
 
-    while(item != NULL) {
-        const GraphNodeBase* node = oriented_graph_node(graph, (unsigned int) item->value);
-        if(node == NULL)
+    for(int id = set_int_first(layer); id != SET_INT_END; id = set_int_next(layer, id)) {
+        if((size_t) id >= csr->nodes_count)
             continue;
 
-        set_int_union(expanded, node->out_edges);
-        item = (SetIntItem*) item->base.next;
+        for(unsigned int i = csr->successors_offsets[id]; i < csr->successors_offsets[id + 1]; i++)
+            set_int_add(expanded, (int) csr->successors[i]);
     }
 
     set_int_union(layer, expanded);
     set_int_free(&expanded);
 }
 
+// numbers nodes in reverse postorder of depth first search started from entries
+static size_t oriented_graph_depth_first_order(OrientedGraph* graph, const OrientedGraphCSR* csr,
+                                               unsigned int* order, int* order_index, bool* is_entry) {
+    const size_t nodes_count = csr->nodes_count;
+    unsigned int* stack = memory_alloc(sizeof(unsigned int) * (nodes_count + 1));
+    unsigned int* positions = memory_alloc(sizeof(unsigned int) * (nodes_count + 1));
+    bool* visited = memory_alloc(sizeof(bool) * (nodes_count + 1));
+    memset(visited, 0, sizeof(bool) * (nodes_count + 1));
+    size_t count = 0;
+
+    // nodes without predecessors first, then remaining unreachable ones
+    for(int pass = 0; pass < 2; pass++) {
+        for(unsigned int root = 0; root < nodes_count; root++) {
+            if(graph->nodes[root] == NULL || visited[root])
+                continue;
+            if(pass == 0 && csr->predecessors_offsets[root] != csr->predecessors_offsets[root + 1])
+                continue;
+
+            is_entry[root] = true;
+            visited[root] = true;
+            size_t stack_count = 0;
+            stack[stack_count] = root;
+            positions[stack_count++] = csr->successors_offsets[root];
+
+            while(stack_count > 0) {
+                const unsigned int top = stack[stack_count - 1];
+                if(positions[stack_count - 1] < csr->successors_offsets[top + 1]) {
+                    const unsigned int next = csr->successors[positions[stack_count - 1]++];
+                    if(!visited[next]) {
+                        visited[next] = true;
+                        stack[stack_count] = next;
+                        positions[stack_count++] = csr->successors_offsets[next];
+                    }
+                } else {
+                    order[count++] = top;
+                    stack_count--;
+                }
+            }
+        }
+    }
+
+    for(size_t i = 0; i < nodes_count; i++)
+        order_index[i] = -1;
+    for(size_t i = 0; i < count / 2; i++) {
+        const unsigned int swapped = order[i];
+        order[i] = order[count - 1 - i];
+        order[count - 1 - i] = swapped;
+    }
+    for(size_t i = 0; i < count; i++)
+        order_index[order[i]] = (int) i;
+
+    memory_free(stack);
+    memory_free(positions);
+    memory_free(visited);
+    return count;
+}
+
+size_t oriented_graph_reverse_postorder(OrientedGraph* graph, unsigned int* order) {
+    NULL_POINTER_CHECK(graph, 0);
+    NULL_POINTER_CHECK(order, 0);
+
+    const OrientedGraphCSR* csr = oriented_graph_freeze(graph);
+    int* order_index = memory_alloc(sizeof(int) * (csr->nodes_count + 1));
+    bool* is_entry = memory_alloc(sizeof(bool) * (csr->nodes_count + 1));
+    memset(is_entry, 0, sizeof(bool) * (csr->nodes_count + 1));
+
+    const size_t count = oriented_graph_depth_first_order(graph, csr, order, order_index, is_entry);
+
+    memory_free(order_index);
+    memory_free(is_entry);
+    return count;
+}
+
+// nearest common dominator, dominators are indexed by position in reverse postorder shifted by virtual root
+static int oriented_graph_intersect_dominators(const int* dominators, int first, int second) {
+    while(first != second) {
+        while(first > second)
+            first = dominators[first];
+        while(second > first)
+            second = dominators[second];
+    }
+    return first;
+}
+
+// adds nodes reaching back edge source without passing header
+static void oriented_graph_collect_natural_loop(const OrientedGraphCSR* csr, SetInt* nodes, unsigned int source,
+                                                unsigned int* pending) {
+    if(set_int_contains(nodes, (int) source))
+        return;
+
+    size_t pending_count = 0;
+    set_int_add(nodes, (int) source);
+    pending[pending_count++] = source;
+
+    while(pending_count > 0) {
+        const unsigned int id = pending[--pending_count];
+        for(unsigned int i = csr->predecessors_offsets[id]; i < csr->predecessors_offsets[id + 1]; i++) {
+            if(!set_int_contains(nodes, (int) csr->predecessors[i])) {
+                set_int_add(nodes, (int) csr->predecessors[i]);
+                pending[pending_count++] = csr->predecessors[i];
+            }
+        }
+    }
+}
+
+// bigger loops first, so enclosing loop is before nested ones
+static int oriented_graph_loop_compare(const void* first, const void* second) {
+    const OrientedGraphLoop* first_loop = (const OrientedGraphLoop*) first;
+    const OrientedGraphLoop* second_loop = (const OrientedGraphLoop*) second;
+    const size_t first_size = set_int_size(first_loop->nodes);
+    const size_t second_size = set_int_size(second_loop->nodes);
+
+    if(first_size != second_size)
+        return first_size > second_size ? -1 : 1;
+    return first_loop->header < second_loop->header ? -1 : (first_loop->header > second_loop->header);
+}
+
+OrientedGraphLoopForest* oriented_graph_loop_forest_init(OrientedGraph* graph) {
+    NULL_POINTER_CHECK(graph, NULL);
+
+    const OrientedGraphCSR* csr = oriented_graph_freeze(graph);
+    const size_t nodes_count = csr->nodes_count;
+    OrientedGraphLoopForest* forest = memory_alloc(sizeof(OrientedGraphLoopForest));
+    NULL_POINTER_CHECK(forest, NULL);
+    forest->nodes_count = nodes_count;
+    forest->immediate_dominators = memory_alloc(sizeof(int) * (nodes_count + 1));
+    forest->innermost_loops = memory_alloc(sizeof(int) * (nodes_count + 1));
+    // every node is header of at most one loop
+    forest->loops = memory_alloc(sizeof(OrientedGraphLoop) * (nodes_count + 1));
+    forest->loops_count = 0;
+
+    unsigned int* order = memory_alloc(sizeof(unsigned int) * (nodes_count + 1));
+    int* order_index = memory_alloc(sizeof(int) * (nodes_count + 1));
+    bool* is_entry = memory_alloc(sizeof(bool) * (nodes_count + 1));
+    memset(is_entry, 0, sizeof(bool) * (nodes_count + 1));
+    const size_t count = oriented_graph_depth_first_order(graph, csr, order, order_index, is_entry);
+
+    // dominators of nodes at positions in reverse postorder + 1, virtual root at 0 precedes all entries
+    int* dominators = memory_alloc(sizeof(int) * (count + 1));
+    dominators[0] = 0;
+    for(size_t i = 1; i <= count; i++)
+        dominators[i] = -1;
+
+    bool changed = true;
+    while(changed) {
+        changed = false;
+        for(size_t i = 1; i <= count; i++) {
+            const unsigned int id = order[i - 1];
+            int new_dominator = is_entry[id] ? 0 : -1;
+
+            for(unsigned int j = csr->predecessors_offsets[id]; j < csr->predecessors_offsets[id + 1]; j++) {
+                const int predecessor = order_index[csr->predecessors[j]] + 1;
+                if(dominators[predecessor] == -1)
+                    continue;
+                new_dominator = new_dominator == -1 ? predecessor :
+                                oriented_graph_intersect_dominators(dominators, predecessor, new_dominator);
+            }
+
+            if(dominators[i] != new_dominator) {
+                dominators[i] = new_dominator;
+                changed = true;
+            }
+        }
+    }
+
+    for(size_t i = 0; i < nodes_count; i++) {
+        forest->immediate_dominators[i] = -1;
+        forest->innermost_loops[i] = -1;
+    }
+    for(size_t i = 1; i <= count; i++) {
+        if(dominators[i] > 0)
+            forest->immediate_dominators[order[i - 1]] = (int) order[dominators[i] - 1];
+    }
+
+    // loops of retreating edges by their headers
+    int* header_loops = memory_alloc(sizeof(int) * (nodes_count + 1));
+    for(size_t i = 0; i < nodes_count; i++)
+        header_loops[i] = -1;
+    unsigned int* pending = memory_alloc(sizeof(unsigned int) * (nodes_count + 1));
+    LList* components = NULL;
+
+    for(size_t i = 0; i < count; i++) {
+        const unsigned int source = order[i];
+        for(unsigned int j = csr->successors_offsets[source]; j < csr->successors_offsets[source + 1]; j++) {
+            const unsigned int header = csr->successors[j];
+            if(order_index[header] > (int) i)
+                continue;
+
+            if(header_loops[header] == -1) {
+                OrientedGraphLoop* loop = &forest->loops[forest->loops_count];
+                loop->header = header;
+                loop->parent = -1;
+                loop->nodes = set_int_init();
+                set_int_add(loop->nodes, (int) header);
+                header_loops[header] = (int) forest->loops_count++;
+            }
+            SetInt* nodes = forest->loops[header_loops[header]].nodes;
+
+            if(oriented_graph_loop_forest_dominates(forest, header, source)) {
+                oriented_graph_collect_natural_loop(csr, nodes, source, pending);
+                continue;
+            }
+
+            // irreducible cycle, whole strongly connected component is loop
+            if(components == NULL)
+                components = oriented_graph_scc(graph);
+            for(LListItemSet* item = (LListItemSet*) components->head;
+                item != NULL; item = (LListItemSet*) item->base.next) {
+                if(set_int_contains(item->set, (int) header))
+                    set_int_union(nodes, item->set);
+            }
+        }
+    }
+
+    // nesting, header of nested loop is already in enclosing one
+    qsort(forest->loops, forest->loops_count, sizeof(OrientedGraphLoop), &oriented_graph_loop_compare);
+    for(size_t i = 0; i < forest->loops_count; i++) {
+        OrientedGraphLoop* loop = &forest->loops[i];
+        loop->parent = forest->innermost_loops[loop->header];
+        for(int id = set_int_first(loop->nodes); id != SET_INT_END; id = set_int_next(loop->nodes, id))
+            forest->innermost_loops[id] = (int) i;
+    }
+
+    if(components != NULL)
+        llist_free(&components);
+    memory_free(header_loops);
+    memory_free(pending);
+    memory_free(dominators);
+    memory_free(order);
+    memory_free(order_index);
+    memory_free(is_entry);
+    return forest;
+}
+
+void oriented_graph_loop_forest_free(OrientedGraphLoopForest** forest) {
+    NULL_POINTER_CHECK(forest,);
+    NULL_POINTER_CHECK(*forest,);
+
+    for(size_t i = 0; i < (*forest)->loops_count; i++)
+        set_int_free(&(*forest)->loops[i].nodes);
+    memory_free((*forest)->loops);
+    memory_free((*forest)->immediate_dominators);
+    memory_free((*forest)->innermost_loops);
+    memory_free(*forest);
+    *forest = NULL;
+}
+
+bool oriented_graph_loop_forest_dominates(OrientedGraphLoopForest* forest, unsigned int dominator, unsigned int node) {
+    NULL_POINTER_CHECK(forest, false);
+
+    if(node >= forest->nodes_count)
+        return false;
+
+    int id = (int) node;
+    while(id != -1) {
+        if(id == (int) dominator)
+            return true;
+        id = forest->immediate_dominators[id];
+    }
+    return false;
+}
+
+int oriented_graph_loop_forest_innermost_loop(OrientedGraphLoopForest* forest, unsigned int node_id) {
+    NULL_POINTER_CHECK(forest, -1);
+
+    return node_id < forest->nodes_count ? forest->innermost_loops[node_id] : -1;
+}
+
+int oriented_graph_loop_forest_outermost_loop(OrientedGraphLoopForest* forest, unsigned int node_id) {
+    NULL_POINTER_CHECK(forest, -1);
+
+    int loop = oriented_graph_loop_forest_innermost_loop(forest, node_id);
+    while(loop != -1 && forest->loops[loop].parent != -1)
+        loop = forest->loops[loop].parent;
+    return loop;
+}
+
+void oriented_graph_loop_forest_dominance_frontiers(OrientedGraphLoopForest* forest, OrientedGraph* graph,
+                                                    SetInt** frontiers) {
+    NULL_POINTER_CHECK(forest,);
+    NULL_POINTER_CHECK(graph,);
+    NULL_POINTER_CHECK(frontiers,);
+
+    const OrientedGraphCSR* csr = oriented_graph_freeze(graph);
+    if(csr->nodes_count != forest->nodes_count) {
+        LOG_WARNING("Loop forest was built for different graph.");
+        return;
+    }
+
+    // node is in frontier of its predecessors and their dominators up to its immediate dominator,
+    // entries are dominated only by virtual root
+    for(unsigned int id = 0; id < csr->nodes_count; id++) {
+        for(unsigned int i = csr->predecessors_offsets[id]; i < csr->predecessors_offsets[id + 1]; i++) {
+            int runner = (int) csr->predecessors[i];
+            while(runner != -1 && runner != forest->immediate_dominators[id]) {
+                set_int_add(frontiers[runner], (int) id);
+                runner = forest->immediate_dominators[runner];
+            }
+        }
+    }
+}
+
 OrientedGraph* oriented_graph_transpose(OrientedGraph* graph) {
     NULL_POINTER_CHECK(graph, NULL);
 
@@ -259,14 +658,12 @@ OrientedGraph* oriented_graph_transpose(OrientedGraph* graph) {
 
         GraphNodeBase* node = graph->nodes[i];
 
-        SetIntItem* out_node_id = (SetIntItem*) node->out_edges->head;
-        while(out_node_id != NULL) {
+        for(int out_node_id = set_int_first(node->out_edges);
+            out_node_id != SET_INT_END; out_node_id = set_int_next(node->out_edges, out_node_id)) {
             oriented_graph_connect_nodes_by_ids(
                     transposed,
-                    (unsigned int) out_node_id->value,
+                    (unsigned int) out_node_id,
                     node->id);
-
-            out_node_id = (SetIntItem*) out_node_id->base.next;
         }
     }
 
@@ -285,6 +682,7 @@ LList* oriented_graph_scc(OrientedGraph* graph) {
     bool stack_member[graph->capacity];
     int discovery_time = 0;
 
+    oriented_graph_freeze(graph);
     for(size_t i = 0; i < graph->capacity; i++) {
         disc[i] = -1;
         low[i] = -1;
@@ -325,16 +723,14 @@ void oriented_graph_scc_util(OrientedGraph* graph, unsigned int u, int disc[], i
     stack_member[u] = true;
     stack_push(stack, stack_item_int_init(u));
 
-    SetIntItem* v_item = (SetIntItem*) graph->nodes[u]->out_edges->head;
-    while(v_item != NULL) {
-        unsigned int v = (unsigned int) v_item->value;
+    const OrientedGraphCSR* csr = oriented_graph_freeze(graph);
+    for(unsigned int i = csr->successors_offsets[u]; i < csr->successors_offsets[u + 1]; i++) {
+        const unsigned int v = csr->successors[i];
         if(disc[v] == -1) {
             oriented_graph_scc_util(graph, v, disc, low, stack, stack_member, discovery_time, components);
             low[u] = (low[u] < low[v]) ? low[u] : low[v];
         } else if(stack_member[v] == true)
             low[u] = (low[u] < disc[v]) ? low[u] : disc[v];
-
-        v_item = (SetIntItem*) v_item->base.next;
     }
 
     unsigned int w = 0;
@@ -14,11 +14,27 @@ typedef struct {
 typedef void(*oriented_graph_init_data_callback_f)(GraphNodeBase*);
 typedef void(*oriented_graph_free_data_callback_f)(GraphNodeBase*);
 
+/**
+ * @brief Frozen compressed sparse row view of graph edges. Successors of node u are
+ * successors[successors_offsets[u]] .. successors[successors_offsets[u + 1] - 1] in ascending order,
+ * predecessors are stored in same way.
+ */
+typedef struct {
+    // count of node slots, ids of nodes are lower
+    size_t nodes_count;
+    unsigned int* successors_offsets;
+    unsigned int* successors;
+    unsigned int* predecessors_offsets;
+    unsigned int* predecessors;
+} OrientedGraphCSR;
+
 typedef struct {
     size_t capacity;
     size_t nodes_count;
     size_t item_size;
     GraphNodeBase** nodes;
+    // NULL until graph is frozen, every modification of graph drops it
+    OrientedGraphCSR* csr;
     oriented_graph_init_data_callback_f init_data_callback;
     oriented_graph_free_data_callback_f free_data_callback;
 } OrientedGraph;
@@ -43,10 +59,89 @@ void oriented_graph_clear(OrientedGraph* graph);
 
 void oriented_graph_print(OrientedGraph* graph);
 
+/**
+ * @brief Builds CSR view of current edges, if it is not built yet.
+ */
+const OrientedGraphCSR* oriented_graph_freeze(OrientedGraph* graph);
+
+/**
+ * @brief Ids of successors of node in ascending order from CSR view, graph is frozen if needed.
+ * @param count Output for count of successors
+ */
+const unsigned int* oriented_graph_successors(OrientedGraph* graph, unsigned int node_id, size_t* count);
+
+/**
+ * @brief Ids of predecessors of node in ascending order from CSR view, graph is frozen if needed.
+ * @param count Output for count of predecessors
+ */
+const unsigned int* oriented_graph_predecessors(OrientedGraph* graph, unsigned int node_id, size_t* count);
+
 bool oriented_graph_node_is_in_cycle_by_id(OrientedGraph* graph, unsigned int id);
 bool oriented_graph_node_is_in_cycle(OrientedGraph* graph, GraphNodeBase* node);
 void _oriented_graph_expand_nodes(OrientedGraph* graph, SetInt* layer);
 
+/**
+ * @brief Ids of nodes in reverse postorder of depth first search started from nodes without predecessors,
+ * search continues from remaining unvisited nodes.
+ * @param order Output with capacity for all node slots of graph
+ * @return count of nodes
+ */
+size_t oriented_graph_reverse_postorder(OrientedGraph* graph, unsigned int* order);
+
+/**
+ * @brief Loop of graph, natural loops with same header are merged.
+ */
+typedef struct {
+    unsigned int header;
+    // index of directly enclosing loop or -1
+    int parent;
+    // ids of nodes in loop including nodes of nested loops
+    SetInt* nodes;
+} OrientedGraphLoop;
+
+/**
+ * @brief Dominator tree and loop nesting forest of graph. Nodes without predecessors are entries of graph,
+ * nodes unreachable from them are entered in order of ids.
+ */
+typedef struct {
+    size_t nodes_count;
+    // immediate dominator of node, -1 for entries and empty slots
+    int* immediate_dominators;
+    // index of innermost loop containing node or -1
+    int* innermost_loops;
+    // enclosing loop is always before nested ones
+    OrientedGraphLoop* loops;
+    size_t loops_count;
+} OrientedGraphLoopForest;
+
+/**
+ * @brief Builds dominator tree (Cooper, Harvey, Kennedy) and loops of graph. Loops are natural loops
+ * of back edges, cycle entered by more nodes (irreducible) is one loop consisting of its strongly connected component.
+ */
+OrientedGraphLoopForest* oriented_graph_loop_forest_init(OrientedGraph* graph);
+
+void oriented_graph_loop_forest_free(OrientedGraphLoopForest** forest);
+
+bool oriented_graph_loop_forest_dominates(OrientedGraphLoopForest* forest, unsigned int dominator, unsigned int node);
+
+/**
+ * @brief Index of innermost loop containing node or -1.
+ */
+int oriented_graph_loop_forest_innermost_loop(OrientedGraphLoopForest* forest, unsigned int node_id);
+
+/**
+ * @brief Index of outermost loop containing node or -1.
+ */
+int oriented_graph_loop_forest_outermost_loop(OrientedGraphLoopForest* forest, unsigned int node_id);
+
+/**
+ * @brief Dominance frontiers of nodes (Cooper, Harvey, Kennedy), frontier of node are nodes reached by its
+ * dominance region, which are not strictly dominated by it.
+ * @param frontiers Output with set for every node slot of forest, nodes are added to given sets
+ */
+void oriented_graph_loop_forest_dominance_frontiers(OrientedGraphLoopForest* forest, OrientedGraph* graph,
+                                                    SetInt** frontiers);
+
 OrientedGraph* oriented_graph_transpose(OrientedGraph* graph);
 /**
   Tarjan's algorithm
@@ -9,9 +9,14 @@
 
 Parser* parser_init(lexer_input_stream_f input_stream) {
     NULL_POINTER_CHECK(input_stream, NULL);
+    return parser_init_with_input(lexer_input_init_stream(input_stream));
+}
+
+Parser* parser_init_with_input(LexerInput* input) {
+    NULL_POINTER_CHECK(input, NULL);
     Parser* parser = (Parser*) memory_alloc(sizeof(Parser));
 
-    parser->lexer = lexer_init(input_stream);
+    parser->lexer = lexer_init_with_input(input);
     parser->error_report.error_code = ERROR_NONE;
     parser->parser_semantic = parser_semantic_init();
     parser->code_constructor = code_constructor_init();
@@ -187,7 +192,6 @@ bool parser_parse_definitions(Parser* parser) {
     RULES(
             CHECK_RULE(eols);
             CONDITIONAL_RULES(
-                    lexer_rewind_token(parser->lexer, token);
             CHECK_RULE(token_type != TOKEN_DECLARE && token_type != TOKEN_FUNCTION && token_type != TOKEN_DIM, epsilon,
                        NO_CODE);
             CHECK_RULE(definition);
@@ -209,7 +213,6 @@ bool parser_parse_definition(Parser* parser) {
     NULL_POINTER_CHECK(parser, false);
     RULES(
             CONDITIONAL_RULES(
-                    lexer_rewind_token(parser->lexer, token);
             CHECK_RULE(token_type == TOKEN_DECLARE, function_declaration, NO_CODE);
             CHECK_RULE(token_type == TOKEN_FUNCTION, function_definition, NO_CODE);
             CHECK_RULE(token_type == TOKEN_DIM, shared_variable_declaration, NO_CODE);
@@ -309,7 +312,6 @@ bool parser_parse_function_statements(Parser* parser) {
     NULL_POINTER_CHECK(parser, false);
     RULES(
             CONDITIONAL_RULES(
-                    lexer_rewind_token(parser->lexer, token);
 
 
             CHECK_RULE(
@@ -339,7 +341,6 @@ bool parser_parse_body_statements(Parser* parser) {
     NULL_POINTER_CHECK(parser, false);
     RULES(
             CONDITIONAL_RULES(
-                    lexer_rewind_token(parser->lexer, token);
 
             CHECK_RULE(
                     token_type != TOKEN_INPUT && token_type != TOKEN_DIM && token_type != TOKEN_PRINT &&
@@ -378,15 +379,15 @@ bool parser_parse_function_statement_single(Parser* parser) {
     NULL_POINTER_CHECK(parser, false);
     RULES(
             CONDITIONAL_RULES(
-                    CHECK_RULE(token_type == TOKEN_IDENTIFIER, identifier_assignment, REWIND_AND_SUCCESS);
-            CHECK_RULE(token_type == TOKEN_INPUT, input, REWIND_AND_SUCCESS);
-            CHECK_RULE(token_type == TOKEN_RETURN, return_, REWIND_AND_SUCCESS);
-            CHECK_RULE(token_type == TOKEN_PRINT, print, REWIND_AND_SUCCESS);
-            CHECK_RULE(token_type == TOKEN_IF, condition, REWIND_AND_SUCCESS);
-            CHECK_RULE(token_type == TOKEN_DO, while_, REWIND_AND_SUCCESS);
-            CHECK_RULE(token_type == TOKEN_DIM, variable_declaration, REWIND_AND_SUCCESS);
-            CHECK_RULE(token_type == TOKEN_STATIC, static_variable_declaration, REWIND_AND_SUCCESS);
-            CHECK_RULE(token_type == TOKEN_SCOPE, scope, REWIND_AND_SUCCESS);
+                    CHECK_RULE(token_type == TOKEN_IDENTIFIER, identifier_assignment, RETURN_SUCCESS);
+            CHECK_RULE(token_type == TOKEN_INPUT, input, RETURN_SUCCESS);
+            CHECK_RULE(token_type == TOKEN_RETURN, return_, RETURN_SUCCESS);
+            CHECK_RULE(token_type == TOKEN_PRINT, print, RETURN_SUCCESS);
+            CHECK_RULE(token_type == TOKEN_IF, condition, RETURN_SUCCESS);
+            CHECK_RULE(token_type == TOKEN_DO, while_, RETURN_SUCCESS);
+            CHECK_RULE(token_type == TOKEN_DIM, variable_declaration, RETURN_SUCCESS);
+            CHECK_RULE(token_type == TOKEN_STATIC, static_variable_declaration, RETURN_SUCCESS);
+            CHECK_RULE(token_type == TOKEN_SCOPE, scope, RETURN_SUCCESS);
 
     );
     );
@@ -409,14 +410,14 @@ bool parser_parse_body_statement_single(Parser* parser) {
     NULL_POINTER_CHECK(parser, false);
     RULES(
             CONDITIONAL_RULES(
-                    CHECK_RULE(token_type == TOKEN_INPUT, input, REWIND_AND_SUCCESS);
-            CHECK_RULE(token_type == TOKEN_IDENTIFIER, identifier_assignment, REWIND_AND_SUCCESS);
-            CHECK_RULE(token_type == TOKEN_DO, while_, REWIND_AND_SUCCESS);
-            CHECK_RULE(token_type == TOKEN_PRINT, print, REWIND_AND_SUCCESS);
-            CHECK_RULE(token_type == TOKEN_SCOPE, scope, REWIND_AND_SUCCESS);
-            CHECK_RULE(token_type == TOKEN_IF, condition, REWIND_AND_SUCCESS);
-            CHECK_RULE(token_type == TOKEN_DIM, variable_declaration, REWIND_AND_SUCCESS);
-            CHECK_RULE(token_type == TOKEN_STATIC, static_variable_declaration, REWIND_AND_SUCCESS);
+                    CHECK_RULE(token_type == TOKEN_INPUT, input, RETURN_SUCCESS);
+            CHECK_RULE(token_type == TOKEN_IDENTIFIER, identifier_assignment, RETURN_SUCCESS);
+            CHECK_RULE(token_type == TOKEN_DO, while_, RETURN_SUCCESS);
+            CHECK_RULE(token_type == TOKEN_PRINT, print, RETURN_SUCCESS);
+            CHECK_RULE(token_type == TOKEN_SCOPE, scope, RETURN_SUCCESS);
+            CHECK_RULE(token_type == TOKEN_IF, condition, RETURN_SUCCESS);
+            CHECK_RULE(token_type == TOKEN_DIM, variable_declaration, RETURN_SUCCESS);
+            CHECK_RULE(token_type == TOKEN_STATIC, static_variable_declaration, RETURN_SUCCESS);
     );
     );
 
@@ -501,7 +502,6 @@ bool parser_parse_function_params(Parser* parser) {
     NULL_POINTER_CHECK(parser, false);
     RULES(
             CONDITIONAL_RULES(
-                    lexer_rewind_token(parser->lexer, token);
             CHECK_RULE(
                     token_type == TOKEN_RIGHT_BRACKET,
                     epsilon,
@@ -533,14 +533,12 @@ bool parser_parse_function_n_param(Parser* parser) {
                             epsilon,
                             BEFORE({}),
                             AFTER({
-                                          lexer_rewind_token(
-                                                  parser->lexer,
-                                                  token
-                                          );
                                           return true;
                                   }
                             )
                     );
+            // consume separator of params
+            GET_NEXT_TOKEN_TYPE();
             CHECK_RULE(function_param);
             CHECK_RULE(function_n_param);
     );
@@ -554,11 +552,10 @@ bool parser_parse_function_param(Parser* parser) {
      * <function_param> -> IDENTIFIER AS TYPE
      */
     NULL_POINTER_CHECK(parser, false);
-    char* name = NULL;
+    const char* name = NULL;
     RULES(
             CHECK_TOKEN(TOKEN_IDENTIFIER);
-            name = c_string_copy(token.data);
-            memory_free_lazy(name);
+            name = token.data;
             CHECK_TOKEN(TOKEN_AS);
             CHECK_TOKEN(TOKEN_DATA_TYPE_CLASS);
             SEMANTIC_ANALYSIS(
@@ -581,12 +578,8 @@ bool parser_parse_eols(Parser* parser) {
 
 
     NULL_POINTER_CHECK(parser, false);
-    Token token = {.data=NULL};
-    do {
-        token_free(&token);
-        token = lexer_next_token(parser->lexer);
-    } while(token.type == TOKEN_EOL);
-    lexer_rewind_token(parser->lexer, token);
+    while(lexer_peek_token(parser->lexer, 0).type == TOKEN_EOL)
+        lexer_next_token(parser->lexer);
 
     return true;
 }
@@ -603,15 +596,14 @@ bool parser_parse_variable_declaration(Parser* parser) {
      */
 
     NULL_POINTER_CHECK(parser, false);
-    char* name = NULL;
+    const char* name = NULL;
     RULES(
             CHECK_TOKEN(TOKEN_DIM);
             CHECK_TOKEN(
                     TOKEN_IDENTIFIER,
                     BEFORE(
                             {
-                                    name = c_string_copy(token.data);
-                                    memory_free_lazy(name);
+                                    name = token.data;
                             }
                     )
             );
@@ -659,7 +651,6 @@ bool parser_parse_shared_variables_declarations(Parser* parser) {
     RULES(
             CHECK_RULE(eols);
             CONDITIONAL_RULES(
-                    lexer_rewind_token(parser->lexer, token);
             CHECK_RULE(token_type != TOKEN_DIM, epsilon, NO_CODE);
             CHECK_RULE(shared_variable_declaration);
             CHECK_TOKEN(TOKEN_EOL);
@@ -677,7 +668,7 @@ bool parser_parse_shared_variable_declaration(Parser* parser) {
      */
 
     NULL_POINTER_CHECK(parser, false);
-    char* name = NULL;
+    const char* name = NULL;
     RULES(
             CHECK_TOKEN(TOKEN_DIM);
             CHECK_TOKEN(TOKEN_SHARED);
@@ -685,8 +676,7 @@ bool parser_parse_shared_variable_declaration(Parser* parser) {
                     TOKEN_IDENTIFIER,
                     BEFORE(
                             {
-                                    name = c_string_copy(token.data);
-                                    memory_free_lazy(name);
+                                    name = token.data;
                             }
                     )
             );
@@ -728,7 +718,7 @@ bool parser_parse_static_variable_declaration(Parser* parser) {
      */
 
     NULL_POINTER_CHECK(parser, false);
-    char* name = NULL;
+    const char* name = NULL;
 
     if(parser->parser_semantic->expression_result != NULL) {
         expr_token_free(parser->parser_semantic->expression_result);
@@ -740,8 +730,7 @@ bool parser_parse_static_variable_declaration(Parser* parser) {
                     TOKEN_IDENTIFIER,
                     BEFORE(
                             {
-                                    name = c_string_copy(token.data);
-                                    memory_free_lazy(name);
+                                    name = token.data;
                             }
                     )
             );
@@ -868,11 +857,7 @@ bool parser_parse_print_expressions(Parser* parser) {
                     CHECK_RULE(
                             token_type == TOKEN_EOL,
                             epsilon,
-                            BEFORE(
-                                    {
-                                            lexer_rewind_token(parser->lexer,
-                                                               token);
-                                    }),
+                            BEFORE({}),
                             AFTER(
                                     {
                                             token_free(&token);
@@ -883,11 +868,8 @@ bool parser_parse_print_expressions(Parser* parser) {
             CHECK_RULE(
                     token_type != TOKEN_EOL,
                     print_expression,
-                    BEFORE(
-                            {
-                                    lexer_rewind_token(parser->lexer, token);
-                            }
-                    ), AFTER(
+                    BEFORE({}),
+                    AFTER(
                             {
                                     token_free(&token);
                             }
@@ -1114,11 +1096,7 @@ bool parser_parse_condition_elseif(Parser* parser) {
                     CHECK_RULE(
                             token_type != TOKEN_ELSEIF,
                             epsilon,
-                            BEFORE(
-                                    {
-                                            lexer_rewind_token(parser->lexer, token);
-                                    }
-                            ),
+                            BEFORE({}),
                             AFTER(
                                     {
                                             token_free(&token);
@@ -1126,6 +1104,7 @@ bool parser_parse_condition_elseif(Parser* parser) {
                                     }
                             )
                     );
+            CHECK_TOKEN(TOKEN_ELSEIF);
             CODE_GENERATION(
                     {
                             code_constructor_if_else_if_before_expression(parser->code_constructor);
@@ -1187,11 +1166,7 @@ bool parser_parse_condition_else(Parser* parser) {
                     CHECK_RULE(
                             token_type != TOKEN_ELSE,
                             epsilon,
-                            BEFORE(
-                                    {
-                                            lexer_rewind_token(parser->lexer, token);
-                                    }
-                            ),
+                            BEFORE({}),
                             AFTER(
                                     {
                                             token_free(&token);
@@ -1199,6 +1174,7 @@ bool parser_parse_condition_else(Parser* parser) {
                                     }
                             )
                     );
+            CHECK_TOKEN(TOKEN_ELSE);
             CHECK_TOKEN(TOKEN_EOL);
             CALL_RULE(eols);
             CODE_GENERATION(
@@ -1232,7 +1208,6 @@ bool parser_parse_declaration_assignment(Parser* parser) {
     RULES(
 
             CONDITIONAL_RULES(
-                    lexer_rewind_token(parser->lexer, token);
             CHECK_RULE(token_type == TOKEN_EQUAL, assignment, NO_CODE);
     );
     );
@@ -1286,7 +1261,6 @@ bool parser_parse_assignment(Parser* parser) {
 
     RULES(
             CONDITIONAL_RULES(
-                    lexer_rewind_token(parser->lexer, token);
 
             CHECK_RULE(
                     token_type == TOKEN_ASSIGN_SUB || token_type == TOKEN_ASSIGN_ADD ||
@@ -19,6 +19,13 @@
     token_type = token.type; \
 } while(0);
 
+// token stays in lookahead buffer of lexer, next GET_NEXT_TOKEN_TYPE consumes it
+#define PEEK_NEXT_TOKEN_TYPE() do { \
+    token_free(&token);\
+    token = lexer_peek_token(parser->lexer, 0); \
+    token_type = token.type; \
+} while(0);
+
 
 #define CALL_RULE(Rule) if (!parser_parse_##Rule(parser)) { token_free(&token); return false; }
 #define CALL_EXPRESSION_RULE() do { \
@@ -32,7 +39,7 @@
 #define BEFORE(code) do {code} while(false);
 #define AFTER(code) do {code} while(false);
 #define NO_CODE {},{}
-#define REWIND_AND_SUCCESS BEFORE({lexer_rewind_token(parser->lexer, token);}), AFTER({token_free(&token); return true;})
+#define RETURN_SUCCESS BEFORE({}), AFTER({token_free(&token); return true;})
 
 #define RULES(rules) \
     do { \
@@ -45,8 +52,9 @@
         token_free(&token); \
     } while(0)
 
+// alternatives are selected by peeked token, which is not consumed
 #define CONDITIONAL_RULES(rules) do { \
-        GET_NEXT_TOKEN_TYPE(); \
+        PEEK_NEXT_TOKEN_TYPE(); \
         conditions_buffer = 0; \
         conditional_rules = true; \
         rules \
@@ -210,6 +218,14 @@ typedef struct parser_t {
  */
 Parser* parser_init(lexer_input_stream_f input_stream);
 
+/**
+ * @brief Constructor for parser with buffered input
+ *
+ * @param input LexerInput* Input of source code, parser takes ownership
+ * @return Parser* Pointer to parser
+ */
+Parser* parser_init_with_input(LexerInput* input);
+
 /**
  * @brief Constructor for parser
  *
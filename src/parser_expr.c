@@ -2,13 +2,16 @@
 #include "parser_expr_internal.h"
 #include "parser_expr_rules.h"
 #include "parser.h"
-#include "llist.h"
 
-bool expression_reduce(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_reduce(Parser* parser, ExprTokenStack* stack, ExprIdx* expression_idx) {
     bool pass = false;
     const int table_size = sizeof(expr_rule_table) / sizeof(*expr_rule_table);
+    const size_t handle_begin = expr_token_stack_handle(stack);
+    if(handle_begin == 0)
+        return false;
+
     for(int i = 0; i < table_size; i++) {
-        pass |= expr_rule_table[i](parser, expr_token_buffer, expression_idx);
+        pass |= expr_rule_table[i](parser, stack, handle_begin, stack->count, expression_idx);
         if(
                 parser->parser_semantic->error_report.error_code != ERROR_NONE
                 &&
@@ -26,92 +29,75 @@ bool parser_parse_expression(Parser* parser) {
 
     Token last_token;
     last_token.data = NULL;
-    ExprToken* token, * precedence;
+    ExprToken token;
+    ExprTokenType precedence;
     ExprIdx expression_idx = 0;
-    LList* buffer;
-    llist_init(&buffer, sizeof(ExprToken), NULL, expr_llist_free, expr_llist_type_cmp);
+    bool success = false;
+    ExprTokenStack stack;
+    expr_token_stack_init(&stack);
 
-    token = (ExprToken*) llist_new_tail_item(buffer);
-    token->type = EXPR_TOKEN_$;
+    expr_token_stack_push(&stack, create_expr_token(EXPR_TOKEN_$));
 
     do {
         token = load_expr_token(parser->lexer, &last_token);
-        if(token->type == EXPR_TOKEN_MINUS) {
-            expr_token_update_unary(token, (ExprToken*) buffer->tail); // check if minus is unary and update
+        if(token.type == EXPR_TOKEN_MINUS) {
+            expr_token_update_unary(&token, expr_token_stack_top(&stack)); // check if minus is unary and update
         }
 
         do {
-            precedence = expr_get_precedence(expr_last_terminal(buffer), token);
+            precedence = expr_get_precedence(
+                    stack.items[expr_token_stack_last_terminal(&stack)].type,
+                    token.type
+            );
 
             // Check for delimiter of expression
-            if(token->type != EXPR_TOKEN_$ && precedence->type == EXPR_UNKNOWN) {
+            if(token.type != EXPR_TOKEN_$ && precedence == EXPR_UNKNOWN) {
                 lexer_rewind_token(parser->lexer, last_token);
-                expr_token_free(token);
-                expr_token_free(precedence);
                 token = create_expr_token(EXPR_TOKEN_$);
-                precedence = expr_get_precedence(expr_last_terminal(buffer), token);
+                precedence = expr_get_precedence(
+                        stack.items[expr_token_stack_last_terminal(&stack)].type,
+                        token.type
+                );
             }
 
             // Check completion of expression parsing
-            if(is_expr_parsing_complete(buffer, token)) {
-                if(parser->parser_semantic->expression_result != NULL)
-                    expr_token_free(parser->parser_semantic->expression_result);
-                parser->parser_semantic->expression_result = expr_token_copy((ExprToken*) buffer->tail);
+            if(is_expr_parsing_complete(&stack, token.type)) {
+                if(parser->parser_semantic->expression_result == NULL)
+                    parser->parser_semantic->expression_result = expr_token_init();
+                *parser->parser_semantic->expression_result = *expr_token_stack_top(&stack);
 
-                expr_token_free(token);
-                expr_token_free(precedence);
-                // Cleanup
-                token_free(&last_token);
-                llist_free(&buffer);
                 LOG_INFO(
                         "Expression success, data type %d, constant: %d.",
                         parser->parser_semantic->expression_result->data_type,
                         parser->parser_semantic->expression_result->is_constant
                 );
-                return true;
+                success = true;
+                goto cleanup;
             }
 
-            if(precedence->type == EXPR_LEFT_SHARP) {
-                expr_llist_append_after_last_terminal(buffer, precedence);
-            } else if(precedence->type == EXPR_RIGHT_SHARP) {
-                llist_append_item(buffer, (LListBaseItem*) precedence);
-            } else if(precedence->type == EXPR_SAME) {
-                expr_token_free(precedence);
-            } else {
+            if(precedence == EXPR_LEFT_SHARP) {
+                expr_token_stack_shift(&stack);
+                break;
+            } else if(precedence == EXPR_SAME) {
+                break;
+            } else if(precedence != EXPR_RIGHT_SHARP) {
                 LOG_INFO(
                         "Expression fail, precedence: %d, token: %d.",
-                        precedence->type,
+                        precedence,
                         last_token.type
                 );
-                expr_token_free(token);
-                expr_token_free(precedence);
-                // Cleanup
-                token_free(&last_token);
-                llist_free(&buffer);
-                return false; // Precedence error - undefined
+                goto cleanup; // Precedence error - undefined
             }
 
-            if(((ExprToken*) buffer->tail)->type == EXPR_REDUCE) {
-                if(expression_reduce(parser, buffer, &expression_idx)) {
-                    continue;
-                } else {
-                    expr_token_free(token);
-                    // Cleanup
-                    token_free(&last_token);
-                    llist_free(&buffer);
-                    return false; // Expression reduction error - no rule has been found
-                }
-            }
-            if(((ExprToken*) buffer->tail)->type != EXPR_REDUCE) {
-                break;
-            }
+            if(!expression_reduce(parser, &stack, &expression_idx))
+                goto cleanup; // Expression reduction error - no rule has been found
         } while(true);
-        llist_append_item(buffer, (LListBaseItem*) token);
+        expr_token_stack_push(&stack, token);
 
-    } while(token->type != EXPR_TOKEN_$);
+    } while(token.type != EXPR_TOKEN_$);
 
-    // Cleanup
+    cleanup:
     token_free(&last_token);
-    llist_free(&buffer);
-    return false; //Expression procession error
+    expr_token_stack_free(&stack);
+    return success;
 }
@@ -1,8 +1,8 @@
 #include "parser_expr_internal.h"
 #include "lexer.h"
 #include "token.h"
-#include "llist.h"
 #include "common.h"
+#include <string.h>
 
 static ExprTokenType _expr_internal_fn_literal_to_id(ExprTokenType t) {
     if(t >= EXPR_TOKEN_BOOLEAN_LITERAL &&
@@ -12,157 +12,129 @@ static ExprTokenType _expr_internal_fn_literal_to_id(ExprTokenType t) {
     return t;
 }
 
-static ExprTokenType _expr_get_precedence(ExprTokenType a, ExprTokenType b) {
-    ExprTokenType t;
-    if(!(a & EXPR_TERMINALS_MASK)) { return EXPR_UNKNOWN; }
-    if(!(b & EXPR_TERMINALS_MASK)) { return EXPR_UNKNOWN; }
+static bool _expr_internal_is_terminal(ExprTokenType t) {
+    return t > 0 && t <= EXPR_TOKEN_FN_CHR;
+}
+
+ExprTokenType expr_get_precedence(ExprTokenType a, ExprTokenType b) {
+    // also unknown tokens and marks have no precedence, EXPR_TERMINALS_MASK doesn't exclude them
+    if(!_expr_internal_is_terminal(a)) { return EXPR_UNKNOWN; }
+    if(!_expr_internal_is_terminal(b)) { return EXPR_UNKNOWN; }
 
     a = _expr_internal_fn_literal_to_id(a); // treat literals precedence as same as identifiers
     b = _expr_internal_fn_literal_to_id(b); // treat literals precedence as same as identifiers
 
-    a--;
-    b--;
-    char precedence = prec_table[((a * prec_table_size) * 2) + (b * 2)];
-    switch(precedence) {
-        case '<':
-            t = EXPR_LEFT_SHARP;
-            break;
-        case '>':
-            t = EXPR_RIGHT_SHARP;
-            break;
-        case '=':
-            t = EXPR_SAME;
-            break;
-        case '*':
-            t = EXPR_TOKEN_CHANGE;
-            break;
-        case 'x':
-        case '#':
-        case ' ':
-        default:
-            t = EXPR_UNKNOWN;
-            break;
-    }
-    return t;
+    return prec_table[a - 1][b - 1];
 }
 
-ExprToken* expr_get_precedence(ExprToken* a, ExprToken* b) {
-    ExprToken* r = create_expr_token(EXPR_UNKNOWN);
-    r->type = _expr_get_precedence(a->type, b->type);
-    return r;
+bool is_expr_parsing_complete(ExprTokenStack* stack, ExprTokenType token_type) {
+    return stack->count == 2 &&
+           stack->items[0].type == EXPR_TOKEN_$ &&
+           stack->items[1].type == EXPR_EXPRESSION &&
+           token_type == EXPR_TOKEN_$;
 }
 
-bool is_expr_parsing_complete(LList* expr_token_buffer, ExprToken* token) {
-    LListBaseItem* tmp = expr_token_buffer->head;
-    return ((ExprToken*) tmp)->type == EXPR_TOKEN_$ &&
-           (tmp = tmp->next) != NULL &&
-           ((ExprToken*) tmp)->type == EXPR_EXPRESSION &&
-           tmp->next == NULL &&
-           token->type == EXPR_TOKEN_$;
-}
-
-ExprToken* load_expr_token(Lexer* lexer, Token* last_token) {
-    NULL_POINTER_CHECK(lexer, NULL);
-    NULL_POINTER_CHECK(last_token, NULL);
+ExprToken load_expr_token(Lexer* lexer, Token* last_token) {
+    ExprToken expr_t = create_expr_token(EXPR_UNKNOWN);
+    NULL_POINTER_CHECK(lexer, expr_t);
+    NULL_POINTER_CHECK(last_token, expr_t);
 
     token_free(last_token);
 
     *last_token = lexer_next_token(lexer);
-    ExprToken* expr_t = expr_token_init();
-    expr_t->data.s = NULL;
 
     switch(last_token->type) {
         case TOKEN_MULTIPLY:
-            expr_t->type = EXPR_TOKEN_MULTIPLY;
+            expr_t.type = EXPR_TOKEN_MULTIPLY;
             break;
         case TOKEN_DIVIDE:
-            expr_t->type = EXPR_TOKEN_DIVIDE;
+            expr_t.type = EXPR_TOKEN_DIVIDE;
             break;
         case TOKEN_INTEGER_DIVIDE:
-            expr_t->type = EXPR_TOKEN_INTEGER_DIVIDE;
+            expr_t.type = EXPR_TOKEN_INTEGER_DIVIDE;
             break;
         case TOKEN_ADD:
-            expr_t->type = EXPR_TOKEN_PLUS;
+            expr_t.type = EXPR_TOKEN_PLUS;
             break;
         case TOKEN_SUBTRACT:
-            expr_t->type = EXPR_TOKEN_MINUS;
+            expr_t.type = EXPR_TOKEN_MINUS;
             break;
         case TOKEN_EQUAL:
-            expr_t->type = EXPR_TOKEN_EQUAL;
+            expr_t.type = EXPR_TOKEN_EQUAL;
             break;
         case TOKEN_SMALLER_BIGGER:
-            expr_t->type = EXPR_TOKEN_NOT_EQUAL;
+            expr_t.type = EXPR_TOKEN_NOT_EQUAL;
             break;
         case TOKEN_SMALLER:
-            expr_t->type = EXPR_TOKEN_LESSER;
+            expr_t.type = EXPR_TOKEN_LESSER;
             break;
         case TOKEN_SMALLER_EQUAL:
-            expr_t->type = EXPR_TOKEN_LESSER_OR_EQUAL;
+            expr_t.type = EXPR_TOKEN_LESSER_OR_EQUAL;
             break;
         case TOKEN_BIGGER_EQUAL:
-            expr_t->type = EXPR_TOKEN_GREATHER_OR_EQUAL;
+            expr_t.type = EXPR_TOKEN_GREATHER_OR_EQUAL;
             break;
         case TOKEN_BIGGER:
-            expr_t->type = EXPR_TOKEN_GREATHER;
+            expr_t.type = EXPR_TOKEN_GREATHER;
             break;
         case TOKEN_NOT:
-            expr_t->type = EXPR_TOKEN_NOT;
+            expr_t.type = EXPR_TOKEN_NOT;
             break;
         case TOKEN_AND:
-            expr_t->type = EXPR_TOKEN_AND;
+            expr_t.type = EXPR_TOKEN_AND;
             break;
         case TOKEN_OR:
-            expr_t->type = EXPR_TOKEN_OR;
+            expr_t.type = EXPR_TOKEN_OR;
             break;
         case TOKEN_LEFT_BRACKET:
-            expr_t->type = EXPR_TOKEN_LEFT_BRACKET;
+            expr_t.type = EXPR_TOKEN_LEFT_BRACKET;
             break;
         case TOKEN_RIGHT_BRACKET:
-            expr_t->type = EXPR_TOKEN_RIGHT_BRACKET;
+            expr_t.type = EXPR_TOKEN_RIGHT_BRACKET;
             break;
         case TOKEN_COMMA:
-            expr_t->type = EXPR_TOKEN_COMMA;
+            expr_t.type = EXPR_TOKEN_COMMA;
             break;
         case TOKEN_IDENTIFIER:
-            expr_t->type = EXPR_TOKEN_IDENTIFIER;
-            expr_t->data.s = c_string_copy(last_token->data);
+            expr_t.type = EXPR_TOKEN_IDENTIFIER;
+            expr_t.data.s = last_token->data;
             break;
             // Literals
         case TOKEN_TRUE:
-            expr_t->type = EXPR_TOKEN_BOOLEAN_LITERAL;
-            expr_t->data.b = true;
+            expr_t.type = EXPR_TOKEN_BOOLEAN_LITERAL;
+            expr_t.data.b = true;
             break;
         case TOKEN_FALSE:
-            expr_t->type = EXPR_TOKEN_BOOLEAN_LITERAL;
-            expr_t->data.b = false;
+            expr_t.type = EXPR_TOKEN_BOOLEAN_LITERAL;
+            expr_t.data.b = false;
             break;
         case TOKEN_DOUBLE_LITERAL:
-            expr_t->type = EXPR_TOKEN_DOUBLE_LITERAL;
-            expr_t->data.s = c_string_copy(last_token->data);
+            expr_t.type = EXPR_TOKEN_DOUBLE_LITERAL;
+            expr_t.data.d = last_token->value.double_;
             break;
         case TOKEN_INTEGER_LITERAL:
-            expr_t->type = EXPR_TOKEN_INTEGER_LITERAL;
-            expr_t->data.s = c_string_copy(last_token->data);
+            expr_t.type = EXPR_TOKEN_INTEGER_LITERAL;
+            expr_t.data.i = last_token->value.integer;
             break;
         case TOKEN_STRING_VALUE:
-            expr_t->type = EXPR_TOKEN_STRING_LITERAL;
-            expr_t->data.s = c_string_copy(last_token->data);
+            expr_t.type = EXPR_TOKEN_STRING_LITERAL;
+            expr_t.data.s = last_token->data;
             break;
             // Internal functions
         case TOKEN_LENGTH:
-            expr_t->type = EXPR_TOKEN_FN_LENGTH;
+            expr_t.type = EXPR_TOKEN_FN_LENGTH;
             break;
         case TOKEN_SUBSTR:
-            expr_t->type = EXPR_TOKEN_FN_SUBSTR;
+            expr_t.type = EXPR_TOKEN_FN_SUBSTR;
             break;
         case TOKEN_ASC:
-            expr_t->type = EXPR_TOKEN_FN_ASC;
+            expr_t.type = EXPR_TOKEN_FN_ASC;
             break;
         case TOKEN_CHR:
-            expr_t->type = EXPR_TOKEN_FN_CHR;
+            expr_t.type = EXPR_TOKEN_FN_CHR;
             break;
         default:
-            expr_t->type = EXPR_UNKNOWN;
+            expr_t.type = EXPR_UNKNOWN;
             break;
     }
 
@@ -171,75 +143,29 @@ ExprToken* load_expr_token(Lexer* lexer, Token* last_token) {
 
 void expr_token_free(ExprToken* t) {
     if(t != NULL) {
-        if((t->type == EXPR_TOKEN_IDENTIFIER ||
-            t->type == EXPR_TOKEN_INTEGER_LITERAL ||
-            t->type == EXPR_TOKEN_DOUBLE_LITERAL ||
-            t->type == EXPR_TOKEN_STRING_LITERAL
-           ) && t->data.s != NULL) {
-            memory_free(t->data.s);
-        }
+        // string data are interned
         memory_free(t);
     }
 }
 
 
-int expr_llist_type_cmp(LListBaseItem* a, LListBaseItem* b) {
-    ASSERT(a != NULL && b != NULL);
-    if(((ExprToken*) a)->type == ((ExprToken*) b)->type) {
-        return 0;
-    } else {
-        return -1;
-    }
-}
-
-void expr_llist_free(LListBaseItem* item) {
-    ASSERT(item != NULL);
-    ExprToken* t = (ExprToken*) item;
-    if(t != NULL) {
-        if((t->type == EXPR_TOKEN_IDENTIFIER ||
-            t->type == EXPR_TOKEN_INTEGER_LITERAL ||
-            t->type == EXPR_TOKEN_DOUBLE_LITERAL ||
-            t->type == EXPR_TOKEN_STRING_LITERAL
-           ) && t->data.s != NULL) {
-            memory_free(t->data.s);
-        }
-    }
-}
-
-ExprToken* create_expr_token(ExprTokenType type) {
-    ExprToken* t = expr_token_init();
-    t->type = type;
+ExprToken create_expr_token(ExprTokenType type) {
+    ExprToken t;
+    t.type = type;
+    t.data.s = NULL;
+    t.is_constant = false;
+    t.is_variable = false;
+    t.instruction = NULL;
+    t.data_type = DATA_TYPE_NONE;
     return t;
 }
 
-ExprToken* create_expression(ExprIdx index) {
-    ExprToken* t = memory_alloc(sizeof(ExprToken));
-    t->type = EXPR_EXPRESSION;
-    t->data.idx = index;
-    t->is_constant = false;
-    t->is_variable = false;
-    t->instruction = NULL;
-    t->data_type = DATA_TYPE_NONE;
+ExprToken create_expression(ExprIdx index) {
+    ExprToken t = create_expr_token(EXPR_EXPRESSION);
+    t.data.idx = index;
     return t;
 }
 
-ExprToken* expr_last_terminal(LList* expr_token_buffer) {
-    LListBaseItem* it = expr_token_buffer->tail;
-    while(!(((ExprToken*) it)->type & EXPR_TERMINALS_MASK)) {
-        it = it->previous;
-    }
-    return (ExprToken*) it;
-}
-
-void expr_llist_append_after_last_terminal(LList* expr_token_buffer, ExprToken* token) {
-    LListBaseItem* it = expr_token_buffer->tail;
-    while(!(((ExprToken*) it)->type & EXPR_TERMINALS_MASK)) {
-        it = it->previous;
-        ASSERT(it != NULL);
-    }
-    llist_insert_after(expr_token_buffer, it, (LListBaseItem*) token);
-}
-
 void expr_token_update_unary(ExprToken* minus, const ExprToken* previous) {
     // unary + is not in project doc
     ASSERT(minus->type == EXPR_TOKEN_MINUS);
@@ -257,45 +183,85 @@ void expr_token_update_unary(ExprToken* minus, const ExprToken* previous) {
     }
 }
 
-void expr_replace(LList* expr_token_buffer, LListBaseItem* expr_token_buffer_left_sharp, ExprToken* single_expression) {
-    LListBaseItem* i = expr_token_buffer_left_sharp;
-    while((i = llist_remove_item(expr_token_buffer, i)) != NULL);
-    llist_append_item(expr_token_buffer, (LListBaseItem*) single_expression);
+ExprToken* expr_token_init() {
+    ExprToken* et = memory_alloc(sizeof(ExprToken));
+    NULL_POINTER_CHECK(et, NULL);
+    *et = create_expr_token(EXPR_UNKNOWN);
+    return et;
 }
 
-ExprToken* get_next_expr(LListBaseItem** expr_token_buffer_item) {
-    return ((ExprToken*) (get_next_expr_item(expr_token_buffer_item)));
+void expr_token_stack_init(ExprTokenStack* stack) {
+    NULL_POINTER_CHECK(stack,);
+    stack->items = stack->inline_items;
+    stack->count = 0;
+    stack->capacity = EXPR_TOKEN_STACK_INLINE_CAPACITY;
 }
 
-LListBaseItem* get_next_expr_item(LListBaseItem** expr_token_buffer_item) {
-    while(((ExprToken*) ((*expr_token_buffer_item)))->type != EXPR_EXPRESSION) {
-        (*expr_token_buffer_item) = (*expr_token_buffer_item)->next;
-        ASSERT((*expr_token_buffer_item) != NULL);
-    }
-    return (*expr_token_buffer_item);
+void expr_token_stack_free(ExprTokenStack* stack) {
+    NULL_POINTER_CHECK(stack,);
+    if(stack->items != stack->inline_items)
+        memory_free(stack->items);
+    expr_token_stack_init(stack);
 }
 
-ExprToken* expr_token_init() {
-    ExprToken* et = memory_alloc(sizeof(ExprToken));
-    et->base.next = NULL;
-    et->base.previous = NULL;
+static void expr_token_stack_reserve(ExprTokenStack* stack, size_t count) {
+    if(count <= stack->capacity)
+        return;
 
-    return et;
+    const size_t capacity = stack->capacity * 2;
+    ExprToken* items = memory_alloc(sizeof(ExprToken) * capacity);
+    NULL_POINTER_CHECK(items,);
+    memcpy(items, stack->items, sizeof(ExprToken) * stack->count);
+    if(stack->items != stack->inline_items)
+        memory_free(stack->items);
+    stack->items = items;
+    stack->capacity = capacity;
+}
+
+void expr_token_stack_push(ExprTokenStack* stack, ExprToken token) {
+    NULL_POINTER_CHECK(stack,);
+    expr_token_stack_reserve(stack, stack->count + 1);
+    stack->items[stack->count++] = token;
+}
+
+ExprToken* expr_token_stack_top(ExprTokenStack* stack) {
+    NULL_POINTER_CHECK(stack, NULL);
+    ASSERT(stack->count > 0);
+    return &stack->items[stack->count - 1];
+}
+
+size_t expr_token_stack_last_terminal(ExprTokenStack* stack) {
+    size_t i = stack->count - 1;
+    while(!_expr_internal_is_terminal(stack->items[i].type)) {
+        ASSERT(i > 0);
+        i--;
+    }
+    return i;
+}
+
+void expr_token_stack_shift(ExprTokenStack* stack) {
+    NULL_POINTER_CHECK(stack,);
+    const size_t position = expr_token_stack_last_terminal(stack) + 1;
+    expr_token_stack_reserve(stack, stack->count + 1);
+    memmove(
+            &stack->items[position + 1],
+            &stack->items[position],
+            sizeof(ExprToken) * (stack->count - position)
+    );
+    stack->items[position] = create_expr_token(EXPR_LEFT_SHARP);
+    stack->count++;
 }
 
-ExprToken* get_n_expr(LList* expression_list, size_t n) {
-    NULL_POINTER_CHECK(expression_list, NULL);
-    return ((ExprToken*) llist_get_n_from_end(expression_list, n));
+size_t expr_token_stack_handle(ExprTokenStack* stack) {
+    size_t i = stack->count;
+    while(i > 0 && stack->items[i - 1].type != EXPR_LEFT_SHARP)
+        i--;
+    return i;
 }
 
-ExprToken* expr_token_copy(ExprToken* t) {
-    NULL_POINTER_CHECK(t, NULL);
-    ExprToken* new = create_expr_token(t->type);
-    new->is_constant = t->is_constant;
-    new->is_variable = t->is_variable;
-    new->instruction = t->instruction;
-    new->data_type = t->data_type;
-    new->base.next = new->base.previous = NULL;
-    new->data.s = NULL;
-    return new;
+void expr_token_stack_replace(ExprTokenStack* stack, size_t handle_begin, ExprToken single_expression) {
+    NULL_POINTER_CHECK(stack,);
+    ASSERT(handle_begin > 0 && stack->items[handle_begin - 1].type == EXPR_LEFT_SHARP);
+    stack->items[handle_begin - 1] = single_expression;
+    stack->count = handle_begin;
 }
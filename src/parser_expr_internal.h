@@ -2,13 +2,9 @@
 #define _PARSER_EXPR_INTERNAL_H
 
 #include "lexer.h"
-#include "llist.h"
 #include "data_type.h"
 #include "code_instruction.h"
 
-extern const int prec_table_size;
-extern const char* prec_table;
-
 typedef enum {
     // Terminals
             EXPR_TOKEN_UNARY_MINUS = 1,
@@ -60,17 +56,22 @@ typedef enum {
     EXPR_UNKNOWN = 133  // unknown token or undefined precedence
 } ExprTokenType;
 
+// Count of terminals with own row and column in precedence table, literals and functions share identifier's ones
+#define PREC_TABLE_SIZE EXPR_TOKEN_$
+
+extern const ExprTokenType prec_table[PREC_TABLE_SIZE][PREC_TABLE_SIZE];
+
 typedef unsigned ExprIdx;
 
 typedef union {
     ExprIdx idx;
-    char* s;
+    const char* s; // interned data of token
+    int i;
+    double d;
     bool b;
 } ExprData;
 
 typedef struct expr_token_t {
-    LListBaseItem base;
-
     ExprTokenType type;
     ExprData data;
 
@@ -80,39 +81,71 @@ typedef struct expr_token_t {
     CodeInstruction* instruction;
 } ExprToken;
 
+#define EXPR_TOKEN_STACK_INLINE_CAPACITY 32
+
+/**
+ * @brief Work stack of precedence parser. Tokens are stored by value in contiguous array, which is placed inline
+ * for common expressions and moved to heap only when it overflows.
+ */
+typedef struct expr_token_stack_t {
+    ExprToken* items;
+    size_t count;
+    size_t capacity;
+    ExprToken inline_items[EXPR_TOKEN_STACK_INLINE_CAPACITY];
+} ExprTokenStack;
+
 ExprToken* expr_token_init();
 
 void expr_token_free(ExprToken* t);
 
-ExprToken* expr_token_copy(ExprToken* t);
-
-int expr_llist_type_cmp(LListBaseItem* a, LListBaseItem* b);
+void expr_token_stack_init(ExprTokenStack* stack);
 
-void expr_llist_free(LListBaseItem* item);
+void expr_token_stack_free(ExprTokenStack* stack);
 
-ExprToken* get_n_expr(LList* expression_list, size_t n);
+void expr_token_stack_push(ExprTokenStack* stack, ExprToken token);
 
-ExprToken* expr_get_precedence(ExprToken* a, ExprToken* b);
+ExprToken* expr_token_stack_top(ExprTokenStack* stack);
 
-bool is_expr_parsing_complete(LList* expr_token_buffer, ExprToken* token);
+/**
+ * @brief Get index of topmost terminal on stack, stack has always $ at bottom.
+ */
+size_t expr_token_stack_last_terminal(ExprTokenStack* stack);
 
-ExprToken* load_expr_token(Lexer* lexer, Token* last_token);
+/**
+ * @brief Insert left sharp (shift mark) directly after topmost terminal.
+ */
+void expr_token_stack_shift(ExprTokenStack* stack);
 
-ExprToken* create_expr_token(ExprTokenType type);
+/**
+ * @brief Get index of first item of handle, so tokens after the last left sharp.
+ */
+size_t expr_token_stack_handle(ExprTokenStack* stack);
 
-ExprToken* create_expression(ExprIdx index);
+/**
+ * @brief Replace handle of stack and its left sharp by single expression.
+ *
+ * @param stack stack to reduce
+ * @param handle_begin index of first item of handle
+ * @param single_expression result of reduction
+ */
+void expr_token_stack_replace(ExprTokenStack* stack, size_t handle_begin, ExprToken single_expression);
 
-ExprToken* expr_last_terminal(LList* expr_token_buffer);
+/**
+ * @brief Get precedence relation between terminal on stack and input terminal.
+ *
+ * @return ExprTokenType one of EXPR_LEFT_SHARP, EXPR_RIGHT_SHARP, EXPR_SAME, EXPR_TOKEN_CHANGE or EXPR_UNKNOWN
+ */
+ExprTokenType expr_get_precedence(ExprTokenType a, ExprTokenType b);
 
-void expr_llist_append_after_last_terminal(LList* expr_token_buffer, ExprToken* token);
+bool is_expr_parsing_complete(ExprTokenStack* stack, ExprTokenType token_type);
 
-void expr_token_update_unary(ExprToken* minus, const ExprToken* previous);
+ExprToken load_expr_token(Lexer* lexer, Token* last_token);
 
-ExprToken* get_next_expr(LListBaseItem** expr_token_buffer_item);
+ExprToken create_expr_token(ExprTokenType type);
 
-LListBaseItem* get_next_expr_item(LListBaseItem** expr_token_buffer_item);
+ExprToken create_expression(ExprIdx index);
 
-void expr_replace(LList* expr_token_buffer, LListBaseItem* expr_token_buffer_left_sharp, ExprToken* single_expression);
+void expr_token_update_unary(ExprToken* minus, const ExprToken* previous);
 
 
 #endif //_PARSER_EXPR_INTERNAL_H
@@ -1,27 +1,38 @@
 #include "parser_expr_internal.h"
 
-const int prec_table_size = 20;
+// Shortcuts of cells, only for readability of table below
+#define L EXPR_LEFT_SHARP
+#define R EXPR_RIGHT_SHARP
+#define S EXPR_SAME
+#define C EXPR_TOKEN_CHANGE
+#define X EXPR_UNKNOWN
 
-// Copy-pasted from "/doc/prec_table.csv"
-const char* prec_table = "\
-<;>;>;>;>;>;>;>;>;>;>;>;x;>;>;<;>;>;<;>\n\
-<;>;>;>;>;>;>;>;>;>;>;>;<;>;>;<;>;>;<;>\n\
-<;>;>;>;>;>;>;>;>;>;>;>;<;>;>;<;>;>;<;>\n\
-<;<;<;>;>;>;>;>;>;>;>;>;<;>;>;<;>;>;<;>\n\
-<;<;<;<;>;>;>;>;>;>;>;>;<;>;>;<;>;>;<;>\n\
-<;<;<;<;>;>;>;>;>;>;>;>;<;>;>;<;>;>;<;>\n\
-<;<;<;<;<;<;x;x;x;x;x;x;<;>;>;<;>;>;<;>\n\
-<;<;<;<;<;<;x;x;x;x;x;x;<;>;>;<;>;>;<;>\n\
-<;<;<;<;<;<;x;x;x;x;x;x;<;>;>;<;>;>;<;>\n\
-<;<;<;<;<;<;x;x;x;x;x;x;<;>;>;<;>;>;<;>\n\
-<;<;<;<;<;<;x;x;x;x;x;x;<;>;>;<;>;>;<;>\n\
-<;<;<;<;<;<;x;x;x;x;x;x;<;>;>;<;>;>;<;>\n\
-x;>;>;>;>;>;>;>;>;>;>;>;<;>;>;<;>;>;<;>\n\
-<;<;<;<;<;<;<;<;<;<;<;<;<;>;>;<;>;>;<;>\n\
-<;<;<;<;<;<;<;<;<;<;<;<;<;<;>;<;>;>;<;>\n\
-<;<;<;<;<;<;<;<;<;<;<;<;<;<;<;<;=;=;<;x\n\
->;>;>;>;>;>;>;>;>;>;>;>;>;>;>;x;>;>;x;>\n\
-<;<;<;<;<;<;<;<;<;<;<;<;<;<;<;<;=;=;<;x\n\
-x;>;>;>;>;>;>;>;>;>;>;>;x;>;>;=;>;>;x;>\n\
-<;<;<;<;<;<;<;<;<;<;<;<;<;<;<;<;x;x;<;x\n\
-";
+// Transcribed from "/doc/prec_table.csv", rows are indexed by top terminal and columns by input terminal
+const ExprTokenType prec_table[PREC_TABLE_SIZE][PREC_TABLE_SIZE] = {
+        {L, R, R, R, R, R, R, R, R, R, R, R, X, R, R, L, R, R, L, R}, // un -
+        {L, R, R, R, R, R, R, R, R, R, R, R, L, R, R, L, R, R, L, R}, // *
+        {L, R, R, R, R, R, R, R, R, R, R, R, L, R, R, L, R, R, L, R}, // /
+        {L, L, L, R, R, R, R, R, R, R, R, R, L, R, R, L, R, R, L, R}, // \ (integer division)
+        {L, L, L, L, R, R, R, R, R, R, R, R, L, R, R, L, R, R, L, R}, // +
+        {L, L, L, L, R, R, R, R, R, R, R, R, L, R, R, L, R, R, L, R}, // -
+        {L, L, L, L, L, L, X, X, X, X, X, X, L, R, R, L, R, R, L, R}, // =
+        {L, L, L, L, L, L, X, X, X, X, X, X, L, R, R, L, R, R, L, R}, // <>
+        {L, L, L, L, L, L, X, X, X, X, X, X, L, R, R, L, R, R, L, R}, // <
+        {L, L, L, L, L, L, X, X, X, X, X, X, L, R, R, L, R, R, L, R}, // <=
+        {L, L, L, L, L, L, X, X, X, X, X, X, L, R, R, L, R, R, L, R}, // >=
+        {L, L, L, L, L, L, X, X, X, X, X, X, L, R, R, L, R, R, L, R}, // >
+        {X, R, R, R, R, R, R, R, R, R, R, R, L, R, R, L, R, R, L, R}, // NOT
+        {L, L, L, L, L, L, L, L, L, L, L, L, L, R, R, L, R, R, L, R}, // AND
+        {L, L, L, L, L, L, L, L, L, L, L, L, L, L, R, L, R, R, L, R}, // OR
+        {L, L, L, L, L, L, L, L, L, L, L, L, L, L, L, L, S, S, L, X}, // (
+        {R, R, R, R, R, R, R, R, R, R, R, R, R, R, R, X, R, R, X, R}, // )
+        {L, L, L, L, L, L, L, L, L, L, L, L, L, L, L, L, S, S, L, X}, // ,
+        {X, R, R, R, R, R, R, R, R, R, R, R, X, R, R, S, R, R, X, R}, // i
+        {L, L, L, L, L, L, L, L, L, L, L, L, L, L, L, L, X, X, L, X}, // $
+};
+
+#undef L
+#undef R
+#undef S
+#undef C
+#undef X
@@ -28,35 +28,27 @@ const expression_rule_function expr_rule_table[EXPR_RULE_TABLE_SIZE] = {
         expression_rule_lesser
 };
 
-bool expression_rule_fake(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_fake(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     // ***FAKE Reduction***
     UNUSED(parser);
 
-    ExprToken* tmp;
-    ExprTokenType type;
     DataType expr_data_type = DATA_TYPE_NONE;
 
-    do {
-        tmp = (ExprToken*) llist_pop_back(expr_token_buffer);
-        if(tmp == NULL) {
-            return false;
-        }
-        type = tmp->type;
-        if(tmp->type == EXPR_EXPRESSION)
-            expr_data_type = tmp->data_type;
-        expr_token_free(tmp);
-    } while(type != EXPR_LEFT_SHARP);
+    for(size_t i = handle_begin; i < handle_end; i++) {
+        if(stack->items[i].type == EXPR_EXPRESSION)
+            expr_data_type = stack->items[i].data_type;
+    }
 
-    ExprToken* new_token = create_expression((*expression_idx)++);
-    new_token->data_type = expr_data_type;
+    ExprToken new_token = create_expression((*expression_idx)++);
+    new_token.data_type = expr_data_type;
 
-    llist_append_item(expr_token_buffer, (LListBaseItem*) new_token);
+    EXPR_RULE_REPLACE(new_token);
 
     return true;
 }
 
 // --------------- ACTUAL RULES ---------------
-bool expression_rule_id(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_id(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
     * RULE
     * E -> i
@@ -64,49 +56,46 @@ bool expression_rule_id(Parser* parser, LList* expr_token_buffer, ExprIdx* expre
 
     // NOTE: we are processing rule backwards!
     EXPR_RULE_CHECK_START();
-    if(it->previous != NULL) { it = it->previous; } else { return false; }
-    if(it != NULL) {
-        ExprTokenType tt = ((ExprToken*) it)->type;
-        if(tt != EXPR_TOKEN_IDENTIFIER &&
-           tt != EXPR_TOKEN_BOOLEAN_LITERAL &&
-           tt != EXPR_TOKEN_INTEGER_LITERAL &&
-           tt != EXPR_TOKEN_DOUBLE_LITERAL &&
-           tt != EXPR_TOKEN_STRING_LITERAL) {
-            return false;
-        }
+    if(it > handle_begin) { it--; } else { return false; }
+    ExprTokenType tt = stack->items[it].type;
+    if(tt != EXPR_TOKEN_IDENTIFIER &&
+       tt != EXPR_TOKEN_BOOLEAN_LITERAL &&
+       tt != EXPR_TOKEN_INTEGER_LITERAL &&
+       tt != EXPR_TOKEN_DOUBLE_LITERAL &&
+       tt != EXPR_TOKEN_STRING_LITERAL) {
+        return false;
     }
     EXPR_RULE_CHECK_FINISH();
 
     // NOTE: now we are processing rule regular way - from the left to the right
-    ExprToken* i = (ExprToken*) tmp->next;
+    ExprToken* i = EXPR_RULE_HANDLE_ITEM(0);
 
-    ExprToken* e = create_expression((*expression_idx)++);
+    ExprToken e = create_expression((*expression_idx)++);
 
     CodeConstructor* constructor = parser->code_constructor;
     if(i->type == EXPR_TOKEN_INTEGER_LITERAL) {
-        e->data_type = DATA_TYPE_INTEGER;
-        e->is_constant = true;
-        e->instruction = GENERATE_CODE(I_PUSH_STACK,
-                                       code_instruction_operand_init_integer(strtol(i->data.s, NULL, 10)));
+        e.data_type = DATA_TYPE_INTEGER;
+        e.is_constant = true;
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, code_instruction_operand_init_integer(i->data.i));
 
     } else if(i->type == EXPR_TOKEN_DOUBLE_LITERAL) {
-        e->data_type = DATA_TYPE_DOUBLE;
-        e->is_constant = true;
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, code_instruction_operand_init_double(strtod(i->data.s, NULL)));
+        e.data_type = DATA_TYPE_DOUBLE;
+        e.is_constant = true;
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, code_instruction_operand_init_double(i->data.d));
 
     } else if(i->type == EXPR_TOKEN_STRING_LITERAL) {
-        e->data_type = DATA_TYPE_STRING;
-        e->is_constant = true;
+        e.data_type = DATA_TYPE_STRING;
+        e.is_constant = true;
         String* string = string_init();
         string_append_s(string, i->data.s);
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, code_instruction_operand_init_string(string));
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, code_instruction_operand_init_string(string));
         string_free(&string);
 
     } else if(i->type == EXPR_TOKEN_BOOLEAN_LITERAL) {
-        e->data_type = DATA_TYPE_BOOLEAN;
-        e->is_constant = true;
+        e.data_type = DATA_TYPE_BOOLEAN;
+        e.is_constant = true;
 
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, code_instruction_operand_init_boolean(i->data.b));
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, code_instruction_operand_init_boolean(i->data.b));
 
     } else if(i->type == EXPR_TOKEN_IDENTIFIER) {
         SymbolVariable* variable = symbol_register_find_variable_recursive(
@@ -121,15 +110,15 @@ bool expression_rule_id(Parser* parser, LList* expr_token_buffer, ExprIdx* expre
                         return false;
                     }
 
-                    e->data_type = variable->data_type;
+                    e.data_type = variable->data_type;
                 }
         );
 
-        e->is_variable = true;
-        e->is_constant = false;
+        e.is_variable = true;
+        e.is_constant = false;
         CODE_GENERATION(
                 {
-                    e->instruction = GENERATE_CODE(
+                    e.instruction = GENERATE_CODE(
                             I_PUSH_STACK,
                             code_instruction_operand_init_variable(variable)
                     );
@@ -142,7 +131,7 @@ bool expression_rule_id(Parser* parser, LList* expr_token_buffer, ExprIdx* expre
     return true;
 }
 
-bool expression_rule_brackets(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_brackets(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     UNUSED(parser);
 
     EXPR_RULE_CHECK_START();
@@ -151,19 +140,19 @@ bool expression_rule_brackets(Parser* parser, LList* expr_token_buffer, ExprIdx*
     EXPR_RULE_CHECK_TYPE(EXPR_TOKEN_LEFT_BRACKET);
     EXPR_RULE_CHECK_FINISH();
 
-    ExprToken* e = create_expression((*expression_idx)++);
+    ExprToken e = create_expression((*expression_idx)++);
     // 2 because 0 is right sharp and 1 is bracket
-    ExprToken* content = get_n_expr(expr_token_buffer, 2);
+    ExprToken* content = EXPR_RULE_NTH_FROM_END(2);
 
-    e->is_constant = content->is_constant;
-    e->instruction = content->instruction;
-    e->data_type = content->data_type;
+    e.is_constant = content->is_constant;
+    e.instruction = content->instruction;
+    e.data_type = content->data_type;
     EXPR_RULE_REPLACE(e);
 
     return true;
 }
 
-bool expression_rule_fn(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_fn(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
     * RULE
     * E -> id ( )
@@ -181,9 +170,9 @@ bool expression_rule_fn(Parser* parser, LList* expr_token_buffer, ExprIdx* expre
     ExprTokenType tt;
     size_t arg_count = 0;
 
-    if(it->previous != NULL) {
-        it = it->previous;
-        tt = ((ExprToken*) it)->type;
+    if(it > handle_begin) {
+        it--;
+        tt = stack->items[it].type;
     } else {
         return false;
     }
@@ -197,9 +186,9 @@ bool expression_rule_fn(Parser* parser, LList* expr_token_buffer, ExprIdx* expre
 
     // arg_count in while condition is only for entering infinite while, if arg_count > 0
     while(arg_count) {
-        if(it->previous != NULL) {
-            it = it->previous;
-            tt = ((ExprToken*) it)->type;
+        if(it > handle_begin) {
+            it--;
+            tt = stack->items[it].type;
         } else {
             return false;
         }
@@ -210,9 +199,9 @@ bool expression_rule_fn(Parser* parser, LList* expr_token_buffer, ExprIdx* expre
             return false;
         }
 
-        if(it->previous != NULL) {
-            it = it->previous;
-            tt = ((ExprToken*) it)->type;
+        if(it > handle_begin) {
+            it--;
+            tt = stack->items[it].type;
         } else {
             return false;
         }
@@ -228,7 +217,7 @@ bool expression_rule_fn(Parser* parser, LList* expr_token_buffer, ExprIdx* expre
 
     // NOTE: now we are processing rule regular way - from the left to the right
 
-    char* function_name = ((ExprToken*) tmp->next)->data.s;
+    const char* function_name = EXPR_RULE_HANDLE_ITEM(0)->data.s;
     SymbolFunction* function = symbol_table_function_get(
             parser->parser_semantic->register_->functions,
             function_name
@@ -248,7 +237,7 @@ bool expression_rule_fn(Parser* parser, LList* expr_token_buffer, ExprIdx* expre
             {
                 param = function->param_tail;
                 for(size_t i = 1; i <= arg_count; i++) {
-                    ExprToken* token = get_n_expr(expr_token_buffer, 2 * i);
+                    ExprToken* token = EXPR_RULE_NTH_FROM_END(2 * i);
 
                     if(param == NULL) {
                         parser->parser_semantic->error_report.error_code = ERROR_SEMANTIC_TYPE;
@@ -342,16 +331,16 @@ bool expression_rule_fn(Parser* parser, LList* expr_token_buffer, ExprIdx* expre
             }
     );
 
-    ExprToken* e = create_expression((*expression_idx)++);
+    ExprToken e = create_expression((*expression_idx)++);
     if(function != NULL) {
-        e->data_type = function->return_data_type;
+        e.data_type = function->return_data_type;
     }
     EXPR_RULE_REPLACE(e);
 
     return true;
 }
 
-bool expression_rule_add(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_add(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
     * RULE
     * E -> E + E
@@ -370,7 +359,7 @@ bool expression_rule_add(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
             parser->optimizer,
             EXPR_LOWER_OPERAND,
             EXPR_HIGHER_OPERAND,
-            e,
+            &e,
             operation_signature
     );
 
@@ -381,7 +370,7 @@ bool expression_rule_add(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
     }
 
     if(evaluated_operand != NULL) {
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
     } else {
         if(EXPR_LOWER_OPERAND->data_type == DATA_TYPE_STRING && EXPR_HIGHER_OPERAND->data_type == DATA_TYPE_STRING) {
             GENERATE_CODE(I_POP_STACK, code_instruction_operand_init_variable(parser->parser_semantic->temp_variable1));
@@ -406,7 +395,7 @@ bool expression_rule_add(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
     return true;
 }
 
-bool expression_rule_sub(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_sub(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
     * RULE
     * E -> E - E
@@ -426,7 +415,7 @@ bool expression_rule_sub(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
             parser->optimizer,
             EXPR_LOWER_OPERAND,
             EXPR_HIGHER_OPERAND,
-            e,
+            &e,
             operation_signature
     );
 
@@ -436,7 +425,7 @@ bool expression_rule_sub(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
     }
 
     if(evaluated_operand != NULL) {
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
     } else {
         GENERATE_IMPLICIT_CONVERSIONS_FOR_BINARY_OPERATION_SIGNATURE();
         GENERATE_CODE(I_SUB_STACK);
@@ -446,7 +435,7 @@ bool expression_rule_sub(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
     return true;
 }
 
-bool expression_rule_mul(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_mul(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
     * RULE
     * E -> E * E
@@ -467,7 +456,7 @@ bool expression_rule_mul(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
             parser->optimizer,
             EXPR_LOWER_OPERAND,
             EXPR_HIGHER_OPERAND,
-            e,
+            &e,
             operation_signature
     );
 
@@ -477,7 +466,7 @@ bool expression_rule_mul(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
     }
 
     if(evaluated_operand != NULL) {
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
     } else {
         GENERATE_IMPLICIT_CONVERSIONS_FOR_BINARY_OPERATION_SIGNATURE();
         GENERATE_CODE(I_MUL_STACK);
@@ -487,7 +476,7 @@ bool expression_rule_mul(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
     return true;
 }
 
-bool expression_rule_div(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_div(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
     * RULE
     * E -> E / E
@@ -507,7 +496,7 @@ bool expression_rule_div(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
             parser->optimizer,
             EXPR_LOWER_OPERAND,
             EXPR_HIGHER_OPERAND,
-            e,
+            &e,
             operation_signature
     );
 
@@ -517,7 +506,7 @@ bool expression_rule_div(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
     }
 
     if(evaluated_operand != NULL) {
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
     } else {
         GENERATE_IMPLICIT_CONVERSIONS_FOR_BINARY_OPERATION_SIGNATURE();
         GENERATE_CODE(I_DIV_STACK);
@@ -527,7 +516,7 @@ bool expression_rule_div(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
     return true;
 }
 
-bool expression_rule_div_int(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_div_int(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
     * RULE
     * E -> E \ E
@@ -547,7 +536,7 @@ bool expression_rule_div_int(Parser* parser, LList* expr_token_buffer, ExprIdx*
             parser->optimizer,
             EXPR_LOWER_OPERAND,
             EXPR_HIGHER_OPERAND,
-            e,
+            &e,
             operation_signature
     );
 
@@ -557,7 +546,7 @@ bool expression_rule_div_int(Parser* parser, LList* expr_token_buffer, ExprIdx*
     }
 
     if(evaluated_operand != NULL) {
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
     } else {
         if(operation_signature != NULL) {
             GENERATE_STACK_DATA_TYPE_CONVERSION_CODE(
@@ -581,7 +570,7 @@ bool expression_rule_div_int(Parser* parser, LList* expr_token_buffer, ExprIdx*
     return true;
 }
 
-bool expression_rule_unary_minus(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_unary_minus(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
     * RULE
     * E -> - E
@@ -593,7 +582,7 @@ bool expression_rule_unary_minus(Parser* parser, LList* expr_token_buffer, ExprI
     EXPR_RULE_CHECK_FINISH();
     EXPR_CHECK_UNARY_OPERATION_IMPLICIT_CONVERSION(OPERATION_UNARY_MINUS);
 
-    ExprToken* e = create_expression((*expression_idx)++);
+    ExprToken e = create_expression((*expression_idx)++);
 
     CodeConstructor* constructor = parser->code_constructor;
     OperationSignature* signature = parser_semantic_get_operation_signature(
@@ -608,12 +597,12 @@ bool expression_rule_unary_minus(Parser* parser, LList* expr_token_buffer, ExprI
             parser->optimizer,
             EXPR_HIGHER_OPERAND,
             NULL,
-            e,
+            &e,
             signature
     );
 
     if(operand != NULL) {
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, operand);
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, operand);
         code_generator_remove_instruction(constructor->generator, EXPR_HIGHER_OPERAND->instruction);
     } else {
         CodeInstructionOperand* inverse_operand = NULL;
@@ -640,13 +629,13 @@ bool expression_rule_unary_minus(Parser* parser, LList* expr_token_buffer, ExprI
                     GENERATE_CODE(I_MUL_STACK);
                 }
         );
-        e->data_type = EXPR_HIGHER_OPERAND->data_type;
+        e.data_type = EXPR_HIGHER_OPERAND->data_type;
     }
     EXPR_RULE_REPLACE(e);
     return true;
 }
 
-bool expression_rule_equal(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_equal(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
      * RULE
      * E -> E = E
@@ -666,7 +655,7 @@ bool expression_rule_equal(Parser* parser, LList* expr_token_buffer, ExprIdx* ex
             parser->optimizer,
             EXPR_LOWER_OPERAND,
             EXPR_HIGHER_OPERAND,
-            e,
+            &e,
             operation_signature
     );
 
@@ -676,7 +665,7 @@ bool expression_rule_equal(Parser* parser, LList* expr_token_buffer, ExprIdx* ex
     }
 
     if(evaluated_operand != NULL) {
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
     } else {
         GENERATE_IMPLICIT_CONVERSIONS_FOR_BINARY_OPERATION_SIGNATURE();
         GENERATE_CODE(I_EQUAL_STACK);
@@ -687,7 +676,7 @@ bool expression_rule_equal(Parser* parser, LList* expr_token_buffer, ExprIdx* ex
     return true;
 }
 
-bool expression_rule_not_equal(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_not_equal(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
      * RULE
      * E -> E <> E
@@ -707,7 +696,7 @@ bool expression_rule_not_equal(Parser* parser, LList* expr_token_buffer, ExprIdx
             parser->optimizer,
             EXPR_LOWER_OPERAND,
             EXPR_HIGHER_OPERAND,
-            e,
+            &e,
             operation_signature
     );
 
@@ -717,7 +706,7 @@ bool expression_rule_not_equal(Parser* parser, LList* expr_token_buffer, ExprIdx
     }
 
     if(evaluated_operand != NULL) {
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
     } else {
         GENERATE_IMPLICIT_CONVERSIONS_FOR_BINARY_OPERATION_SIGNATURE();
         GENERATE_CODE(I_EQUAL_STACK);
@@ -729,7 +718,7 @@ bool expression_rule_not_equal(Parser* parser, LList* expr_token_buffer, ExprIdx
     return true;
 }
 
-bool expression_rule_greater(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_greater(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
      * RULE
      * E -> E > E
@@ -749,7 +738,7 @@ bool expression_rule_greater(Parser* parser, LList* expr_token_buffer, ExprIdx*
             parser->optimizer,
             EXPR_LOWER_OPERAND,
             EXPR_HIGHER_OPERAND,
-            e,
+            &e,
             operation_signature
     );
 
@@ -759,7 +748,7 @@ bool expression_rule_greater(Parser* parser, LList* expr_token_buffer, ExprIdx*
     }
 
     if(evaluated_operand != NULL) {
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
     } else {
         GENERATE_IMPLICIT_CONVERSIONS_FOR_BINARY_OPERATION_SIGNATURE();
         GENERATE_CODE(I_GREATER_THEN_STACK);
@@ -770,7 +759,7 @@ bool expression_rule_greater(Parser* parser, LList* expr_token_buffer, ExprIdx*
     return true;
 }
 
-bool expression_rule_greater_or_equal(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_greater_or_equal(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
      * RULE
      * E -> E >= E
@@ -790,7 +779,7 @@ bool expression_rule_greater_or_equal(Parser* parser, LList* expr_token_buffer,
             parser->optimizer,
             EXPR_LOWER_OPERAND,
             EXPR_HIGHER_OPERAND,
-            e,
+            &e,
             operation_signature
     );
 
@@ -800,7 +789,7 @@ bool expression_rule_greater_or_equal(Parser* parser, LList* expr_token_buffer,
     }
 
     if(evaluated_operand != NULL) {
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
     } else {
         GENERATE_IMPLICIT_CONVERSIONS_FOR_BINARY_OPERATION_SIGNATURE();
 
@@ -813,7 +802,7 @@ bool expression_rule_greater_or_equal(Parser* parser, LList* expr_token_buffer,
     return true;
 }
 
-bool expression_rule_lesser(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_lesser(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
      * RULE
      * E -> E < E
@@ -833,7 +822,7 @@ bool expression_rule_lesser(Parser* parser, LList* expr_token_buffer, ExprIdx* e
             parser->optimizer,
             EXPR_LOWER_OPERAND,
             EXPR_HIGHER_OPERAND,
-            e,
+            &e,
             operation_signature
     );
 
@@ -843,7 +832,7 @@ bool expression_rule_lesser(Parser* parser, LList* expr_token_buffer, ExprIdx* e
     }
 
     if(evaluated_operand != NULL) {
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
     } else {
         GENERATE_IMPLICIT_CONVERSIONS_FOR_BINARY_OPERATION_SIGNATURE();
 
@@ -855,7 +844,7 @@ bool expression_rule_lesser(Parser* parser, LList* expr_token_buffer, ExprIdx* e
     return true;
 }
 
-bool expression_rule_lesser_or_equal(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_lesser_or_equal(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
      * RULE
      * E -> E <= E
@@ -876,7 +865,7 @@ bool expression_rule_lesser_or_equal(Parser* parser, LList* expr_token_buffer, E
             parser->optimizer,
             EXPR_LOWER_OPERAND,
             EXPR_HIGHER_OPERAND,
-            e,
+            &e,
             operation_signature
     );
 
@@ -886,7 +875,7 @@ bool expression_rule_lesser_or_equal(Parser* parser, LList* expr_token_buffer, E
     }
 
     if(evaluated_operand != NULL) {
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
     } else {
         GENERATE_IMPLICIT_CONVERSIONS_FOR_BINARY_OPERATION_SIGNATURE();
 
@@ -899,7 +888,7 @@ bool expression_rule_lesser_or_equal(Parser* parser, LList* expr_token_buffer, E
     return true;
 }
 
-bool expression_rule_fn_length(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_fn_length(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
     * RULE
     * E -> length ( E )
@@ -917,12 +906,12 @@ bool expression_rule_fn_length(Parser* parser, LList* expr_token_buffer, ExprIdx
     EXPR_RULE_CHECK_FINISH();
 
     // Length(s As String) As Integer
-    ExprToken* source_expr = get_n_expr(expr_token_buffer, 2);
+    ExprToken* source_expr = EXPR_RULE_NTH_FROM_END(2);
     const DataType param_data_type = source_expr->data_type;
-    ExprToken* e = create_expression((*expression_idx)++);
+    ExprToken e = create_expression((*expression_idx)++);
     if(CEE_ENABLED && source_expr->is_constant) {
-        e->is_constant = true;
-        e->instruction = GENERATE_CODE(
+        e.is_constant = true;
+        e.instruction = GENERATE_CODE(
                 I_PUSH_STACK,
                 code_instruction_operand_init_integer(
                         string_length(source_expr->instruction->op0->data.constant.data.string
@@ -944,13 +933,13 @@ bool expression_rule_fn_length(Parser* parser, LList* expr_token_buffer, ExprIdx
                 }
         );
     }
-    e->data_type = DATA_TYPE_INTEGER;
+    e.data_type = DATA_TYPE_INTEGER;
     EXPR_RULE_REPLACE(e);
     return true;
 
 }
 
-bool expression_rule_fn_substr(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_fn_substr(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
     * RULE
     * E -> substr ( E, E, E )
@@ -971,10 +960,10 @@ bool expression_rule_fn_substr(Parser* parser, LList* expr_token_buffer, ExprIdx
     EXPR_RULE_CHECK_TYPE(EXPR_TOKEN_FN_SUBSTR);
     EXPR_RULE_CHECK_FINISH();
 
-    ExprToken* length_expr = get_n_expr(expr_token_buffer, 2);
-    ExprToken* index_expr = get_n_expr(expr_token_buffer, 4);
-    ExprToken* string_expr = get_n_expr(expr_token_buffer, 6);
-    ExprToken* e = create_expression((*expression_idx)++);
+    ExprToken* length_expr = EXPR_RULE_NTH_FROM_END(2);
+    ExprToken* index_expr = EXPR_RULE_NTH_FROM_END(4);
+    ExprToken* string_expr = EXPR_RULE_NTH_FROM_END(6);
+    ExprToken e = create_expression((*expression_idx)++);
 
     EXPR_CHECK_UNARY_OPERATION_IMPLICIT_CONVERSION_FROM_DATA_TYPE(
             OPERATION_IMPLICIT_CONVERSION,
@@ -1039,8 +1028,8 @@ bool expression_rule_fn_substr(Parser* parser, LList* expr_token_buffer, ExprIdx
             length--;
         }
 
-        e->is_constant = true;
-        e->instruction = GENERATE_CODE(
+        e.is_constant = true;
+        e.instruction = GENERATE_CODE(
                 I_PUSH_STACK,
                 code_instruction_operand_init_string(result)
         );
@@ -1061,13 +1050,13 @@ bool expression_rule_fn_substr(Parser* parser, LList* expr_token_buffer, ExprIdx
         );
     }
     // SubStr(s As String, i As Integer, n As Integer) As String
-    e->data_type = DATA_TYPE_STRING;
+    e.data_type = DATA_TYPE_STRING;
     EXPR_RULE_REPLACE(e);
     return true;
 
 }
 
-bool expression_rule_fn_asc(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_fn_asc(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
     * RULE
     * E -> asc ( E, E )
@@ -1086,8 +1075,8 @@ bool expression_rule_fn_asc(Parser* parser, LList* expr_token_buffer, ExprIdx* e
     EXPR_RULE_CHECK_TYPE(EXPR_TOKEN_FN_ASC);
     EXPR_RULE_CHECK_FINISH();
 
-    ExprToken* source_string_expr = get_n_expr(expr_token_buffer, 4);
-    ExprToken* index_expr = get_n_expr(expr_token_buffer, 2);
+    ExprToken* source_string_expr = EXPR_RULE_NTH_FROM_END(4);
+    ExprToken* index_expr = EXPR_RULE_NTH_FROM_END(2);
 
     // Asc(s As String, i As Integer) As Integer
     EXPR_CHECK_UNARY_OPERATION_IMPLICIT_CONVERSION_FROM_DATA_TYPE(
@@ -1102,7 +1091,7 @@ bool expression_rule_fn_asc(Parser* parser, LList* expr_token_buffer, ExprIdx* e
             DATA_TYPE_INTEGER
     );
 
-    ExprToken* e = create_expression((*expression_idx)++);
+    ExprToken e = create_expression((*expression_idx)++);
     if(CEE_ENABLED && source_string_expr->is_constant && index_expr->is_constant) {
         int index;
         switch(index_expr->instruction->op0->data.constant.data_type) {
@@ -1122,11 +1111,11 @@ bool expression_rule_fn_asc(Parser* parser, LList* expr_token_buffer, ExprIdx* e
         if(index > 0 && index < string_len + 1) {
             result = (int) ((unsigned char*) string)[index - 1];
         }
-        e->instruction = GENERATE_CODE(
+        e.instruction = GENERATE_CODE(
                 I_PUSH_STACK,
                 code_instruction_operand_init_integer(result)
         );
-        e->is_constant = true;
+        e.is_constant = true;
         code_generator_remove_instruction(constructor->generator, source_string_expr->instruction);
         code_generator_remove_instruction(constructor->generator, index_expr->instruction);
     } else {
@@ -1144,13 +1133,13 @@ bool expression_rule_fn_asc(Parser* parser, LList* expr_token_buffer, ExprIdx* e
         );
     }
 
-    e->data_type = DATA_TYPE_INTEGER;
+    e.data_type = DATA_TYPE_INTEGER;
     EXPR_RULE_REPLACE(e);
     return true;
 
 }
 
-bool expression_rule_fn_chr(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_fn_chr(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
     * RULE
     * E -> chr ( E )
@@ -1170,8 +1159,8 @@ bool expression_rule_fn_chr(Parser* parser, LList* expr_token_buffer, ExprIdx* e
     // NOTE: now we are processing rule regular way - from the left to the right
 
     // Chr(i As Integer) As String
-    ExprToken* source_expr = get_n_expr(expr_token_buffer, 2);
-    ExprToken* e = create_expression((*expression_idx)++);
+    ExprToken* source_expr = EXPR_RULE_NTH_FROM_END(2);
+    ExprToken e = create_expression((*expression_idx)++);
     EXPR_CHECK_UNARY_OPERATION_IMPLICIT_CONVERSION_FROM_DATA_TYPE(
             OPERATION_IMPLICIT_CONVERSION,
             source_expr->data_type,
@@ -1192,11 +1181,11 @@ bool expression_rule_fn_chr(Parser* parser, LList* expr_token_buffer, ExprIdx* e
         }
         String* result = string_init_with_capacity(1);
         string_append_c(result, (char) char_);
-        e->instruction = GENERATE_CODE(
+        e.instruction = GENERATE_CODE(
                 I_PUSH_STACK,
                 code_instruction_operand_init_string(result)
         );
-        e->is_constant = true;
+        e.is_constant = true;
         code_generator_remove_instruction(constructor->generator, source_expr->instruction);
     } else {
         CODE_GENERATION(
@@ -1210,13 +1199,13 @@ bool expression_rule_fn_chr(Parser* parser, LList* expr_token_buffer, ExprIdx* e
                 }
         );
     }
-    e->data_type = DATA_TYPE_STRING;
+    e.data_type = DATA_TYPE_STRING;
     EXPR_RULE_REPLACE(e);
     return true;
 
 }
 
-bool expression_rule_not(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_not(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
     * RULE
     * E -> NOT E
@@ -1232,7 +1221,7 @@ bool expression_rule_not(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
     // NOTE: now we are processing rule regular way - from the left to the right
     CodeConstructor* constructor = parser->code_constructor;
 
-    ExprToken* e = create_expression((*expression_idx)++);
+    ExprToken e = create_expression((*expression_idx)++);
     OperationSignature* signature = parser_semantic_get_operation_signature(
             parser->parser_semantic,
             OPERATION_NOT,
@@ -1244,7 +1233,7 @@ bool expression_rule_not(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
             parser->optimizer,
             EXPR_LOWER_OPERAND,
             EXPR_HIGHER_OPERAND,
-            e,
+            &e,
             signature
     );
 
@@ -1253,17 +1242,17 @@ bool expression_rule_not(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
     }
 
     if(evaluated_operand != NULL) {
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
     } else {
         GENERATE_CODE(I_NOT_STACK);
     }
 
-    e->data_type = DATA_TYPE_BOOLEAN;
+    e.data_type = DATA_TYPE_BOOLEAN;
     EXPR_RULE_REPLACE(e);
     return true;
 }
 
-bool expression_rule_and(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_and(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
     * RULE
     * E -> E AND E
@@ -1283,7 +1272,7 @@ bool expression_rule_and(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
             parser->optimizer,
             EXPR_LOWER_OPERAND,
             EXPR_HIGHER_OPERAND,
-            e,
+            &e,
             operation_signature
     );
 
@@ -1293,7 +1282,7 @@ bool expression_rule_and(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
     }
 
     if(evaluated_operand != NULL) {
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
     } else {
         GENERATE_IMPLICIT_CONVERSIONS_FOR_BINARY_OPERATION_SIGNATURE();
         GENERATE_CODE(I_AND_STACK);
@@ -1303,7 +1292,7 @@ bool expression_rule_and(Parser* parser, LList* expr_token_buffer, ExprIdx* expr
     return true;
 }
 
-bool expression_rule_or(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx) {
+bool expression_rule_or(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx) {
     /*
     * RULE
     * E -> E OR E
@@ -1323,7 +1312,7 @@ bool expression_rule_or(Parser* parser, LList* expr_token_buffer, ExprIdx* expre
             parser->optimizer,
             EXPR_LOWER_OPERAND,
             EXPR_HIGHER_OPERAND,
-            e,
+            &e,
             operation_signature
     );
 
@@ -1333,7 +1322,7 @@ bool expression_rule_or(Parser* parser, LList* expr_token_buffer, ExprIdx* expre
     }
 
     if(evaluated_operand != NULL) {
-        e->instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
+        e.instruction = GENERATE_CODE(I_PUSH_STACK, evaluated_operand);
     } else {
         GENERATE_IMPLICIT_CONVERSIONS_FOR_BINARY_OPERATION_SIGNATURE();
         GENERATE_CODE(I_OR_STACK);
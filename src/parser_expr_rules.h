@@ -3,24 +3,23 @@
 
 #include "parser.h"
 #include "parser_expr_internal.h"
-#include "llist.h"
 
 // Helper macros
 
-#define EXPR_RULE_CHECK_START() LListBaseItem *tmp = NULL, *it = expr_token_buffer->tail
+// Handle of rule is range [handle_begin, handle_end) of stack, left sharp is directly before it
+#define EXPR_RULE_CHECK_START() size_t it = handle_end
 #define EXPR_RULE_CHECK_TYPE(expr_token_type) do {\
-    if (it->previous != NULL) { it = it->previous; } else { return false; }\
-    if (!(it != NULL && ((ExprToken*)it)->type == (expr_token_type))) { return false; }\
-    UNUSED(tmp); \
-    UNUSED(it); \
+    if (it > handle_begin) { it--; } else { return false; }\
+    if (stack->items[it].type != (expr_token_type)) { return false; }\
 } while(false)
-#define EXPR_RULE_CHECK_FINISH() EXPR_RULE_CHECK_TYPE(EXPR_LEFT_SHARP); tmp = it;
-#define EXPR_RULE_NEXT_E_ID() get_next_expr(&tmp)->data.idx
-#define EXPR_RULE_NEXT_E() get_next_expr(&tmp)
-#define EXPR_RULE_NEXT_E_ITEM() get_next_expr_item(&tmp)
-#define EXPR_RULE_REPLACE(single_expression) expr_replace(expr_token_buffer, it, (single_expression))
-#define EXPR_LOWER_OPERAND get_n_expr(expr_token_buffer, 3)
-#define EXPR_HIGHER_OPERAND get_n_expr(expr_token_buffer, 1)
+#define EXPR_RULE_CHECK_FINISH() do {\
+    if (it != handle_begin) { return false; }\
+} while(false)
+#define EXPR_RULE_HANDLE_ITEM(index) (&stack->items[handle_begin + (index)])
+#define EXPR_RULE_NTH_FROM_END(n) (&stack->items[handle_end - (n)])
+#define EXPR_RULE_REPLACE(single_expression) expr_token_stack_replace(stack, handle_begin, (single_expression))
+#define EXPR_LOWER_OPERAND EXPR_RULE_NTH_FROM_END(3)
+#define EXPR_HIGHER_OPERAND EXPR_RULE_NTH_FROM_END(1)
 
 #define CHECK_BINARY_OPERATION_IMPLICIT_CONVERSION(operation, operand_1_type, operand_2_type) SEMANTIC_ANALYSIS({ \
     const DataType target_type = parser_semantic_resolve_implicit_data_type_conversion( \
@@ -58,7 +57,7 @@
 
 
 #define CREATE_EXPR_RESULT_OF_BINARY_OPERATION(operation) \
-    ExprToken* e = create_expression((*expression_idx)++); \
+    ExprToken e = create_expression((*expression_idx)++); \
     const OperationSignature* operation_signature = NULL; \
     SEMANTIC_ANALYSIS({ \
         operation_signature = parser_semantic_get_operation_signature( \
@@ -69,7 +68,7 @@
                 DATA_TYPE_ANY \
         ); \
         if (operation_signature != NULL)    \
-            e->data_type = operation_signature->result_type; \
+            e.data_type = operation_signature->result_type; \
     }); \
 
 #define GENERATE_IMPLICIT_CONVERSIONS_FOR_BINARY_OPERATION_SIGNATURE() do {\
@@ -87,45 +86,51 @@
 
 #define EXPR_RULE_TABLE_SIZE 22
 
-typedef bool(*expression_rule_function)(Parser* parser, LList *expr_token_buffer, ExprIdx* expression_idx);
+typedef bool(*expression_rule_function)(
+        Parser* parser,
+        ExprTokenStack* stack,
+        size_t handle_begin,
+        size_t handle_end,
+        ExprIdx* expression_idx
+);
 extern const expression_rule_function expr_rule_table[EXPR_RULE_TABLE_SIZE];
 
 // Expression rule headers
-bool expression_rule_fake(Parser* parser, LList *expr_token_buffer, ExprIdx* expression_idx);
-bool expression_rule_example(Parser* parser, LList *expr_token_buffer, ExprIdx* expression_idx);
+bool expression_rule_fake(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
+bool expression_rule_example(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
 
 // Actual Rules
-bool expression_rule_id(Parser* parser, LList *expr_token_buffer, ExprIdx* expression_idx);
-bool expression_rule_brackets(Parser* parser, LList *expr_token_buffer, ExprIdx* expression_idx);
-bool expression_rule_fn(Parser* parser, LList *expr_token_buffer, ExprIdx* expression_idx);
+bool expression_rule_id(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
+bool expression_rule_brackets(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
+bool expression_rule_fn(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
 
-bool expression_rule_fn_length(Parser* parser, LList *expr_token_buffer, ExprIdx* expression_idx);
-bool expression_rule_fn_substr(Parser* parser, LList *expr_token_buffer, ExprIdx* expression_idx);
-bool expression_rule_fn_asc(Parser* parser, LList *expr_token_buffer, ExprIdx* expression_idx);
-bool expression_rule_fn_chr(Parser* parser, LList *expr_token_buffer, ExprIdx* expression_idx);
+bool expression_rule_fn_length(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
+bool expression_rule_fn_substr(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
+bool expression_rule_fn_asc(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
+bool expression_rule_fn_chr(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
 
-bool expression_rule_add(Parser* parser, LList *expr_token_buffer, ExprIdx* expression_idx);
-bool expression_rule_sub(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx);
+bool expression_rule_add(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
+bool expression_rule_sub(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
 
-bool expression_rule_mul(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx);
+bool expression_rule_mul(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
 
-bool expression_rule_div(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx);
+bool expression_rule_div(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
 
-bool expression_rule_div_int(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx);
+bool expression_rule_div_int(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
 
-bool expression_rule_unary_minus(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx);
+bool expression_rule_unary_minus(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
 
 // Boolean
-bool expression_rule_not(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx);
-bool expression_rule_and(Parser* parser, LList *expr_token_buffer, ExprIdx* expression_idx);
-bool expression_rule_or(Parser* parser, LList *expr_token_buffer, ExprIdx* expression_idx);
+bool expression_rule_not(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
+bool expression_rule_and(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
+bool expression_rule_or(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
 
 // Comparison
-bool expression_rule_greater(Parser* parser, LList *expr_token_buffer, ExprIdx* expression_idx);
-bool expression_rule_greater_or_equal(Parser* parser, LList *expr_token_buffer, ExprIdx* expression_idx);
-bool expression_rule_equal(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx);
-bool expression_rule_not_equal(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx);
-bool expression_rule_lesser_or_equal(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx);
-bool expression_rule_lesser(Parser* parser, LList* expr_token_buffer, ExprIdx* expression_idx);
+bool expression_rule_greater(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
+bool expression_rule_greater_or_equal(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
+bool expression_rule_equal(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
+bool expression_rule_not_equal(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
+bool expression_rule_lesser_or_equal(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
+bool expression_rule_lesser(Parser* parser, ExprTokenStack* stack, size_t handle_begin, size_t handle_end, ExprIdx* expression_idx);
 
 #endif //_PARSER_EXPR_RULES_H
@@ -1,4 +1,5 @@
 #include "parser_semantic.h"
+#include <string.h>
 
 
 ParserSemantic* parser_semantic_init() {
@@ -23,6 +24,7 @@ ParserSemantic* parser_semantic_init() {
     // Add allowed operations signatures
     for(int i = 0; i < (int) OPERATION__LAST; i++)
         llist_init(&(parser_semantic->operations_signatures[i]), sizeof(OperationSignature), NULL, NULL, NULL);
+    memset(parser_semantic->operations_signatures_table, 0, sizeof(parser_semantic->operations_signatures_table));
 
     // Operation add signatures
     // MATH OPERATIONS
@@ -172,7 +174,7 @@ void parser_semantic_set_action(ParserSemantic* parser_semantic, SemanticAction
         parser_semantic->argument_index = 0;
 }
 
-SymbolVariable* parser_semantic_add_variable(ParserSemantic* parser_semantic, char* name, DataType data_type) {
+SymbolVariable* parser_semantic_add_variable(ParserSemantic* parser_semantic, const char* name, DataType data_type) {
     NULL_POINTER_CHECK(parser_semantic, NULL);
     NULL_POINTER_CHECK(name, NULL);
 
@@ -196,7 +198,7 @@ SymbolVariable* parser_semantic_add_variable(ParserSemantic* parser_semantic, ch
     return symbol_variable;
 }
 
-bool parser_semantic_set_function_name(ParserSemantic* parser_semantic, char* name) {
+bool parser_semantic_set_function_name(ParserSemantic* parser_semantic, const char* name) {
     NULL_POINTER_CHECK(parser_semantic, false);
     NULL_POINTER_CHECK(name, false);
 
@@ -259,7 +261,7 @@ bool parser_semantic_set_function_return_data_type(ParserSemantic* parser_semant
     return true;
 }
 
-bool parser_semantic_add_function_parameter(ParserSemantic* parser_semantic, char* name, DataType data_type) {
+bool parser_semantic_add_function_parameter(ParserSemantic* parser_semantic, const char* name, DataType data_type) {
     NULL_POINTER_CHECK(parser_semantic, false);
     NULL_POINTER_CHECK(name, false);
 
@@ -305,8 +307,7 @@ bool parser_semantic_add_function_parameter(ParserSemantic* parser_semantic, cha
             return false;
         }
         if(0 != strcmp(parameter->name, name)) {
-            memory_free(parameter->name);
-            parameter->name = c_string_copy(name);
+            parameter->name = string_interner_intern_c_string(&string_interner, name);
         }
     }
 
@@ -341,30 +342,12 @@ bool parser_semantic_check_function_definitions(ParserSemantic* parser_semantic)
 void parser_semantic_setup_temp_variables(ParserSemantic* parser_semantic) {
     NULL_POINTER_CHECK(parser_semantic,);
 
-    parser_semantic->temp_variable1 = symbol_table_variable_get_or_create(
-            parser_semantic->register_->variables->symbol_table,
-            "&1"
-    );
-    parser_semantic->temp_variable2 = symbol_table_variable_get_or_create(
-            parser_semantic->register_->variables->symbol_table,
-            "&2"
-    );
-    parser_semantic->temp_variable3 = symbol_table_variable_get_or_create(
-            parser_semantic->register_->variables->symbol_table,
-            "&3"
-    );
-    parser_semantic->temp_variable4 = symbol_table_variable_get_or_create(
-            parser_semantic->register_->variables->symbol_table,
-            "&4"
-    );
-    parser_semantic->temp_variable5 = symbol_table_variable_get_or_create(
-            parser_semantic->register_->variables->symbol_table,
-            "&5"
-    );
-    parser_semantic->temp_variable6 = symbol_table_variable_get_or_create(
-            parser_semantic->register_->variables->symbol_table,
-            "&6"
-    );
+    parser_semantic->temp_variable1 = symbol_register_new_variable(parser_semantic->register_, "&1");
+    parser_semantic->temp_variable2 = symbol_register_new_variable(parser_semantic->register_, "&2");
+    parser_semantic->temp_variable3 = symbol_register_new_variable(parser_semantic->register_, "&3");
+    parser_semantic->temp_variable4 = symbol_register_new_variable(parser_semantic->register_, "&4");
+    parser_semantic->temp_variable5 = symbol_register_new_variable(parser_semantic->register_, "&5");
+    parser_semantic->temp_variable6 = symbol_register_new_variable(parser_semantic->register_, "&6");
     parser_semantic->temp_variable1->frame =
     parser_semantic->temp_variable2->frame =
     parser_semantic->temp_variable3->frame =
@@ -373,6 +356,25 @@ void parser_semantic_setup_temp_variables(ParserSemantic* parser_semantic) {
     parser_semantic->temp_variable6->frame = VARIABLE_FRAME_GLOBAL;
 }
 
+static int parser_semantic_signature_data_type_index(DataType data_type) {
+    switch(data_type) {
+        case DATA_TYPE_NONE:
+            return 0;
+        case DATA_TYPE_INTEGER:
+            return 1;
+        case DATA_TYPE_DOUBLE:
+            return 2;
+        case DATA_TYPE_STRING:
+            return 3;
+        case DATA_TYPE_BOOLEAN:
+            return 4;
+        case DATA_TYPE_ANY:
+            return 5;
+        default:
+            return -1;
+    }
+}
+
 OperationSignature* parser_semantic_get_operation_signature(
         ParserSemantic* parser_semantic,
         TypeExpressionOperation operation_type,
@@ -380,19 +382,15 @@ OperationSignature* parser_semantic_get_operation_signature(
         DataType operand_2_type,
         DataType target_type
 ) {
-    LList* operation_signatures = parser_semantic->operations_signatures[operation_type];
-    OperationSignature* single_operation_signature = (OperationSignature*) operation_signatures->head;
-
-    while(single_operation_signature != NULL) {
-        if(operands_match_data_type_combination(operand_1_type, operand_2_type,
-                                                single_operation_signature->operand_1_type,
-                                                single_operation_signature->operand_2_type) &&
-                (target_type == single_operation_signature->conversion_target_type ||
-                 target_type == DATA_TYPE_ANY)) {
-            return single_operation_signature;
-        }
-
-        single_operation_signature = (OperationSignature*) single_operation_signature->base.next;
+    const int operand_1_index = parser_semantic_signature_data_type_index(operand_1_type);
+    const int operand_2_index = parser_semantic_signature_data_type_index(operand_2_type);
+    const int target_index = parser_semantic_signature_data_type_index(target_type);
+
+    if(operand_1_index >= 0 && operand_2_index >= 0 && target_index >= 0) {
+        OperationSignature* operation_signature = parser_semantic->operations_signatures_table
+        [operation_type][operand_1_index][operand_2_index][target_index];
+        if(operation_signature != NULL)
+            return operation_signature;
     }
 
     LOG_WARNING(
@@ -437,6 +435,27 @@ void parser_semantic_add_operation_signature(ParserSemantic* parser_semantic, Ty
     operation_signature->operand_2_type = operand_2_type;
     operation_signature->conversion_target_type = target_type;
     operation_signature->result_type = result_type;
+
+    const int operand_1_index = parser_semantic_signature_data_type_index(operand_1_type);
+    const int operand_2_index = parser_semantic_signature_data_type_index(operand_2_type);
+    const int target_index = parser_semantic_signature_data_type_index(target_type);
+    const int any_index = parser_semantic_signature_data_type_index(DATA_TYPE_ANY);
+    if(operand_1_index < 0 || operand_2_index < 0 || target_index < 0) {
+        LOG_WARNING("Operation %d signature with unsupported data type is not registered.", operation);
+        return;
+    }
+
+    // operands are commutative, earlier added signature has priority
+    OperationSignature** operands_signatures[2] = {
+            parser_semantic->operations_signatures_table[operation][operand_1_index][operand_2_index],
+            parser_semantic->operations_signatures_table[operation][operand_2_index][operand_1_index]
+    };
+    for(int i = 0; i < 2; i++) {
+        if(operands_signatures[i][target_index] == NULL)
+            operands_signatures[i][target_index] = operation_signature;
+        if(operands_signatures[i][any_index] == NULL)
+            operands_signatures[i][any_index] = operation_signature;
+    }
 }
 
 void parser_semantic_function_start(ParserSemantic* parser_semantic, SymbolFunction* function) {
@@ -40,6 +40,9 @@ typedef enum {
     OPERATION__LAST
 } TypeExpressionOperation;
 
+// Count of data types, which could be operands or targets of operation signature, including DATA_TYPE_ANY
+#define OPERATION_SIGNATURE_DATA_TYPES_COUNT 6
+
 typedef struct expr_operation_signature_t {
     LListBaseItem base;
     TypeExpressionOperation operation_type;
@@ -68,6 +71,9 @@ typedef struct parser_semantic_t {
     SymbolVariable* temp_variable5;
     SymbolVariable* temp_variable6;
     LList* operations_signatures[OPERATION__LAST];
+    // first matching signature for operation, both operands and target type, DATA_TYPE_ANY target matches any one
+    OperationSignature* operations_signatures_table[OPERATION__LAST]
+    [OPERATION_SIGNATURE_DATA_TYPES_COUNT][OPERATION_SIGNATURE_DATA_TYPES_COUNT][OPERATION_SIGNATURE_DATA_TYPES_COUNT];
     ExprToken* expression_result;
 } ParserSemantic;
 
@@ -100,7 +106,7 @@ void parser_semantic_set_action(ParserSemantic* parser_semantic, SemanticAction
  * @param char* name Name of function
  * @return bool was successfully sets?
  */
-bool parser_semantic_set_function_name(ParserSemantic* parser_semantic, char* name);
+bool parser_semantic_set_function_name(ParserSemantic* parser_semantic, const char* name);
 
 
 /**
@@ -111,7 +117,7 @@ bool parser_semantic_set_function_name(ParserSemantic* parser_semantic, char* na
  * @param data_type data type of variable
  * @return instance of created variable
  */
-SymbolVariable* parser_semantic_add_variable(ParserSemantic* parser_semantic, char* name, DataType data_type);
+SymbolVariable* parser_semantic_add_variable(ParserSemantic* parser_semantic, const char* name, DataType data_type);
 
 /**
  * @brief If the actual action is ACTUAL_ACTION__FUNCTION_DECLARATION, then set return data type for actual function,
@@ -129,7 +135,7 @@ bool parser_semantic_set_function_return_data_type(ParserSemantic* parser_semant
  * @param data_type data types
  * @return bool was successfully sets?
  */
-bool parser_semantic_add_function_parameter(ParserSemantic* parser_semantic, char* name, DataType data_type);
+bool parser_semantic_add_function_parameter(ParserSemantic* parser_semantic, const char* name, DataType data_type);
 
 /**
  *  Checks function parameter count with declaration.
@@ -174,7 +180,8 @@ void parser_semantic_add_operation_signature(
 );
 
 /**
- * Gets Signature or NULL if operand types and result type were matched.
+ * Gets Signature or NULL if operand types and result type were matched. Signature is read directly from table,
+ * which is filled by parser_semantic_add_operation_signature.
  * @param parser_semantic instance
  * @param operation_type operation type
  * @param operand_1_type first operand type
@@ -1,8 +1,77 @@
 #include "set_int.h"
 
+#define SET_INT_WORD_BITS 64
+#define SET_INT_WORD_INDEX(value) ((size_t) (value) / SET_INT_WORD_BITS)
+#define SET_INT_BIT(value) ((uint64_t) 1 << ((size_t) (value) % SET_INT_WORD_BITS))
+
+static size_t set_int_popcount(uint64_t word) {
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (size_t) ((word * 0x0101010101010101ULL) >> 56);
+}
+
+// index of lowest set bit in non zero word, de Bruijn multiplication
+static int set_int_lowest_bit(uint64_t word) {
+    static const int positions[64] = {
+            0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4,
+            62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+            63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+            46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9, 13, 8, 7, 6
+    };
+    return positions[((word & (~word + 1)) * 0x03F79D71B4CB0A89ULL) >> 58];
+}
+
+static void set_int_recount(SetInt* set) {
+    set->size = 0;
+    for(size_t i = 0; i < set->words_count; i++)
+        set->size += set_int_popcount(set->words[i]);
+}
+
+// grows bitset to given count of words, small values are moved into bitset
+static void set_int_reserve_words(SetInt* set, size_t words_count) {
+    if(set->words != NULL && set->words_count >= words_count)
+        return;
+
+    // bitset has to cover also biggest small value
+    if(set->words == NULL && set->size > 0 && SET_INT_WORD_INDEX(set->small_values[set->size - 1]) >= words_count)
+        words_count = SET_INT_WORD_INDEX(set->small_values[set->size - 1]) + 1;
+
+    // amortized growth
+    if(words_count < set->words_count * 2)
+        words_count = set->words_count * 2;
+
+    uint64_t* words = memory_alloc(sizeof(uint64_t) * words_count);
+    NULL_POINTER_CHECK(words,);
+    memset(words, 0, sizeof(uint64_t) * words_count);
+
+    if(set->words != NULL) {
+        memcpy(words, set->words, sizeof(uint64_t) * set->words_count);
+        memory_free(set->words);
+    } else {
+        for(size_t i = 0; i < set->size; i++)
+            words[SET_INT_WORD_INDEX(set->small_values[i])] |= SET_INT_BIT(set->small_values[i]);
+    }
+
+    set->words = words;
+    set->words_count = words_count;
+}
+
+// position of value in small set or position, where it should be inserted
+static size_t set_int_small_index(SetInt* set, int value) {
+    size_t i = 0;
+    while(i < set->size && set->small_values[i] < value)
+        i++;
+    return i;
+}
+
 SetInt* set_int_init() {
-    SetInt* set;
-    llist_init(&set, sizeof(SetIntItem), NULL, NULL, NULL);
+    SetInt* set = memory_alloc(sizeof(SetInt));
+    NULL_POINTER_CHECK(set, NULL);
+
+    set->size = 0;
+    set->words = NULL;
+    set->words_count = 0;
 
     return set;
 }
@@ -11,132 +80,240 @@ void set_int_free(SetInt** set) {
     NULL_POINTER_CHECK(set,);
     NULL_POINTER_CHECK(*set,);
 
-    llist_free(set);
+    if((*set)->words != NULL)
+        memory_free((*set)->words);
+    memory_free(*set);
+    *set = NULL;
 }
 
 bool set_int_contains(SetInt* set, int value) {
     NULL_POINTER_CHECK(set, false);
 
-    SetIntItem* item = (SetIntItem*) set->head;
+    if(value < 0)
+        return false;
 
-    while(item) {
-        if(item->value == value)
-            return true;
-        item = (SetIntItem*) item->base.next;
-    }
+    if(set->words != NULL)
+        return SET_INT_WORD_INDEX(value) < set->words_count &&
+               (set->words[SET_INT_WORD_INDEX(value)] & SET_INT_BIT(value)) != 0;
 
-    return false;
+    const size_t index = set_int_small_index(set, value);
+    return index < set->size && set->small_values[index] == value;
 }
 
 bool set_int_is_empty(SetInt* set) {
     NULL_POINTER_CHECK(set, true);
 
-    return set->head == NULL;
+    return set->size == 0;
 }
 
 size_t set_int_size(SetInt* set) {
     NULL_POINTER_CHECK(set, 0);
 
-    return llist_length(set);
+    return set->size;
 }
 
 void set_int_add(SetInt* set, int value) {
     NULL_POINTER_CHECK(set,);
 
-    if(set_int_contains(set, value))
+    if(value < 0) {
+        LOG_WARNING("Negative value %d cannot be stored in set.", value);
         return;
+    }
+
+    if(set->words == NULL) {
+        const size_t index = set_int_small_index(set, value);
+        if(index < set->size && set->small_values[index] == value)
+            return;
+
+        if(set->size < SET_INT_SMALL_CAPACITY) {
+            memmove(&set->small_values[index + 1], &set->small_values[index], sizeof(int) * (set->size - index));
+            set->small_values[index] = value;
+            set->size++;
+            return;
+        }
+    }
 
-    SetIntItem* new_item = (SetIntItem*) llist_new_tail_item(set);
-    new_item->value = value;
+    set_int_reserve_words(set, SET_INT_WORD_INDEX(value) + 1);
+    uint64_t* word = &set->words[SET_INT_WORD_INDEX(value)];
+    if((*word & SET_INT_BIT(value)) == 0) {
+        *word |= SET_INT_BIT(value);
+        set->size++;
+    }
 }
 
 void set_int_remove(SetInt* set, int value) {
     NULL_POINTER_CHECK(set,);
 
-    SetIntItem* item = (SetIntItem*) set->head;
+    if(!set_int_contains(set, value))
+        return;
 
-    while(item != NULL) {
-        if(item->value == value) {
-            llist_remove_item(set, (LListBaseItem*) item);
-            return;
-        }
-        item = (SetIntItem*) item->base.next;
+    if(set->words != NULL) {
+        set->words[SET_INT_WORD_INDEX(value)] &= ~SET_INT_BIT(value);
+    } else {
+        const size_t index = set_int_small_index(set, value);
+        memmove(&set->small_values[index], &set->small_values[index + 1], sizeof(int) * (set->size - index - 1));
     }
+    set->size--;
 }
 
 void set_int_clear(SetInt* set) {
     NULL_POINTER_CHECK(set,);
 
-    LListBaseItem* current_item = set->head;
-    LListBaseItem* next_item = NULL;
-
-    if(current_item != NULL) {
-        do {
-            next_item = current_item->next;
-            memory_free(current_item);
-            current_item = next_item;
-        } while(current_item != NULL);
-    }
-
-    set->head = set->tail = NULL;
+    if(set->words != NULL)
+        memset(set->words, 0, sizeof(uint64_t) * set->words_count);
+    set->size = 0;
 }
 
 void set_int_print(SetInt* set) {
     NULL_POINTER_CHECK(set,);
 
-    SetIntItem* item = (SetIntItem*) set->head;
     fprintf(stderr, "Set(");
+    for(int value = set_int_first(set); value != SET_INT_END; value = set_int_next(set, value))
+        fprintf(stderr, "%d, ", value);
+    fprintf(stderr, ")");
+}
+
+int set_int_first(SetInt* set) {
+    return set_int_next(set, SET_INT_END);
+}
 
-    while(item != NULL) {
-        fprintf(stderr, "%d, ", item->value);
-        item = (SetIntItem*) item->base.next;
+int set_int_next(SetInt* set, int value) {
+    NULL_POINTER_CHECK(set, SET_INT_END);
+
+    if(set->words == NULL) {
+        const size_t index = set_int_small_index(set, value + 1);
+        return index < set->size ? set->small_values[index] : SET_INT_END;
     }
-    fprintf(stderr, ")");
+
+    const int next_value = value + 1;
+    size_t word_index = SET_INT_WORD_INDEX(next_value);
+    if(word_index >= set->words_count)
+        return SET_INT_END;
+
+    // skip values lower than next value in its word
+    uint64_t word = set->words[word_index] & ~(SET_INT_BIT(next_value) - 1);
+    while(word == 0) {
+        if(++word_index >= set->words_count)
+            return SET_INT_END;
+        word = set->words[word_index];
+    }
+
+    return (int) (word_index * SET_INT_WORD_BITS) + set_int_lowest_bit(word);
 }
 
 void set_int_union(SetInt* set, SetInt* other) {
     NULL_POINTER_CHECK(set,);
     NULL_POINTER_CHECK(other,);
 
-    SetIntItem* item = (SetIntItem*) other->head;
-
-    while(item != NULL) {
-        set_int_add(set, item->value);
-        item = (SetIntItem*) item->base.next;
+    if(other->words == NULL) {
+        for(size_t i = 0; i < other->size; i++)
+            set_int_add(set, other->small_values[i]);
+        return;
     }
+
+    set_int_reserve_words(set, other->words_count);
+    // simple loop over words is vectorized by compiler
+    uint64_t* words = set->words;
+    const uint64_t* other_words = other->words;
+    for(size_t i = 0; i < other->words_count; i++)
+        words[i] |= other_words[i];
+    set_int_recount(set);
 }
 
 void set_int_difference(SetInt* set, SetInt* other) {
     NULL_POINTER_CHECK(set,);
     NULL_POINTER_CHECK(other,);
 
-    SetIntItem* item = (SetIntItem*) other->head;
+    if(set->words == NULL) {
+        size_t kept_count = 0;
+        for(size_t i = 0; i < set->size; i++) {
+            if(!set_int_contains(other, set->small_values[i]))
+                set->small_values[kept_count++] = set->small_values[i];
+        }
+        set->size = kept_count;
+        return;
+    }
 
-    while(item != NULL) {
-        set_int_remove(set, item->value);
-        item = (SetIntItem*) item->base.next;
+    if(other->words == NULL) {
+        for(size_t i = 0; i < other->size; i++)
+            set_int_remove(set, other->small_values[i]);
+        return;
     }
+
+    const size_t words_count = set->words_count < other->words_count ? set->words_count : other->words_count;
+    uint64_t* words = set->words;
+    const uint64_t* other_words = other->words;
+    for(size_t i = 0; i < words_count; i++)
+        words[i] &= ~other_words[i];
+    set_int_recount(set);
+}
+
+void set_int_intersection(SetInt* set, SetInt* other) {
+    NULL_POINTER_CHECK(set,);
+    NULL_POINTER_CHECK(other,);
+
+    size_t kept_count = 0;
+    if(set->words == NULL) {
+        for(size_t i = 0; i < set->size; i++) {
+            if(set_int_contains(other, set->small_values[i]))
+                set->small_values[kept_count++] = set->small_values[i];
+        }
+        set->size = kept_count;
+        return;
+    }
+
+    // intersection with small set is small
+    if(other->words == NULL) {
+        for(size_t i = 0; i < other->size; i++) {
+            if(set_int_contains(set, other->small_values[i]))
+                set->small_values[kept_count++] = other->small_values[i];
+        }
+        memory_free(set->words);
+        set->words = NULL;
+        set->words_count = 0;
+        set->size = kept_count;
+        return;
+    }
+
+    uint64_t* words = set->words;
+    const uint64_t* other_words = other->words;
+    for(size_t i = 0; i < set->words_count; i++)
+        words[i] &= i < other->words_count ? other_words[i] : 0;
+    set_int_recount(set);
 }
 
 bool set_int_difference_is_empty(SetInt* set, SetInt* other) {
     NULL_POINTER_CHECK(set, false);
     NULL_POINTER_CHECK(other, false);
 
-    SetIntItem* item = (SetIntItem*) other->head;
-    unsigned int match_count = 0;
+    if(set->size > other->size)
+        return false;
 
-    while(item != NULL) {
-        if(set_int_contains(set, item->value))
-            match_count++;
-        item = (SetIntItem*) item->base.next;
+    if(set->words == NULL || other->words == NULL) {
+        for(int value = set_int_first(set); value != SET_INT_END; value = set_int_next(set, value)) {
+            if(!set_int_contains(other, value))
+                return false;
+        }
+        return true;
     }
 
-    return match_count == set_int_size(set);
+    uint64_t remaining = 0;
+    for(size_t i = 0; i < set->words_count; i++)
+        remaining |= set->words[i] & ~(i < other->words_count ? other->words[i] : 0);
+    return remaining == 0;
 }
 
 SetInt* set_int_copy(SetInt* other) {
+    NULL_POINTER_CHECK(other, NULL);
+
     SetInt* new_set = set_int_init();
-    set_int_union(new_set, other);
+    NULL_POINTER_CHECK(new_set, NULL);
+
+    *new_set = *other;
+    if(other->words != NULL) {
+        new_set->words = memory_alloc(sizeof(uint64_t) * other->words_count);
+        memcpy(new_set->words, other->words, sizeof(uint64_t) * other->words_count);
+    }
 
     return new_set;
 }
@@ -1,15 +1,25 @@
 #ifndef SETINT_H
 #define SETINT_H
 
+#include <stdint.h>
 #include "llist.h"
 
-typedef struct {
-    LListBaseItem base;
-    int value;
-} SetIntItem;
-
-
-typedef LList SetInt;
+// count of values kept in sorted array, bigger sets are stored in bitset
+#define SET_INT_SMALL_CAPACITY 8
+// returned by iteration after last value
+#define SET_INT_END (-1)
+
+/**
+ * @brief Set of non-negative integers (dense ids of blocks). Small set keeps sorted values inline,
+ * bigger one is bitset, so set operations run over whole words.
+ */
+typedef struct set_int_t {
+    size_t size;
+    int small_values[SET_INT_SMALL_CAPACITY];
+    // NULL while set is small
+    uint64_t* words;
+    size_t words_count;
+} SetInt;
 
 typedef struct {
     LListBaseItem base;
@@ -40,12 +50,26 @@ void set_int_clear(SetInt* set);
 
 void set_int_print(SetInt* set);
 
-// TODO test
+/**
+ * @brief Smallest value in set or SET_INT_END.
+ */
+int set_int_first(SetInt* set);
+
+/**
+ * @brief Smallest value in set greater than given value or SET_INT_END, values are iterated in ascending order by
+ * for(int value = set_int_first(set); value != SET_INT_END; value = set_int_next(set, value))
+ */
+int set_int_next(SetInt* set, int value);
+
 void set_int_union(SetInt* set, SetInt* other);
 
-// TODO test
 void set_int_difference(SetInt* set, SetInt* other);
 
+void set_int_intersection(SetInt* set, SetInt* other);
+
+/**
+ * @brief Checks if difference set - other is empty.
+ */
 bool set_int_difference_is_empty(SetInt* set, SetInt* other);
 
 #endif // SETINT_H
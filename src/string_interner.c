@@ -0,0 +1,161 @@
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "string_interner.h"
+#include "memory.h"
+#include "debug.h"
+
+StringInterner string_interner;
+
+#define STRING_INTERNER_SELECT(interner) ((interner) == NULL ? &string_interner : (interner))
+#define STRING_INTERNER_ALIGN(size) (((size) + STRING_INTERNER_ALIGNMENT - 1) & ~(STRING_INTERNER_ALIGNMENT - 1))
+
+size_t string_interner_hash(const char* string, size_t length) {
+    // multiplicative hash of whole words, long string literals would be slow with per char hashing
+    const uint64_t multiplier = UINT64_C(0x9E3779B97F4A7C15);
+    uint64_t hash = length * multiplier;
+    uint64_t word;
+    for(; length >= sizeof(word); length -= sizeof(word), string += sizeof(word)) {
+        memcpy(&word, string, sizeof(word));
+        hash = (((hash << 5) | (hash >> 59)) ^ word) * multiplier;
+    }
+    word = 0;
+    memcpy(&word, string, length);
+    hash = (((hash << 5) | (hash >> 59)) ^ word) * multiplier;
+    return (size_t) (hash ^ (hash >> 32));
+}
+
+static void* string_interner_alloc(size_t size) {
+    // interned strings live through all phases, so they must not be owned by sub-arena of current phase
+    const MemoryManagerArena arena = memory_manager_switch_arena(&memory_manager, MEMORY_MANAGER_ARENA_NONE);
+    void* block = memory_alloc(size);
+    memory_manager_switch_arena(&memory_manager, arena);
+    return block;
+}
+
+static StringInternerEntry** string_interner_find_slot(
+        StringInternerEntry** slots, size_t capacity,
+        const char* string, size_t length, size_t hash
+) {
+    size_t index = hash & (capacity - 1);
+    while(slots[index] != NULL) {
+        const StringInternerEntry* entry = slots[index];
+        if(entry->hash == hash && entry->length == length && memcmp(entry->content, string, length) == 0)
+            break;
+        index = (index + 1) & (capacity - 1);
+    }
+    return &slots[index];
+}
+
+static void string_interner_grow(StringInterner* interner) {
+    const size_t capacity = interner->capacity == 0 ? STRING_INTERNER_BASE_CAPACITY : interner->capacity * 2;
+    StringInternerEntry** slots = (StringInternerEntry**) string_interner_alloc(
+            sizeof(StringInternerEntry*) * capacity
+    );
+    memset(slots, 0, sizeof(StringInternerEntry*) * capacity);
+
+    for(size_t i = 0; i < interner->capacity; i++) {
+        StringInternerEntry* entry = interner->slots[i];
+        if(entry == NULL)
+            continue;
+        size_t index = entry->hash & (capacity - 1);
+        while(slots[index] != NULL)
+            index = (index + 1) & (capacity - 1);
+        slots[index] = entry;
+    }
+
+    if(interner->slots != NULL)
+        memory_free(interner->slots);
+    interner->slots = slots;
+    interner->capacity = capacity;
+}
+
+static StringInternerEntry* string_interner_new_entry(StringInterner* interner, size_t length) {
+    const size_t size = STRING_INTERNER_ALIGN(sizeof(StringInternerEntry) + length + 1);
+    StringInternerChunk* chunk = interner->chunks;
+
+    if(chunk == NULL || chunk->size - chunk->used < size) {
+        const size_t data_size = size > STRING_INTERNER_CHUNK_SIZE ? size : STRING_INTERNER_CHUNK_SIZE;
+        StringInternerChunk* new_chunk = (StringInternerChunk*) string_interner_alloc(
+                sizeof(StringInternerChunk) + data_size
+        );
+        NULL_POINTER_CHECK(new_chunk, NULL);
+        new_chunk->size = data_size;
+        new_chunk->used = 0;
+        if(chunk != NULL && size > STRING_INTERNER_CHUNK_SIZE) {
+            // keep the current chunk on top, it has still free space for short strings
+            new_chunk->next = chunk->next;
+            chunk->next = new_chunk;
+        } else {
+            new_chunk->next = chunk;
+            interner->chunks = new_chunk;
+        }
+        chunk = new_chunk;
+    }
+
+    StringInternerEntry* entry = (StringInternerEntry*) ((char*) (chunk + 1) + chunk->used);
+    chunk->used += size;
+    return entry;
+}
+
+const char* string_interner_intern(StringInterner* interner, const char* string, size_t length) {
+    NULL_POINTER_CHECK(string, NULL);
+    interner = STRING_INTERNER_SELECT(interner);
+
+    // keep load factor under 1/2
+    if((interner->count + 1) * 2 > interner->capacity)
+        string_interner_grow(interner);
+
+    const size_t hash = string_interner_hash(string, length);
+    StringInternerEntry** slot = string_interner_find_slot(
+            interner->slots, interner->capacity, string, length, hash
+    );
+    if(*slot != NULL)
+        return (*slot)->content;
+
+    StringInternerEntry* entry = string_interner_new_entry(interner, length);
+    NULL_POINTER_CHECK(entry, NULL);
+    entry->hash = hash;
+    entry->length = length;
+    memcpy(entry->content, string, length);
+    entry->content[length] = '\0';
+
+    *slot = entry;
+    interner->count++;
+    return entry->content;
+}
+
+const char* string_interner_intern_c_string(StringInterner* interner, const char* string) {
+    NULL_POINTER_CHECK(string, NULL);
+    return string_interner_intern(interner, string, strlen(string));
+}
+
+size_t string_interner_length(const char* interned) {
+    NULL_POINTER_CHECK(interned, 0);
+    const StringInternerEntry* entry = (const StringInternerEntry*) (
+            interned - offsetof(StringInternerEntry, content)
+    );
+    return entry->length;
+}
+
+size_t string_interner_count(StringInterner* interner) {
+    return STRING_INTERNER_SELECT(interner)->count;
+}
+
+void string_interner_free(StringInterner* interner) {
+    interner = STRING_INTERNER_SELECT(interner);
+
+    StringInternerChunk* chunk = interner->chunks;
+    while(chunk != NULL) {
+        StringInternerChunk* next = chunk->next;
+        memory_free(chunk);
+        chunk = next;
+    }
+    if(interner->slots != NULL)
+        memory_free(interner->slots);
+
+    interner->slots = NULL;
+    interner->capacity = 0;
+    interner->count = 0;
+    interner->chunks = NULL;
+}
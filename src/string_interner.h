@@ -0,0 +1,96 @@
+#ifndef _STRING_INTERNER_H
+#define _STRING_INTERNER_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+/**
+ * Compilation-wide pool of immutable strings. Each distinct content is stored only once, so interned strings
+ * could be shared by tokens, expression tokens and symbol tables without copying and two interned strings are equal
+ * exactly when their pointers are equal. Interned strings are valid until string_interner_free.
+ *
+ * All functions accept NULL as interner, global string_interner is then used.
+ */
+
+#define STRING_INTERNER_BASE_CAPACITY 1024 // must be power of two
+#define STRING_INTERNER_CHUNK_SIZE (16 * 1024)
+#define STRING_INTERNER_ALIGNMENT sizeof(size_t)
+
+/**
+ * @brief Interned string with cached hash and length, content is stored directly after the header.
+ */
+typedef struct string_interner_entry_t {
+    size_t hash;
+    size_t length;
+    char content[];
+} StringInternerEntry;
+
+/**
+ * @brief Chunk of memory, entries are bump-allocated from memory directly after the header.
+ */
+typedef struct string_interner_chunk_t {
+    struct string_interner_chunk_t* next;
+    size_t size;
+    size_t used;
+} StringInternerChunk;
+
+typedef struct string_interner_t {
+    StringInternerEntry** slots; // open addressing with linear probing, NULL as empty slot
+    size_t capacity;
+    size_t count;
+    StringInternerChunk* chunks;
+} StringInterner;
+
+extern StringInterner string_interner;
+
+/**
+ * @brief Get canonical copy of given chars, which is created on first use.
+ *
+ * @param interner optional specified interner
+ * @param string chars to intern, don't have to be terminated
+ * @param length count of chars
+ * @return const char* NUL terminated interned string
+ */
+const char* string_interner_intern(StringInterner* interner, const char* string, size_t length);
+
+/**
+ * @brief Get canonical copy of given NUL terminated string.
+ *
+ * @param interner optional specified interner
+ * @param string string to intern
+ * @return const char* interned string
+ */
+const char* string_interner_intern_c_string(StringInterner* interner, const char* string);
+
+/**
+ * @brief Get length of interned string without scanning its content.
+ *
+ * @param interned string returned by interner
+ * @return size_t length of string
+ */
+size_t string_interner_length(const char* interned);
+
+/**
+ * @brief Hash chars by whole words, used by interner and shared with other string keyed tables.
+ *
+ * @param string chars to hash, don't have to be terminated
+ * @param length count of chars
+ * @return size_t hash
+ */
+size_t string_interner_hash(const char* string, size_t length);
+
+/**
+ * @brief Get count of distinct interned strings.
+ *
+ * @param interner optional specified interner
+ */
+size_t string_interner_count(StringInterner* interner);
+
+/**
+ * @brief Release all interned strings, interner could be used again after that.
+ *
+ * @param interner optional specified interner
+ */
+void string_interner_free(StringInterner* interner);
+
+#endif //_STRING_INTERNER_H
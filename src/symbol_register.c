@@ -1,14 +1,54 @@
 #include "symbol_register.h"
 
+static void symbol_register_binding_init_data(SymbolTableBaseItem* item) {
+    NULL_POINTER_CHECK(item,);
+    ((SymbolRegisterBinding*) item)->variable = NULL;
+}
+
+static SymbolTableSymbolVariableStackItem* symbol_register_new_scope(
+        SymbolTableSymbolVariableStackItem* parent,
+        size_t scope_identifier,
+        size_t undo_log_start
+) {
+    SymbolTableSymbolVariableStackItem* item = memory_alloc(sizeof(SymbolTableSymbolVariableStackItem));
+    NULL_POINTER_CHECK(item, NULL);
+    item->parent = parent;
+    item->scope_identifier = scope_identifier;
+    item->undo_log_start = undo_log_start;
+    item->scope_alias = NULL;
+    return item;
+}
+
+static void symbol_register_free_scope(SymbolTableSymbolVariableStackItem* item) {
+    if(item->scope_alias != NULL)
+        memory_free(item->scope_alias);
+    memory_free(item);
+}
+
+static void symbol_register_undo_declarations(SymbolRegister* register_, size_t undo_log_start) {
+    while(register_->undo_log_size > undo_log_start) {
+        SymbolRegisterUndoItem* undo_item = &register_->undo_log[--register_->undo_log_size];
+        SymbolVariable* variable = undo_item->binding->variable;
+        undo_item->binding->variable = undo_item->shadowed;
+        symbol_variable_single_free(&variable);
+    }
+}
+
 SymbolRegister* symbol_register_init() {
     SymbolRegister* register_ = (SymbolRegister*) memory_alloc(sizeof(SymbolRegister));
 
     // TODO: sizes?
     register_->functions = symbol_table_function_init(8);
-    register_->variables = memory_alloc(sizeof(SymbolTable));
-    register_->variables->symbol_table = symbol_table_variable_init(16);
-    register_->variables->parent = NULL;
-    register_->variables->scope_identifier = 0;
+    register_->bindings = symbol_table_init(
+            SYMBOL_REGISTER_BINDINGS_SIZE,
+            sizeof(SymbolRegisterBinding),
+            symbol_register_binding_init_data,
+            NULL
+    );
+    register_->undo_log = NULL;
+    register_->undo_log_size = 0;
+    register_->undo_log_capacity = 0;
+    register_->variables = symbol_register_new_scope(NULL, 0, 0);
     register_->variables_table_counter = 0;
 
     return register_;
@@ -24,12 +64,16 @@ void symbol_register_free(SymbolRegister** register_) {
     SymbolTableSymbolVariableStackItem* parent;
 
     while(stack_item != NULL) {
-        symbol_table_free(stack_item->symbol_table);
         parent = stack_item->parent;
-        memory_free(stack_item);
+        symbol_register_free_scope(stack_item);
         stack_item = parent;
     }
 
+    symbol_register_undo_declarations(*register_, 0);
+    if((*register_)->undo_log != NULL)
+        memory_free((*register_)->undo_log);
+    symbol_table_free((*register_)->bindings);
+
     memory_free(*register_);
     *register_ = NULL;
 }
@@ -37,12 +81,11 @@ void symbol_register_free(SymbolRegister** register_) {
 void symbol_register_push_variables_table(SymbolRegister* register_) {
     NULL_POINTER_CHECK(register_,);
 
-    SymbolTableSymbolVariableStackItem* item = memory_alloc(sizeof(SymbolTableSymbolVariableStackItem));
-    item->symbol_table = symbol_table_variable_init(16);
-    item->parent = register_->variables;
-    item->scope_identifier = ++register_->variables_table_counter;
-    item->scope_alias = NULL;
-    register_->variables = item;
+    register_->variables = symbol_register_new_scope(
+            register_->variables,
+            ++register_->variables_table_counter,
+            register_->undo_log_size
+    );
 }
 
 void symbol_register_pop_variables_table(SymbolRegister* register_) {
@@ -51,50 +94,34 @@ void symbol_register_pop_variables_table(SymbolRegister* register_) {
 
     SymbolTableSymbolVariableStackItem* stack_item_to_free = register_->variables;
     register_->variables = stack_item_to_free->parent;
-    symbol_table_free(stack_item_to_free->symbol_table);
-    if(stack_item_to_free->scope_alias != NULL)
-        memory_free(stack_item_to_free->scope_alias);
-    memory_free(stack_item_to_free);
+    symbol_register_undo_declarations(register_, stack_item_to_free->undo_log_start);
+    symbol_register_free_scope(stack_item_to_free);
 
     if(register_->variables == NULL) {
         // poped last stack item
-        register_->variables = memory_alloc(sizeof(SymbolTableSymbolVariableStackItem));
-        register_->variables->symbol_table = symbol_table_variable_init(16);
-        register_->variables->parent = NULL;
-        register_->variables->scope_identifier = 0;
-        register_->variables->scope_alias = NULL;
+        register_->variables = symbol_register_new_scope(NULL, 0, 0);
     }
 }
 
 SymbolVariable* symbol_register_find_variable(SymbolRegister* register_, const char* key) {
     NULL_POINTER_CHECK(register_, NULL);
     NULL_POINTER_CHECK(register_->variables, NULL);
-    NULL_POINTER_CHECK(register_->variables->symbol_table, NULL);
     NULL_POINTER_CHECK(key, NULL);
 
-    return symbol_table_variable_get(
-            register_->variables->symbol_table,
-            key
-    );
+    SymbolVariable* variable = symbol_register_find_variable_recursive(register_, key);
+    // each scope has unique identifier, so innermost variable is from actual scope only if identifiers match
+    if(variable != NULL && variable->scope_depth == register_->variables->scope_identifier)
+        return variable;
+    return NULL;
 }
 
 SymbolVariable* symbol_register_find_variable_recursive(SymbolRegister* register_, const char* key) {
     NULL_POINTER_CHECK(register_, NULL);
-    NULL_POINTER_CHECK(register_->variables, NULL);
-    NULL_POINTER_CHECK(register_->variables->symbol_table, NULL);
+    NULL_POINTER_CHECK(register_->bindings, NULL);
     NULL_POINTER_CHECK(key, NULL);
 
-    SymbolVariable* item = NULL;
-    SymbolTableSymbolVariableStackItem* variables = register_->variables;
-
-    while(variables != NULL) {
-        item = symbol_table_variable_get(variables->symbol_table, key);
-        if(item != NULL)
-            return item;
-
-        variables = variables->parent;
-    }
-    return NULL;
+    SymbolRegisterBinding* binding = (SymbolRegisterBinding*) symbol_table_get(register_->bindings, key);
+    return binding == NULL ? NULL : binding->variable;
 }
 
 SymbolVariable* symbol_register_new_variable(SymbolRegister* register_, const char* key) {
@@ -108,10 +135,33 @@ SymbolVariable* symbol_register_new_variable(SymbolRegister* register_, const ch
         return variable;
     }
 
-    variable = symbol_table_variable_get_or_create(register_->variables->symbol_table, key);
+    if(register_->undo_log_size == register_->undo_log_capacity) {
+        const size_t capacity = register_->undo_log_capacity == 0 ?
+                                SYMBOL_REGISTER_UNDO_LOG_BASE_CAPACITY : register_->undo_log_capacity * 2;
+        SymbolRegisterUndoItem* undo_log = memory_alloc(sizeof(SymbolRegisterUndoItem) * capacity);
+        NULL_POINTER_CHECK(undo_log, NULL);
+        if(register_->undo_log != NULL) {
+            memcpy(undo_log, register_->undo_log, sizeof(SymbolRegisterUndoItem) * register_->undo_log_size);
+            memory_free(register_->undo_log);
+        }
+        register_->undo_log = undo_log;
+        register_->undo_log_capacity = capacity;
+    }
+
+    SymbolRegisterBinding* binding = (SymbolRegisterBinding*) symbol_table_get_or_create(register_->bindings, key);
+    NULL_POINTER_CHECK(binding, NULL);
+
+    variable = symbol_variable_init(key);
+    NULL_POINTER_CHECK(variable, NULL);
+    symbol_variable_init_data((SymbolTableBaseItem*) variable);
     variable->scope_depth = register_->variables->scope_identifier;
     if(register_->variables->scope_alias != NULL)
         variable->scope_alias = c_string_copy(register_->variables->scope_alias);
 
+    SymbolRegisterUndoItem* undo_item = &register_->undo_log[register_->undo_log_size++];
+    undo_item->binding = binding;
+    undo_item->shadowed = binding->variable;
+    binding->variable = variable;
+
     return variable;
 }
@@ -5,13 +5,32 @@
 #include "symtable_variable.h"
 #include "symtable_function.h"
 
+#define SYMBOL_REGISTER_BINDINGS_SIZE 64
+#define SYMBOL_REGISTER_UNDO_LOG_BASE_CAPACITY 32
+
+/**
+ * @brief Variable visible under single name, item of identifiers table shared by all scopes.
+ */
+typedef struct symbol_register_binding_t {
+    SymbolTableBaseItem base;
+    SymbolVariable* variable; // variable from innermost scope or NULL
+} SymbolRegisterBinding;
+
 /**
- * @brief Helper structure for stacking variable symbol tables.
+ * @brief Single declaration in undo log, variables shadowed by declarations create chain per name.
+ */
+typedef struct symbol_register_undo_item_t {
+    SymbolRegisterBinding* binding;
+    SymbolVariable* shadowed; // variable visible before declaration, restored when scope is popped
+} SymbolRegisterUndoItem;
+
+/**
+ * @brief Helper structure for stacking variable scopes.
  */
 typedef struct symbol_table_symbol_variable_stack_item_t {
-    SymbolTable* symbol_table;
     size_t scope_identifier;
     struct symbol_table_symbol_variable_stack_item_t* parent;
+    size_t undo_log_start; // declarations of scope are in undo log from this index to end
 
     char* scope_alias;
 } SymbolTableSymbolVariableStackItem;
@@ -23,6 +42,11 @@ typedef struct symbol_register_t {
     SymbolTable* functions;
     SymbolTableSymbolVariableStackItem* variables;
     size_t variables_table_counter;
+
+    SymbolTable* bindings;
+    SymbolRegisterUndoItem* undo_log;
+    size_t undo_log_size;
+    size_t undo_log_capacity;
 } SymbolRegister;
 
 /**
@@ -38,19 +62,19 @@ SymbolRegister* symbol_register_init();
 void symbol_register_free(SymbolRegister** register_);
 
 /**
- * Add new variables table and actual push backward.
+ * Open new variables scope, variables of outer scopes stay visible.
  * @param register_ Symbol register
  */
 void symbol_register_push_variables_table(SymbolRegister* register_);
 
 /**
- * Remove actual variables table and second table marks as actual.
+ * Close actual variables scope, free its variables and make visible variables shadowed by them.
  * @param register_ Symbol register
  */
 void symbol_register_pop_variables_table(SymbolRegister* register_);
 
 /**
- * Try to find variable by name in actual variables table.
+ * Try to find variable by name in actual variables scope.
  * @param register_ Symbol register
  * @param key variable name to find
  * @return Found variable symbol or NULL
@@ -58,7 +82,7 @@ void symbol_register_pop_variables_table(SymbolRegister* register_);
 SymbolVariable* symbol_register_find_variable(SymbolRegister* register_, const char* key);
 
 /**
- * Try to find variable by name in all variable tables.
+ * Try to find variable by name in all variable scopes, innermost declaration is returned.
  * @param register_ Symbol register
  * @param key variable name to find
  * @return Found variable symbol or NULL
@@ -2,23 +2,95 @@
 #include "debug.h"
 #include "memory.h"
 
-size_t hash(const char* str);
+// keys of items are interned, so interned searched key is found without comparing of content
+#define SYMBOL_TABLE_KEY_EQUAL(key, length, item_key) ((key) == (item_key) || 0 == memcmp((key), (item_key), (length)))
+// distance of slot from home slot of its item
+#define SYMBOL_TABLE_PROBE_DISTANCE(table, index, hash) (((index) - (hash)) & ((table)->bucket_count - 1))
+// keep load factor under 3/4
+#define SYMBOL_TABLE_NEEDS_GROW(table, count) ((count) * 4 > (table)->bucket_count * 3)
+
+static size_t symbol_table_round_size(size_t size) {
+    size_t rounded = 1;
+    while(rounded < size)
+        rounded <<= 1;
+    return rounded;
+}
+
+static SymbolTableSlot* symbol_table_alloc_slots(size_t count) {
+    SymbolTableSlot* slots = memory_alloc(sizeof(SymbolTableSlot) * count);
+    NULL_POINTER_CHECK(slots, NULL);
+    memset(slots, 0, sizeof(SymbolTableSlot) * count);
+    return slots;
+}
+
+static void symbol_table_insert_slot(SymbolTable* table, SymbolTableSlot entry) {
+    const size_t mask = table->bucket_count - 1;
+    size_t index = entry.hash & mask;
+    size_t distance = 0;
+
+    while(table->slots[index].item != NULL) {
+        // Robin Hood - item closer to its home slot gives place to the inserted one
+        const size_t slot_distance = SYMBOL_TABLE_PROBE_DISTANCE(table, index, table->slots[index].hash);
+        if(slot_distance < distance) {
+            SymbolTableSlot tmp = table->slots[index];
+            table->slots[index] = entry;
+            entry = tmp;
+            distance = slot_distance;
+        }
+        index = (index + 1) & mask;
+        distance++;
+    }
+    table->slots[index] = entry;
+}
+
+static void symbol_table_resize(SymbolTable* table, size_t bucket_count) {
+    SymbolTableSlot* old_slots = table->slots;
+    const size_t old_bucket_count = table->bucket_count;
+
+    table->slots = symbol_table_alloc_slots(bucket_count);
+    table->bucket_count = bucket_count;
+    if(old_slots == NULL)
+        return;
+
+    for(size_t i = 0; i < old_bucket_count; ++i) {
+        if(old_slots[i].item != NULL)
+            symbol_table_insert_slot(table, old_slots[i]);
+    }
+    memory_free(old_slots);
+}
+
+static SymbolTableSlot* symbol_table_find_slot(SymbolTable* table, const char* key, unsigned hash,
+                                               unsigned key_length) {
+    if(table->slots == NULL)
+        return NULL;
+
+    const size_t mask = table->bucket_count - 1;
+    size_t index = hash & mask;
+
+    for(size_t distance = 0;; ++distance) {
+        SymbolTableSlot* slot = &table->slots[index];
+        // item would be placed before any item further from its home slot
+        if(slot->item == NULL || SYMBOL_TABLE_PROBE_DISTANCE(table, index, slot->hash) < distance)
+            return NULL;
+        if(slot->hash == hash && slot->key_length == key_length &&
+           SYMBOL_TABLE_KEY_EQUAL(key, key_length, slot->item->key))
+            return slot;
+        index = (index + 1) & mask;
+    }
+}
 
 SymbolTable* symbol_table_init(size_t size, size_t item_size, symtable_init_data_callback_f init_data_callback,
                                symtable_free_data_callback_f free_data_callback) {
-    size_t need_memory = sizeof(SymbolTable) + item_size * size;
-
-    SymbolTable* table = memory_alloc(need_memory);
+    SymbolTable* table = memory_alloc(sizeof(SymbolTable));
+    NULL_POINTER_CHECK(table, NULL);
 
     table->item_size = item_size;
-    table->bucket_count = size;
+    table->bucket_count = symbol_table_round_size(size);
     table->item_count = 0;
     table->free_data_callback = free_data_callback;
     table->init_data_callback = init_data_callback;
     table->copy_data_callback = NULL;
-
-    for(size_t i = 0; i < size; ++i)
-        table->items[i] = NULL;
+    table->slots = NULL;
 
     return table;
 }
@@ -27,6 +99,8 @@ void symbol_table_free(SymbolTable* table) {
     NULL_POINTER_CHECK(table,);
     symbol_table_clear_buckets(table);
 
+    if(table->slots != NULL)
+        memory_free(table->slots);
     memory_free(table);
 }
 
@@ -42,25 +116,18 @@ size_t symbol_table_bucket_count(SymbolTable* table) {
 
 void symbol_table_clear_buckets(SymbolTable* table) {
     NULL_POINTER_CHECK(table,);
-
-    SymbolTableBaseItem* item_to_free = NULL;
-    SymbolTableBaseItem* tmp_item = NULL;
+    if(table->slots == NULL)
+        return;
 
     for(size_t i = 0; i < table->bucket_count; ++i) {
-        item_to_free = table->items[i];
+        SymbolTableBaseItem* item_to_free = table->slots[i].item;
         if(item_to_free == NULL) continue;
-        do {
-            tmp_item = item_to_free;
-            item_to_free = item_to_free->next;
-            if(table->free_data_callback != NULL) {
-                table->free_data_callback(tmp_item);
-            }
-            if(tmp_item->key != NULL) {
-                memory_free(tmp_item->key);
-            }
-            memory_free(tmp_item);
-        } while(item_to_free != NULL);
-        table->items[i] = NULL;
+
+        if(table->free_data_callback != NULL) {
+            table->free_data_callback(item_to_free);
+        }
+        memory_free(item_to_free);
+        table->slots[i].item = NULL;
     }
     table->item_count = 0;
 }
@@ -68,61 +135,35 @@ void symbol_table_clear_buckets(SymbolTable* table) {
 SymbolTableBaseItem* symbol_table_new_item(const char* key, size_t item_size) {
     NULL_POINTER_CHECK(key, NULL);
     SymbolTableBaseItem* new_item = memory_alloc(item_size);
-    char* copied_key = c_string_copy(key);
-    NULL_POINTER_CHECK(copied_key, NULL);
+    const char* interned_key = string_interner_intern_c_string(&string_interner, key);
+    NULL_POINTER_CHECK(interned_key, NULL);
 
-    new_item->key = copied_key;
-    new_item->next = NULL;
+    new_item->key = interned_key;
 
     return new_item;
 }
 
-void symbol_table_append_item(SymbolTable* table,
-                              SymbolTableBaseItem* new_item) {
-    NULL_POINTER_CHECK(table,);
-    NULL_POINTER_CHECK(new_item,);
-
-    size_t index = hash(new_item->key) % table->bucket_count;
-    SymbolTableBaseItem* target = table->items[index];
-
-    new_item->next = NULL;
-    if(target == NULL) {
-        table->items[index] = new_item;
-
-    } else {
-        while(target->next != NULL) {
-            target = target->next;
-        };
-        target->next = new_item;
-    }
-}
-
-
 SymbolTableBaseItem* symbol_table_get(SymbolTable* table, const char* key) {
     NULL_POINTER_CHECK(table, NULL);
     NULL_POINTER_CHECK(key, NULL);
 
-    size_t index = hash(key) % table->bucket_count;
-    SymbolTableBaseItem* item = table->items[index];
-
-    while(item != NULL) {
-        if(0 == strcmp(key, item->key))
-            return item;
-        item = item->next;
-    }
-    return item;
+    const size_t key_length = strlen(key);
+    SymbolTableSlot* slot = symbol_table_find_slot(
+            table, key, (unsigned) string_interner_hash(key, key_length), (unsigned) key_length
+    );
+    return slot == NULL ? NULL : slot->item;
 }
 
 void symbol_table_foreach(SymbolTable* table, symtable_foreach_callback_f callback, void* static_data) {
     NULL_POINTER_CHECK(table,);
     NULL_POINTER_CHECK(callback,);
+    if(table->slots == NULL)
+        return;
 
     for(size_t i = 0; i < table->bucket_count; ++i) {
-        SymbolTableBaseItem* item = table->items[i];
-        while(item != NULL) {
+        SymbolTableBaseItem* item = table->slots[i].item;
+        if(item != NULL)
             callback(item->key, item, static_data);
-            item = item->next;
-        }
     }
 }
 
@@ -130,32 +171,26 @@ SymbolTableBaseItem* symbol_table_get_or_create(SymbolTable* table, const char*
     NULL_POINTER_CHECK(table, NULL);
     NULL_POINTER_CHECK(key, NULL);
 
-    size_t index = hash(key) % table->bucket_count;
-    SymbolTableBaseItem* item = table->items[index];
-    SymbolTableBaseItem* last_item = NULL;
-
-    while(item != NULL) {
-        if(0 == strcmp(key, item->key))
-            return item;
-
-        last_item = item;
-        item = item->next;
-    };
+    const size_t key_length = strlen(key);
+    const unsigned hash = (unsigned) string_interner_hash(key, key_length);
+    SymbolTableSlot* slot = symbol_table_find_slot(table, key, hash, (unsigned) key_length);
+    if(slot != NULL)
+        return slot->item;
 
     // key not found, we need to allocate new item
     SymbolTableBaseItem* new_item = symbol_table_new_item(key, table->item_size);
+    if(new_item == NULL) return NULL;
+
     if(table->init_data_callback != NULL)
         table->init_data_callback(new_item);
 
-    if(new_item == NULL) return NULL;
+    if(table->slots == NULL)
+        symbol_table_resize(table, table->bucket_count);
+    if(SYMBOL_TABLE_NEEDS_GROW(table, table->item_count + 1))
+        symbol_table_resize(table, table->bucket_count * 2);
 
-    if(last_item == NULL) {
-        // not items not found at index
-        table->items[index] = new_item;
-    } else {
-        // link to next
-        last_item->next = new_item;
-    }
+    SymbolTableSlot entry = {.hash = hash, .key_length = (unsigned) key_length, .item = new_item};
+    symbol_table_insert_slot(table, entry);
     table->item_count++;
 
     return new_item;
@@ -168,20 +203,18 @@ SymbolTable* symbol_table_move(size_t new_size, SymbolTable* source) {
                                                  source->free_data_callback);
     if(destination == NULL) return NULL;
 
-    destination->bucket_count = new_size;
     destination->copy_data_callback = source->copy_data_callback;
 
-    SymbolTableBaseItem* item = NULL;
-    SymbolTableBaseItem* next = NULL;
-
-    for(size_t source_bucket_i = 0; source_bucket_i < source->bucket_count; ++source_bucket_i) {
-        item = source->items[source_bucket_i];
-        source->items[source_bucket_i] = NULL;
-        while(item != NULL) {
-            next = item->next;
-            symbol_table_append_item(destination, item);
-            item = next;
-        };
+    if(source->slots != NULL) {
+        while(SYMBOL_TABLE_NEEDS_GROW(destination, source->item_count))
+            destination->bucket_count *= 2;
+        symbol_table_resize(destination, destination->bucket_count);
+
+        for(size_t i = 0; i < source->bucket_count; ++i) {
+            if(source->slots[i].item != NULL)
+                symbol_table_insert_slot(destination, source->slots[i]);
+            source->slots[i].item = NULL;
+        }
     }
 
     destination->item_count = source->item_count;
@@ -194,29 +227,31 @@ bool symbol_table_remove(SymbolTable* table, const char* key) {
     NULL_POINTER_CHECK(table, false);
     NULL_POINTER_CHECK(key, false);
 
-    size_t index = hash(key) % table->bucket_count;
-    SymbolTableBaseItem* item = table->items[index];
-    SymbolTableBaseItem* prev = NULL;
-
-    while(item != NULL) {
-        if(0 == strcmp(key, item->key)) {
-            if(prev == NULL)
-                table->items[index] = item->next;
-            else
-                prev->next = item->next;
-
-            memory_free(item->key);
-            if(table->free_data_callback != NULL)
-                table->free_data_callback(item);
-            memory_free(item);
-            return true;
-        }
-
-        prev = item;
-        item = item->next;
-    };
+    const size_t key_length = strlen(key);
+    SymbolTableSlot* slot = symbol_table_find_slot(
+            table, key, (unsigned) string_interner_hash(key, key_length), (unsigned) key_length
+    );
+    if(slot == NULL)
+        return false;
+
+    SymbolTableBaseItem* item = slot->item;
+
+    // backward shift of following items, so no tombstones are needed
+    const size_t mask = table->bucket_count - 1;
+    size_t index = (size_t) (slot - table->slots);
+    size_t next = (index + 1) & mask;
+    while(table->slots[next].item != NULL && SYMBOL_TABLE_PROBE_DISTANCE(table, next, table->slots[next].hash) != 0) {
+        table->slots[index] = table->slots[next];
+        index = next;
+        next = (next + 1) & mask;
+    }
+    table->slots[index].item = NULL;
+    table->item_count--;
 
-    return false;
+    if(table->free_data_callback != NULL)
+        table->free_data_callback(item);
+    memory_free(item);
+    return true;
 }
 
 SymbolTable* symbol_table_copy(SymbolTable* source) {
@@ -230,35 +265,23 @@ SymbolTable* symbol_table_copy(SymbolTable* source) {
     );
     new_table->item_count = source->item_count;
     new_table->copy_data_callback = source->copy_data_callback;
+    if(source->slots == NULL)
+        return new_table;
 
-    SymbolTableBaseItem* copied_item;
+    // same count of slots, so items keep their positions
+    new_table->slots = symbol_table_alloc_slots(new_table->bucket_count);
     for(size_t i = 0; i < source->bucket_count; ++i) {
-        new_table->items[i] = NULL;
-        copied_item = source->items[i];
-        while(copied_item != NULL) {
-            SymbolTableBaseItem* new_item = memory_alloc(new_table->item_size);
-            char* copied_key = c_string_copy(copied_item->key);
-            NULL_POINTER_CHECK(copied_key, NULL);
-
-            new_item->key = copied_key;
-            new_item->next = new_table->items[i];
-            new_table->items[i] = new_item;
-            if(new_table->copy_data_callback != NULL)
-                new_table->copy_data_callback(new_item, copied_item);
-
-            copied_item = copied_item->next;
-        }
+        SymbolTableBaseItem* copied_item = source->slots[i].item;
+        if(copied_item == NULL)
+            continue;
+
+        SymbolTableBaseItem* new_item = memory_alloc(new_table->item_size);
+        // interned key is shared
+        new_item->key = copied_item->key;
+        new_table->slots[i] = source->slots[i];
+        new_table->slots[i].item = new_item;
+        if(new_table->copy_data_callback != NULL)
+            new_table->copy_data_callback(new_item, copied_item);
     }
     return new_table;
 }
-
-
-size_t hash(const char* str) {
-    unsigned hash = 5381;
-    int c;
-
-    while((c = *str++))
-        hash = ((hash << 5) + hash) + c; /* hash * 33 + c */
-
-    return hash;
-}
\ No newline at end of file
@@ -6,13 +6,13 @@
 #include <string.h>
 #include <stdio.h>
 #include "memory.h"
+#include "string_interner.h"
 
 
 #define SYMBOL_TABLE_BASE_SIZE 32
 
 typedef struct symbol_table_base_list_item_t {
-    char* key;
-    struct symbol_table_base_list_item_t* next;
+    const char* key; // interned, shared with copies of item
 } SymbolTableBaseItem;
 
 typedef struct {
@@ -31,19 +31,32 @@ typedef void(* symtable_copy_data_callback_f)(SymbolTableBaseItem*, SymbolTableB
 
 typedef void(* symtable_foreach_callback_f)(const char* key, void* data, void* static_data);
 
+/**
+ * @brief Slot of open addressing table, item is NULL for empty slot.
+ */
+typedef struct symbol_table_slot_t {
+    unsigned hash; // hash of key, also determines home slot of item
+    unsigned key_length;
+    SymbolTableBaseItem* item;
+} SymbolTableSlot;
+
+/**
+ * @brief Hash table with Robin Hood open addressing, slots are allocated on first insert and table grows
+ * automatically. Items are allocated separately, so pointers to them are stable until they are removed.
+ */
 typedef struct symbol_table_t {
     size_t item_size;
-    size_t bucket_count;
+    size_t bucket_count; // count of slots, always power of two
     size_t item_count;
     symtable_free_data_callback_f free_data_callback;
     symtable_init_data_callback_f init_data_callback;
     symtable_copy_data_callback_f copy_data_callback;
-    SymbolTableBaseItem* items[];
+    SymbolTableSlot* slots;
 } SymbolTable;
 
 /**
  * Construct new hash table with given size.
- * @param size count of buckets
+ * @param size initial count of buckets, rounded up to power of two
  * @param item_size size of one item to correct memory allocating for inherited symtables
  * @param init_data_callback call back to init data for item
  * @param free_data_callback call back to free data for item
@@ -69,7 +82,7 @@ void symbol_table_free(SymbolTable* table);
 size_t symbol_table_size(SymbolTable* table);
 
 /**
- * Getter for count of buckets in hash table.
+ * Getter for count of buckets (slots) in hash table, grows with count of items.
  * @return Count of buckets in table.
  */
 size_t symbol_table_bucket_count(SymbolTable* table);
@@ -94,14 +107,14 @@ SymbolTableBaseItem* symbol_table_get_or_create(SymbolTable* table, const char*
 SymbolTableBaseItem* symbol_table_get(SymbolTable* table, const char* key);
 
 /**
- * Create new item with copied key, non linked to table.
- * @param key key to copy
+ * Create new item with interned key, non linked to table.
+ * @param key key to intern
  * @param item_size bytes to allocated
  */
 SymbolTableBaseItem* symbol_table_new_item(const char* key, size_t item_size);
 
 /**
- * Call given function on all items in hash table.
+ * Call given function on all items in hash table. Callback could modify found items, but mustn't add or remove them.
  */
 void symbol_table_foreach(SymbolTable* table, symtable_foreach_callback_f, void* static_data);
 
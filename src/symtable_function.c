@@ -15,7 +15,6 @@ void symbol_function_free_data(SymbolTableBaseItem* item) {
     SymbolFunctionParam* next;
     while(param != NULL) {
         next = param->next;
-        memory_free(param->name);
         memory_free(param);
         param = next;
     }
@@ -32,12 +31,12 @@ void symbol_function_init_data(SymbolTableBaseItem* item) {
     function->arguments_count = 0;
 }
 
-SymbolFunctionParam* symbol_function_add_param(SymbolFunction* function, char* name, DataType data_type) {
+SymbolFunctionParam* symbol_function_add_param(SymbolFunction* function, const char* name, DataType data_type) {
     NULL_POINTER_CHECK(function, NULL);
     SymbolFunctionParam* param = memory_alloc(sizeof(SymbolFunctionParam));
 
     param->data_type = data_type;
-    param->name = c_string_copy(name);
+    param->name = string_interner_intern_c_string(&string_interner, name);
     param->next = NULL;
     param->prev = NULL;
 
@@ -15,7 +15,7 @@
 
 typedef struct symbol_function_param_t {
     // inherit from symbolvariable
-    char* name;
+    const char* name; // interned
     DataType data_type;
     struct symbol_function_param_t* next;
     struct symbol_function_param_t* prev;
@@ -67,7 +67,7 @@ void symbol_function_free_data(SymbolTableBaseItem* item);
  * @param data_type data type of parameter
  * @return created parameter
  */
-SymbolFunctionParam* symbol_function_add_param(SymbolFunction* function, char* name, DataType data_type);
+SymbolFunctionParam* symbol_function_add_param(SymbolFunction* function, const char* name, DataType data_type);
 
 /**
  * Try to get parameter by given index. 0 is index of leftmost parameter.
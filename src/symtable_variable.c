@@ -15,7 +15,6 @@ void symbol_variable_free_data(SymbolTableBaseItem* item) {
     NULL_POINTER_CHECK(item,);
     SymbolVariable* variable = (SymbolVariable*) item;
 
-    memory_free(variable->base.key);
     variable->base.key = NULL;
     if(variable->alias_name != NULL) {
         memory_free(variable->alias_name);
@@ -51,7 +50,6 @@ SymbolVariable* symbol_variable_copy(SymbolVariable* variable) {
     new->data_type = variable->data_type;
     new->frame = variable->frame;
     new->scope_depth = variable->scope_depth;
-    new->base.next = NULL;
     if(variable->alias_name != NULL) {
         new->alias_name = c_string_copy(variable->alias_name);
     }
@@ -82,9 +80,6 @@ SymbolVariable* symbol_variable_init_from_function_param(SymbolFunction* functio
 void symbol_variable_single_free(SymbolVariable** variable) {
     NULL_POINTER_CHECK(variable,);
     NULL_POINTER_CHECK(*variable,);
-    if((*variable)->base.next != NULL) {
-        LOG_WARNING("Symbol variable from table, not standalone!");
-    }
     symbol_variable_free_data((SymbolTableBaseItem*) *variable);
     memory_free(*variable);
     *variable = NULL;
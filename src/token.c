@@ -1,6 +1,5 @@
 #include "token.h"
-#include "memory.h"
-#include <string.h>
+#include "debug.h"
 
 bool token_check(Token token, TokenType type) {
     return !(((token.type & type) == 0 && type >= TOKEN_CLASSES && (type & 0xFF) == 0) ||
@@ -8,20 +7,10 @@ bool token_check(Token token, TokenType type) {
 }
 
 Token token_copy(Token token) {
-    if(token.data == NULL) {
-        return token;
-    }
-    Token tmp = {
-            .data = c_string_copy(token.data),
-            .type = token.type
-    };
-    return tmp;
+    return token;
 }
 
 void token_free(Token* token) {
     NULL_POINTER_CHECK(token,);
-    if(token->data != NULL) {
-        memory_free(token->data);
-        token->data = NULL;
-    }
+    token->data = NULL;
 }
@@ -88,12 +88,21 @@ typedef enum {
 
 } TokenType;
 
+/**
+ * @brief Numeric value of literal token
+ */
+typedef union {
+    int integer;
+    double double_;
+} TokenValue;
+
 /**
  * @brief Represents a token
  */
 typedef struct token_t {
     TokenType type; // Type of token
-    char* data;
+    const char* data; // interned string of identifiers and string literals, shared by all tokens with same content
+    TokenValue value; // value of integer and double literals
 } Token;
 
 /**
@@ -102,12 +111,12 @@ typedef struct token_t {
 bool token_check(Token token, TokenType type);
 
 /**
-* @brief Performs deep copy of token.
+* @brief Copy token, interned data are shared.
 */
 Token token_copy(Token token);
 
 /**
-* @brief Free token data.
+* @brief Release token data, interned data are only unlinked.
 */
 void token_free(Token *token);
 
@@ -0,0 +1,88 @@
+#include "gtest/gtest.h"
+#include "utils/stringbycharprovider.h"
+
+extern "C" {
+#include "../src/parser.h"
+#include "../src/code_optimizer.h"
+#include "../src/code_optimizer_expr.h"
+}
+
+class CodeOptimizerTestFixture : public testing::Test {
+    protected:
+        Parser* parser = nullptr;
+        StringByCharProvider* provider = StringByCharProvider::instance();
+
+        void TearDown() override {
+            if(parser != nullptr)
+                parser_free(&parser);
+        }
+
+        void parse(const std::string &program) {
+            provider->setString(program);
+            parser = parser_init(token_stream);
+            ASSERT_TRUE(parser_parse(parser));
+            code_optimizer_optimize_type_casts(parser->optimizer);
+            code_optimizer_update_meta_data(parser->optimizer);
+        }
+
+        // runs worklist peep hole passes until nothing is rewritten, false if it does not stop
+        bool peep_hole_stops() {
+            for(int i = 0; i < 16; i++) {
+                const size_t applied_before = parser->optimizer->peep_hole_applied_count;
+                const bool rewritten = code_optimizer_peep_hole_optimization_worklist(parser->optimizer);
+                if(parser->optimizer->peep_hole_applied_count - applied_before > 1000)
+                    return false;
+                if(!rewritten)
+                    return true;
+            }
+            return false;
+        }
+};
+
+TEST_F(CodeOptimizerTestFixture, WorklistSelfAssignment) {
+    parse("Scope\n"
+          "Dim a As Integer\n"
+          "Dim b As Integer\n"
+          "Dim i As Integer\n"
+          "input a\n"
+          "Do While i < 3\n"
+          "If i > 1 Then\n"
+          "a = a\n"
+          "b = a + i\n"
+          "End If\n"
+          "print b;\n"
+          "i = i + 1\n"
+          "Loop\n"
+          "End Scope\n");
+
+    EXPECT_TRUE(peep_hole_stops()) << "Self assignment is rewritten to itself";
+    code_optimizer_add_advance_peep_hole_patterns(parser->optimizer);
+    EXPECT_TRUE(peep_hole_stops());
+}
+
+TEST_F(CodeOptimizerTestFixture, WorklistCyclicPatterns) {
+    parse("Scope\n"
+          "Dim a As Integer\n"
+          "input a\n"
+          "print a;\n"
+          "print a + 1;\n"
+          "End Scope\n");
+
+    PeepHolePattern* pattern = code_optimizer_new_ph_pattern(parser->optimizer);
+    code_optimizer_add_matching_instruction_to_ph_pattern(pattern, I_WRITE, "a", NULL, NULL, -1, 0, 0);
+    code_optimizer_add_replacement_instruction_to_ph_pattern(pattern, I_PUSH_STACK, "a", NULL, NULL);
+    pattern = code_optimizer_new_ph_pattern(parser->optimizer);
+    code_optimizer_add_matching_instruction_to_ph_pattern(pattern, I_PUSH_STACK, "a", NULL, NULL, -1, 0, 0);
+    code_optimizer_add_replacement_instruction_to_ph_pattern(pattern, I_WRITE, "a", NULL, NULL);
+
+    size_t instructions_count = 0;
+    for(CodeInstruction* instruction = parser->optimizer->generator->first;
+        instruction != nullptr; instruction = instruction->next)
+        instructions_count++;
+
+    EXPECT_TRUE(code_optimizer_peep_hole_optimization_worklist(parser->optimizer));
+    EXPECT_LE(
+            parser->optimizer->peep_hole_applied_count,
+            (CODE_OPTIMIZER_PEEP_HOLE_REVISITS_PER_INSTRUCTION + 1) * instructions_count
+    ) << "Patterns rewriting into each other are bounded by revisits";
+}
@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+#include "utils/codeoptimizergraphfixture.h"
+
+extern "C" {
+#include "../src/code_optimizer_licm.h"
+}
+
+class CodeOptimizerLICMTestFixture : public CodeOptimizerGraphTestFixture {
+    protected:
+        // position of first instruction starting with prefix and containing part or -1
+        int position(const std::string &prefix, const std::string &part) {
+            const std::vector<std::string> rendered = instructions();
+            for(size_t i = 0; i < rendered.size(); i++) {
+                if(rendered[i].compare(0, prefix.size(), prefix) == 0 && rendered[i].find(part) != std::string::npos)
+                    return static_cast<int>(i);
+            }
+            return -1;
+        }
+
+        bool is_before_loop(const std::string &prefix, const std::string &part) {
+            const int found = position(prefix, part);
+            return found != -1 && found < position("LABEL", "while_start");
+        }
+};
+
+TEST_F(CodeOptimizerLICMTestFixture, LengthInCondition) {
+    split("Function f(s As String) As Integer\n"
+          "Dim i As Integer\n"
+          "Do While i < Length(s)\n"
+          "i = i + 1\n"
+          "Loop\n"
+          "Return i\n"
+          "End Function\n"
+          "Scope\n"
+          "print f(!\"abc\");\n"
+          "End Scope\n");
+    EXPECT_FALSE(is_before_loop("STRLEN", ""));
+
+    EXPECT_TRUE(code_optimizer_loop_invariant_code_motion(parser->optimizer));
+    EXPECT_TRUE(is_before_loop("STRLEN", "")) << "Length of parameter is computed once";
+    EXPECT_FALSE(is_before_loop("ADD", "_i")) << "Counter is modified in loop";
+}
+
+TEST_F(CodeOptimizerLICMTestFixture, ArithmeticOnUnchangedVariable) {
+    split("Function f(k As Integer) As Integer\n"
+          "Dim i As Integer\n"
+          "Dim y As Integer\n"
+          "Do While i < 10\n"
+          "y = k * 3\n"
+          "print y;\n"
+          "i = i + 1\n"
+          "Loop\n"
+          "Return i\n"
+          "End Function\n"
+          "Scope\n"
+          "print f(4);\n"
+          "End Scope\n");
+
+    EXPECT_TRUE(code_optimizer_loop_invariant_code_motion(parser->optimizer));
+    EXPECT_TRUE(is_before_loop("MUL", "_y"));
+}
+
+TEST_F(CodeOptimizerLICMTestFixture, VariableReadAfterSkippedLoop) {
+    split("Function f(k As Integer) As Integer\n"
+          "Dim i As Integer\n"
+          "Dim y As Integer\n"
+          "Do While i < k\n"
+          "y = k * 3\n"
+          "i = i + 1\n"
+          "Loop\n"
+          "Return y\n"
+          "End Function\n"
+          "Scope\n"
+          "print f(4);\n"
+          "End Scope\n");
+
+    EXPECT_FALSE(code_optimizer_loop_invariant_code_motion(parser->optimizer));
+    EXPECT_FALSE(is_before_loop("MUL", "_y")) << "Value before loop is printed, if loop is skipped";
+}
+
+TEST_F(CodeOptimizerLICMTestFixture, ConditionalComputation) {
+    split("Function f(k As Integer) As Integer\n"
+          "Dim i As Integer\n"
+          "Dim y As Integer\n"
+          "Do While i < 10\n"
+          "If i > 5 Then\n"
+          "y = k * 3\n"
+          "print y;\n"
+          "End If\n"
+          "i = i + 1\n"
+          "Loop\n"
+          "Return i\n"
+          "End Function\n"
+          "Scope\n"
+          "print f(4);\n"
+          "End Scope\n");
+
+    EXPECT_FALSE(code_optimizer_loop_invariant_code_motion(parser->optimizer));
+    EXPECT_FALSE(is_before_loop("MUL", "_y")) << "Computation is not executed in every iteration";
+}
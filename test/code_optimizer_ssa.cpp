@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+#include "utils/codeoptimizergraphfixture.h"
+
+extern "C" {
+#include "../src/code_optimizer_ssa.h"
+}
+
+class CodeOptimizerSSATestFixture : public CodeOptimizerGraphTestFixture {
+    protected:
+        size_t count(const std::string &prefix, const std::string &part) {
+            size_t found = 0;
+            for(const std::string &instruction : instructions()) {
+                if(instruction.compare(0, prefix.size(), prefix) == 0 && instruction.find(part) != std::string::npos)
+                    found++;
+            }
+            return found;
+        }
+};
+
+TEST_F(CodeOptimizerSSATestFixture, PhisOnJoins) {
+    split("Scope\n"
+          "Dim x As Integer\n"
+          "input x\n"
+          "Do While x < 10\n"
+          "x = x + 3\n"
+          "Loop\n"
+          "print x;\n"
+          "End Scope\n");
+
+    CodeSSA* ssa = code_optimizer_ssa_init(parser->optimizer);
+    ASSERT_NE(ssa, nullptr);
+    const OrientedGraphCSR* csr = oriented_graph_freeze(parser->optimizer->code_graph);
+
+    size_t phis_count = 0;
+    for(size_t i = 0; i < ssa->values_count; i++) {
+        const CodeSSAValue* value = &ssa->values[i];
+        if(value->type != CODE_SSA_VALUE_PHI)
+            continue;
+        phis_count++;
+        const unsigned int predecessors_count =
+                csr->predecessors_offsets[value->block + 1] - csr->predecessors_offsets[value->block];
+        EXPECT_GE(predecessors_count, 2) << "Phi in block without join";
+        for(unsigned int j = 0; j < predecessors_count; j++)
+            EXPECT_NE(ssa->phis_operands[value->operands_offset + j], -1) << "Operand of phi has reaching value";
+    }
+    EXPECT_GE(phis_count, 1) << "Phi of loop variable";
+
+    code_ssa_free(&ssa);
+    EXPECT_EQ(ssa, nullptr);
+}
+
+TEST_F(CodeOptimizerSSATestFixture, ConstantsThroughJoinAndLoop) {
+    split("Scope\n"
+          "Dim x As Integer\n"
+          "Dim c As Integer = 2\n"
+          "input x\n"
+          "If x > 5 Then\n"
+          "c = 1 + 1\n"
+          "Else\n"
+          "x = x + c\n"
+          "End If\n"
+          "Do While x < 100\n"
+          "x = x * c\n"
+          "Loop\n"
+          "print x;\n"
+          "End Scope\n");
+    EXPECT_EQ(count("MUL", "_c"), 1) << "Variable read in loop";
+
+    EXPECT_TRUE(code_optimizer_ssa_optimization(parser->optimizer));
+    EXPECT_EQ(count("MUL", "_c"), 0) << "Constant of variable set on both branches";
+    EXPECT_EQ(count("MUL", "int@2"), 1);
+}
+
+TEST_F(CodeOptimizerSSATestFixture, UnreachableBranchIsNotMerged) {
+    split("Scope\n"
+          "Dim x As Integer\n"
+          "Dim c As Integer = 3\n"
+          "Dim i As Integer = 0\n"
+          "input x\n"
+          "Do While i < x\n"
+          "If c <> 3 Then\n"
+          "c = x\n"
+          "End If\n"
+          "x = x - c\n"
+          "i = i + 1\n"
+          "Loop\n"
+          "print x;\n"
+          "End Scope\n");
+
+    EXPECT_TRUE(code_optimizer_ssa_optimization(parser->optimizer));
+    EXPECT_EQ(count("SUB", "_c"), 0) << "Branch changing variable is never executed";
+    EXPECT_EQ(count("SUB", "int@3"), 1);
+}
+
+TEST_F(CodeOptimizerSSATestFixture, RedundantComputation) {
+    split("Scope\n"
+          "Dim x As Integer\n"
+          "Dim y As Integer\n"
+          "Dim z As Integer\n"
+          "input x\n"
+          "y = x * 7\n"
+          "If x > 0 Then\n"
+          "z = x * 7\n"
+          "print z;\n"
+          "End If\n"
+          "print y;\n"
+          "End Scope\n");
+    EXPECT_EQ(count("MUL", "_x"), 2);
+
+    EXPECT_TRUE(code_optimizer_ssa_optimization(parser->optimizer));
+    EXPECT_EQ(count("MUL", "_x"), 1);
+    EXPECT_EQ(count("MOVE", "_z GF@"), 1) << "Dominating value is reused";
+}
@@ -0,0 +1,110 @@
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "../src/meta_data_constants_table.h"
+#include "../src/code_instruction.h"
+}
+
+class ConstantsTableTestFixture : public testing::Test {
+    protected:
+        ConstantsTable* table = nullptr;
+        // only identity of setters is checked
+        CodeInstruction setters[2] = {};
+
+        void SetUp() override {
+            table = constants_table_init();
+        }
+
+        void TearDown() override {
+            constants_table_free(&table);
+        }
+
+        static int constant_value(ConstantsTable* table, const char* key) {
+            CodeInstructionOperand* constant = constants_table_get_constant(table, key);
+            return constant == nullptr ? -1 : constant->data.constant.data.integer;
+        }
+};
+
+TEST_F(ConstantsTableTestFixture, SetAndRemove) {
+    EXPECT_EQ(constants_table_get_constant(table, "LF@a"), nullptr);
+    EXPECT_EQ(constants_table_remove(table, "LF@a"), nullptr);
+
+    constants_table_set(table, "LF@a", code_instruction_operand_init_integer(42), &setters[0]);
+    EXPECT_EQ(constant_value(table, "LF@a"), 42);
+    EXPECT_EQ(constants_table_get_setter(table, "LF@a"), &setters[0]);
+
+    EXPECT_EQ(constants_table_remove(table, "LF@a"), &setters[0]);
+    EXPECT_EQ(constants_table_get_constant(table, "LF@a"), nullptr);
+    EXPECT_EQ(constants_table_get_setter(table, "LF@a"), nullptr);
+}
+
+TEST_F(ConstantsTableTestFixture, Block) {
+    constants_table_set(table, "LF@a", code_instruction_operand_init_integer(1), &setters[0]);
+    constants_table_block(table, "LF@a");
+    constants_table_block(table, "LF@b");
+
+    EXPECT_TRUE(constants_table_is_blocked(table, "LF@a"));
+    EXPECT_TRUE(constants_table_is_blocked(table, "LF@b"));
+    EXPECT_FALSE(constants_table_is_blocked(table, "LF@c"));
+    EXPECT_EQ(constants_table_get_constant(table, "LF@a"), nullptr) << "Blocked constant is not propagated";
+    EXPECT_EQ(constants_table_get_setter(table, "LF@a"), &setters[0]);
+}
+
+TEST_F(ConstantsTableTestFixture, ForkIsolation) {
+    constants_table_set(table, "LF@a", code_instruction_operand_init_integer(1), &setters[0]);
+    constants_table_set(table, "LF@b", code_instruction_operand_init_integer(2), &setters[0]);
+
+    ConstantsTable* fork = constants_table_fork(table);
+    EXPECT_EQ(constant_value(fork, "LF@a"), 1);
+    EXPECT_EQ(constants_table_get_setter(fork, "LF@a"), nullptr) << "Setters are not inherited";
+    EXPECT_EQ(constants_table_remove(fork, "LF@a"), nullptr);
+
+    constants_table_set(fork, "LF@c", code_instruction_operand_init_integer(3), &setters[1]);
+    constants_table_block(fork, "LF@b");
+    // parent is modified after fork
+    constants_table_remove(table, "LF@b");
+    constants_table_set(table, "LF@d", code_instruction_operand_init_integer(4), &setters[0]);
+
+    EXPECT_EQ(constant_value(table, "LF@a"), 1);
+    EXPECT_EQ(constant_value(table, "LF@b"), -1);
+    EXPECT_EQ(constant_value(table, "LF@c"), -1);
+    EXPECT_EQ(constant_value(table, "LF@d"), 4);
+    EXPECT_FALSE(constants_table_is_blocked(table, "LF@b"));
+    EXPECT_EQ(constants_table_get_setter(table, "LF@a"), &setters[0]);
+
+    EXPECT_EQ(constant_value(fork, "LF@a"), -1);
+    EXPECT_EQ(constant_value(fork, "LF@b"), -1);
+    EXPECT_TRUE(constants_table_is_blocked(fork, "LF@b"));
+    EXPECT_EQ(constant_value(fork, "LF@c"), 3);
+    EXPECT_EQ(constant_value(fork, "LF@d"), -1);
+
+    constants_table_free(&fork);
+    EXPECT_EQ(constant_value(table, "LF@a"), 1) << "Shared content outlives fork";
+}
+
+TEST_F(ConstantsTableTestFixture, ManyVariablesInForks) {
+    const int count = 500;
+    std::vector<std::string> keys;
+    for(int i = 0; i < count; ++i) {
+        keys.push_back("LF@var" + std::to_string(i));
+        constants_table_set(table, keys.back().c_str(), code_instruction_operand_init_integer(i), nullptr);
+    }
+
+    std::vector<ConstantsTable*> forks;
+    for(int i = 0; i < 10; ++i) {
+        forks.push_back(constants_table_fork(i == 0 ? table : forks.back()));
+        for(int j = i; j < count; j += 10)
+            constants_table_remove(forks.back(), keys[j].c_str());
+    }
+
+    for(int i = 0; i < count; ++i) {
+        EXPECT_EQ(constant_value(table, keys[i].c_str()), i);
+        for(int f = 0; f < 10; ++f)
+            EXPECT_EQ(constant_value(forks[f], keys[i].c_str()), i % 10 <= f ? -1 : i);
+    }
+
+    for(auto fork : forks)
+        constants_table_free(&fork);
+}
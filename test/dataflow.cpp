@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+#include <vector>
+
+extern "C" {
+#include "../src/dataflow.h"
+}
+
+class DataflowTestFixture : public testing::Test {
+    protected:
+        OrientedGraph* graph = nullptr;
+        Dataflow* dataflow = nullptr;
+
+        void SetUp() override {
+            graph = oriented_graph_init(sizeof(GraphNodeBase), nullptr, nullptr);
+            // 0 -> 1 -> 2 -> 1, 2 -> 3, 0 -> 3
+            for(int i = 0; i < 4; i++)
+                oriented_graph_new_node(graph);
+            oriented_graph_connect_nodes_by_ids(graph, 0, 1);
+            oriented_graph_connect_nodes_by_ids(graph, 1, 2);
+            oriented_graph_connect_nodes_by_ids(graph, 2, 1);
+            oriented_graph_connect_nodes_by_ids(graph, 2, 3);
+            oriented_graph_connect_nodes_by_ids(graph, 0, 3);
+        }
+
+        void TearDown() override {
+            if(dataflow != nullptr)
+                dataflow_free(&dataflow);
+            oriented_graph_free(&graph);
+        }
+
+        static std::vector<int> values(SetInt* set) {
+            std::vector<int> result;
+            for(int value = set_int_first(set); value != SET_INT_END; value = set_int_next(set, value))
+                result.push_back(value);
+            return result;
+        }
+};
+
+TEST_F(DataflowTestFixture, ForwardUnion) {
+    // reaching definitions, definition 0 in node 0 and definition 1 of same variable in node 2
+    dataflow = dataflow_init(graph, DATAFLOW_DIRECTION_FORWARD, DATAFLOW_MEET_UNION, 2);
+    set_int_add(dataflow->gen[0], 0);
+    set_int_add(dataflow->kill[0], 1);
+    set_int_add(dataflow->gen[2], 1);
+    set_int_add(dataflow->kill[2], 0);
+    dataflow_solve(dataflow, graph);
+
+    EXPECT_EQ(values(dataflow->in[0]), std::vector<int>());
+    EXPECT_EQ(values(dataflow->in[1]), std::vector<int>({0, 1}));
+    EXPECT_EQ(values(dataflow->out[2]), std::vector<int>({1}));
+    EXPECT_EQ(values(dataflow->in[3]), std::vector<int>({0, 1}));
+}
+
+TEST_F(DataflowTestFixture, BackwardUnion) {
+    // liveness, variable 0 used in node 2 and defined in node 0, variable 1 used in node 3
+    dataflow = dataflow_init(graph, DATAFLOW_DIRECTION_BACKWARD, DATAFLOW_MEET_UNION, 2);
+    set_int_add(dataflow->kill[0], 0);
+    set_int_add(dataflow->gen[2], 0);
+    set_int_add(dataflow->gen[3], 1);
+    set_int_add(dataflow->boundary, 1);
+    dataflow_solve(dataflow, graph);
+
+    EXPECT_EQ(values(dataflow->in[0]), std::vector<int>({1}));
+    EXPECT_EQ(values(dataflow->out[0]), std::vector<int>({0, 1}));
+    EXPECT_EQ(values(dataflow->in[1]), std::vector<int>({0, 1}));
+    EXPECT_EQ(values(dataflow->out[3]), std::vector<int>({1})) << "Boundary at exit";
+}
+
+TEST_F(DataflowTestFixture, ForwardIntersection) {
+    // available expressions, expression 0 computed in node 0 and killed in loop, expression 1 computed on both paths
+    dataflow = dataflow_init(graph, DATAFLOW_DIRECTION_FORWARD, DATAFLOW_MEET_INTERSECTION, 100);
+    set_int_add(dataflow->gen[0], 0);
+    set_int_add(dataflow->gen[0], 1);
+    set_int_add(dataflow->gen[0], 99);
+    set_int_add(dataflow->kill[1], 0);
+    set_int_add(dataflow->gen[2], 1);
+    dataflow_solve(dataflow, graph);
+
+    EXPECT_EQ(values(dataflow->in[0]), std::vector<int>());
+    EXPECT_EQ(values(dataflow->in[1]), std::vector<int>({1, 99}));
+    EXPECT_EQ(values(dataflow->in[3]), std::vector<int>({1, 99}));
+    EXPECT_EQ(values(dataflow->out[1]), std::vector<int>({1, 99}));
+}
+
+TEST_F(DataflowTestFixture, NodeIsEvaluatedAgainOnlyAfterChange) {
+    dataflow = dataflow_init(graph, DATAFLOW_DIRECTION_FORWARD, DATAFLOW_MEET_UNION, 1);
+    set_int_add(dataflow->gen[0], 0);
+    dataflow_solve(dataflow, graph);
+
+    // loop header is evaluated again after back edge brings new fact
+    EXPECT_LE(dataflow->evaluations_count, 6);
+    EXPECT_EQ(values(dataflow->out[3]), std::vector<int>({0}));
+}
@@ -90,3 +90,19 @@ TEST_F(DynamicStringTestFixture, AppendLong) {
             STRING_INITIAL_CAPACITY * 4
     ) << "Append very long string.";
 }
+
+TEST_F(DynamicStringTestFixture, AppendN) {
+    string_append_s(string, "foo");
+    string_append_n(string, "barbaz", 3);
+    EXPECT_STREQ(
+            string_content(string),
+            "foobar"
+    ) << "Error appending part of string";
+
+    std::string to_append(STRING_INITIAL_CAPACITY * 3, 'X');
+    string_append_n(string, to_append.c_str(), to_append.length());
+    EXPECT_EQ(
+            string_length(string),
+            STRING_INITIAL_CAPACITY * 3 + 6
+    ) << "Append very long part of string.";
+}
@@ -393,3 +393,36 @@ TEST_F(ParserExpressionTestFixture, SooooooooHardcooooooreExpressionII) {
 
 
 
+TEST_F(ParserExpressionTestFixture, DeeplyNestedExpression) {
+    // deeper than inline capacity of work stack
+    const int depth = 3 * EXPR_TOKEN_STACK_INLINE_CAPACITY;
+    std::string expression;
+    for(int i = 0; i < depth; ++i)
+        expression += "(1 + ";
+    expression += "1";
+    for(int i = 0; i < depth; ++i)
+        expression += ")";
+    provider->setString(expression + " * (((((((((((42))))))))))) begin");
+
+    EXPECT_TRUE(
+            parser_parse_expression(parser)
+    ) << "Error parsing <expression> rule";
+
+    EXPECT_EQ(
+            (tmp = lexer_next_token(parser->lexer)).type,
+            TOKEN_IDENTIFIER
+    ) << "Error get token after <expression> rule";
+}
+
+TEST_F(ParserExpressionTestFixture, PrecedenceRelations) {
+    EXPECT_EQ(expr_get_precedence(EXPR_TOKEN_PLUS, EXPR_TOKEN_MULTIPLY), EXPR_LEFT_SHARP);
+    EXPECT_EQ(expr_get_precedence(EXPR_TOKEN_MULTIPLY, EXPR_TOKEN_PLUS), EXPR_RIGHT_SHARP);
+    EXPECT_EQ(expr_get_precedence(EXPR_TOKEN_LEFT_BRACKET, EXPR_TOKEN_RIGHT_BRACKET), EXPR_SAME);
+    EXPECT_EQ(expr_get_precedence(EXPR_TOKEN_IDENTIFIER, EXPR_TOKEN_LEFT_BRACKET), EXPR_SAME);
+    EXPECT_EQ(expr_get_precedence(EXPR_TOKEN_STRING_LITERAL, EXPR_TOKEN_PLUS), EXPR_RIGHT_SHARP)
+                        << "Literals have precedence of identifier";
+    EXPECT_EQ(expr_get_precedence(EXPR_TOKEN_EQUAL, EXPR_TOKEN_LESSER), EXPR_UNKNOWN);
+    EXPECT_EQ(expr_get_precedence(EXPR_TOKEN_$, EXPR_TOKEN_$), EXPR_UNKNOWN);
+    EXPECT_EQ(expr_get_precedence(EXPR_TOKEN_PLUS, EXPR_UNKNOWN), EXPR_UNKNOWN) << "Not terminal";
+    EXPECT_EQ(expr_get_precedence(EXPR_EXPRESSION, EXPR_TOKEN_PLUS), EXPR_UNKNOWN) << "Not terminal";
+}
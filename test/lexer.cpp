@@ -9,13 +9,14 @@ extern "C" {
 #include "../src/memory.h"
 }
 
-class LexerTokenizerTestFixture : public ::testing::Test {
+class LexerTokenizerTestFixture : public ::testing::TestWithParam<LexerFSMEngine> {
     protected:
         Lexer* lexer;
         StringByCharProvider* provider;
 
         void SetUp() override {
             lexer = lexer_init(token_stream);
+            lexer->lexer_fsm->engine = GetParam();
             provider = StringByCharProvider::instance();
         }
 
@@ -31,144 +32,78 @@ class LexerTokenizerTestFixture : public ::testing::Test {
         }
 };
 
+// both engines must pass same suite
+INSTANTIATE_TEST_SUITE_P(
+        Engines, LexerTokenizerTestFixture,
+        ::testing::Values(LEXER_FSM_ENGINE__SWITCH, LEXER_FSM_ENGINE__TABLE)
+);
+
+
+TEST_P(LexerTokenizerTestFixture, StringToInteger) {
+    const std::vector<std::pair<const char*, int>> literals = {
+            {"b101",                                                        5},
+            {"b0",                                                          0},
+            {"b00000000000000000000000000000000000000000000000000000000000", 0},
+            {"b111",                                                        7},
+            {"b000000111",                                                  7},
+            {"b000010111",                                                  23},
+            {"b000000110",                                                  6},
+            {"o1",                                                          1},
+            {"o1065",                                                       565},
+            {"h6776",                                                       26486},
+            {"hd25",                                                        3365},
+            {"hd2a5",                                                       53925},
+            {"hd245456",                                                    220484694},
+            {"h0000001",                                                    1},
+            {"h0000000",                                                    0},
+            {"h1f1a1",                                                      127393},
+            {"0042",                                                        42},
+            {"2147483647",                                                  2147483647},
+            {"h7fffffff",                                                   2147483647},
+    };
 
-TEST_F(LexerTokenizerTestFixture, StringToInteger) {
-    char* integer_value;
-
-    integer_value = c_string_copy("b101");
-    lexer_transform_integer_value(&integer_value);
-    EXPECT_STREQ(
-            integer_value,
-            "5"
-    );
-    memory_free(integer_value);
-
-    integer_value = c_string_copy("b0");
-    lexer_transform_integer_value(&integer_value);
-    EXPECT_STREQ(
-            integer_value,
-            "0"
-    );
-    memory_free(integer_value);
-
-    integer_value = c_string_copy("b00000000000000000000000000000000000000000000000000000000000");
-    lexer_transform_integer_value(&integer_value);
-    EXPECT_STREQ(
-            integer_value,
-            "0"
-    );
-    memory_free(integer_value);
-
-    integer_value = c_string_copy("b111");
-    lexer_transform_integer_value(&integer_value);
-    EXPECT_STREQ(
-            integer_value,
-            "7"
-    );
-    memory_free(integer_value);
-
-    integer_value = c_string_copy("b000000111");
-    lexer_transform_integer_value(&integer_value);
-    EXPECT_STREQ(
-            integer_value,
-            "7"
-    );
-    memory_free(integer_value);
-
-    integer_value = c_string_copy("b000010111");
-    lexer_transform_integer_value(&integer_value);
-    EXPECT_STREQ(
-            integer_value,
-            "23"
-    );
-    memory_free(integer_value);
-
-    integer_value = c_string_copy("b000000110");
-    lexer_transform_integer_value(&integer_value);
-    EXPECT_STREQ(
-            integer_value,
-            "6"
-    );
-    memory_free(integer_value);
-
-    integer_value = c_string_copy("o1");
-    lexer_transform_integer_value(&integer_value);
-    EXPECT_STREQ(
-            integer_value,
-            "1"
-    );
-    memory_free(integer_value);
-
-    integer_value = c_string_copy("o1065");
-    lexer_transform_integer_value(&integer_value);
-    EXPECT_STREQ(
-            integer_value,
-            "565"
-    );
-    memory_free(integer_value);
-
-    integer_value = c_string_copy("h6776");
-    lexer_transform_integer_value(&integer_value);
-    EXPECT_STREQ(
-            integer_value,
-            "26486"
-    );
-    memory_free(integer_value);
-
-    integer_value = c_string_copy("hd25");
-    lexer_transform_integer_value(&integer_value);
-    EXPECT_STREQ(
-            integer_value,
-            "3365"
-    );
-    memory_free(integer_value);
-
-    integer_value = c_string_copy("hd2a5");
-    lexer_transform_integer_value(&integer_value);
-    EXPECT_STREQ(
-            integer_value,
-            "53925"
-    );
-    memory_free(integer_value);
-
-    integer_value = c_string_copy("hd245456");
-    lexer_transform_integer_value(&integer_value);
-    EXPECT_STREQ(
-            integer_value,
-            "220484694"
-    );
-
-    memory_free(integer_value);
-
-    integer_value = c_string_copy("h0000001");
-    lexer_transform_integer_value(&integer_value);
-    EXPECT_STREQ(
-            integer_value,
-            "1"
-    );
+    for(const auto &literal: literals) {
+        int value = -1;
+        EXPECT_TRUE(lexer_parse_integer_value(literal.first, &value)) << literal.first;
+        EXPECT_EQ(value, literal.second) << literal.first;
+    }
+}
 
-    memory_free(integer_value);
+TEST_P(LexerTokenizerTestFixture, IntegerOverflow) {
+    int value;
+    EXPECT_FALSE(lexer_parse_integer_value("2147483648", &value));
+    EXPECT_FALSE(lexer_parse_integer_value("99999999999999999999999", &value));
+    EXPECT_FALSE(lexer_parse_integer_value("h80000000", &value));
+    EXPECT_FALSE(lexer_parse_integer_value("b100000000000000000000000000000000", &value));
 
-    integer_value = c_string_copy("h0000000");
-    lexer_transform_integer_value(&integer_value);
-    EXPECT_STREQ(
-            integer_value,
-            "0"
-    );
+    EXPECT_FALSE(lexer_parse_integer_value("hffffffff", &value));
+    EXPECT_EQ(value, -1) << "Overflowed value is truncated";
 
-    memory_free(integer_value);
+    double double_value;
+    EXPECT_FALSE(lexer_parse_double_value("1e999", &double_value));
+    EXPECT_TRUE(lexer_parse_double_value("1e-999", &double_value)) << "Underflow is rounded to zero";
+    EXPECT_EQ(double_value, 0.0);
+}
 
-    integer_value = c_string_copy("h1f1a1");
-    lexer_transform_integer_value(&integer_value);
-    EXPECT_STREQ(
-            integer_value,
-            "127393"
-    );
+TEST_P(LexerTokenizerTestFixture, NumericLiteralValues) {
+    provider->setString("&B101 &O17 &HfF 1234 1.5 2e3 0.25E-2");
 
-    memory_free(integer_value);
+    Token token = lexer_next_token(lexer);
+    EXPECT_EQ(token.type, TOKEN_INTEGER_LITERAL);
+    EXPECT_EQ(token.value.integer, 5);
+    EXPECT_EQ(token.data, nullptr) << "Numeric literals don't carry text";
+    EXPECT_EQ(lexer_next_token(lexer).value.integer, 15);
+    EXPECT_EQ(lexer_next_token(lexer).value.integer, 255);
+    EXPECT_EQ(lexer_next_token(lexer).value.integer, 1234);
+
+    token = lexer_next_token(lexer);
+    EXPECT_EQ(token.type, TOKEN_DOUBLE_LITERAL);
+    EXPECT_DOUBLE_EQ(token.value.double_, 1.5);
+    EXPECT_DOUBLE_EQ(lexer_next_token(lexer).value.double_, 2e3);
+    EXPECT_DOUBLE_EQ(lexer_next_token(lexer).value.double_, 0.25e-2);
 }
 
-TEST_F(LexerTokenizerTestFixture, Keywords) {
+TEST_P(LexerTokenizerTestFixture, Keywords) {
     provider->setString("AS + sCOpE");
     char_stack_empty(lexer->lexer_fsm->stack);
 
@@ -190,7 +125,7 @@ TEST_F(LexerTokenizerTestFixture, Keywords) {
 
 }
 
-TEST_F(LexerTokenizerTestFixture, MathTokens) {
+TEST_P(LexerTokenizerTestFixture, MathTokens) {
     provider->setString("+ \n -     + \t * /");
 
     EXPECT_EQ(
@@ -224,7 +159,7 @@ TEST_F(LexerTokenizerTestFixture, MathTokens) {
     ) << "Error get divide token";
 }
 
-TEST_F(LexerTokenizerTestFixture, IntegerLiterals) {
+TEST_P(LexerTokenizerTestFixture, IntegerLiterals) {
     provider->setString(R"RAW(
 127
 &B111
@@ -259,7 +194,7 @@ TEST_F(LexerTokenizerTestFixture, IntegerLiterals) {
 
 }
 
-TEST_F(LexerTokenizerTestFixture, Strings) {
+TEST_P(LexerTokenizerTestFixture, Strings) {
     provider->setString(R"RAW(
 !"Simple string"
 !"\\\n _hudkghj6878"
@@ -300,7 +235,7 @@ TEST_F(LexerTokenizerTestFixture, Strings) {
 
 }
 
-TEST_F(LexerTokenizerTestFixture, IntegersAndDoubles) {
+TEST_P(LexerTokenizerTestFixture, IntegersAndDoubles) {
     provider->setString(R"RAW(
 124667257
 1221342.54654
@@ -343,7 +278,32 @@ TEST_F(LexerTokenizerTestFixture, IntegersAndDoubles) {
     }
 }
 
-TEST_F(LexerTokenizerTestFixture, Identifiers) {
+TEST_P(LexerTokenizerTestFixture, Lookahead) {
+    provider->setString("dim x as integer\n");
+
+    EXPECT_EQ(lexer_peek_token(lexer, 0).type, TOKEN_DIM);
+    EXPECT_EQ(lexer_peek_token(lexer, 2).type, TOKEN_AS);
+    EXPECT_STREQ(lexer_peek_token(lexer, 1).data, "x");
+    EXPECT_EQ(lexer_peek_token(lexer, 0).type, TOKEN_DIM) << "Peek doesn't consume";
+
+    Token dim = lexer_next_token(lexer);
+    Token x = lexer_next_token(lexer);
+    EXPECT_EQ(dim.type, TOKEN_DIM);
+    EXPECT_EQ(x.type, TOKEN_IDENTIFIER);
+
+    // more tokens could be returned back, in reversed order
+    lexer_rewind_token(lexer, x);
+    lexer_rewind_token(lexer, dim);
+    EXPECT_EQ(getNextTokenType(), TOKEN_DIM);
+    EXPECT_EQ(getNextTokenType(), TOKEN_IDENTIFIER);
+    EXPECT_EQ(getNextTokenType(), TOKEN_AS);
+    EXPECT_EQ(lexer_peek_token(lexer, 1).type, TOKEN_EOL);
+    EXPECT_EQ(getNextTokenType(), TOKEN_INTEGER);
+    EXPECT_EQ(getNextTokenType(), TOKEN_EOL);
+    EXPECT_EQ(getNextTokenType(), TOKEN_EOF);
+}
+
+TEST_P(LexerTokenizerTestFixture, Identifiers) {
     provider->setString("ahoj _9h7___ a_9");
 
     EXPECT_EQ(
@@ -362,7 +322,7 @@ TEST_F(LexerTokenizerTestFixture, Identifiers) {
     ) << "Error IDENTIFIER  add token";
 }
 
-TEST_F(LexerTokenizerTestFixture, EOFToken) {
+TEST_P(LexerTokenizerTestFixture, EOFToken) {
     provider->setString("");
 
     EXPECT_EQ(
@@ -383,7 +343,7 @@ TEST_F(LexerTokenizerTestFixture, EOFToken) {
     ) << "Error EOF token";
 }
 
-TEST_F(LexerTokenizerTestFixture, AssignmentTokens) {
+TEST_P(LexerTokenizerTestFixture, AssignmentTokens) {
     provider->setString("+= 31");
     char_stack_empty(lexer->lexer_fsm->stack);
 
@@ -400,7 +360,7 @@ TEST_F(LexerTokenizerTestFixture, AssignmentTokens) {
 
 }
 
-TEST_F(LexerTokenizerTestFixture, AssignmentTokens1) {
+TEST_P(LexerTokenizerTestFixture, AssignmentTokens1) {
     provider->setString("-= 31 + b");
     char_stack_empty(lexer->lexer_fsm->stack);
 
@@ -427,7 +387,7 @@ TEST_F(LexerTokenizerTestFixture, AssignmentTokens1) {
 
 }
 
-TEST_F(LexerTokenizerTestFixture, RelationOperators) {
+TEST_P(LexerTokenizerTestFixture, RelationOperators) {
     provider->setString("< > <= >= <>");
     char_stack_empty(lexer->lexer_fsm->stack);
 
@@ -457,7 +417,7 @@ TEST_F(LexerTokenizerTestFixture, RelationOperators) {
     ) << "Error SMALLER_BIGGER token";
 }
 
-TEST_F(LexerTokenizerTestFixture, ComplexTestMathematicTokens) {
+TEST_P(LexerTokenizerTestFixture, ComplexTestMathematicTokens) {
 
     provider->setString("+-*/+=-=*=/=");
     EXPECT_EQ(
@@ -503,7 +463,7 @@ TEST_F(LexerTokenizerTestFixture, ComplexTestMathematicTokens) {
 }
 
 
-TEST_F(LexerTokenizerTestFixture, ErrorTokens) {
+TEST_P(LexerTokenizerTestFixture, ErrorTokens) {
 
     provider->setString("@");
     EXPECT_EQ(
@@ -622,7 +582,7 @@ TEST_F(LexerTokenizerTestFixture, ErrorTokens) {
 }
 
 
-TEST_F(LexerTokenizerTestFixture, ComplexTest) {
+TEST_P(LexerTokenizerTestFixture, ComplexTest) {
     provider->setString("+ <= >= ahoj _8wtf \\ *");
 
     EXPECT_EQ(
@@ -666,7 +626,7 @@ TEST_F(LexerTokenizerTestFixture, ComplexTest) {
     ) << "Error EOF token";
 }
 
-TEST_F(LexerTokenizerTestFixture, OneLineComment) {
+TEST_P(LexerTokenizerTestFixture, OneLineComment) {
     provider->setString(R"RAW(PrinT 42; ' !"Zadejte cislo pro vypocet faktorialu";
 InpuT a
 )RAW");
@@ -684,7 +644,7 @@ InpuT a
     }
 }
 
-TEST_F(LexerTokenizerTestFixture, StringWithEscapeSequences) {
+TEST_P(LexerTokenizerTestFixture, StringWithEscapeSequences) {
     provider->setString(R"(!"foob\238armanr545")");
 
     Token token = lexer_next_token(lexer);
@@ -700,7 +660,7 @@ TEST_F(LexerTokenizerTestFixture, StringWithEscapeSequences) {
     token_free(&token);
 }
 
-TEST_F(LexerTokenizerTestFixture, EmptyString) {
+TEST_P(LexerTokenizerTestFixture, EmptyString) {
     provider->setString(R"(!"")");
 
     Token token = lexer_next_token(lexer);
@@ -717,7 +677,7 @@ TEST_F(LexerTokenizerTestFixture, EmptyString) {
 }
 
 
-TEST_F(LexerTokenizerTestFixture, LongString) {
+TEST_P(LexerTokenizerTestFixture, LongString) {
     provider->setString(
             R"(!"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat. Duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur. Excepteur sint occaecat cupidatat non proident, sunt in culpa qui officia deserunt mollit anim id est laborum.")");
 
@@ -727,7 +687,7 @@ TEST_F(LexerTokenizerTestFixture, LongString) {
     );
 }
 
-TEST_F(LexerTokenizerTestFixture, SecondComplexTest) {
+TEST_P(LexerTokenizerTestFixture, SecondComplexTest) {
     provider->setString(R"RAW(
 /'Program 2: Vypocet faktorialu (rekurzivne)'/
 Declare Function factorial (n As Integer) As Integer
@@ -778,7 +738,7 @@ End Function
     }
 }
 
-TEST_F(LexerTokenizerTestFixture, ThirdComplexTest) {
+TEST_P(LexerTokenizerTestFixture, ThirdComplexTest) {
     provider->setString(R"RAW(
 /' Program 3: Prace s retezci a vestavenymi funkcemi '/
 Scope
@@ -852,3 +812,63 @@ End Scope
         ) << "Error token in complex test";
     }
 }
+
+TEST_P(LexerTokenizerTestFixture, BufferedInputAcrossBlocks) {
+    const std::string snippet = R"RAW(/' block
+comment '/ Dim identifier_with_longer_name As Integer = &HFF + 1.5e-3 ' line comment
+Print !"string \"with\" escapes \065 and tabs\t";    identifier_with_longer_name <= 42
+)RAW";
+    std::string program;
+    while(program.length() < 2 * LEXER_INPUT_BLOCK_SIZE + 1)
+        program += snippet;
+
+    FILE* file = tmpfile();
+    ASSERT_NE(file, nullptr);
+    fwrite(program.c_str(), sizeof(char), program.length(), file);
+    rewind(file);
+
+    Lexer* buffered_lexer = lexer_init_with_input(lexer_input_init_file(file));
+    buffered_lexer->lexer_fsm->engine = GetParam();
+    provider->setString(program);
+
+    Token token, buffered_token;
+    do {
+        token = lexer_next_token(lexer);
+        buffered_token = lexer_next_token(buffered_lexer);
+
+        ASSERT_EQ(buffered_token.type, token.type) << "Error token from buffered input";
+        if(token.data != nullptr)
+            EXPECT_STREQ(buffered_token.data, token.data) << "Error token data from buffered input";
+        if(token.type == TOKEN_INTEGER_LITERAL)
+            EXPECT_EQ(buffered_token.value.integer, token.value.integer) << "Error token value from buffered input";
+
+        token_free(&token);
+        token_free(&buffered_token);
+    } while(buffered_token.type != TOKEN_EOF);
+
+    EXPECT_EQ(buffered_lexer->lexer_fsm->line, lexer->lexer_fsm->line);
+
+    lexer_free(&buffered_lexer);
+    fclose(file);
+}
+
+TEST(LexerInputTest, EndOfFileIsNotReadAgain) {
+    FILE* file = tmpfile();
+    ASSERT_NE(file, nullptr);
+    fputs("ab", file);
+    rewind(file);
+
+    LexerInput* input = lexer_input_init_file(file);
+    EXPECT_EQ(lexer_input_next_char(input), 'a');
+    EXPECT_EQ(lexer_input_next_char(input), 'b');
+    EXPECT_EQ(lexer_input_next_char(input), EOF);
+
+    // more input after end, e.g. from terminal, is not waited for
+    fputs("c", file);
+    fseek(file, 2, SEEK_SET);
+    EXPECT_EQ(lexer_input_next_char(input), EOF);
+    EXPECT_EQ(lexer_input_next_char(input), EOF);
+
+    lexer_input_free(&input);
+    fclose(file);
+}
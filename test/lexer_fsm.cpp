@@ -7,13 +7,14 @@ extern "C" {
 #include "../src/lexer_fsm.h"
 }
 
-class LexerFSMTestFixture : public ::testing::Test {
+class LexerFSMTestFixture : public ::testing::TestWithParam<LexerFSMEngine> {
     protected:
         LexerFSM* lexer_fsm;
         StringByCharProvider* provider = StringByCharProvider::instance();
 
         virtual void SetUp() {
             lexer_fsm = lexer_fsm_init(token_stream);
+            lexer_fsm->engine = GetParam();
             provider->reset();
         }
 
@@ -23,7 +24,13 @@ class LexerFSMTestFixture : public ::testing::Test {
 
 };
 
-TEST_F(LexerFSMTestFixture, IsFinalStateTest) {
+// both engines must pass same suite
+INSTANTIATE_TEST_SUITE_P(
+        Engines, LexerFSMTestFixture,
+        ::testing::Values(LEXER_FSM_ENGINE__SWITCH, LEXER_FSM_ENGINE__TABLE)
+);
+
+TEST_P(LexerFSMTestFixture, IsFinalStateTest) {
 
     std::vector<LexerFSMState> final_states = {
             // FINAL STATES
@@ -92,7 +99,7 @@ TEST_F(LexerFSMTestFixture, IsFinalStateTest) {
 }
 
 
-TEST_F(LexerFSMTestFixture, GettingIdentifierTypeTest) {
+TEST_P(LexerFSMTestFixture, GettingIdentifierTypeTest) {
 
     EXPECT_EQ(
             lexer_fsm_get_identifier_state("and"),
@@ -106,7 +113,45 @@ TEST_F(LexerFSMTestFixture, GettingIdentifierTypeTest) {
 
 }
 
-TEST_F(LexerFSMTestFixture, UnknownCharacter) {
+TEST_P(LexerFSMTestFixture, GettingIdentifierTypeAllKeywords) {
+    struct Keyword {
+        const char* name;
+        LexerFSMState state;
+    };
+    const std::vector<Keyword> keywords = {
+#define KEYWORD_ITEM(name, state) {name, state},
+            LEXER_FSM_KEYWORDS(KEYWORD_ITEM)
+#undef KEYWORD_ITEM
+    };
+
+    for(const Keyword &keyword: keywords) {
+        EXPECT_EQ(
+                lexer_fsm_get_identifier_state(keyword.name),
+                keyword.state
+        ) << "Error getting type of keyword " << keyword.name;
+
+        // same hash inputs (first char, last char, length), but not a keyword
+        std::string similar(keyword.name);
+        if(similar.length() > 2) {
+            similar[1] = '_';
+            EXPECT_EQ(
+                    lexer_fsm_get_identifier_state(similar.c_str()),
+                    LEX_FSM__IDENTIFIER_FINISHED
+            ) << "Error getting type of identifier " << similar;
+        }
+        EXPECT_EQ(
+                lexer_fsm_get_identifier_state((std::string(keyword.name) + "x").c_str()),
+                LEX_FSM__IDENTIFIER_FINISHED
+        ) << "Error getting type of identifier " << keyword.name << "x";
+    }
+
+    EXPECT_EQ(
+            lexer_fsm_get_identifier_state("longer_identifier"),
+            LEX_FSM__IDENTIFIER_FINISHED
+    ) << "Error getting identifier type";
+}
+
+TEST_P(LexerFSMTestFixture, UnknownCharacter) {
     provider->setString("@");
     EXPECT_EQ(
             lexer_fsm_next_state(lexer_fsm, LEX_FSM__INIT),
@@ -114,7 +159,7 @@ TEST_F(LexerFSMTestFixture, UnknownCharacter) {
     ) << "Unknown character for lexer.";
 }
 
-TEST_F(LexerFSMTestFixture, UnknownState) {
+TEST_P(LexerFSMTestFixture, UnknownState) {
     provider->setString("a");
     EXPECT_EQ(
             lexer_fsm_next_state(lexer_fsm, LEX_FSM__STRING_NUMERIC_CHAR),
@@ -128,7 +173,7 @@ TEST_F(LexerFSMTestFixture, UnknownState) {
 
 }
 
-TEST_F(LexerFSMTestFixture, LineComment) {
+TEST_P(LexerFSMTestFixture, LineComment) {
     provider->setString("'");
     EXPECT_EQ(
             lexer_fsm_next_state(lexer_fsm, LEX_FSM__INIT),
@@ -154,7 +199,7 @@ TEST_F(LexerFSMTestFixture, LineComment) {
     ) << "End of line resets line comment to init state.";
 }
 
-TEST_F(LexerFSMTestFixture, EOLTest) {
+TEST_P(LexerFSMTestFixture, EOLTest) {
 
     provider->setString("\n");
     EXPECT_EQ(
@@ -164,7 +209,7 @@ TEST_F(LexerFSMTestFixture, EOLTest) {
 
 }
 
-TEST_F(LexerFSMTestFixture, StringNumericChar) {
+TEST_P(LexerFSMTestFixture, StringNumericChar) {
     provider->setString(R"(!"\114")");
     EXPECT_EQ(
             lexer_fsm_next_state(lexer_fsm, LEX_FSM__INIT),
@@ -208,7 +253,7 @@ TEST_F(LexerFSMTestFixture, StringNumericChar) {
 
 }
 
-TEST_F(LexerFSMTestFixture, StringValue) {
+TEST_P(LexerFSMTestFixture, StringValue) {
     provider->setString("\n");
     EXPECT_EQ(
             lexer_fsm_next_state(lexer_fsm, LEX_FSM__STRING_LOAD),
@@ -221,7 +266,7 @@ TEST_F(LexerFSMTestFixture, StringValue) {
     );
 }
 
-TEST_F(LexerFSMTestFixture, BlockComment) {
+TEST_P(LexerFSMTestFixture, BlockComment) {
     provider->setString("/'");
     EXPECT_EQ(
             lexer_fsm_next_state(lexer_fsm, LEX_FSM__INIT),
@@ -258,7 +303,7 @@ TEST_F(LexerFSMTestFixture, BlockComment) {
     ) << "End of comment.";
 }
 
-TEST_F(LexerFSMTestFixture, MathematicOperations) {
+TEST_P(LexerFSMTestFixture, MathematicOperations) {
     provider->setString("+-*/");
 
     EXPECT_EQ(
@@ -302,7 +347,7 @@ TEST_F(LexerFSMTestFixture, MathematicOperations) {
     );
 }
 
-TEST_F(LexerFSMTestFixture, Identifier) {
+TEST_P(LexerFSMTestFixture, Identifier) {
     provider->setString("a");
     EXPECT_EQ(
             lexer_fsm_next_state(lexer_fsm, LEX_FSM__INIT),
@@ -0,0 +1,45 @@
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "../src/lexer_scan.h"
+}
+
+class LexerScanTestFixture : public ::testing::Test {
+};
+
+TEST_F(LexerScanTestFixture, Whitespace) {
+    EXPECT_EQ(lexer_scan_whitespace("", 0), 0);
+    EXPECT_EQ(lexer_scan_whitespace("x  ", 3), 0);
+    EXPECT_EQ(lexer_scan_whitespace(" \t\v\f\rx", 6), 5);
+    EXPECT_EQ(lexer_scan_whitespace("  \n  ", 5), 2) << "New line ends the run";
+
+    // runs ending at every position of vector blocks
+    for(size_t run = 0; run < 100; ++run) {
+        std::string source(run, ' ');
+        source += "Dim";
+        EXPECT_EQ(lexer_scan_whitespace(source.c_str(), source.length()), run);
+        EXPECT_EQ(lexer_scan_whitespace(source.c_str(), run), run) << "Run to end of buffer";
+    }
+}
+
+TEST_F(LexerScanTestFixture, String) {
+    EXPECT_EQ(lexer_scan_string("", 0), 0);
+    EXPECT_EQ(lexer_scan_string("ab\"cd", 5), 2);
+    EXPECT_EQ(lexer_scan_string("ab\\ncd", 6), 2);
+    EXPECT_EQ(lexer_scan_string("ab\tcd", 5), 2) << "Control chars end the run";
+    EXPECT_EQ(lexer_scan_string("a \xc8\xff b", 6), 6) << "Chars above 127 are plain";
+
+    for(size_t run = 0; run < 100; ++run) {
+        std::string source(run, 'x');
+        for(const char end: {'"', '\\', '\n', '\x1f'}) {
+            EXPECT_EQ(lexer_scan_string((source + end).c_str(), run + 1), run);
+        }
+        EXPECT_EQ(lexer_scan_string(source.c_str(), run), run) << "Run to end of buffer";
+    }
+}
+
+TEST_F(LexerScanTestFixture, ToChar) {
+    EXPECT_EQ(lexer_scan_to_char("", 0, '\n'), 0);
+    EXPECT_EQ(lexer_scan_to_char("comment\nDim", 11, '\n'), 7);
+    EXPECT_EQ(lexer_scan_to_char("block comment", 13, '\''), 13);
+}
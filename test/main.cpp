@@ -3,6 +3,7 @@
 extern "C" {
 #include "../src/debug.h"
 #include "../src/memory.h"
+#include "../src/string_interner.h"
 }
 
 short log_verbosity = LOG_VERBOSITY_INFO;
@@ -12,6 +13,7 @@ int main(int argc, char** argv) {
     memory_manager_enter(nullptr);
     auto ret = RUN_ALL_TESTS();
     memory_manager_log_stats(nullptr);
+    string_interner_free(nullptr);
     memory_manager_exit(nullptr);
     return ret;
 }
@@ -12,7 +12,7 @@ class MemoryManagerTestFixture : public ::testing::Test {
         MemoryManager memory_manager;
 
         MemoryManagerTestFixture() : ::testing::Test() {
-            memory_manager.head = nullptr;
+            memory_manager = MemoryManager();
         };
 
         void SetUp() override {
@@ -101,6 +101,118 @@ TEST_F(MemoryManagerTestFixture, MultipleMemoryAllocation) {
     EXPECT_EQ(second_page->address, nullptr) << "Nulled address of freed page.";
 }
 
+TEST_F(MemoryManagerTestFixture, ArenaDrop) {
+    EXPECT_EQ(
+            memory_manager_switch_arena(&memory_manager, MEMORY_MANAGER_ARENA_OPTIMIZER),
+            MEMORY_MANAGER_ARENA_NONE
+    ) << "Default without arena.";
+    void* first_memory = memory_manager_malloc(8, "bar", 1, "foo", &memory_manager);
+    MemoryManagerPage* first_page = memory_manager.head;
+
+    EXPECT_EQ(
+            memory_manager_switch_arena(&memory_manager, MEMORY_MANAGER_ARENA_RENDER),
+            MEMORY_MANAGER_ARENA_OPTIMIZER
+    ) << "Previous arena.";
+    void* second_memory = memory_manager_malloc(16, "file", 1, "function", &memory_manager);
+    MemoryManagerPage* second_page = memory_manager.head;
+
+    EXPECT_EQ(first_page->arena, MEMORY_MANAGER_ARENA_OPTIMIZER) << "Page tagged by arena.";
+    EXPECT_EQ(second_page->arena, MEMORY_MANAGER_ARENA_RENDER) << "Page tagged by arena.";
+
+    memory_manager_drop_arena(&memory_manager, MEMORY_MANAGER_ARENA_RENDER);
+
+    EXPECT_FALSE(second_page->allocated) << "Dropped page.";
+    EXPECT_EQ(second_page->address, nullptr) << "Freed memory of dropped page.";
+    EXPECT_TRUE(first_page->allocated) << "Page from other arena kept.";
+    EXPECT_EQ(first_page->address, first_memory) << "Page from other arena kept.";
+
+    memory_free(first_memory, &memory_manager);
+    UNUSED(second_memory);
+}
+TEST_F(MemoryManagerTestFixture, LazyFreeCollect) {
+    void* first_memory = memory_manager_malloc(8, "bar", 1, "foo", &memory_manager);
+    MemoryManagerPage* first_page = memory_manager.head;
+    void* second_memory = memory_manager_malloc(16, "file", 1, "function", &memory_manager);
+    MemoryManagerPage* second_page = memory_manager.head;
+
+    memory_free_lazy(first_memory, &memory_manager);
+    EXPECT_TRUE(first_page->allocated) << "Lazy freed block kept until collection.";
+    EXPECT_TRUE(first_page->lazy_free) << "Marked as lazy freed.";
+
+    memory_manager_collect(&memory_manager);
+    EXPECT_FALSE(first_page->allocated) << "Lazy freed block collected.";
+    EXPECT_EQ(first_page->address, nullptr) << "Lazy freed block collected.";
+    EXPECT_TRUE(second_page->allocated) << "Other blocks kept.";
+    EXPECT_EQ(
+            memory_manager.pools[MEMORY_MANAGER_POOL_INDEX(8)].recycled, 1
+    ) << "Collected block recycled by pool.";
+
+    memory_free(second_memory, &memory_manager);
+}
+
+TEST_F(MemoryManagerTestFixture, PoolHitRate) {
+    MemoryManagerPool* pool = &memory_manager.pools[MEMORY_MANAGER_POOL_INDEX(24)];
+
+    void* first_memory = memory_manager_malloc(24, "bar", 1, "foo", &memory_manager);
+    EXPECT_EQ(pool->misses, 1) << "Empty pool.";
+    EXPECT_EQ(pool->hits, 0) << "Empty pool.";
+
+    memory_free(first_memory, &memory_manager);
+    EXPECT_EQ(pool->recycled, 1) << "Freed block recycled.";
+
+    void* second_memory = memory_manager_malloc(32, "bar", 1, "foo", &memory_manager);
+    EXPECT_EQ(pool->hits, 1) << "Recycled block of same size class.";
+    EXPECT_EQ(pool->recycled, 0) << "Recycled block used.";
+
+    void* big_memory = memory_manager_malloc(MEMORY_MANAGER_POOL_MAX_SIZE + 1, "bar", 1, "foo", &memory_manager);
+    memory_free(big_memory, &memory_manager);
+    for(auto& size_pool: memory_manager.pools)
+        EXPECT_EQ(size_pool.recycled, 0) << "Big blocks are not pooled.";
+
+    memory_free(second_memory, &memory_manager);
+}
+TEST_F(MemoryManagerTestFixture, SitesTracking) {
+    memory_manager_exit(&memory_manager);
+    memory_manager_enter_tracking(&memory_manager, MEMORY_MANAGER_TRACKING_SITES);
+
+    const char* file = "bar";
+    const char* func = "foo";
+    void* first_memory = memory_manager_malloc(8, file, 1, func, &memory_manager);
+    void* second_memory = memory_manager_malloc(16, file, 1, func, &memory_manager);
+    void* third_memory = memory_manager_malloc(32, file, 2, func, &memory_manager);
+
+    EXPECT_EQ(memory_manager.head, nullptr) << "No pages in sites tracking.";
+    ASSERT_EQ(memory_manager.sites_count, 2) << "Blocks aggregated by sites.";
+
+    MemoryManagerSite* first_site = &memory_manager.sites[0];
+    EXPECT_EQ(first_site->line, 1) << "Site line.";
+    EXPECT_EQ(first_site->count, 2) << "Count of blocks from site.";
+    EXPECT_EQ(first_site->bytes, 24) << "Bytes from site.";
+    EXPECT_EQ(first_site->live_count, 2) << "Live blocks from site.";
+
+    memory_free(first_memory, &memory_manager);
+    EXPECT_EQ(first_site->count, 2) << "Total count kept after free.";
+    EXPECT_EQ(first_site->live_count, 1) << "Live blocks after free.";
+    EXPECT_EQ(first_site->live_bytes, 16) << "Live bytes after free.";
+
+    DISABLE_LOG(
+            {
+                memory_free(&memory_manager, &memory_manager);
+                memory_free(first_memory, &memory_manager);
+                memory_manager_enter_tracking(&memory_manager, MEMORY_MANAGER_TRACKING_SITES);
+            }
+    );
+    EXPECT_EQ(first_site->live_count, 1) << "Foreign address and double free are ignored.";
+    EXPECT_EQ(memory_manager.sites_count, 2) << "Entered session is not reset.";
+
+    memory_free(second_memory, &memory_manager);
+    memory_free_lazy(third_memory, &memory_manager);
+    EXPECT_EQ(memory_manager.sites[1].live_count, 1) << "Lazy free keeps block until exit.";
+
+    memory_manager_exit(&memory_manager);
+    EXPECT_EQ(memory_manager.blocks, nullptr) << "Released blocks.";
+    EXPECT_EQ(memory_manager.sites, nullptr) << "Released sites.";
+}
 
 TEST_F(MemoryManagerTestFixture, Stats) {
     // Empty test case to have stats coverage, only prints stats values.
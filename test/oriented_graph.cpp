@@ -0,0 +1,191 @@
+#include "gtest/gtest.h"
+#include <vector>
+
+extern "C" {
+#include "../src/oriented_graph.h"
+}
+
+class OrientedGraphTestFixture : public testing::Test {
+    protected:
+        OrientedGraph* graph = nullptr;
+
+        void SetUp() override {
+            graph = oriented_graph_init(sizeof(GraphNodeBase), nullptr, nullptr);
+        }
+
+        void TearDown() override {
+            oriented_graph_free(&graph);
+        }
+
+        void add_nodes(unsigned int count) {
+            for(unsigned int i = 0; i < count; i++)
+                oriented_graph_new_node(graph);
+        }
+
+        std::vector<unsigned int> successors(unsigned int id) {
+            size_t count;
+            const unsigned int* ids = oriented_graph_successors(graph, id, &count);
+            return std::vector<unsigned int>(ids, ids + count);
+        }
+
+        std::vector<unsigned int> predecessors(unsigned int id) {
+            size_t count;
+            const unsigned int* ids = oriented_graph_predecessors(graph, id, &count);
+            return std::vector<unsigned int>(ids, ids + count);
+        }
+};
+
+TEST_F(OrientedGraphTestFixture, FrozenEdges) {
+    add_nodes(4);
+    oriented_graph_connect_nodes_by_ids(graph, 0, 2);
+    oriented_graph_connect_nodes_by_ids(graph, 0, 1);
+    oriented_graph_connect_nodes_by_ids(graph, 2, 1);
+    oriented_graph_connect_nodes_by_ids(graph, 3, 0);
+
+    EXPECT_EQ(successors(0), std::vector<unsigned int>({1, 2}));
+    EXPECT_EQ(successors(1), std::vector<unsigned int>());
+    EXPECT_EQ(predecessors(1), std::vector<unsigned int>({0, 2}));
+    EXPECT_EQ(predecessors(0), std::vector<unsigned int>({3}));
+    EXPECT_NE(graph->csr, nullptr);
+
+    // modification drops frozen view
+    oriented_graph_connect_nodes_by_ids(graph, 1, 3);
+    EXPECT_EQ(graph->csr, nullptr);
+    EXPECT_EQ(successors(1), std::vector<unsigned int>({3}));
+
+    oriented_graph_remove_node(graph, 2);
+    EXPECT_EQ(successors(0), std::vector<unsigned int>({1}));
+    EXPECT_EQ(predecessors(1), std::vector<unsigned int>({0}));
+    EXPECT_EQ(successors(2), std::vector<unsigned int>());
+}
+
+TEST_F(OrientedGraphTestFixture, NewNodeReusesRemovedSlot) {
+    add_nodes(40);
+    oriented_graph_remove_node(graph, 5);
+
+    EXPECT_EQ(oriented_graph_new_node(graph)->id, 5);
+    EXPECT_EQ(oriented_graph_new_node(graph)->id, 40);
+    EXPECT_EQ(graph->nodes_count, 41);
+}
+
+TEST_F(OrientedGraphTestFixture, CyclesAndComponents) {
+    add_nodes(6);
+    // 0 -> 1 -> 2 -> 1, 2 -> 3 -> 4 -> 3, 4 -> 5
+    oriented_graph_connect_nodes_by_ids(graph, 0, 1);
+    oriented_graph_connect_nodes_by_ids(graph, 1, 2);
+    oriented_graph_connect_nodes_by_ids(graph, 2, 1);
+    oriented_graph_connect_nodes_by_ids(graph, 2, 3);
+    oriented_graph_connect_nodes_by_ids(graph, 3, 4);
+    oriented_graph_connect_nodes_by_ids(graph, 4, 3);
+    oriented_graph_connect_nodes_by_ids(graph, 4, 5);
+
+    EXPECT_FALSE(oriented_graph_node_is_in_cycle_by_id(graph, 0));
+    EXPECT_TRUE(oriented_graph_node_is_in_cycle_by_id(graph, 1));
+    EXPECT_TRUE(oriented_graph_node_is_in_cycle_by_id(graph, 2));
+    EXPECT_TRUE(oriented_graph_node_is_in_cycle_by_id(graph, 4));
+    EXPECT_FALSE(oriented_graph_node_is_in_cycle_by_id(graph, 5));
+
+    LList* components = oriented_graph_scc(graph);
+    std::vector<std::vector<int>> found;
+    for(LListItemSet* item = (LListItemSet*) components->head; item != nullptr;
+        item = (LListItemSet*) item->base.next) {
+        std::vector<int> ids;
+        for(int id = set_int_first(item->set); id != SET_INT_END; id = set_int_next(item->set, id))
+            ids.push_back(id);
+        found.push_back(ids);
+    }
+    llist_free(&components);
+
+    EXPECT_EQ(found, std::vector<std::vector<int>>({{3, 4}, {1, 2}}));
+}
+
+TEST_F(OrientedGraphTestFixture, DominatorsAndNestedLoops) {
+    add_nodes(7);
+    // 0 -> 1 -> 2 -> 3 -> 2, 3 -> 4 -> 1, 1 -> 5, 6 -> 6
+    oriented_graph_connect_nodes_by_ids(graph, 0, 1);
+    oriented_graph_connect_nodes_by_ids(graph, 1, 2);
+    oriented_graph_connect_nodes_by_ids(graph, 2, 3);
+    oriented_graph_connect_nodes_by_ids(graph, 3, 2);
+    oriented_graph_connect_nodes_by_ids(graph, 3, 4);
+    oriented_graph_connect_nodes_by_ids(graph, 4, 1);
+    oriented_graph_connect_nodes_by_ids(graph, 1, 5);
+    oriented_graph_connect_nodes_by_ids(graph, 6, 6);
+
+    OrientedGraphLoopForest* forest = oriented_graph_loop_forest_init(graph);
+    EXPECT_EQ(forest->immediate_dominators[0], -1);
+    EXPECT_EQ(forest->immediate_dominators[2], 1);
+    EXPECT_EQ(forest->immediate_dominators[4], 3);
+    EXPECT_EQ(forest->immediate_dominators[5], 1);
+    EXPECT_EQ(forest->immediate_dominators[6], -1);
+    EXPECT_TRUE(oriented_graph_loop_forest_dominates(forest, 1, 4));
+    EXPECT_FALSE(oriented_graph_loop_forest_dominates(forest, 2, 5));
+
+    ASSERT_EQ(forest->loops_count, 3);
+    const int outer = oriented_graph_loop_forest_innermost_loop(forest, 1);
+    const int inner = oriented_graph_loop_forest_innermost_loop(forest, 3);
+    ASSERT_NE(outer, -1);
+    ASSERT_NE(inner, -1);
+    EXPECT_EQ(forest->loops[outer].header, 1);
+    EXPECT_EQ(forest->loops[outer].parent, -1);
+    EXPECT_EQ(set_int_size(forest->loops[outer].nodes), 4);
+    EXPECT_EQ(forest->loops[inner].header, 2);
+    EXPECT_EQ(forest->loops[inner].parent, outer);
+    EXPECT_EQ(set_int_size(forest->loops[inner].nodes), 2);
+    EXPECT_EQ(oriented_graph_loop_forest_outermost_loop(forest, 3), outer);
+    EXPECT_EQ(oriented_graph_loop_forest_innermost_loop(forest, 0), -1);
+    EXPECT_EQ(oriented_graph_loop_forest_innermost_loop(forest, 5), -1);
+    EXPECT_NE(oriented_graph_loop_forest_innermost_loop(forest, 6), -1) << "Self loop";
+
+    oriented_graph_loop_forest_free(&forest);
+}
+
+TEST_F(OrientedGraphTestFixture, IrreducibleLoop) {
+    add_nodes(4);
+    // cycle 1 <-> 2 is entered from 0 by both nodes
+    oriented_graph_connect_nodes_by_ids(graph, 0, 1);
+    oriented_graph_connect_nodes_by_ids(graph, 0, 2);
+    oriented_graph_connect_nodes_by_ids(graph, 1, 2);
+    oriented_graph_connect_nodes_by_ids(graph, 2, 1);
+    oriented_graph_connect_nodes_by_ids(graph, 2, 3);
+
+    OrientedGraphLoopForest* forest = oriented_graph_loop_forest_init(graph);
+    EXPECT_EQ(forest->immediate_dominators[1], 0);
+    EXPECT_EQ(forest->immediate_dominators[2], 0);
+    ASSERT_EQ(forest->loops_count, 1);
+    EXPECT_EQ(set_int_size(forest->loops[0].nodes), 2);
+    EXPECT_EQ(oriented_graph_loop_forest_innermost_loop(forest, 1), 0);
+    EXPECT_EQ(oriented_graph_loop_forest_innermost_loop(forest, 2), 0);
+    EXPECT_EQ(oriented_graph_loop_forest_innermost_loop(forest, 3), -1);
+
+    oriented_graph_loop_forest_free(&forest);
+}
+
+TEST_F(OrientedGraphTestFixture, DominanceFrontiers) {
+    add_nodes(6);
+    // diamond 0 -> 1, 2 -> 3 joined into loop 3 -> 4 -> 3, 3 -> 5
+    oriented_graph_connect_nodes_by_ids(graph, 0, 1);
+    oriented_graph_connect_nodes_by_ids(graph, 0, 2);
+    oriented_graph_connect_nodes_by_ids(graph, 1, 3);
+    oriented_graph_connect_nodes_by_ids(graph, 2, 3);
+    oriented_graph_connect_nodes_by_ids(graph, 3, 4);
+    oriented_graph_connect_nodes_by_ids(graph, 4, 3);
+    oriented_graph_connect_nodes_by_ids(graph, 3, 5);
+
+    OrientedGraphLoopForest* forest = oriented_graph_loop_forest_init(graph);
+    std::vector<SetInt*> frontiers;
+    for(int i = 0; i < 6; i++)
+        frontiers.push_back(set_int_init());
+    oriented_graph_loop_forest_dominance_frontiers(forest, graph, frontiers.data());
+
+    std::vector<std::vector<int>> found;
+    for(SetInt* frontier : frontiers) {
+        std::vector<int> ids;
+        for(int id = set_int_first(frontier); id != SET_INT_END; id = set_int_next(frontier, id))
+            ids.push_back(id);
+        found.push_back(ids);
+        set_int_free(&frontier);
+    }
+    EXPECT_EQ(found, std::vector<std::vector<int>>({{}, {3}, {3}, {3}, {3}, {}}));
+
+    oriented_graph_loop_forest_free(&forest);
+}
@@ -28,7 +28,7 @@ class ParserSemanticTestFixture : public ::testing::Test {
 
 TEST_F(ParserSemanticTestFixture, FunctionStatementSingle) {
     symbol_register_push_variables_table(parser->parser_semantic->register_);
-    symbol_table_get_or_create(parser->parser_semantic->register_->variables->symbol_table, "hello_input42");
+    symbol_register_new_variable(parser->parser_semantic->register_, "hello_input42");
 
     provider->setString("input hello_input42");
 
@@ -380,3 +380,65 @@ END SCOPE
     ) << "Body parse";
 }
 
+
+TEST_F(ParserSemanticTestFixture, OperationSignaturesTable) {
+    const DataType data_types[] = {
+            DATA_TYPE_NONE, DATA_TYPE_INTEGER, DATA_TYPE_DOUBLE, DATA_TYPE_STRING, DATA_TYPE_BOOLEAN, DATA_TYPE_ANY
+    };
+    ParserSemantic* semantic = parser->parser_semantic;
+
+    for(int operation = 0; operation < OPERATION__LAST; ++operation) {
+        for(DataType operand_1 : data_types) {
+            for(DataType operand_2 : data_types) {
+                for(DataType target : data_types) {
+                    // first registered signature is expected, same as by sequential search
+                    OperationSignature* expected = nullptr;
+                    LListBaseItem* item = semantic->operations_signatures[operation]->head;
+                    for(; item != nullptr && expected == nullptr; item = item->next) {
+                        auto signature = (OperationSignature*) item;
+                        if(operands_match_data_type_combination(
+                                operand_1, operand_2, signature->operand_1_type, signature->operand_2_type
+                        ) && (target == signature->conversion_target_type || target == DATA_TYPE_ANY))
+                            expected = signature;
+                    }
+
+                    EXPECT_EQ(
+                            parser_semantic_get_operation_signature(
+                                    semantic, (TypeExpressionOperation) operation, operand_1, operand_2, target
+                            ),
+                            expected
+                    ) << "Operation " << operation << " with " << operand_1 << ", " << operand_2 << " to " << target;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(ParserSemanticTestFixture, OperationSignaturesLookup) {
+    ParserSemantic* semantic = parser->parser_semantic;
+    OperationSignature* signature = parser_semantic_get_operation_signature(
+            semantic, OPERATION_ADD, DATA_TYPE_DOUBLE, DATA_TYPE_INTEGER, DATA_TYPE_ANY
+    );
+    ASSERT_NE(signature, nullptr);
+    EXPECT_EQ(signature->result_type, DATA_TYPE_DOUBLE);
+    EXPECT_EQ(signature->conversion_target_type, DATA_TYPE_DOUBLE);
+
+    EXPECT_EQ(
+            parser_semantic_resolve_implicit_data_type_conversion(
+                    semantic, OPERATION_INT_DIVIDE, DATA_TYPE_INTEGER, DATA_TYPE_INTEGER, DATA_TYPE_ANY
+            ),
+            DATA_TYPE_DOUBLE
+    );
+    EXPECT_EQ(
+            parser_semantic_resolve_implicit_data_type_conversion(
+                    semantic, OPERATION_IMPLICIT_CONVERSION, DATA_TYPE_NONE, DATA_TYPE_DOUBLE, DATA_TYPE_INTEGER
+            ),
+            DATA_TYPE_INTEGER
+    );
+    EXPECT_EQ(
+            parser_semantic_get_operation_signature(
+                    semantic, OPERATION_MULTIPLY, DATA_TYPE_STRING, DATA_TYPE_INTEGER, DATA_TYPE_ANY
+            ),
+            nullptr
+    );
+}
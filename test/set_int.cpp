@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <vector>
 
 extern "C" {
 #include "../src/set_int.h"
@@ -111,3 +112,138 @@ TEST_F(SetIntTestFixture, ClearItems) {
             set_int_contains(set, 4)
     ) << "Error non inserted value in set.";
 }
+
+TEST_F(SetIntTestFixture, IterateInAscendingOrder) {
+    const int values[] = {7, 3, 200, 64, 0, 63, 65, 1000, 12, 5};
+    for(int value : values)
+        set_int_add(set, value);
+    set_int_add(set, 64);
+
+    EXPECT_EQ(
+            set_int_size(set),
+            10
+    ) << "Error set length is not correct.";
+
+    std::vector<int> iterated;
+    for(int value = set_int_first(set); value != SET_INT_END; value = set_int_next(set, value))
+        iterated.push_back(value);
+
+    EXPECT_EQ(
+            iterated,
+            std::vector<int>({0, 3, 5, 7, 12, 63, 64, 65, 200, 1000})
+    ) << "Error values are not iterated in ascending order.";
+}
+
+TEST_F(SetIntTestFixture, UnionAndDifference) {
+    SetInt* other = set_int_init();
+    for(int i = 0; i < 300; i += 2)
+        set_int_add(set, i);
+    for(int i = 0; i < 300; i += 3)
+        set_int_add(other, i);
+
+    SetInt* united = set_int_copy(set);
+    set_int_union(united, other);
+    set_int_difference(set, other);
+
+    for(int i = 0; i < 300; i++) {
+        EXPECT_EQ(
+                set_int_contains(united, i),
+                i % 2 == 0 || i % 3 == 0
+        ) << "Error union contains " << i;
+        EXPECT_EQ(
+                set_int_contains(set, i),
+                i % 2 == 0 && i % 3 != 0
+        ) << "Error difference contains " << i;
+    }
+
+    EXPECT_EQ(
+            set_int_size(united),
+            200
+    ) << "Error union length is not correct.";
+
+    EXPECT_EQ(
+            set_int_size(set),
+            100
+    ) << "Error difference length is not correct.";
+
+    EXPECT_TRUE(
+            set_int_difference_is_empty(set, united)
+    ) << "Error difference is subset of union.";
+
+    EXPECT_FALSE(
+            set_int_difference_is_empty(united, set)
+    ) << "Error union is not subset of difference.";
+
+    set_int_free(&united);
+    set_int_free(&other);
+}
+
+TEST_F(SetIntTestFixture, SmallAndLargeSets) {
+    SetInt* small = set_int_init();
+    set_int_add(small, 2);
+    set_int_add(small, 500);
+
+    for(int i = 0; i < 20; i++)
+        set_int_add(set, i);
+    set_int_remove(set, 2);
+
+    set_int_union(small, set);
+    EXPECT_EQ(
+            set_int_size(small),
+            21
+    ) << "Error union length is not correct.";
+
+    set_int_difference(small, set);
+    EXPECT_EQ(
+            set_int_size(small),
+            2
+    ) << "Error difference length is not correct.";
+
+    EXPECT_TRUE(
+            set_int_contains(small, 500)
+    ) << "Error missing value in set.";
+
+    set_int_free(&small);
+}
+
+TEST_F(SetIntTestFixture, Intersection) {
+    SetInt* other = set_int_init();
+    for(int i = 0; i < 300; i += 2)
+        set_int_add(set, i);
+    for(int i = 0; i < 300; i += 3)
+        set_int_add(other, i);
+
+    SetInt* small = set_int_init();
+    set_int_add(small, 6);
+    set_int_add(small, 7);
+    set_int_add(small, 1000);
+
+    set_int_intersection(set, other);
+    for(int i = 0; i < 300; i++) {
+        EXPECT_EQ(
+                set_int_contains(set, i),
+                i % 6 == 0
+        ) << "Error intersection contains " << i;
+    }
+    EXPECT_EQ(
+            set_int_size(set),
+            50
+    ) << "Error intersection length is not correct.";
+
+    set_int_intersection(set, small);
+    EXPECT_EQ(
+            set_int_size(set),
+            1
+    ) << "Error intersection with small set length is not correct.";
+    EXPECT_TRUE(set_int_contains(set, 6));
+
+    set_int_add(set, 12);
+    set_int_intersection(small, set);
+    EXPECT_EQ(
+            set_int_size(small),
+            1
+    ) << "Error intersection of small set length is not correct.";
+
+    set_int_free(&small);
+    set_int_free(&other);
+}
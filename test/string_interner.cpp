@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "../src/string_interner.h"
+#include "../src/symtable.h"
+#include "../src/lexer.h"
+}
+
+#include "utils/stringbycharprovider.h"
+
+class StringInternerTestFixture : public ::testing::Test {
+    protected:
+        StringInterner interner = {};
+
+        virtual void TearDown() {
+            string_interner_free(&interner);
+        }
+};
+
+TEST_F(StringInternerTestFixture, SameContentSamePointer) {
+    const char* first = string_interner_intern_c_string(&interner, "identifier");
+    std::string copy("identifier");
+    const char* second = string_interner_intern_c_string(&interner, copy.c_str());
+
+    EXPECT_STREQ(first, "identifier");
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first, copy.c_str());
+    EXPECT_EQ(string_interner_count(&interner), 1);
+
+    const char* other = string_interner_intern_c_string(&interner, "identifiers");
+    EXPECT_NE(first, other);
+    EXPECT_EQ(string_interner_count(&interner), 2);
+}
+
+TEST_F(StringInternerTestFixture, NotTerminatedChars) {
+    const char* part = string_interner_intern(&interner, "abcdef", 3);
+    EXPECT_STREQ(part, "abc");
+    EXPECT_EQ(string_interner_length(part), 3);
+    EXPECT_EQ(part, string_interner_intern_c_string(&interner, "abc"));
+
+    const char* empty = string_interner_intern(&interner, "abc", 0);
+    EXPECT_STREQ(empty, "");
+    EXPECT_EQ(string_interner_length(empty), 0);
+
+    const char with_nul[] = {'a', '\0', 'b'};
+    EXPECT_NE(string_interner_intern(&interner, with_nul, 3), string_interner_intern(&interner, with_nul, 1));
+}
+
+TEST_F(StringInternerTestFixture, ManyStringsStayValid) {
+    std::vector<const char*> interned;
+    // enough strings to grow table and to allocate more chunks, one longer than chunk
+    for(size_t i = 0; i < 5000; ++i) {
+        std::string s = "variable_" + std::to_string(i);
+        interned.push_back(string_interner_intern(&interner, s.c_str(), s.length()));
+    }
+    std::string long_string(STRING_INTERNER_CHUNK_SIZE * 2, 'x');
+    const char* long_interned = string_interner_intern(&interner, long_string.c_str(), long_string.length());
+
+    EXPECT_EQ(string_interner_count(&interner), 5001);
+    EXPECT_EQ(string_interner_length(long_interned), long_string.length());
+    for(size_t i = 0; i < interned.size(); ++i) {
+        std::string s = "variable_" + std::to_string(i);
+        EXPECT_STREQ(interned[i], s.c_str());
+        EXPECT_EQ(interned[i], string_interner_intern(&interner, s.c_str(), s.length()));
+    }
+    EXPECT_EQ(string_interner_count(&interner), 5001);
+}
+
+TEST_F(StringInternerTestFixture, Reuse) {
+    string_interner_intern_c_string(&interner, "before");
+    string_interner_free(&interner);
+    EXPECT_EQ(string_interner_count(&interner), 0);
+
+    EXPECT_STREQ(string_interner_intern_c_string(&interner, "after"), "after");
+    EXPECT_EQ(string_interner_count(&interner), 1);
+}
+
+TEST_F(StringInternerTestFixture, SymbolTableKeys) {
+    SymbolTable* table = symbol_table_init(8, sizeof(SymbolTableBaseItem), nullptr, nullptr);
+    std::string key("key");
+
+    SymbolTableBaseItem* item = symbol_table_get_or_create(table, key.c_str());
+    EXPECT_EQ(item->key, string_interner_intern_c_string(nullptr, "key")) << "Keys are interned globally";
+    EXPECT_EQ(symbol_table_get(table, item->key), item);
+    EXPECT_EQ(symbol_table_get(table, key.c_str()), item) << "Not interned key is compared by content";
+
+    SymbolTable* copy = symbol_table_copy(table);
+    EXPECT_EQ(symbol_table_get(copy, "key")->key, item->key) << "Copies share interned keys";
+
+    symbol_table_free(copy);
+    symbol_table_free(table);
+}
+
+TEST_F(StringInternerTestFixture, TokensShareData) {
+    StringByCharProvider* provider = StringByCharProvider::instance();
+    provider->setString("abc + abc\n");
+    Lexer* lexer = lexer_init(token_stream);
+
+    Token first = lexer_next_token(lexer);
+    lexer_next_token(lexer);
+    Token second = lexer_next_token(lexer);
+
+    EXPECT_EQ(first.type, TOKEN_IDENTIFIER);
+    EXPECT_EQ(second.type, TOKEN_IDENTIFIER);
+    EXPECT_EQ(first.data, second.data);
+
+    lexer_rewind_token(lexer, second);
+    Token rewound = lexer_next_token(lexer);
+    EXPECT_EQ(rewound.data, second.data) << "Rewound token is not copied";
+
+    lexer_free(&lexer);
+}
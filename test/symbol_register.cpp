@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <string>
 
 extern "C" {
 #include "../src/memory.h"
@@ -52,10 +53,7 @@ TEST_F(SymbolRegisterTestFixture, PushAndGetFunctions) {
 }
 
 TEST_F(SymbolRegisterTestFixture, FindingVariablesInStack) {
-    SymbolVariable* symbol_variable = symbol_table_variable_get_or_create(
-            symbol_register->variables->symbol_table,
-            "foo"
-    );
+    SymbolVariable* symbol_variable = symbol_register_new_variable(symbol_register, "foo");
 
     EXPECT_NE(
             symbol_variable,
@@ -83,10 +81,7 @@ TEST_F(SymbolRegisterTestFixture, FindingVariablesInStack) {
             symbol_variable
     ) << "Recursively found variable.";
 
-    SymbolVariable* new_variable = symbol_table_variable_get_or_create(
-            symbol_register->variables->symbol_table,
-            "bar"
-    );
+    SymbolVariable* new_variable = symbol_register_new_variable(symbol_register, "bar");
 
     EXPECT_EQ(
             symbol_register_find_variable(symbol_register, "bar"),
@@ -109,22 +104,65 @@ TEST_F(SymbolRegisterTestFixture, FindingVariablesInStack) {
 
 TEST_F(SymbolRegisterTestFixture, InvalidStackAccess) {
     SymbolVariable* found_item;
-    SymbolVariable* symbol_variable = symbol_table_variable_get_or_create(
-            symbol_register->variables->symbol_table,
-            "foo_variable_42"
-    );
+    SymbolVariable* symbol_variable = symbol_register_new_variable(symbol_register, "foo_variable_42");
     EXPECT_NE(
             symbol_variable,
             nullptr
     ) << "Found variable";
     symbol_register_pop_variables_table(symbol_register);
-    found_item = symbol_table_variable_get(
-            symbol_register->variables->symbol_table,
-            "foo_variable_42"
-    );
+    found_item = symbol_register_find_variable_recursive(symbol_register, "foo_variable_42");
     EXPECT_EQ(
             found_item,
             nullptr
     ) << "Not found variable in reset stack.";
 
 }
+
+TEST_F(SymbolRegisterTestFixture, ShadowingVariables) {
+    SymbolVariable* outer = symbol_register_new_variable(symbol_register, "foo");
+    SymbolVariable* other = symbol_register_new_variable(symbol_register, "bar");
+
+    symbol_register_push_variables_table(symbol_register);
+    symbol_register_push_variables_table(symbol_register);
+    SymbolVariable* inner = symbol_register_new_variable(symbol_register, "foo");
+
+    EXPECT_NE(inner, outer) << "New variable shadows outer one";
+    EXPECT_EQ(symbol_register_find_variable(symbol_register, "foo"), inner);
+    EXPECT_EQ(symbol_register_find_variable_recursive(symbol_register, "foo"), inner);
+    EXPECT_EQ(symbol_register_find_variable(symbol_register, "bar"), nullptr) << "Variable is from outer scope";
+    EXPECT_EQ(symbol_register_find_variable_recursive(symbol_register, "bar"), other);
+    EXPECT_EQ(symbol_register_new_variable(symbol_register, "foo"), inner) << "Variable already exists in scope";
+
+    symbol_register_push_variables_table(symbol_register);
+    SymbolVariable* innermost = symbol_register_new_variable(symbol_register, "foo");
+    EXPECT_EQ(symbol_register_find_variable_recursive(symbol_register, "foo"), innermost);
+
+    symbol_register_pop_variables_table(symbol_register);
+    EXPECT_EQ(symbol_register_find_variable_recursive(symbol_register, "foo"), inner);
+
+    symbol_register_pop_variables_table(symbol_register);
+    EXPECT_EQ(symbol_register_find_variable(symbol_register, "foo"), nullptr);
+    EXPECT_EQ(symbol_register_find_variable_recursive(symbol_register, "foo"), outer);
+
+    symbol_register_pop_variables_table(symbol_register);
+    EXPECT_EQ(symbol_register_find_variable(symbol_register, "foo"), outer);
+    EXPECT_EQ(symbol_register_find_variable(symbol_register, "bar"), other);
+}
+
+TEST_F(SymbolRegisterTestFixture, ManyScopes) {
+    // more declarations than initial capacity of undo log
+    const int depth = 4 * SYMBOL_REGISTER_UNDO_LOG_BASE_CAPACITY;
+    for(int i = 0; i < depth; ++i) {
+        symbol_register_push_variables_table(symbol_register);
+        symbol_register_new_variable(symbol_register, "i")->data_type = DATA_TYPE_INTEGER;
+        symbol_register_new_variable(symbol_register, ("depth_" + std::to_string(i)).c_str());
+    }
+    for(int i = depth - 1; i >= 0; --i) {
+        EXPECT_NE(symbol_register_find_variable_recursive(symbol_register, "depth_0"), nullptr);
+        EXPECT_NE(symbol_register_find_variable(symbol_register, ("depth_" + std::to_string(i)).c_str()), nullptr);
+        EXPECT_EQ(symbol_register_find_variable(symbol_register, "i")->scope_depth, (size_t) i + 1);
+        symbol_register_pop_variables_table(symbol_register);
+        EXPECT_EQ(symbol_register_find_variable_recursive(symbol_register, ("depth_" + std::to_string(i)).c_str()), nullptr);
+    }
+    EXPECT_EQ(symbol_register_find_variable_recursive(symbol_register, "i"), nullptr);
+}
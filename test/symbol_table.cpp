@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <string>
 
 extern "C" {
 #include "../src/memory.h"
@@ -312,3 +313,43 @@ TEST_F(SymbolTableWithDataTestFixture, CopyAdvanced) {
     );
     symbol_table_free(new_table);
 }
+
+TEST_F(SymbolTableTestFixture, GrowAndRemove) {
+    std::vector<std::string> keys;
+    for(int i = 0; i < 1000; ++i)
+        keys.push_back("key_" + std::to_string(i));
+
+    for(auto &key : keys) {
+        EXPECT_NE(
+                symbol_table_get_or_create(symbol_table, key.c_str()),
+                nullptr
+        );
+    }
+    EXPECT_EQ(symbol_table_size(symbol_table), keys.size());
+    EXPECT_GE(
+            symbol_table_bucket_count(symbol_table) * 3,
+            keys.size() * 4
+    ) << "Table should grow to keep load factor";
+
+    for(auto &key : keys) {
+        SymbolTableBaseItem* item = symbol_table_get(symbol_table, key.c_str());
+        ASSERT_NE(item, nullptr);
+        EXPECT_STREQ(item->key, key.c_str());
+    }
+
+    // remove every other item, the rest must stay reachable
+    for(size_t i = 0; i < keys.size(); i += 2)
+        EXPECT_TRUE(symbol_table_remove(symbol_table, keys[i].c_str()));
+    EXPECT_EQ(symbol_table_size(symbol_table), keys.size() / 2);
+
+    for(size_t i = 0; i < keys.size(); ++i) {
+        if(i % 2 == 0)
+            EXPECT_EQ(symbol_table_get(symbol_table, keys[i].c_str()), nullptr);
+        else
+            EXPECT_NE(symbol_table_get(symbol_table, keys[i].c_str()), nullptr);
+    }
+
+    callCounter->resetCounter();
+    symbol_table_foreach(symbol_table, callCounter->wrapper(), nullptr);
+    EXPECT_EQ(callCounter->callCount(), keys.size() / 2);
+}
@@ -0,0 +1,51 @@
+#ifndef _CODEOPTIMIZERGRAPHFIXTURE_H
+#define _CODEOPTIMIZERGRAPHFIXTURE_H
+
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "stringbycharprovider.h"
+
+extern "C" {
+#include "../../src/parser.h"
+#include "../../src/code_optimizer.h"
+#include "../../src/code_optimizer_expr.h"
+}
+
+// header only, benchmarks are built with sources of utils, but without gtest
+class CodeOptimizerGraphTestFixture : public testing::Test {
+    protected:
+        Parser* parser = nullptr;
+        StringByCharProvider* provider = StringByCharProvider::instance();
+
+        void TearDown() override {
+            if(parser != nullptr)
+                parser_free(&parser);
+        }
+
+        // parses program to code graph of instructions with operands in memory
+        void split(const std::string &program) {
+            provider->setString(program);
+            parser = parser_init(token_stream);
+            ASSERT_TRUE(parser_parse(parser));
+            code_optimizer_optimize_type_casts(parser->optimizer);
+            code_optimizer_update_meta_data(parser->optimizer);
+            code_optimizer_add_advance_peep_hole_patterns(parser->optimizer);
+            while(code_optimizer_peep_hole_optimization_worklist(parser->optimizer));
+            code_optimizer_split_code_to_graph(parser->optimizer);
+            code_optimizer_update_meta_data(parser->optimizer);
+        }
+
+        std::vector<std::string> instructions() {
+            std::vector<std::string> rendered;
+            for(CodeInstruction* instruction = parser->optimizer->generator->first;
+                instruction != nullptr; instruction = instruction->next) {
+                char* line = code_instruction_render(instruction);
+                rendered.emplace_back(line);
+                memory_free(line);
+            }
+            return rendered;
+        }
+};
+
+#endif //_CODEOPTIMIZERGRAPHFIXTURE_H